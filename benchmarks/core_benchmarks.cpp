@@ -0,0 +1,737 @@
+/**
+ * @file core_benchmarks.cpp
+ * @brief Mikrobenchmarki gorących ścieżek biblioteki rdzenia (Google Benchmark)
+ *
+ * Dane wejściowe są budowane z nagranych plików w katalogach data/ i export/:
+ * lista stacji jest przekształcana do formatu odpowiedzi /station/findAll,
+ * a pomiary z eksportów do formatu odpowiedzi /data/getData/{id}.
+ * Wyniki w formacie JSON: --benchmark_out=wyniki.json --benchmark_out_format=json
+ * Licznik "allocs" podaje liczbę alokacji sterty na iterację (globalny operator new).
+ */
+
+#include "api_client.hpp"
+#include "archive_importer.hpp"
+#include "async_client.hpp"
+#include "bounded_queue.hpp"
+#include "fetch_pipeline.hpp"
+#include "measurement_file.hpp"
+#include "measurement_series.hpp"
+#include "resampler.hpp"
+#include "response_decoder.hpp"
+#include "series_codec.hpp"
+#include "series_store.hpp"
+#ifdef AIRQUALITY_MOCK_FIXTURES
+#include "mock_gios_server.hpp"
+#endif
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Liczba wywołań globalnego operatora new (cały proces)
+static std::atomic<std::uint64_t> heapAllocations{0};
+
+void* operator new(std::size_t size) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// Zapisuje średnią liczbę alokacji sterty na iterację
+void reportAllocations(benchmark::State& state, std::uint64_t before) {
+    const std::uint64_t total = heapAllocations.load(std::memory_order_relaxed) - before;
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(total) / static_cast<double>(state.iterations()));
+}
+
+// Katalog główny repozytorium z nagranymi danymi (można nadpisać zmienną środowiskową)
+std::string fixtureDir() {
+    const char* overrideDir = std::getenv("AIRQUALITY_FIXTURE_DIR");
+    return overrideDir ? overrideDir : AIRQUALITY_FIXTURE_DIR;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Nie mozna otworzyc pliku: " + path);
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+std::string stationsFilePath() {
+    return fixtureDir() + "/data/stations.json";
+}
+
+// Pierwszy plik eksportu pojedynczego czujnika
+std::string measurementFilePath() {
+    std::vector<std::string> files;
+    for (const auto& entry : fs::directory_iterator(fixtureDir() + "/export")) {
+        if (entry.path().extension() == ".json") {
+            files.push_back(entry.path().string());
+        }
+    }
+    if (files.empty()) {
+        throw std::runtime_error("Brak plikow eksportu w katalogu export/");
+    }
+    std::sort(files.begin(), files.end());
+    return files.front();
+}
+
+/**
+ * @brief Odpowiedź /station/findAll odtworzona z data/stations.json
+ */
+const std::string& stationsResponse() {
+    static const std::string response = []() {
+        json saved = json::parse(readFile(stationsFilePath()));
+        json api = json::array();
+        for (const auto& item : saved) {
+            char lat[32], lon[32];
+            std::snprintf(lat, sizeof(lat), "%.6f", item["lat"].get<double>());
+            std::snprintf(lon, sizeof(lon), "%.6f", item["lon"].get<double>());
+            api.push_back({
+                {"id", item["id"]},
+                {"stationName", item["name"]},
+                {"gegrLat", lat},
+                {"gegrLon", lon},
+                {"city", {{"id", item["id"]}, {"name", item["city"]},
+                          {"commune", {{"communeName", item["city"]}, {"districtName", item["city"]},
+                                       {"provinceName", item["province"]}}}}},
+                {"addressStreet", item["address"]}
+            });
+        }
+        return api.dump();
+    }();
+    return response;
+}
+
+/**
+ * @brief Odpowiedź /station/sensors/{id} z typowym zestawem parametrów stacji
+ */
+const std::string& sensorsResponse() {
+    static const std::string response = []() {
+        const char* params[][3] = {
+            {"dwutlenek azotu", "NO2", "NO2"}, {"ozon", "O3", "O3"},
+            {"pył zawieszony PM10", "PM10", "PM10"}, {"pył zawieszony PM2.5", "PM2.5", "PM2.5"},
+            {"dwutlenek siarki", "SO2", "SO2"}, {"tlenek węgla", "CO", "CO"}, {"benzen", "C6H6", "C6H6"}
+        };
+        json api = json::array();
+        int id = 50;
+        for (const auto& param : params) {
+            api.push_back({{"id", id}, {"stationId", 11},
+                           {"param", {{"paramName", param[0]}, {"paramFormula", param[1]},
+                                      {"paramCode", param[2]}, {"idParam", id}}}});
+            ++id;
+        }
+        return api.dump();
+    }();
+    return response;
+}
+
+/**
+ * @brief Pomiary z nagranego eksportu powielone do zadanej liczby punktów (co godzinę, malejąco)
+ */
+std::vector<Measurement> measurementsFixture(std::size_t count) {
+    SavedMeasurementFile saved = MeasurementFileLoader::load(measurementFilePath());
+    if (saved.series.empty()) {
+        throw std::runtime_error("Plik eksportu nie zawiera pomiarow");
+    }
+
+    const std::int64_t newest = saved.series.timestamps.back();
+    std::vector<Measurement> measurements;
+    measurements.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const double value = saved.series.values[saved.series.size() - 1 - i % saved.series.size()];
+        measurements.push_back({formatMeasurementDate(newest - static_cast<std::int64_t>(i) * 3600), value});
+    }
+    return measurements;
+}
+
+/**
+ * @brief Odpowiedź /data/getData/{id} o zadanej liczbie pomiarów (co 24. pomiar pusty, jak w API)
+ */
+std::string measurementsResponse(std::size_t count) {
+    json values = json::array();
+    for (const auto& measurement : measurementsFixture(count)) {
+        json value = values.size() % 24 == 23 ? json(nullptr) : json(measurement.value);
+        values.push_back({{"date", measurement.date}, {"value", value}});
+    }
+    return json({{"key", "NO2"}, {"values", values}}).dump();
+}
+
+std::string tempPath(const std::string& name) {
+    return (fs::temp_directory_path() / name).string();
+}
+
+// Rozmiary serii: 3 dni, miesiąc i rok pomiarów godzinowych
+void seriesSizes(benchmark::internal::Benchmark* benchmark) {
+    benchmark->Arg(72)->Arg(720)->Arg(8760);
+}
+
+} // namespace
+
+// ======== Dekodowanie odpowiedzi API ========
+
+// Drzewo JSON (json::parse + ApiClient::parse*)
+static void BM_DecodeStationsResponse(benchmark::State& state) {
+    const std::string& body = stationsResponse();
+    const std::uint64_t allocationsBefore = heapAllocations.load();
+    for (auto _ : state) {
+        std::vector<Station> stations = ApiClient::parseStations(json::parse(body));
+        benchmark::DoNotOptimize(stations.data());
+    }
+    reportAllocations(state, allocationsBefore);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * body.size()));
+}
+BENCHMARK(BM_DecodeStationsResponse);
+
+// SAX z areną per odpowiedź (ResponseDecoder, ścieżka używana przez ApiClient)
+static void BM_DecodeStationsSax(benchmark::State& state) {
+    const std::string& body = stationsResponse();
+    const std::uint64_t allocationsBefore = heapAllocations.load();
+    for (auto _ : state) {
+        std::vector<Station> stations = ResponseDecoder::decodeStations(body.data(), body.size());
+        benchmark::DoNotOptimize(stations.data());
+    }
+    reportAllocations(state, allocationsBefore);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * body.size()));
+}
+BENCHMARK(BM_DecodeStationsSax);
+
+static void BM_DecodeSensorsResponse(benchmark::State& state) {
+    const std::string& body = sensorsResponse();
+    const std::uint64_t allocationsBefore = heapAllocations.load();
+    for (auto _ : state) {
+        std::vector<Sensor> sensors = ApiClient::parseSensors(json::parse(body));
+        benchmark::DoNotOptimize(sensors.data());
+    }
+    reportAllocations(state, allocationsBefore);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * body.size()));
+}
+BENCHMARK(BM_DecodeSensorsResponse);
+
+static void BM_DecodeSensorsSax(benchmark::State& state) {
+    const std::string& body = sensorsResponse();
+    const std::uint64_t allocationsBefore = heapAllocations.load();
+    for (auto _ : state) {
+        std::vector<Sensor> sensors = ResponseDecoder::decodeSensors(body.data(), body.size());
+        benchmark::DoNotOptimize(sensors.data());
+    }
+    reportAllocations(state, allocationsBefore);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * body.size()));
+}
+BENCHMARK(BM_DecodeSensorsSax);
+
+static void BM_DecodeMeasurementsResponse(benchmark::State& state) {
+    const std::string body = measurementsResponse(static_cast<std::size_t>(state.range(0)));
+    const std::uint64_t allocationsBefore = heapAllocations.load();
+    for (auto _ : state) {
+        std::vector<Measurement> measurements = ApiClient::parseMeasurements(json::parse(body));
+        benchmark::DoNotOptimize(measurements.data());
+    }
+    reportAllocations(state, allocationsBefore);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * body.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DecodeMeasurementsResponse)->Apply(seriesSizes);
+
+static void BM_DecodeMeasurementsSax(benchmark::State& state) {
+    const std::string body = measurementsResponse(static_cast<std::size_t>(state.range(0)));
+    const std::uint64_t allocationsBefore = heapAllocations.load();
+    for (auto _ : state) {
+        std::vector<Measurement> measurements = ResponseDecoder::decodeMeasurements(body.data(), body.size());
+        benchmark::DoNotOptimize(measurements.data());
+    }
+    reportAllocations(state, allocationsBefore);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * body.size()));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DecodeMeasurementsSax)->Apply(seriesSizes);
+
+static void BM_GroupStationsByProvince(benchmark::State& state) {
+    const std::vector<Station> stations = ApiClient::parseStations(json::parse(stationsResponse()));
+    for (auto _ : state) {
+        std::unordered_map<InternedString, int> perProvince;
+        for (const auto& station : stations) {
+            ++perProvince[station.province];
+        }
+        benchmark::DoNotOptimize(perProvince.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(stations.size()));
+}
+BENCHMARK(BM_GroupStationsByProvince);
+
+// ======== Daty ========
+
+static void BM_ParseMeasurementDate(benchmark::State& state) {
+    const std::vector<Measurement> measurements = measurementsFixture(1024);
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (const auto& measurement : measurements) {
+            std::int64_t timestamp;
+            parseMeasurementDate(measurement.date.data(), measurement.date.size(), timestamp);
+            sum += timestamp;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(measurements.size()));
+}
+BENCHMARK(BM_ParseMeasurementDate);
+
+static void BM_FormatMeasurementDate(benchmark::State& state) {
+    std::int64_t timestamp = parseMeasurementDate("2025-04-26 16:00:00");
+    for (auto _ : state) {
+        std::string date = formatMeasurementDate(timestamp);
+        benchmark::DoNotOptimize(date.data());
+        timestamp += 3600;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FormatMeasurementDate);
+
+// ======== Cache i pliki stacji ========
+
+static void BM_StationCacheLookup(benchmark::State& state) {
+    ApiClient client;
+    client.setVerbose(false);
+    client.loadStationsFromFile(stationsFilePath());
+    for (auto _ : state) {
+        std::vector<Station> stations = client.getAllStations();
+        benchmark::DoNotOptimize(stations.data());
+    }
+}
+BENCHMARK(BM_StationCacheLookup);
+
+static void BM_LoadStationsFile(benchmark::State& state) {
+    ApiClient client;
+    client.setVerbose(false);
+    const std::string path = stationsFilePath();
+    for (auto _ : state) {
+        std::vector<Station> stations = client.loadStationsFromFile(path);
+        benchmark::DoNotOptimize(stations.data());
+    }
+}
+BENCHMARK(BM_LoadStationsFile);
+
+static void BM_SaveStationsFile(benchmark::State& state) {
+    ApiClient client;
+    client.setVerbose(false);
+    client.loadStationsFromFile(stationsFilePath());
+    const std::string path = tempPath("airquality_bench_stations.json");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(client.saveStationsToFile(path));
+    }
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_SaveStationsFile);
+
+// ======== Pliki pomiarów ========
+
+static void BM_LoadMeasurementFile(benchmark::State& state) {
+    const std::string path = measurementFilePath();
+    for (auto _ : state) {
+        SavedMeasurementFile saved = MeasurementFileLoader::load(path);
+        benchmark::DoNotOptimize(saved.series.values.data());
+    }
+}
+BENCHMARK(BM_LoadMeasurementFile);
+
+// Budowa dokumentu jak w MainWindow::saveMeasurementsToJSON i zapis do pliku
+static void BM_ExportMeasurementsJson(benchmark::State& state) {
+    const std::vector<Measurement> measurements = measurementsFixture(static_cast<std::size_t>(state.range(0)));
+    const std::string path = tempPath("airquality_bench_export.json");
+    for (auto _ : state) {
+        json jsonData;
+        jsonData["metadata"]["station"]["id"] = 11;
+        jsonData["metadata"]["station"]["name"] = "Czerniawa";
+        jsonData["metadata"]["station"]["city"] = "Czerniawa";
+        jsonData["metadata"]["station"]["province"] = "DOLNOŚLĄSKIE";
+        jsonData["metadata"]["station"]["location"]["lat"] = 50.912475;
+        jsonData["metadata"]["station"]["location"]["lon"] = 15.31219;
+        jsonData["metadata"]["sensor"]["id"] = 50;
+        jsonData["metadata"]["sensor"]["paramName"] = "dwutlenek azotu";
+        jsonData["metadata"]["sensor"]["paramFormula"] = "NO2";
+        jsonData["metadata"]["sensor"]["paramCode"] = "NO2";
+        jsonData["metadata"]["sensor"]["color"] = "#0000ff";
+        jsonData["metadata"]["exportDate"] = "2025-04-26 16:46:20";
+
+        json measurementsArray = json::array();
+        for (const auto& measurement : measurements) {
+            json item;
+            item["date"] = measurement.date;
+            item["value"] = measurement.value;
+            measurementsArray.push_back(item);
+        }
+        jsonData["measurements"] = measurementsArray;
+
+        std::ofstream file(path);
+        file << jsonData.dump(4);
+    }
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ExportMeasurementsJson)->Apply(seriesSizes);
+
+// Eksport przyrostowy kolejnej odpowiedzi getData (3 dni, w tym jedna nowa godzina)
+// do pliku z historią state.range(0) pomiarów - koszt nie powinien zależeć od historii
+static void BM_ExportIncrementalHour(benchmark::State& state) {
+    const std::string path = tempPath("airquality_bench_export.jsonl");
+    fs::remove(path);
+    MeasurementSeries history = MeasurementSeries::fromMeasurements(
+        measurementsFixture(static_cast<std::size_t>(state.range(0))));
+    history.sortByTime();
+    const json metadata = {{"station", {{"id", 11}, {"name", "Czerniawa"}}}, {"sensor", {{"id", 50}}}};
+    MeasurementFileWriter::appendJsonLines(path, metadata, history);
+
+    MeasurementSeries response;
+    for (std::size_t i = history.size() - 72; i < history.size(); ++i) {
+        response.append(history.timestamps[i], history.values[i]);
+    }
+    for (auto _ : state) {
+        for (auto& timestamp : response.timestamps) {
+            timestamp += 3600;
+        }
+        benchmark::DoNotOptimize(MeasurementFileWriter::appendJsonLines(path, metadata, response).appended);
+    }
+    fs::remove(path);
+}
+BENCHMARK(BM_ExportIncrementalHour)->Apply(seriesSizes);
+
+// ======== Serie dla wykresu ========
+
+// Odpowiednik wypełniania serii w MainWindow::displayChart: daty na znaczniki czasu i zakresy osi
+static void BM_BuildChartSeries(benchmark::State& state) {
+    const std::vector<Measurement> measurements = measurementsFixture(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        MeasurementSeries series = MeasurementSeries::fromMeasurements(measurements);
+        series.sortByTime();
+        SeriesStatistics statistics = computeStatistics(series);
+        benchmark::DoNotOptimize(statistics);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BuildChartSeries)->Apply(seriesSizes);
+
+// Porównanie stacji: k serii miesięcznych przesuniętych w czasie, wspólna oś i przerzedzenie do 2000 punktów
+static void BM_AlignAndDecimateStations(benchmark::State& state) {
+    const std::size_t stationCount = static_cast<std::size_t>(state.range(0));
+    MeasurementSeries base = MeasurementSeries::fromMeasurements(measurementsFixture(720));
+    base.sortByTime();
+    std::vector<MeasurementSeries> series(stationCount, base);
+    for (std::size_t s = 0; s < stationCount; ++s) {
+        // Stacje różnią się zakresem dostępnych pomiarów
+        for (auto& timestamp : series[s].timestamps) {
+            timestamp += static_cast<std::int64_t>(s) * 3600;
+        }
+    }
+    for (auto _ : state) {
+        AlignedSeries aligned = alignSeries(series);
+        for (const auto& column : aligned.columns) {
+            MeasurementSeries points = decimateMinMax(aligned.timestamps.data(), column.data(),
+                                                      aligned.timestamps.size(), 2000);
+            benchmark::DoNotOptimize(points.values.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(stationCount * base.size()));
+}
+BENCHMARK(BM_AlignAndDecimateStations)->Arg(1)->Arg(5)->Arg(20);
+
+// Zawężenie roku pomiarów do tygodnia: wyszukiwanie binarne i statystyki tylko dla fragmentu
+static void BM_SeriesRangeWeek(benchmark::State& state) {
+    MeasurementSeries series = MeasurementSeries::fromMeasurements(measurementsFixture(8760));
+    series.sortByTime();
+    const std::int64_t from = series.timestamps[series.size() / 2];
+    for (auto _ : state) {
+        SeriesSlice week = series.range(from, from + 7 * 86400 - 1);
+        SeriesStatistics statistics = computeStatistics(week);
+        benchmark::DoNotOptimize(statistics);
+    }
+}
+BENCHMARK(BM_SeriesRangeWeek);
+
+// Tryb "Wszystkie": pięć parametrów stacji na siatce godzinowej z interpolacją luk
+static void BM_ResampleStationFrame(benchmark::State& state) {
+    std::vector<MeasurementSeries> series(5, MeasurementSeries::fromMeasurements(
+        measurementsFixture(static_cast<std::size_t>(state.range(0)))));
+    const std::vector<std::string> names{"PM10", "PM2.5", "NO2", "O3", "SO2"};
+    for (auto _ : state) {
+        ResampledFrame frame = Resampler::resample(series, names, ResampleStep::Hour, GapFill::Linear);
+        benchmark::DoNotOptimize(frame.columns.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(5 * series.front().size()));
+}
+BENCHMARK(BM_ResampleStationFrame)->Apply(seriesSizes);
+
+// Odświeżenie: odpowiedź z jedną nową godziną dopisana do istniejącej siatki
+static void BM_ResampleIncrementalHour(benchmark::State& state) {
+    MeasurementSeries history = MeasurementSeries::fromMeasurements(
+        measurementsFixture(static_cast<std::size_t>(state.range(0))));
+    history.sortByTime();
+    for (auto _ : state) {
+        state.PauseTiming();
+        Resampler resampler;
+        const std::size_t column = resampler.addColumn("PM10");
+        resampler.append(column, history);
+        MeasurementSeries refreshed = history;
+        refreshed.append(history.timestamps.back() + 3600, 1.0);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(resampler.append(column, refreshed));
+    }
+}
+BENCHMARK(BM_ResampleIncrementalHour)->Apply(seriesSizes);
+
+// ======== Archiwum pomiarów (SeriesStore) ========
+
+// Dziennik z pięcioma latami pomiarów godzinowych jednego czujnika
+const SeriesStore& fiveYearStore() {
+    static const SeriesStore store = []() {
+        const std::string directory = tempPath("airquality_bench_store");
+        fs::remove_all(directory);
+        SeriesStore created(directory);
+        MeasurementSeries base = MeasurementSeries::fromMeasurements(measurementsFixture(5 * 8760));
+        base.sortByTime();
+        created.merge(1, base);
+        return created;
+    }();
+    return store;
+}
+
+// Zakres miesiąca z połowy historii
+static void BM_StoreScanMonth(benchmark::State& state) {
+    const SeriesStore& store = fiveYearStore();
+    const std::vector<SegmentHeader> segments = store.segments(1);
+    const std::int64_t from = segments[segments.size() / 2].firstTime;
+    for (auto _ : state) {
+        MeasurementSeries month = store.scan(1, from, from + 30 * 86400);
+        benchmark::DoNotOptimize(month.values.data());
+    }
+}
+BENCHMARK(BM_StoreScanMonth);
+
+// Przekroczenia progu w całej historii (segmenty bez przekroczeń są pomijane)
+static void BM_StoreScanAboveThreshold(benchmark::State& state) {
+    const SeriesStore& store = fiveYearStore();
+    for (auto _ : state) {
+        MeasurementSeries above = store.scanAbove(1, 50.0);
+        benchmark::DoNotOptimize(above.values.data());
+    }
+}
+BENCHMARK(BM_StoreScanAboveThreshold);
+
+// Scalenie kolejnej odpowiedzi getData (3 dni, w tym jedna nowa godzina) z dziennikiem
+static void BM_StoreMergeResponse(benchmark::State& state) {
+    const std::string directory = tempPath("airquality_bench_store_merge");
+    fs::remove_all(directory);
+    SeriesStore store(directory);
+    MeasurementSeries response = MeasurementSeries::fromMeasurements(measurementsFixture(72));
+    response.sortByTime();
+    store.merge(1, response);
+    for (auto _ : state) {
+        for (auto& timestamp : response.timestamps) {
+            timestamp += 3600;
+        }
+        benchmark::DoNotOptimize(store.merge(1, response).appended);
+    }
+    fs::remove_all(directory);
+}
+BENCHMARK(BM_StoreMergeResponse);
+
+// Import 100 eksportów JSON (10 czujników, nakładające się okna 30 dni) do pustego archiwum
+static void BM_ImportExportDirectory(benchmark::State& state) {
+    const std::string root = tempPath("airquality_bench_import");
+    fs::remove_all(root);
+    fs::create_directories(root + "/export");
+    MeasurementSeries history = MeasurementSeries::fromMeasurements(measurementsFixture(720 + 99 * 240));
+    history.sortByTime();
+    std::size_t bytes = 0;
+    for (int f = 0; f < 100; ++f) {
+        json measurements = json::array();
+        for (std::size_t i = static_cast<std::size_t>(f) * 240; i < static_cast<std::size_t>(f) * 240 + 720; ++i) {
+            measurements.push_back({{"date", formatMeasurementDate(history.timestamps[i])}, {"value", history.values[i]}});
+        }
+        json file;
+        file["metadata"]["station"]["id"] = 11;
+        file["metadata"]["sensor"]["id"] = 50 + f % 10;
+        file["measurements"] = std::move(measurements);
+        const std::string content = file.dump(4);
+        bytes += content.size();
+        std::ofstream(root + "/export/pomiary_" + std::to_string(f) + ".json") << content;
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        fs::remove_all(root + "/archive");
+        fs::remove(root + "/import_index.json");
+        SeriesStore store(root + "/archive");
+        ArchiveImporter importer(store, root + "/import_index.json");
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(importer.importDirectory(root + "/export").appended);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes));
+    fs::remove_all(root);
+}
+BENCHMARK(BM_ImportExportDirectory)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// ======== Kompresja serii (SeriesCodec) ========
+
+static void BM_EncodeSeriesBlock(benchmark::State& state) {
+    MeasurementSeries series = MeasurementSeries::fromMeasurements(
+        measurementsFixture(static_cast<std::size_t>(state.range(0))));
+    series.sortByTime();
+    std::size_t blockSize = 0;
+    for (auto _ : state) {
+        std::string block = SeriesCodec::encode(series);
+        blockSize = block.size();
+        benchmark::DoNotOptimize(block.data());
+    }
+    state.counters["bytes_per_point"] = static_cast<double>(blockSize) / static_cast<double>(series.size());
+}
+BENCHMARK(BM_EncodeSeriesBlock)->Apply(seriesSizes);
+
+// Przepustowość liczona w bajtach zdekodowanych kolumn (16 B na pomiar)
+static void BM_DecodeSeriesBlock(benchmark::State& state) {
+    MeasurementSeries series = MeasurementSeries::fromMeasurements(
+        measurementsFixture(static_cast<std::size_t>(state.range(0))));
+    series.sortByTime();
+    const std::string block = SeriesCodec::encode(series);
+    for (auto _ : state) {
+        MeasurementSeries decoded = SeriesCodec::decode(block.data(), block.size());
+        benchmark::DoNotOptimize(decoded.values.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(series.size() * 16));
+    state.counters["bytes_per_point"] = static_cast<double>(block.size()) / static_cast<double>(series.size());
+}
+BENCHMARK(BM_DecodeSeriesBlock)->Apply(seriesSizes);
+
+// ======== Kolejka między etapami potoku (BoundedQueue) ========
+
+// Przekazanie elementów z wątku producenta do konsumenta przez kolejkę o pojemności range(0)
+static void BM_BoundedQueueTransfer(benchmark::State& state) {
+    const std::size_t items = 100000;
+    for (auto _ : state) {
+        BoundedQueue<std::size_t> queue(static_cast<std::size_t>(state.range(0)));
+        std::thread producer([&] {
+            for (std::size_t i = 0; i < items; ++i) {
+                queue.push(i);
+            }
+            queue.close();
+        });
+        std::size_t value = 0;
+        std::size_t sum = 0;
+        while (queue.pop(value)) {
+            sum += value;
+        }
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * items);
+}
+BENCHMARK(BM_BoundedQueueTransfer)->Arg(4)->Arg(64)->Arg(1024)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// ======== Pełna ścieżka pobierania (serwer zastępczy GIOŚ na localhost) ========
+
+#ifdef AIRQUALITY_MOCK_FIXTURES
+// Zapytanie HTTP, dekodowanie i zapis do cache dla jednego czujnika
+static void BM_FetchMeasurementsMock(benchmark::State& state) {
+    MockGiosOptions options;
+    options.fixtureDir = AIRQUALITY_MOCK_FIXTURES;
+    MockGiosServer server(options);
+    server.start();
+
+    ApiClient client(server.baseUrl());
+    client.setVerbose(false);
+    for (auto _ : state) {
+        client.clearMeasurementCache(1100);
+        std::vector<Measurement> measurements = client.getMeasurements(1100);
+        benchmark::DoNotOptimize(measurements.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FetchMeasurementsMock)->UseRealTime();
+
+// Równoczesne pobranie pomiarów wielu czujników przez klienta asynchronicznego (jeden wątek I/O)
+static void BM_FetchMeasurementsAsyncMock(benchmark::State& state) {
+    MockGiosOptions options;
+    options.fixtureDir = AIRQUALITY_MOCK_FIXTURES;
+    options.latencyMs = 20;
+    MockGiosServer server(options);
+    server.start();
+
+    ApiClient client(server.baseUrl());
+    client.setVerbose(false);
+    WorkerExecutor executor;
+    AsyncApiClient async(client, executor, 256);
+    std::vector<int> sensorIds;
+    for (int i = 0; i < state.range(0); ++i) {
+        sensorIds.push_back(1100 + i);
+    }
+    for (auto _ : state) {
+        client.clearCache();
+        std::vector<std::vector<Measurement>> results = syncWait(async.measurements(sensorIds));
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FetchMeasurementsAsyncMock)->Arg(1)->Arg(32)->Arg(256)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Potok pobieranie -> dekodowanie -> zapis (statystyki serii) dla range(0) czujników; liczniki
+// podają zajętość etapów z ostatniej iteracji
+static void BM_PipelineFetchMock(benchmark::State& state) {
+    MockGiosOptions options;
+    options.fixtureDir = AIRQUALITY_MOCK_FIXTURES;
+    options.latencyMs = 20;
+    MockGiosServer server(options);
+    server.start();
+
+    ApiClient client(server.baseUrl());
+    client.setVerbose(false);
+    PipelineOptions pipelineOptions;
+    pipelineOptions.maxInFlight = 64;
+    pipelineOptions.useCache = false;
+    FetchPipeline pipeline(client, pipelineOptions);
+    double sum = 0.0;
+    pipeline.setStoreStage([&sum](PipelineItem& item) {
+        sum += computeStatistics(item.series).mean;
+    });
+    std::vector<int> sensorIds;
+    for (int i = 0; i < state.range(0); ++i) {
+        sensorIds.push_back(1100 + i);
+    }
+    PipelineReport report;
+    for (auto _ : state) {
+        report = pipeline.run(sensorIds);
+        benchmark::DoNotOptimize(sum);
+    }
+    for (const auto& stage : report.stages) {
+        state.counters[stage.name] = stage.utilization(report.seconds);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PipelineFetchMock)->Arg(32)->Arg(256)->Unit(benchmark::kMillisecond)->UseRealTime();
+#endif
+
+BENCHMARK_MAIN();
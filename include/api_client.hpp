@@ -5,38 +5,49 @@
 #ifndef API_CLIENT_HPP
 #define API_CLIENT_HPP
 
+#include <chrono>
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <functional>
 #include <unordered_map>
 #include <nlohmann/json.hpp>
+#include "circuit_breaker.hpp"
+#include "metrics.hpp"
+#include "pollutant.hpp"
+#include "single_flight.hpp"
+#include "string_pool.hpp"
 
 using json = nlohmann::json;
 
 /**
  * @brief Struktura reprezentująca stację pomiarową
+ * Miasto i województwo powtarzają się między stacjami, więc są internowane.
  */
 struct Station {
     int id;
     std::string name;
     double lat;
     double lon;
-    std::string city;
+    InternedString city;
     std::string address;
-    std::string province;
+    InternedString province;
 };
 
 /**
  * @brief Struktura reprezentująca czujnik pomiarowy
+ * Opis parametru jest wspólny dla wszystkich czujników danej substancji, więc jest internowany.
+ * Porównania i wyszukiwanie parametru używają pola pollutant, a nie napisów.
  */
 struct Sensor {
     int id;
     int stationId;
-    std::string paramName;
-    std::string paramFormula;
-    std::string paramCode;
+    InternedString paramName;
+    InternedString paramFormula;
+    InternedString paramCode;
     int paramId;
+    Pollutant pollutant = Pollutant::Unknown; ///< Parametr ustalony z paramId/paramCode
 };
 
 /**
@@ -47,15 +58,39 @@ struct Measurement {
     double value;
 };
 
+/**
+ * @brief Zasady wykonywania zapytań HTTP: termin, ponowienia, zapytania zapasowe i wyłącznik obwodu
+ */
+struct RequestPolicy {
+    std::chrono::milliseconds deadline{10000};          ///< Domyślny termin całej operacji (z ponowieniami)
+    int maxRetries = 2;                                 ///< Maksymalna liczba ponowień po błędzie przejściowym
+    std::chrono::milliseconds retryBaseDelay{100};      ///< Bazowe opóźnienie ponowienia (rośnie wykładniczo)
+    std::chrono::milliseconds retryMaxDelay{2000};      ///< Górny limit opóźnienia ponowienia
+    bool hedging = true;                                ///< Czy wysyłać zapasowe zapytanie przy powolnej odpowiedzi
+    double hedgePercentile = 95.0;                      ///< Percentyl czasu odpowiedzi wyznaczający moment wysłania zapasowego zapytania
+    std::size_t hedgeMinSamples = 20;                   ///< Minimalna liczba pomiarów czasu, zanim percentyl zostanie użyty
+    std::chrono::milliseconds initialHedgeDelay{1000};  ///< Opóźnienie zapasowego zapytania, gdy pomiarów jest za mało
+    std::chrono::milliseconds minHedgeDelay{50};        ///< Dolny limit opóźnienia zapasowego zapytania
+    int breakerFailureThreshold = 5;                    ///< Kolejne błędy otwierające obwód (0 - bez wyłącznika)
+    std::chrono::milliseconds breakerOpenDuration{30000}; ///< Czas otwarcia obwodu przed zapytaniem próbnym
+    bool compression = true;                            ///< Czy akceptować skompresowane odpowiedzi (gzip, deflate, brotli)
+    bool http2 = true;                                  ///< Czy negocjować HTTP/2 (przy połączeniach TLS)
+};
+
 /**
  * @brief Klasa klienta API GIOŚ
+ *
+ * Dostęp do wewnętrznych cache jest synchronizowany, dzięki czemu jeden obiekt
+ * może być używany jednocześnie z wielu wątków.
  */
 class ApiClient {
 public:
     /**
      * @brief Konstruktor
+     * @param baseUrl Adres bazowy API; pusty - wartość zmiennej środowiskowej
+     *        AIRQUALITY_API_URL, a jeśli nie jest ustawiona - adres API GIOŚ
      */
-    ApiClient();
+    explicit ApiClient(const std::string& baseUrl = std::string());
     
     /**
      * @brief Destruktor
@@ -68,6 +103,13 @@ public:
      */
     std::vector<Station> getAllStations();
     
+    /**
+     * @brief Pobiera listę wszystkich stacji pomiarowych w podanym czasie
+     * @param timeout Termin całej operacji (z ponowieniami)
+     * @return Wektor struktur Station (pusty w przypadku błędu lub przekroczenia terminu)
+     */
+    std::vector<Station> getAllStations(std::chrono::milliseconds timeout);
+    
     /**
      * @brief Zapisuje stacje do pliku JSON
      * @param filename Nazwa pliku
@@ -89,6 +131,14 @@ public:
      */
     std::vector<Sensor> getSensors(int stationId);
     
+    /**
+     * @brief Pobiera listę czujników dla danej stacji w podanym czasie
+     * @param stationId ID stacji
+     * @param timeout Termin całej operacji (z ponowieniami)
+     * @return Wektor struktur Sensor
+     */
+    std::vector<Sensor> getSensors(int stationId, std::chrono::milliseconds timeout);
+    
     /**
      * @brief Pobiera dane pomiarowe dla danego czujnika
      * @param sensorId ID czujnika
@@ -96,12 +146,33 @@ public:
      */
     std::vector<Measurement> getMeasurements(int sensorId);
     
+    /**
+     * @brief Pobiera dane pomiarowe dla danego czujnika w podanym czasie
+     * @param sensorId ID czujnika
+     * @param timeout Termin całej operacji (z ponowieniami)
+     * @return Wektor struktur Measurement
+     */
+    std::vector<Measurement> getMeasurements(int sensorId, std::chrono::milliseconds timeout);
+    
     /**
      * @brief Sprawdza czy połączenie z API jest dostępne
      * @return true jeśli API jest dostępne, false w przeciwnym wypadku
      */
     bool isApiAvailable();
     
+    /**
+     * @brief Zmienia adres bazowy API (np. na lokalny serwer zastępczy)
+     * @param url Adres bazowy bez końcowego ukośnika
+     * Należy wywołać przed pierwszym zapytaniem; nie czyści cache.
+     */
+    void setBaseUrl(const std::string& url);
+    
+    /**
+     * @brief Zwraca adres bazowy API
+     * @return Adres bazowy
+     */
+    const std::string& getBaseUrl() const;
+    
     /**
      * @brief Włącza lub wyłącza tryb gadatliwy (wyświetlanie komunikatów)
      * @param enabled Wartość true włącza komunikaty, false wyłącza
@@ -114,27 +185,161 @@ public:
      */
     bool isVerbose() const;
     
+    /**
+     * @brief Ustawia zasady wykonywania zapytań (termin, ponowienia, zapytania zapasowe, wyłącznik)
+     * @param policy Nowe zasady
+     */
+    void setRequestPolicy(const RequestPolicy& policy);
+    
+    /**
+     * @brief Zwraca zasady wykonywania zapytań
+     * @return Kopia bieżących zasad
+     */
+    RequestPolicy getRequestPolicy() const;
+    
+    /**
+     * @brief Zwraca stan wyłącznika obwodu
+     * @return Stan wyłącznika
+     */
+    CircuitBreaker::State getCircuitState() const;
+    
     /**
      * @brief Czyści wszystkie cache
      */
     void clearCache();
+    
+    /**
+     * @brief Usuwa z cache pomiary jednego czujnika
+     * @param sensorId ID czujnika
+     * Kolejne wywołanie getMeasurements pobierze świeże dane z API. Usunięte dane są
+     * zachowywane jako nieaktualne i zwracane, jeśli API będzie niedostępne.
+     */
+    void clearMeasurementCache(int sensorId);
+    
+    /**
+     * @brief Odczytuje pomiary czujnika z cache bez zapytania do API
+     * @param sensorId ID czujnika
+     * @param measurements Pomiary z cache (wyjście)
+     * @return true jeśli pomiary były w cache (trafienie jest liczone w metrykach)
+     */
+    bool lookupMeasurementCache(int sensorId, std::vector<Measurement>& measurements);
+    
+    /**
+     * @brief Zapisuje w cache pomiary pobrane poza klientem (np. przez potok pobierania)
+     * @param sensorId ID czujnika
+     * @param measurements Pomiary czujnika
+     */
+    void updateMeasurementCache(int sensorId, std::vector<Measurement> measurements);
+
+    /**
+     * @brief Zwraca metryki zapytań (liczniki, cache, histogramy opóźnień)
+     * @return Referencja do metryk klienta
+     */
+    ApiMetrics& getMetrics() { return metrics; }
+    const ApiMetrics& getMetrics() const { return metrics; }
+    
+    /**
+     * @brief Zwraca liczbę wywołań, które dołączyły do trwającego pobierania tych samych danych
+     * @return Liczba zaoszczędzonych zapytań do API
+     */
+    std::uint64_t getCoalescedRequestCount() const;
+    
+    // Dekodowanie z gotowego drzewa JSON; odpowiedzi pobierane z API dekoduje ResponseDecoder
+    /**
+     * @brief Dekoduje odpowiedź endpointu /station/findAll
+     * @param response Odpowiedź API w formacie JSON
+     * @return Wektor struktur Station
+     */
+    static std::vector<Station> parseStations(const json& response);
+    
+    /**
+     * @brief Dekoduje odpowiedź endpointu /station/sensors/{id}
+     * @param response Odpowiedź API w formacie JSON
+     * @return Wektor struktur Sensor
+     */
+    static std::vector<Sensor> parseSensors(const json& response);
+    
+    /**
+     * @brief Dekoduje odpowiedź endpointu /data/getData/{id}
+     * @param response Odpowiedź API w formacie JSON
+     * @return Wektor struktur Measurement (bez pomiarów o wartości null)
+     */
+    static std::vector<Measurement> parseMeasurements(const json& response);
 
 private:
     std::string baseUrl;
     bool verbose; // Flaga określająca tryb wyświetlania komunikatów
     
     // Mechanizmy cachowania
-    std::unordered_map<std::string, json> responseCache; // Cache dla odpowiedzi z API
+    mutable std::mutex cacheMutex; // Blokada chroniąca wszystkie cache
     std::vector<Station> cachedStations; // Cache dla stacji
     std::unordered_map<int, std::vector<Sensor>> sensorCache; // Cache dla czujników (klucz: ID stacji)
     std::unordered_map<int, std::vector<Measurement>> measurementCache; // Cache dla pomiarów (klucz: ID czujnika)
     
+    // Nieaktualne dane usunięte z cache, zwracane gdy API jest niedostępne
+    std::vector<Station> staleStations;
+    std::unordered_map<int, std::vector<Sensor>> staleSensors;
+    std::unordered_map<int, std::vector<Measurement>> staleMeasurements;
+    
+    // Zasady zapytań i wyłącznik obwodu
+    mutable std::mutex policyMutex; // Blokada chroniąca requestPolicy
+    RequestPolicy requestPolicy;
+    CircuitBreaker breaker;
+    
+    // Połączenia, cache DNS i sesje TLS współdzielone przez wszystkie zapytania
+    struct ConnectionPool;
+    std::unique_ptr<ConnectionPool> connectionPool;
+    
+    ApiMetrics metrics; // Metryki zapytań i cache
+    
+    // Scalanie równoczesnych pobrań tych samych danych
+    SingleFlight<int, std::vector<Station>> stationFlight; // Pobieranie listy stacji (klucz: 0)
+    SingleFlight<int, std::vector<Sensor>> sensorFlights; // Pobieranie czujników (klucz: ID stacji)
+    SingleFlight<int, std::vector<Measurement>> measurementFlights; // Pobieranie pomiarów (klucz: ID czujnika)
+    
     /**
      * @brief Funkcja pomocnicza do wykonywania zapytań HTTP
      * @param endpoint Endpoint API
-     * @return Odpowiedź w formacie JSON
+     * @param deadline Termin, po którym zapytanie (z ponowieniami) jest przerywane
+     * @return Treść odpowiedzi (niepusta)
+     * @throws std::runtime_error gdy zapytanie się nie powiodło, minął termin lub obwód jest otwarty
+     */
+    std::string makeRequest(const std::string& endpoint, std::chrono::steady_clock::time_point deadline);
+    
+    /**
+     * @brief Wykonuje jedną próbę zapytania, z ewentualnym zapytaniem zapasowym
+     * @param endpoint Endpoint API
+     * @param deadline Termin próby
+     * @param policy Zasady zapytań
+     * @param body Treść odpowiedzi (wyjście)
+     * @param retryable Czy błąd jest przejściowy i można ponowić (wyjście)
+     * @param upstreamFailure Czy błąd świadczy o niedostępności API (wyjście)
+     * @return Pusty tekst w przypadku sukcesu, w przeciwnym razie opis błędu
      */
-    json makeRequest(const std::string& endpoint);
+    std::string performAttempt(const std::string& endpoint, std::chrono::steady_clock::time_point deadline,
+                               const RequestPolicy& policy, std::string& body,
+                               bool& retryable, bool& upstreamFailure);
+    
+    /**
+     * @brief Pobiera i dekoduje listę stacji, zapisując ją w cache
+     * @throws std::runtime_error w przypadku błędu zapytania lub parsowania
+     */
+    std::vector<Station> fetchStations(std::chrono::steady_clock::time_point deadline);
+    
+    /**
+     * @brief Pobiera i dekoduje czujniki stacji, zapisując je w cache
+     * @throws std::runtime_error w przypadku błędu zapytania lub parsowania
+     */
+    std::vector<Sensor> fetchSensors(int stationId, std::chrono::steady_clock::time_point deadline);
+    
+    /**
+     * @brief Pobiera i dekoduje pomiary czujnika, zapisując je w cache
+     * @throws std::runtime_error w przypadku błędu zapytania lub parsowania
+     */
+    std::vector<Measurement> fetchMeasurements(int sensorId, std::chrono::steady_clock::time_point deadline);
+    
+    // Klient asynchroniczny korzysta z tych samych cache, metryk i wyłącznika obwodu
+    friend class AsyncApiClient;
 };
 
 #endif // API_CLIENT_HPP
\ No newline at end of file
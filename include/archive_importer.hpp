@@ -0,0 +1,73 @@
+/**
+ * @file archive_importer.hpp
+ * @brief Równoległy import zapisanych plików z pomiarami do lokalnego archiwum
+ */
+#ifndef ARCHIVE_IMPORTER_HPP
+#define ARCHIVE_IMPORTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "series_store.hpp"
+
+/**
+ * @brief Podsumowanie importu
+ */
+struct ImportReport {
+    std::size_t files = 0;        ///< Znalezione pliki z pomiarami
+    std::size_t imported = 0;     ///< Pliki wczytane i scalone z archiwum
+    std::size_t unchanged = 0;    ///< Pliki pominięte - ta sama zawartość była już importowana
+    std::size_t skipped = 0;      ///< Pliki bez przypisania pomiarów do czujnika (tryb "Wszystkie")
+    std::size_t failed = 0;       ///< Pliki, których nie udało się wczytać lub scalić
+    std::size_t bytes = 0;        ///< Rozmiar wczytanych plików
+    std::size_t measurements = 0; ///< Pomiary w wczytanych plikach
+    std::size_t appended = 0;     ///< Nowe pomiary w archiwum
+    std::size_t duplicates = 0;   ///< Pomiary już zapisane lub powtórzone w wielu plikach
+    std::size_t sensors = 0;      ///< Czujniki, których dzienniki zostały scalone
+    double seconds = 0.0;         ///< Czas importu
+    std::vector<std::string> errors; ///< Komunikaty błędów (plik lub czujnik i przyczyna)
+};
+
+/**
+ * @brief Import katalogu plików eksportu (.json, .aqz, .jsonl) do SeriesStore
+ *
+ * Pliki są wyszukiwane rekurencyjnie i wczytywane równolegle. Pomiary są grupowane po czujniku
+ * (identyfikator czujnika GIOŚ wyznacza też stację), a każdy dziennik jest scalany raz
+ * z deduplikacją po znaczniku czasu - także pomiary starsze niż koniec dziennika.
+ * Skróty zawartości zaimportowanych plików są zapisywane w indeksie, więc ponowny import
+ * pomija niezmienione pliki (i kopie tego samego pliku) bez ich parsowania.
+ */
+class ArchiveImporter {
+public:
+    /**
+     * @brief Tworzy importer
+     * @param store Archiwum docelowe
+     * @param indexPath Plik indeksu zaimportowanych plików (JSON)
+     */
+    ArchiveImporter(const SeriesStore& store, std::string indexPath);
+
+    /**
+     * @brief Importuje wszystkie pliki z pomiarami z drzewa katalogów
+     * @param directory Katalog główny
+     * @param jobs Liczba wątków (0 - liczba rdzeni)
+     * @return Podsumowanie importu
+     * @throws std::runtime_error jeśli katalog nie istnieje lub indeksu nie można zapisać
+     */
+    ImportReport importDirectory(const std::string& directory, int jobs = 0);
+
+    /**
+     * @brief Oblicza skrót zawartości pliku (FNV-1a, 64 bity)
+     * @param data Wskaźnik na dane
+     * @param size Rozmiar danych
+     * @return Skrót
+     */
+    static std::uint64_t contentHash(const char* data, std::size_t size);
+
+private:
+    const SeriesStore& store;
+    std::string indexPath;
+};
+
+#endif // ARCHIVE_IMPORTER_HPP
@@ -0,0 +1,132 @@
+/**
+ * @file async_client.hpp
+ * @brief Asynchroniczny klient API GIOŚ oparty na korutynach i pętli zdarzeń libcurl (multi)
+ */
+#ifndef ASYNC_CLIENT_HPP
+#define ASYNC_CLIENT_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "api_client.hpp"
+#include "executor.hpp"
+#include "response_decoder.hpp"
+#include "task.hpp"
+
+/**
+ * @brief Nieblokujące API klienta GIOŚ: co_await client.sensors(id), co_await client.measurements(ids)
+ *
+ * Wszystkie transfery HTTP obsługuje jeden wątek I/O z pętlą curl_multi, więc setki
+ * równoczesnych zapytań nie wymagają wątku na zapytanie. Po zakończeniu transferu
+ * korutyna jest wznawiana przez wykonawcę (pętla zdarzeń Qt albo wątki robocze),
+ * a nie w wątku I/O; tam odbywa się też dekodowanie odpowiedzi.
+ *
+ * Klient korzysta z cache, metryk, zasad zapytań i wyłącznika obwodu podanego ApiClient,
+ * więc wyniki pobrane asynchronicznie są widoczne dla wywołań synchronicznych i odwrotnie.
+ * Ponowienia czekają na zegarze pętli I/O, a nie przez uśpienie wątku. Zapytania zapasowe
+ * (hedging) i scalanie równoczesnych pobrań są dostępne tylko w ścieżce synchronicznej.
+ *
+ * Klienta należy zniszczyć po zakończeniu zadań; zapytania trwające w chwili zniszczenia
+ * kończą się błędem.
+ */
+class AsyncApiClient {
+public:
+    /// Domyślny limit jednocześnie otwartych połączeń (kolejne zapytania czekają w pętli I/O)
+    static constexpr int DEFAULT_MAX_CONNECTIONS = 64;
+
+    /**
+     * @brief Uruchamia wątek I/O
+     * @param client Klient synchroniczny (adres API, zasady zapytań, cache i metryki)
+     * @param executor Wykonawca wznawiający korutyny
+     * @param maxConnections Maksymalna liczba jednocześnie otwartych połączeń
+     * @throws std::runtime_error jeśli nie można zainicjalizować libcurl
+     */
+    AsyncApiClient(ApiClient& client, Executor& executor, int maxConnections = DEFAULT_MAX_CONNECTIONS);
+
+    /**
+     * @brief Zatrzymuje wątek I/O; trwające zapytania kończą się błędem
+     */
+    ~AsyncApiClient();
+
+    AsyncApiClient(const AsyncApiClient&) = delete;
+    AsyncApiClient& operator=(const AsyncApiClient&) = delete;
+
+    /**
+     * @brief Pobiera czujniki stacji
+     * @param stationId ID stacji
+     * @return Zadanie zwracające czujniki (pusty wektor w przypadku błędu, jak getSensors)
+     */
+    Task<std::vector<Sensor>> sensors(int stationId);
+
+    /**
+     * @brief Pobiera pomiary czujnika
+     * @param sensorId ID czujnika
+     * @return Zadanie zwracające pomiary (pusty wektor w przypadku błędu, jak getMeasurements)
+     */
+    Task<std::vector<Measurement>> measurements(int sensorId);
+
+    /**
+     * @brief Pobiera jednocześnie pomiary wielu czujników
+     * @param sensorIds ID czujników
+     * @return Zadanie zwracające pomiary w kolejności sensorIds (pusty wektor dla czujnika,
+     *         którego nie udało się pobrać)
+     */
+    Task<std::vector<std::vector<Measurement>>> measurements(std::vector<int> sensorIds);
+
+    /**
+     * @brief Wykonuje zapytanie GET z ponowieniami według zasad klienta
+     * @param endpoint Endpoint API (np. "/data/getData/92")
+     * @param deadline Termin całej operacji (z ponowieniami)
+     * @return Zadanie zwracające treść odpowiedzi (niepustą)
+     * @throws std::runtime_error gdy zapytanie się nie powiodło, minął termin lub obwód jest otwarty
+     */
+    Task<std::string> request(std::string endpoint, std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Zawiesza korutynę na podany czas bez blokowania wątku
+     * @param delay Czas oczekiwania
+     * @return Zadanie kończące się po czasie delay (wznawiane przez wykonawcę)
+     */
+    Task<void> sleepFor(std::chrono::milliseconds delay);
+
+    /**
+     * @brief Przerywa trwające zapytania (kończą się błędem) i odrzuca kolejne; bezpieczna wątkowo
+     *
+     * Korutyny oczekujące na zapytania i zegary są wznawiane przez wykonawcę bez czekania
+     * na termin zapytania. Wątek I/O kończy się w destruktorze.
+     */
+    void stop();
+
+    /**
+     * @brief Zwraca liczbę transferów obsługiwanych w tej chwili przez pętlę I/O
+     */
+    std::size_t activeTransfers() const;
+
+private:
+    ApiClient& client;
+
+    // Pętla zdarzeń libcurl w osobnym wątku
+    struct Loop;
+    std::unique_ptr<Loop> loop;
+
+    /**
+     * @brief Zwraca dane z cache klienta albo pobiera je i zapisuje w cache
+     * @param endpointClass Klasa endpointu (metryki)
+     * @param endpoint Endpoint API
+     * @param key Klucz cache (ID stacji lub czujnika)
+     * @param cache Cache w ApiClient
+     * @param stale Nieaktualne dane zwracane, gdy API jest niedostępne
+     * @param decoder Funkcja dekodująca ResponseDecoder
+     */
+    template <typename Item>
+    Task<std::vector<Item>> fetchCached(EndpointClass endpointClass, std::string endpoint, int key,
+                                        std::unordered_map<int, std::vector<Item>> ApiClient::* cache,
+                                        std::unordered_map<int, std::vector<Item>> ApiClient::* stale,
+                                        std::vector<Item> (*decoder)(const char*, std::size_t, DecodeStats*));
+};
+
+#endif // ASYNC_CLIENT_HPP
@@ -0,0 +1,248 @@
+/**
+ * @file bounded_queue.hpp
+ * @brief Ograniczona kolejka bez blokad (wielu producentów i konsumentów) z przeciwciśnieniem
+ */
+#ifndef BOUNDED_QUEUE_HPP
+#define BOUNDED_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Statystyki zajętości kolejki
+ */
+struct QueueStats {
+    std::size_t capacity = 0;     ///< Pojemność kolejki
+    std::size_t maxDepth = 0;     ///< Największa zaobserwowana liczba elementów
+    double averageDepth = 0.0;    ///< Średnia liczba elementów (próbkowana przy każdym wstawieniu)
+    std::uint64_t pushed = 0;     ///< Wstawione elementy
+    std::uint64_t fullWaits = 0;  ///< Wstawienia, które czekały na wolne miejsce (przeciwciśnienie)
+    std::uint64_t emptyWaits = 0; ///< Pobrania, które czekały na element
+};
+
+/**
+ * @brief Ograniczona kolejka FIFO dla wielu producentów i konsumentów
+ *
+ * Bufor cykliczny z numerem sekwencji w każdej komórce (algorytm D. Vyukova): wstawienie
+ * i pobranie to jedna operacja compare-and-swap na pozycji, bez muteksów. Gdy kolejka
+ * jest pełna, push czeka (std::atomic::wait) na zwolnienie miejsca, więc szybszy etap
+ * zwalnia do tempa wolniejszego zamiast gromadzić dane w pamięci. Po close() push
+ * odrzuca nowe elementy, a pop zwraca pozostałe, po czym kończy się wynikiem false.
+ *
+ * @tparam T Typ elementu (domyślnie konstruowalny i przenoszalny)
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    /**
+     * @brief Tworzy kolejkę
+     * @param capacity Pojemność (zaokrąglana w górę do potęgi dwójki, co najmniej 2)
+     */
+    explicit BoundedQueue(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask = size - 1;
+        cells = std::make_unique<Cell[]>(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Wstawia element, jeśli jest miejsce
+     * @param value Element (przenoszony tylko w przypadku sukcesu)
+     * @return false, jeśli kolejka jest pełna
+     */
+    bool tryPush(T& value) {
+        std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[position & mask];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    recordDepth(position + 1);
+                    pushedSignal.fetch_add(1, std::memory_order_release);
+                    pushedSignal.notify_all();
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Pobiera element, jeśli kolejka nie jest pusta
+     * @param value Pobrany element (wyjście)
+     * @return false, jeśli kolejka jest pusta
+     */
+    bool tryPop(T& value) {
+        std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[position & mask];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+            if (difference == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.sequence.store(position + mask + 1, std::memory_order_release);
+                    poppedSignal.fetch_add(1, std::memory_order_release);
+                    poppedSignal.notify_all();
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Wstawia element, czekając na wolne miejsce
+     * @param value Element
+     * @return false, jeśli kolejka została zamknięta (element nie jest wstawiany)
+     */
+    bool push(T value) {
+        if (closed.load(std::memory_order_acquire)) {
+            return false;
+        }
+        if (tryPush(value)) {
+            return true;
+        }
+        fullWaits.fetch_add(1, std::memory_order_relaxed);
+        for (;;) {
+            // Odczyt licznika przed ponowną próbą: pobranie po nieudanej próbie zmieni go i obudzi wait
+            const std::uint32_t seen = poppedSignal.load(std::memory_order_acquire);
+            if (closed.load(std::memory_order_acquire)) {
+                return false;
+            }
+            if (tryPush(value)) {
+                return true;
+            }
+            poppedSignal.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * @brief Pobiera element, czekając na jego pojawienie się
+     * @param value Pobrany element (wyjście)
+     * @return false, jeśli kolejka jest zamknięta i pusta
+     */
+    bool pop(T& value) {
+        if (tryPop(value)) {
+            return true;
+        }
+        emptyWaits.fetch_add(1, std::memory_order_relaxed);
+        for (;;) {
+            const std::uint32_t seen = pushedSignal.load(std::memory_order_acquire);
+            if (tryPop(value)) {
+                return true;
+            }
+            if (closed.load(std::memory_order_acquire)) {
+                // Element wstawiony tuż przed zamknięciem
+                return tryPop(value);
+            }
+            pushedSignal.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * @brief Zamyka kolejkę: budzi oczekujących, nowe elementy są odrzucane
+     */
+    void close() {
+        closed.store(true, std::memory_order_release);
+        pushedSignal.fetch_add(1, std::memory_order_release);
+        pushedSignal.notify_all();
+        poppedSignal.fetch_add(1, std::memory_order_release);
+        poppedSignal.notify_all();
+    }
+
+    /**
+     * @brief Sprawdza, czy kolejka została zamknięta
+     */
+    bool isClosed() const {
+        return closed.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Zwraca przybliżoną liczbę elementów (dokładną, gdy nikt nie modyfikuje kolejki)
+     */
+    std::size_t size() const {
+        const std::size_t head = dequeuePosition.load(std::memory_order_relaxed);
+        const std::size_t tail = enqueuePosition.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    /**
+     * @brief Zwraca pojemność kolejki
+     */
+    std::size_t capacity() const {
+        return mask + 1;
+    }
+
+    /**
+     * @brief Zwraca statystyki zajętości
+     */
+    QueueStats stats() const {
+        QueueStats stats;
+        stats.capacity = capacity();
+        stats.maxDepth = maxDepth.load(std::memory_order_relaxed);
+        stats.pushed = depthSamples.load(std::memory_order_relaxed);
+        stats.averageDepth = stats.pushed > 0
+            ? static_cast<double>(depthSum.load(std::memory_order_relaxed)) / static_cast<double>(stats.pushed)
+            : 0.0;
+        stats.fullWaits = fullWaits.load(std::memory_order_relaxed);
+        stats.emptyWaits = emptyWaits.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask = 0;
+
+    // Pozycje producentów i konsumentów w osobnych liniach pamięci podręcznej
+    alignas(64) std::atomic<std::size_t> enqueuePosition{0};
+    alignas(64) std::atomic<std::size_t> dequeuePosition{0};
+
+    // Liczniki zdarzeń dla oczekujących (wait/notify), zamknięcie i statystyki
+    alignas(64) std::atomic<std::uint32_t> pushedSignal{0};
+    std::atomic<std::uint32_t> poppedSignal{0};
+    std::atomic<bool> closed{false};
+    std::atomic<std::uint64_t> depthSum{0};
+    std::atomic<std::uint64_t> depthSamples{0};
+    std::atomic<std::size_t> maxDepth{0};
+    std::atomic<std::uint64_t> fullWaits{0};
+    std::atomic<std::uint64_t> emptyWaits{0};
+
+    // Głębokość kolejki tuż po wstawieniu elementu na pozycji tail - 1
+    void recordDepth(std::size_t tail) {
+        const std::size_t head = dequeuePosition.load(std::memory_order_relaxed);
+        const std::size_t depth = tail > head ? tail - head : 0;
+        depthSum.fetch_add(depth, std::memory_order_relaxed);
+        depthSamples.fetch_add(1, std::memory_order_relaxed);
+        std::size_t observed = maxDepth.load(std::memory_order_relaxed);
+        while (depth > observed && !maxDepth.compare_exchange_weak(observed, depth, std::memory_order_relaxed)) {
+        }
+    }
+};
+
+#endif // BOUNDED_QUEUE_HPP
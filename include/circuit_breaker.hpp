@@ -0,0 +1,76 @@
+/**
+ * @file circuit_breaker.hpp
+ * @brief Wyłącznik obwodu chroniący przed wysyłaniem zapytań do niedostępnego API
+ */
+#ifndef CIRCUIT_BREAKER_HPP
+#define CIRCUIT_BREAKER_HPP
+
+#include <chrono>
+#include <mutex>
+
+/**
+ * @brief Wyłącznik obwodu (circuit breaker)
+ *
+ * Po określonej liczbie kolejnych błędów obwód się otwiera i zapytania są odrzucane
+ * bez kontaktu z serwerem. Po upływie czasu otwarcia przepuszczane jest jedno
+ * zapytanie próbne: sukces zamyka obwód, błąd otwiera go ponownie.
+ */
+class CircuitBreaker {
+public:
+    /**
+     * @brief Stan obwodu
+     */
+    enum class State {
+        Closed,     ///< Zapytania przepuszczane
+        Open,       ///< Zapytania odrzucane
+        HalfOpen    ///< Trwa zapytanie próbne
+    };
+
+    /**
+     * @brief Konstruktor
+     * @param failureThreshold Liczba kolejnych błędów otwierająca obwód (0 - wyłącznik nieaktywny)
+     * @param openDuration Czas, po którym dopuszczane jest zapytanie próbne
+     */
+    CircuitBreaker(int failureThreshold, std::chrono::milliseconds openDuration);
+
+    /**
+     * @brief Zmienia parametry wyłącznika (stan pozostaje bez zmian)
+     */
+    void configure(int failureThreshold, std::chrono::milliseconds openDuration);
+
+    /**
+     * @brief Sprawdza, czy zapytanie może zostać wysłane
+     * @return false gdy obwód jest otwarty (lub trwa już zapytanie próbne)
+     */
+    bool allowRequest();
+
+    /**
+     * @brief Zapisuje udane zapytanie (zamyka obwód)
+     */
+    void recordSuccess();
+
+    /**
+     * @brief Zapisuje błąd serwera lub połączenia
+     */
+    void recordFailure();
+
+    /**
+     * @brief Zwraca bieżący stan obwodu
+     */
+    State state() const;
+
+    /**
+     * @brief Zwraca nazwę stanu (np. do diagnostyki)
+     */
+    static const char* stateName(State state);
+
+private:
+    mutable std::mutex mutex;
+    int failureThreshold;
+    std::chrono::milliseconds openDuration;
+    int consecutiveFailures = 0;
+    State currentState = State::Closed;
+    std::chrono::steady_clock::time_point openedAt;
+};
+
+#endif // CIRCUIT_BREAKER_HPP
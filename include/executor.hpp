@@ -0,0 +1,85 @@
+/**
+ * @file executor.hpp
+ * @brief Wykonawcy wznawiający korutyny (pętla zdarzeń Qt lub wątki robocze)
+ */
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Miejsce wykonywania pracy przekazanej z innego wątku
+ *
+ * Klient asynchroniczny nie wznawia korutyn w wątku I/O, tylko przekazuje je wykonawcy:
+ * w aplikacji graficznej jest to pętla zdarzeń Qt (QtExecutor), w narzędziach i testach
+ * - wątki robocze (WorkerExecutor).
+ */
+class Executor {
+public:
+    virtual ~Executor() = default;
+
+    /**
+     * @brief Zleca wykonanie pracy
+     * @param work Funkcja wywoływana dokładnie raz, w wątku wykonawcy
+     *
+     * Metoda jest bezpieczna wątkowo i nie czeka na wykonanie pracy.
+     */
+    virtual void post(std::function<void()> work) = 0;
+
+    /**
+     * @brief Zwraca obiekt oczekiwania przenoszący korutynę do wykonawcy (co_await executor.schedule())
+     */
+    auto schedule() {
+        struct Awaiter {
+            Executor& executor;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { executor.post([handle]() { handle.resume(); }); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+};
+
+/**
+ * @brief Wykonawca z pulą wątków roboczych i wspólną kolejką FIFO
+ */
+class WorkerExecutor : public Executor {
+public:
+    /**
+     * @brief Uruchamia wątki robocze
+     * @param threads Liczba wątków (co najmniej 1)
+     */
+    explicit WorkerExecutor(int threads = 1);
+
+    /**
+     * @brief Wykonuje pozostałą w kolejce pracę i zatrzymuje wątki
+     */
+    ~WorkerExecutor() override;
+
+    WorkerExecutor(const WorkerExecutor&) = delete;
+    WorkerExecutor& operator=(const WorkerExecutor&) = delete;
+
+    void post(std::function<void()> work) override;
+
+    /**
+     * @brief Sprawdza, czy bieżący wątek jest jednym z wątków wykonawcy
+     */
+    bool runsInThisThread() const;
+
+private:
+    std::mutex mutex;
+    std::condition_variable available;
+    std::deque<std::function<void()>> queue;
+    bool stopping = false;
+    std::vector<std::thread> threads;
+
+    void run();
+};
+
+#endif // EXECUTOR_HPP
@@ -0,0 +1,161 @@
+/**
+ * @file fetch_pipeline.hpp
+ * @brief Potok pobierania pomiarów: pobieranie → dekodowanie → zapis → publikacja, z ograniczonymi kolejkami
+ */
+#ifndef FETCH_PIPELINE_HPP
+#define FETCH_PIPELINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "api_client.hpp"
+#include "bounded_queue.hpp"
+#include "executor.hpp"
+#include "measurement_series.hpp"
+
+class AsyncApiClient;
+
+/**
+ * @brief Dane jednego czujnika przekazywane między etapami potoku
+ */
+struct PipelineItem {
+    int sensorId = -1;
+    std::string body;                      ///< Treść odpowiedzi API (zwalniana po dekodowaniu)
+    std::vector<Measurement> measurements; ///< Pomiary po dekodowaniu
+    MeasurementSeries series;              ///< Pomiary w postaci kolumnowej (posortowane po czasie)
+    bool fromCache = false;                ///< Pomiary pochodzą z cache klienta (bez zapytania)
+    std::string error;                     ///< Opis błędu pobierania, dekodowania lub zapisu (pusty - sukces)
+};
+
+/**
+ * @brief Zajętość etapu potoku
+ */
+struct PipelineStageStats {
+    std::string name;                 ///< Nazwa etapu
+    int workers = 0;                  ///< Liczba wątków (dla pobierania - limit równoczesnych zapytań)
+    std::uint64_t items = 0;          ///< Przetworzone elementy
+    std::uint64_t busyMicros = 0;     ///< Łączny czas pracy wszystkich wątków etapu
+    std::uint64_t outputWaitMicros = 0; ///< Czas oczekiwania na miejsce w kolejce wyjściowej (przeciwciśnienie)
+
+    /**
+     * @brief Zwraca zajętość etapu: czas pracy / (czas potoku * liczba wątków)
+     * @param seconds Czas działania potoku
+     * @return Wartość z zakresu [0, 1]
+     */
+    double utilization(double seconds) const;
+};
+
+/**
+ * @brief Podsumowanie przebiegu potoku
+ */
+struct PipelineReport {
+    std::vector<PipelineStageStats> stages; ///< Etapy w kolejności: pobieranie, dekodowanie, zapis, publikacja
+    std::vector<QueueStats> queues;         ///< Kolejki między kolejnymi etapami
+    std::size_t items = 0;                  ///< Czujniki, które przeszły przez potok
+    std::size_t failed = 0;                 ///< Czujniki zakończone błędem
+    double seconds = 0.0;                   ///< Czas działania potoku
+
+    /**
+     * @brief Zwraca nazwę etapu o największej zajętości (wąskie gardło)
+     */
+    std::string bottleneck() const;
+
+    /**
+     * @brief Zwraca jednowierszowy opis zajętości etapów i kolejek (do dziennika lub konsoli)
+     */
+    std::string summary() const;
+};
+
+/**
+ * @brief Parametry potoku
+ */
+struct PipelineOptions {
+    int maxInFlight = 32;         ///< Maksymalna liczba równoczesnych zapytań (etap pobierania)
+    int decodeWorkers = 0;        ///< Wątki dekodowania (0 - liczba rdzeni)
+    std::size_t queueCapacity = 64; ///< Pojemność każdej kolejki między etapami
+    bool useCache = true;         ///< Czy korzystać z cache pomiarów ApiClient i zapisywać w nim wyniki
+    std::function<void()> throttle; ///< Wywoływana przed każdym zapytaniem (np. ogranicznik liczby zapytań)
+};
+
+/**
+ * @brief Potok odświeżania pomiarów wielu czujników
+ *
+ * Etapy działają równocześnie i są połączone ograniczonymi kolejkami bez blokad:
+ * - pobieranie - zapytania wysyła jeden wątek I/O klienta asynchronicznego (do maxInFlight naraz),
+ * - dekodowanie - pula wątków: parsowanie JSON, konwersja do MeasurementSeries, zapis w cache,
+ * - zapis - jeden wątek wykonujący etap zapisu (np. scalenie z SeriesStore, statystyki),
+ * - publikacja - wątek potoku albo podany wykonawca (np. pętla zdarzeń Qt).
+ *
+ * Gdy wolniejszy etap nie nadąża, jego kolejka wejściowa się zapełnia i poprzednie etapy
+ * czekają, więc pamięć jest ograniczona niezależnie od liczby czujników. Oczekiwanie
+ * na sieć nakłada się w ten sposób na dekodowanie i publikację. Raport zawiera zajętość
+ * etapów i kolejek, wskazującą wąskie gardło.
+ */
+class FetchPipeline {
+public:
+    /**
+     * @brief Funkcja etapu wywoływana dla jednego elementu
+     */
+    using Stage = std::function<void(PipelineItem&)>;
+
+    /**
+     * @brief Tworzy potok
+     * @param client Klient API (adres, zasady zapytań, cache i metryki)
+     * @param options Parametry potoku
+     */
+    explicit FetchPipeline(ApiClient& client, PipelineOptions options = PipelineOptions());
+
+    /**
+     * @brief Ustawia etap zapisu, wywoływany w jednym wątku tylko dla elementów bez błędu
+     * @param store Funkcja etapu; wyjątek oznacza element jako błędny
+     */
+    void setStoreStage(Stage store);
+
+    /**
+     * @brief Ustawia etap publikacji, wywoływany dla wszystkich elementów (także błędnych)
+     * @param publish Funkcja etapu
+     * @param executor Wykonawca publikacji (nullptr - wątek potoku); potok czeka na wykonanie
+     *        każdego elementu, więc wolny odbiorca spowalnia cały potok
+     */
+    void setPublishStage(Stage publish, Executor* executor = nullptr);
+
+    /**
+     * @brief Przetwarza czujniki i czeka na zakończenie wszystkich etapów
+     * @param sensorIds ID czujników
+     * @return Raport z przebiegu
+     */
+    PipelineReport run(const std::vector<int>& sensorIds);
+
+    /**
+     * @brief Przerywa trwający przebieg: wysłane zapytania są przerywane, nowe nie są wysyłane,
+     *        a elementy nie są publikowane
+     *
+     * Bezpieczna wątkowo; run() kończy się bez czekania na terminy przerwanych zapytań.
+     */
+    void cancel();
+
+    /**
+     * @brief Sprawdza, czy wywołano cancel()
+     */
+    bool isCancelled() const;
+
+private:
+    ApiClient& client;
+    PipelineOptions options;
+    Stage storeStage;
+    Stage publishStage;
+    Executor* publishExecutor = nullptr;
+    std::atomic<bool> cancelled{false};
+
+    // Klient trwającego przebiegu, zatrzymywany przez cancel() z innego wątku
+    std::mutex fetchMutex;
+    AsyncApiClient* activeClient = nullptr;
+};
+
+#endif // FETCH_PIPELINE_HPP
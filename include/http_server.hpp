@@ -0,0 +1,148 @@
+/**
+ * @file http_server.hpp
+ * @brief Prosty, sterowany zdarzeniami serwer HTTP/1.1 (jeden wątek pętli I/O)
+ */
+#ifndef HTTP_SERVER_HPP
+#define HTTP_SERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Gotowa odpowiedź HTTP (linia statusu, nagłówki i treść)
+ *
+ * Odpowiedzi są niezmienne i współdzielone, dzięki czemu odpowiedź z cache
+ * może być wysyłana do wielu klientów bez kopiowania i ponownej serializacji.
+ */
+using HttpResponsePtr = std::shared_ptr<const std::string>;
+
+/**
+ * @brief Żądanie HTTP przekazywane do handlera
+ */
+struct HttpRequest {
+    std::string method;  ///< Metoda (np. "GET")
+    std::string path;    ///< Ścieżka bez parametrów zapytania
+    std::string query;   ///< Parametry zapytania (bez znaku '?')
+    std::unordered_map<std::string, std::string> headers; ///< Nagłówki (nazwy małymi literami)
+};
+
+/**
+ * @brief Serwer HTTP/1.1 z pętlą zdarzeń (epoll w Linuksie, poll w pozostałych systemach)
+ *
+ * Wszystkie połączenia obsługuje jeden wątek. Handler jest wywoływany w wątku pętli
+ * i nie powinien blokować - może odpowiedzieć od razu (np. z cache) albo przekazać
+ * pracę innemu wątkowi i wywołać Responder później, z dowolnego wątku.
+ * Obsługiwane są połączenia keep-alive.
+ */
+class HttpServer {
+public:
+    /**
+     * @brief Funkcja wysyłająca odpowiedź; bezpieczna wątkowo, wywoływana dokładnie raz
+     */
+    using Responder = std::function<void(HttpResponsePtr)>;
+
+    /**
+     * @brief Handler żądań
+     */
+    using Handler = std::function<void(const HttpRequest&, Responder)>;
+
+    /**
+     * @brief Konstruktor
+     * @param handler Handler wywoływany dla każdego żądania
+     */
+    explicit HttpServer(Handler handler);
+
+    /**
+     * @brief Destruktor - zamyka wszystkie połączenia
+     */
+    ~HttpServer();
+
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    /**
+     * @brief Otwiera gniazdo nasłuchujące
+     * @param host Adres IPv4 (np. "127.0.0.1" lub "0.0.0.0")
+     * @param port Port (0 - dowolny wolny port)
+     * @throws std::runtime_error jeśli gniazda nie można utworzyć
+     */
+    void listen(const std::string& host, std::uint16_t port);
+
+    /**
+     * @brief Zwraca port, na którym nasłuchuje serwer
+     */
+    std::uint16_t port() const { return boundPort; }
+
+    /**
+     * @brief Uruchamia pętlę zdarzeń; kończy się po wywołaniu stop()
+     */
+    void run();
+
+    /**
+     * @brief Zatrzymuje pętlę zdarzeń (bezpieczne wątkowo)
+     */
+    void stop();
+
+    /**
+     * @brief Zwraca liczbę aktualnie otwartych połączeń
+     */
+    std::size_t connectionCount() const { return openConnections.load(); }
+
+    /**
+     * @brief Tworzy gotową odpowiedź HTTP
+     * @param status Kod statusu HTTP
+     * @param contentType Typ treści
+     * @param body Treść odpowiedzi
+     * @param extraHeaders Dodatkowe nagłówki (nazwa, wartość)
+     * @return Współdzielona, serializowana odpowiedź
+     */
+    static HttpResponsePtr makeResponse(int status, const std::string& contentType,
+                                        const std::string& body,
+                                        const std::vector<std::pair<std::string, std::string>>& extraHeaders = {});
+
+private:
+    struct Connection;
+    class Poller;
+
+    Handler handler;
+    int listenFd = -1;
+    int wakeReadFd = -1;
+    int wakeWriteFd = -1;
+    std::uint16_t boundPort = 0;
+    std::atomic<bool> running{true};
+    std::atomic<std::size_t> openConnections{0};
+    std::unique_ptr<Poller> poller;
+
+    // Połączenia (używane wyłącznie w wątku pętli)
+    std::unordered_map<int, std::unique_ptr<Connection>> connections; // klucz: deskryptor
+    std::unordered_map<std::uint64_t, int> connectionFds;             // klucz: ID połączenia
+    std::uint64_t nextConnectionId = 1;
+
+    // Odpowiedź udzielona synchronicznie przez handler jest wysyłana bez wybudzania pętli
+    // (oba pola są odczytywane i zmieniane wyłącznie w wątku pętli)
+    std::uint64_t dispatchingConnection = 0;
+    HttpResponsePtr inlineResponse;
+
+    // Odpowiedzi przekazane z innych wątków, oczekujące na obsłużenie w pętli
+    std::mutex completionMutex;
+    std::vector<std::pair<std::uint64_t, HttpResponsePtr>> completions;
+
+    void wake();
+    void acceptConnections();
+    void handleReadable(Connection& connection);
+    void handleWritable(Connection& connection);
+    void updateInterest(Connection& connection);
+    void processRequests(Connection& connection);
+    void deliver(Connection& connection, HttpResponsePtr response);
+    void drainCompletions();
+    void closeConnection(int fd);
+};
+
+#endif // HTTP_SERVER_HPP
@@ -0,0 +1,92 @@
+/**
+ * @file http_transfer.hpp
+ * @brief Wspólne elementy transferów libcurl klienta synchronicznego i asynchronicznego
+ */
+#ifndef HTTP_TRANSFER_HPP
+#define HTTP_TRANSFER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <curl/curl.h>
+
+#include "api_client.hpp"
+#include "logger.hpp"
+#include "metrics.hpp"
+#include "response_decoder.hpp"
+#include "trace.hpp"
+
+/**
+ * @brief Tworzy uchwyt zapytania GET z limitem czasu równym pozostałemu terminowi
+ * @param url Pełny adres zapytania
+ * @param buffer Bufor na treść odpowiedzi (musi istnieć do końca transferu)
+ * @param timeout Limit czasu transferu
+ * @param policy Zasady zapytań (kompresja, wersja HTTP)
+ * @param share Współdzielone połączenia (nullptr - połączenia uchwytu multi)
+ * @return Uchwyt lub nullptr, jeśli libcurl nie mógł go utworzyć
+ */
+CURL* createTransfer(const std::string& url, std::string& buffer, std::chrono::milliseconds timeout,
+                     const RequestPolicy& policy, CURLSH* share);
+
+/**
+ * @brief Odczytuje czasy etapów zakończonego transferu
+ * @param curl Uchwyt transferu
+ * @return Czasy etapów (mikrosekundy)
+ */
+RequestTimings readTimings(CURL* curl);
+
+/**
+ * @brief Zapisuje rozmiar przesłanej treści, użycie połączenia i wersję protokołu zakończonego transferu
+ * @param metrics Metryki klienta
+ * @param endpointClass Klasa endpointu
+ * @param curl Uchwyt transferu
+ */
+void recordTransferInfo(ApiMetrics& metrics, EndpointClass endpointClass, CURL* curl);
+
+/**
+ * @brief Opisuje nieudany transfer i klasyfikuje błąd
+ * @param curl Uchwyt transferu
+ * @param result Kod wyniku libcurl
+ * @param retryable Czy błąd jest przejściowy i można ponowić (wyjście)
+ * @param upstreamFailure Czy błąd świadczy o niedostępności API (wyjście)
+ * @return Opis błędu
+ */
+std::string describeFailure(CURL* curl, CURLcode result, bool& retryable, bool& upstreamFailure);
+
+/**
+ * @brief Opóźnienie przed ponowieniem: losowe z zakresu [0, min(limit, baza * 2^próba)]
+ * @param policy Zasady zapytań
+ * @param attempt Numer nieudanej próby (od 0)
+ * @return Opóźnienie
+ */
+std::chrono::milliseconds retryDelay(const RequestPolicy& policy, int attempt);
+
+/**
+ * @brief Dekoduje treść odpowiedzi, zapisując czas parsowania (SAX) i kopiowania wyników
+ * @param metrics Metryki klienta
+ * @param endpointClass Klasa endpointu
+ * @param body Treść odpowiedzi
+ * @param decoder Funkcja dekodująca ResponseDecoder
+ * @return Zdekodowane dane
+ * @throws std::runtime_error dla niepoprawnej odpowiedzi
+ */
+template <typename Result>
+Result decodeResponse(ApiMetrics& metrics, EndpointClass endpointClass, const std::string& body,
+                      Result (*decoder)(const char*, std::size_t, DecodeStats*)) {
+    TRACE_SCOPE("ResponseDecoder::decode");
+    DecodeStats stats;
+    try {
+        Result result = decoder(body.data(), body.size(), &stats);
+        metrics.recordPhase(endpointClass, RequestPhase::Parse, stats.parseMicros);
+        metrics.recordPhase(endpointClass, RequestPhase::Decode, stats.copyMicros);
+        return result;
+    } catch (const std::exception& e) {
+        metrics.endpoint(endpointClass).failures.fetch_add(1, std::memory_order_relaxed);
+        std::string errorMsg = "Blad parsowania JSON: " + std::string(e.what()) + "\nOdpowiedz: " + body.substr(0, 200);
+        LOG_ERROR("api", errorMsg);
+        throw std::runtime_error(errorMsg);
+    }
+}
+
+#endif // HTTP_TRANSFER_HPP
@@ -0,0 +1,294 @@
+/**
+ * @file logger.hpp
+ * @brief Asynchroniczny logger z poziomami, filtrowaniem w czasie kompilacji i wątkiem zapisu
+ *
+ * Wątki wywołujące jedynie formatują komunikat i wstawiają go do bezblokadowej kolejki
+ * o stałej pojemności. Zapis na konsolę i do plików wykonuje osobny wątek, więc logowanie
+ * nigdy nie blokuje pobierania danych ani wątku interfejsu. Przy przepełnionej kolejce
+ * komunikat jest odrzucany i zliczany (Logger::droppedCount).
+ *
+ * Konfiguracja z otoczenia (dla Logger::instance):
+ * - AIRQUALITY_LOG_LEVEL - minimalny poziom: trace, debug, info, warning, error, off (domyślnie info)
+ * - AIRQUALITY_LOG_FILE - ścieżka pliku logu z rotacją (10 MB, 3 pliki archiwalne)
+ */
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Poziom ważności komunikatu
+ */
+enum class LogLevel {
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warning = 3,
+    Error = 4,
+    Off = 5
+};
+
+/**
+ * @brief Pojedynczy komunikat w kolejce loggera
+ */
+struct LogRecord {
+    LogLevel level = LogLevel::Info;                   ///< Poziom
+    std::chrono::system_clock::time_point time;        ///< Czas utworzenia
+    std::uint32_t threadId = 0;                        ///< Numer wątku (kolejny, od 1)
+    const char* category = "";                         ///< Kategoria (literał), np. "api"
+    std::string message;                               ///< Treść
+};
+
+/**
+ * @brief Miejsce docelowe komunikatów (wywoływane wyłącznie z wątku zapisu)
+ */
+class LogSink {
+public:
+    virtual ~LogSink() = default;
+
+    /**
+     * @brief Zapisuje komunikat
+     * @param record Komunikat
+     * @param line Komunikat sformatowany przez Logger::format (bez znaku nowej linii)
+     */
+    virtual void write(const LogRecord& record, const std::string& line) = 0;
+
+    /**
+     * @brief Opróżnia bufory (wywoływane po każdej partii komunikatów)
+     */
+    virtual void flush() {}
+};
+
+/**
+ * @brief Wyjście na konsolę: ostrzeżenia i błędy na stderr, pozostałe na stdout, z kolorami ANSI
+ */
+class ConsoleLogSink : public LogSink {
+public:
+    /**
+     * @brief Konstruktor
+     * @param useColors Czy dodawać kody kolorów ANSI
+     */
+    explicit ConsoleLogSink(bool useColors = true) : useColors(useColors) {}
+
+    void write(const LogRecord& record, const std::string& line) override;
+    void flush() override;
+
+private:
+    bool useColors;
+};
+
+/**
+ * @brief Plik logu z rotacją według rozmiaru (plik, plik.1, ..., plik.N)
+ */
+class RotatingFileLogSink : public LogSink {
+public:
+    /**
+     * @brief Konstruktor
+     * @param path Ścieżka bieżącego pliku logu
+     * @param maxBytes Rozmiar, po przekroczeniu którego następuje rotacja
+     * @param maxFiles Liczba zachowywanych plików archiwalnych
+     * @throws std::runtime_error gdy pliku nie da się otworzyć
+     */
+    RotatingFileLogSink(const std::string& path, std::uint64_t maxBytes, int maxFiles);
+
+    void write(const LogRecord& record, const std::string& line) override;
+    void flush() override;
+
+private:
+    void rotate();
+
+    std::string path;
+    std::uint64_t maxBytes;
+    int maxFiles;
+    std::uint64_t currentSize;
+    std::ofstream file;
+};
+
+/**
+ * @brief Asynchroniczny logger
+ */
+class Logger {
+public:
+    static constexpr std::size_t DEFAULT_QUEUE_CAPACITY = 8192; ///< Pojemność kolejki (potęga dwójki)
+
+    /**
+     * @brief Tworzy logger bez wyjść i uruchamia wątek zapisu
+     * @param queueCapacity Pojemność kolejki (zaokrąglana w górę do potęgi dwójki)
+     */
+    explicit Logger(std::size_t queueCapacity = DEFAULT_QUEUE_CAPACITY);
+
+    /**
+     * @brief Opróżnia kolejkę i zatrzymuje wątek zapisu
+     */
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    /**
+     * @brief Zwraca globalny logger (wyjście na konsolę i opcjonalnie do pliku z AIRQUALITY_LOG_FILE)
+     */
+    static Logger& instance();
+
+    /**
+     * @brief Sprawdza, czy komunikat o danym poziomie zostanie zapisany
+     */
+    bool shouldLog(LogLevel level) const {
+        return static_cast<int>(level) >= minLevel.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Wstawia komunikat do kolejki (bez blokowania)
+     * @param level Poziom
+     * @param category Kategoria (literał o statycznym czasie życia)
+     * @param message Treść
+     * @return false jeśli komunikat odrzucono z powodu przepełnienia kolejki
+     */
+    bool log(LogLevel level, const char* category, std::string message);
+
+    /**
+     * @brief Ustawia minimalny poziom zapisywanych komunikatów
+     */
+    void setLevel(LogLevel level);
+
+    /**
+     * @brief Zwraca minimalny poziom zapisywanych komunikatów
+     */
+    LogLevel level() const { return static_cast<LogLevel>(minLevel.load(std::memory_order_relaxed)); }
+
+    /**
+     * @brief Dodaje wyjście
+     */
+    void addSink(std::unique_ptr<LogSink> sink);
+
+    /**
+     * @brief Usuwa wszystkie wyjścia
+     */
+    void clearSinks();
+
+    /**
+     * @brief Czeka, aż wszystkie wcześniej wstawione komunikaty zostaną zapisane
+     */
+    void flush();
+
+    /**
+     * @brief Zwraca liczbę komunikatów odrzuconych z powodu przepełnienia kolejki
+     */
+    std::uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Zwraca nazwę poziomu (np. "INFO")
+     */
+    static const char* levelName(LogLevel level);
+
+    /**
+     * @brief Zamienia nazwę poziomu (bez względu na wielkość liter) na poziom
+     * @param name Nazwa, np. "debug"
+     * @param fallback Poziom zwracany dla nieznanej nazwy
+     */
+    static LogLevel parseLevel(const std::string& name, LogLevel fallback);
+
+    /**
+     * @brief Formatuje komunikat: "RRRR-MM-DD GG:MM:SS.mmm POZIOM [kategoria] #wątek treść"
+     */
+    static std::string format(const LogRecord& record);
+
+private:
+    // Komórka kolejki z numerem sekwencyjnym (kolejka ograniczona Vyukova)
+    struct Slot {
+        std::atomic<std::size_t> sequence{0};
+        LogRecord record;
+    };
+
+    bool tryPop(LogRecord& record);
+    void sinkLoop();
+
+    std::vector<Slot> slots;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> enqueuePos{0};
+    alignas(64) std::size_t dequeuePos = 0;
+
+    std::atomic<int> minLevel{static_cast<int>(LogLevel::Info)};
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<std::uint64_t> enqueued{0};
+    std::atomic<std::uint64_t> processed{0};
+    std::atomic<bool> sinkIdle{false};
+    std::atomic<bool> stopping{false};
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable flushedCondition;
+
+    std::mutex sinkMutex;
+    std::vector<std::unique_ptr<LogSink>> sinks;
+
+    std::thread sinkThread;
+};
+
+/**
+ * @brief Minimalny poziom kompilowanych komunikatów (0 - trace ... 4 - error)
+ *
+ * Wywołania LOG_* poniżej tego poziomu nie generują żadnego kodu.
+ */
+#ifndef AIRQUALITY_LOG_MIN_LEVEL
+#define AIRQUALITY_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * @brief Zapisuje komunikat; wyrażenie jest formatowane tylko gdy poziom jest aktywny
+ *
+ * Przykład: LOG_INFO("api", "Pobrano " << stations.size() << " stacji");
+ */
+#define AIRQUALITY_LOG(level, category, expr)                                  \
+    do {                                                                       \
+        Logger& logger_ = Logger::instance();                                  \
+        if (logger_.shouldLog(level)) {                                        \
+            std::ostringstream logStream_;                                     \
+            logStream_ << expr;                                                \
+            logger_.log(level, category, logStream_.str());                    \
+        }                                                                      \
+    } while (0)
+
+#define AIRQUALITY_LOG_DISABLED() do {} while (0)
+
+#if AIRQUALITY_LOG_MIN_LEVEL <= 0
+#define LOG_TRACE(category, expr) AIRQUALITY_LOG(LogLevel::Trace, category, expr)
+#else
+#define LOG_TRACE(category, expr) AIRQUALITY_LOG_DISABLED()
+#endif
+
+#if AIRQUALITY_LOG_MIN_LEVEL <= 1
+#define LOG_DEBUG(category, expr) AIRQUALITY_LOG(LogLevel::Debug, category, expr)
+#else
+#define LOG_DEBUG(category, expr) AIRQUALITY_LOG_DISABLED()
+#endif
+
+#if AIRQUALITY_LOG_MIN_LEVEL <= 2
+#define LOG_INFO(category, expr) AIRQUALITY_LOG(LogLevel::Info, category, expr)
+#else
+#define LOG_INFO(category, expr) AIRQUALITY_LOG_DISABLED()
+#endif
+
+#if AIRQUALITY_LOG_MIN_LEVEL <= 3
+#define LOG_WARNING(category, expr) AIRQUALITY_LOG(LogLevel::Warning, category, expr)
+#else
+#define LOG_WARNING(category, expr) AIRQUALITY_LOG_DISABLED()
+#endif
+
+#if AIRQUALITY_LOG_MIN_LEVEL <= 4
+#define LOG_ERROR(category, expr) AIRQUALITY_LOG(LogLevel::Error, category, expr)
+#else
+#define LOG_ERROR(category, expr) AIRQUALITY_LOG_DISABLED()
+#endif
+
+#endif // LOGGER_HPP
@@ -23,13 +23,30 @@
 #include <QListWidget>
 #include <QDialog>
 #include <QFutureWatcher>
+#include <functional>
 #include <memory>
 #include <map>
+#include <utility>
 #include <QColor>
 
 QT_CHARTS_USE_NAMESPACE
 
 #include "api_client.hpp"
+#include "fetch_pipeline.hpp"
+#include "measurement_file.hpp"
+#include "qt_executor.hpp"
+#include "resampler.hpp"
+#include "station_comparison.hpp"
+#include "task.hpp"
+
+/**
+ * @brief Wynik asynchronicznego wczytywania pliku z pomiarami
+ */
+struct SavedFileResult {
+    QString filePath;            ///< Ścieżka wczytywanego pliku
+    QString error;               ///< Komunikat błędu (pusty, jeśli wczytanie się powiodło)
+    SavedMeasurementFile data;   ///< Zawartość pliku
+};
 
 /**
  * @brief Klasa reprezentująca główne okno aplikacji do monitorowania jakości powietrza
@@ -51,6 +68,26 @@ public:
      */
     ~MainWindow();
 
+signals:
+    /**
+     * @brief Emitowany raz, gdy okno zostało po raz pierwszy narysowane
+     */
+    void firstFrameShown();
+
+    /**
+     * @brief Emitowany raz, gdy okno jest gotowe do pracy (lista stacji wczytana lub błąd zgłoszony)
+     */
+    void interactive();
+
+protected:
+    /**
+     * @brief Wykrywa pierwsze narysowanie okna (pomiar czasu uruchamiania)
+     * @param watched Obserwowany obiekt (centralny widget)
+     * @param event Zdarzenie
+     * @return false - zdarzenie jest przekazywane dalej
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
     /**
      * @brief Wczytuje listę stacji pomiarowych
@@ -88,7 +125,8 @@ private slots:
      * @brief Zapisuje pomiary do pliku JSON
      * @param filename Nazwa pliku
      * @return true jeśli zapis się powiódł, false w przeciwnym razie
-     * Zapisuje dane pomiarowe, metadane stacji i czujnika oraz kolory do pliku JSON.
+     * Zapisuje dane pomiarowe, metadane stacji i czujnika oraz kolory do pliku JSON
+     * (lub, dla rozszerzenia .aqz, do pliku skompresowanego).
      */
     bool saveMeasurementsToJSON(const QString& filename);
     
@@ -101,16 +139,46 @@ private slots:
     /**
      * @brief Wczytuje zapisane pomiary z wybranego pliku
      * @param item Element z listy plików
-     * Wczytuje dane z wybranego pliku JSON i aktualizuje interfejs.
+     * Uruchamia asynchroniczne wczytywanie wybranego pliku JSON.
      */
     void loadSavedMeasurement(QListWidgetItem* item);
 
+    /**
+     * @brief Obsługuje zakończenie asynchronicznego wczytywania pliku z pomiarami
+     * Aktualizuje dane, tabelę i wykres po wczytaniu pliku.
+     */
+    void onSavedMeasurementLoaded();
+
     /**
      * @brief Obsługuje zakończenie asynchronicznego wczytywania stacji
      * Aktualizuje interfejs po zakończeniu operacji pobierania stacji.
      */
     void onStationsLoaded();
 
+    /**
+     * @brief Otwiera panel diagnostyczny
+     * Wyświetla metryki klienta API (zapytania, trafienia w cache, percentyle opóźnień).
+     */
+    void openDiagnostics();
+
+    /**
+     * @brief Otwiera okno wyboru stacji do porównania
+     * Porównywany jest jeden parametr na wielu stacjach (domyślnie stacje z miasta bieżącej stacji).
+     */
+    void openComparison();
+
+    /**
+     * @brief Obsługuje zakończenie asynchronicznego pobierania porównania stacji
+     * Wyświetla serie wszystkich stacji na wspólnym wykresie.
+     */
+    void onComparisonLoaded();
+
+    /**
+     * @brief Obsługuje zmianę zakresu dat
+     * Aktualizuje tabelę, statystyki i wykres dla pomiarów z wybranego zakresu.
+     */
+    void onDateRangeChanged();
+
 private:
     // Komponenty interfejsu użytkownika
     QComboBox *stationComboBox;      ///< ComboBox do wyboru stacji
@@ -118,22 +186,55 @@ private:
     QPushButton *refreshButton;      ///< Przycisk odświeżania danych
     QPushButton *saveButton;         ///< Przycisk zapisu danych
     QPushButton *openSavedButton;    ///< Przycisk otwierania zapisanych danych
+    QPushButton *diagnosticsButton;  ///< Przycisk otwierania panelu diagnostycznego
+    QPushButton *compareButton;      ///< Przycisk porównania stacji
+    QComboBox *saveFormatComboBox;   ///< Format zapisu pomiarów (JSON, skompresowany lub przyrostowy)
+    QDateEdit *fromDateEdit;         ///< Początek zakresu dat
+    QDateEdit *toDateEdit;           ///< Koniec zakresu dat
+    QLabel *statisticsLabel;         ///< Statystyki pomiarów z wybranego zakresu
     QTableWidget *dataTable;         ///< Tabela wyświetlająca pomiary
     QLabel *statusLabel;             ///< Etykieta statusu w pasku stanu
-    QChartView *chartView;           ///< Widok wykresu z pomiarami
+    QWidget *chartContainer;         ///< Zakładka wykresu (widok wykresu jest tworzony przy pierwszym użyciu)
+    QChartView *chartView = nullptr; ///< Widok wykresu z pomiarami (nullptr do pierwszego użycia)
+    QDialog *savedMeasurementsDialog = nullptr;  ///< Dialog zapisanych pomiarów (tworzony przy pierwszym otwarciu)
+    std::function<void()> refreshSavedFileList; ///< Odświeża listę plików w dialogu zapisanych pomiarów
+    bool firstFrameReported = false; ///< Czy zgłoszono pierwsze narysowanie okna
+    bool interactiveReported = false; ///< Czy zgłoszono gotowość okna
     
     // Dane aplikacji
     std::unique_ptr<ApiClient> apiClient;       ///< Klient API do pobierania danych
+    std::unique_ptr<QtExecutor> uiExecutor;     ///< Wznawia korutyny w wątku interfejsu
+    std::unique_ptr<WorkerExecutor> pipelineExecutor; ///< Wątek, w którym działa potok trybu "Wszystkie"
+    std::shared_ptr<FetchPipeline> activePipeline; ///< Trwający potok trybu "Wszystkie" (przerywany przy nowym wyborze)
+    std::uint64_t measurementRequestId = 0;     ///< Numer ostatniego żądania pomiarów (wybór czujnika, wczytanie pliku); starsze wyniki są odrzucane
     std::vector<Station> stations;              ///< Lista stacji pomiarowych
     std::vector<Sensor> sensors;                ///< Lista czujników dla wybranej stacji
     std::vector<Measurement> measurements;      ///< Lista pomiarów dla wybranego czujnika
+    MeasurementSeries displayedSeries;          ///< Pomiary posortowane po czasie (źródło fragmentów zakresu dat)
+    Resampler resampler;                        ///< Pomiary wszystkich czujników stacji na siatce godzinowej
+    int resamplerStationId = -1;                ///< Stacja, której pomiary zawiera resampler
+    ResampledFrame frame;                       ///< Ramka trybu "Wszystkie" (pusta dla pojedynczego czujnika)
     std::map<int, QColor> sensorColors;         ///< Mapa ID czujnika na kolor wykresu
     
+    /**
+     * @brief Rodzaj wykresu w zakładce "Wykres"
+     */
+    enum class ChartKind {
+        None,          ///< Brak wykresu
+        Single,        ///< Pojedynczy parametr (z displayedSeries)
+        AllParameters, ///< Wszystkie parametry stacji (z kolumn ramki)
+        Comparison     ///< Porównanie stacji (niezależne od zakresu dat)
+    };
+    ChartKind chartKind = ChartKind::None;      ///< Rodzaj wyświetlanego wykresu
+    std::vector<std::size_t> chartFrameColumns; ///< Kolumny ramki kolejnych serii wykresu "Wszystkie"
+    
     // Ścieżka do zapisu pomiarów
     QString exportPath;                         ///< Katalog do zapisu plików JSON
     
     // Obiekt do śledzenia asynchronicznych operacji
     QFutureWatcher<std::vector<Station>> stationsWatcher; ///< Obserwator dla asynchronicznego wczytywania stacji
+    QFutureWatcher<SavedFileResult> savedFileWatcher;     ///< Obserwator dla asynchronicznego wczytywania pliku z pomiarami
+    QFutureWatcher<StationComparison> comparisonWatcher;  ///< Obserwator dla asynchronicznego pobierania porównania stacji
     
     /**
      * @brief Inicjalizuje interfejs użytkownika
@@ -141,12 +242,65 @@ private:
      */
     void initUI();
     
+    /**
+     * @brief Unieważnia trwające pobieranie pomiarów (np. przed wczytaniem pliku)
+     * @return Numer nowego żądania; wyniki ze starszym numerem są odrzucane
+     */
+    std::uint64_t startMeasurementRequest();
+    
+    /**
+     * @brief Pobiera równocześnie pomiary wszystkich czujników stacji i wyświetla je (tryb "Wszystkie")
+     * @param requestId Numer wyboru czujnika; wynik jest odrzucany, jeśli w międzyczasie wybrano inny
+     * @return Korutyna wznawiana w wątku interfejsu
+     */
+    Task<void> loadAllMeasurements(std::uint64_t requestId);
+    
+    /**
+     * @brief Zwraca widok wykresu, tworząc go przy pierwszym użyciu
+     * @return Widok wykresu w zakładce "Wykres"
+     */
+    QChartView* ensureChartView();
+    
     /**
      * @brief Wypełnia tabelę danymi pomiarowymi
-     * Aktualizuje tabelę dataTable danymi z wektora measurements.
+     * Aktualizuje tabelę dataTable danymi z wektora measurements lub, w trybie "Wszystkie",
+     * ramką frame (kolumna na parametr).
      */
     void fillDataTable();
     
+    /**
+     * @brief Ustawia serię wyświetlanych pomiarów i pełny zakres dat
+     * Tworzy posortowaną serię z wektora measurements.
+     */
+    void setDisplayedSeries();
+    
+    /**
+     * @brief Zwraca wybrany zakres dat
+     * @return Para (od, do) w sekundach; pełny zakres, gdy kontrolki dat są nieaktywne
+     */
+    std::pair<std::int64_t, std::int64_t> selectedDateRange() const;
+    
+    /**
+     * @brief Zwraca wiersze ramki trybu "Wszystkie" leżące w zakresie dat
+     * @param range Zakres (od, do) w sekundach
+     * @return Para (pierwszy, ostatni) indeks wiersza; ostatni < pierwszy dla pustego zakresu
+     */
+    std::pair<std::int64_t, std::int64_t> frameRowRange(const std::pair<std::int64_t, std::int64_t>& range) const;
+    
+    /**
+     * @brief Zwraca pomiary jednej kolumny ramki trybu "Wszystkie" z podanych wierszy
+     * @param column Indeks kolumny (parametru)
+     * @param rows Para (pierwszy, ostatni) indeks wiersza, np. wynik frameRowRange()
+     * @return Seria bez godzin, w których brak pomiaru
+     */
+    MeasurementSeries frameColumnSeries(std::size_t column, const std::pair<std::int64_t, std::int64_t>& rows) const;
+    
+    /**
+     * @brief Aktualizuje etykietę statystyk dla wybranego zakresu dat
+     * W trybie "Wszystkie" statystyki są liczone osobno dla każdego parametru (różne jednostki).
+     */
+    void updateRangeStatistics();
+    
     /**
      * @brief Tworzy i wyświetla wykres pomiarów
      * @param paramName Nazwa parametru
@@ -157,13 +311,50 @@ private:
      */
     bool displayChart(const QString& paramName, const QString& paramFormula, bool switchToChartTab = false);
     
+    /**
+     * @brief Zapisuje pomiary trybu "Wszystkie" do plików skompresowanych (.aqz), po jednym na czujnik
+     * @param stationIndex Indeks stacji
+     */
+    void saveCompressedPerSensor(int stationIndex);
+    
+    /**
+     * @brief Dopisuje nowe pomiary do plików eksportu przyrostowego (.jsonl)
+     * @param stationIndex Indeks stacji
+     * @param sensorIndex Indeks w ComboBox czujników (0 = "Wszystkie" - plik na każdy czujnik)
+     * Pliki mają stałe nazwy (stacja i parametr), a dopisywane są tylko pomiary nowsze niż punkt kontrolny pliku.
+     */
+    void appendMeasurementsIncremental(int stationIndex, int sensorIndex);
+    
+    /**
+     * @brief Tworzy obiekt "metadata" eksportu
+     * @param stationIndex Indeks stacji
+     * @param sensorIndex Indeks w ComboBox czujników (0 = "Wszystkie")
+     * @return Metadane stacji, czujnika, kolorów i data eksportu
+     */
+    json exportMetadata(int stationIndex, int sensorIndex) const;
+    
     /**
      * @brief Tworzy dialog do przeglądania zapisanych pomiarów
      * @return Wskaźnik na dialog z listą zapisanych plików
-     * Tworzy okno dialogowe z listą plików JSON w katalogu exportPath.
+     * Tworzy okno dialogowe z listą plików JSON w katalogu exportPath i ustawia refreshSavedFileList.
      */
     QDialog* createSavedMeasurementsDialog();
     
+    /**
+     * @brief Tworzy panel diagnostyczny z metrykami klienta API
+     * @return Wskaźnik na niemodalny dialog (usuwany po zamknięciu)
+     * Tabela z licznikami i percentylami per klasa endpointu, odświeżana co sekundę.
+     */
+    QDialog* createDiagnosticsDialog();
+    
+    /**
+     * @brief Rysuje porównanie stacji na wykresie
+     * @param comparison Serie stacji na wspólnej osi czasu
+     * @return true jeśli wykres został utworzony, false w przeciwnym razie
+     * Serie są przerzedzane do rozdzielczości wykresu, więc czas rysowania nie zależy od liczby pomiarów.
+     */
+    bool displayComparisonChart(const StationComparison& comparison);
+    
     /**
      * @brief Wczytuje pomiary z pliku JSON
      * @param filePath Ścieżka do pliku
@@ -171,6 +362,14 @@ private:
      * Parsuje plik JSON i aktualizuje dane aplikacji (stacje, czujniki, pomiary, kolory).
      */
     bool loadMeasurementsFromJSON(const QString& filePath);
+    
+    /**
+     * @brief Aktualizuje dane aplikacji na podstawie wczytanego pliku
+     * @param file Zawartość pliku z pomiarami
+     * @return true jeśli plik zawierał pomiary, false w przeciwnym razie
+     * Aktualizuje stacje, czujniki, pomiary, kolory oraz ComboBoxy.
+     */
+    bool applySavedMeasurementFile(const SavedMeasurementFile& file);
 };
 
 #endif // MAIN_WINDOW_HPP
\ No newline at end of file
@@ -0,0 +1,57 @@
+/**
+ * @file mapped_file.hpp
+ * @brief Plik odwzorowany w pamięci (mmap) tylko do odczytu
+ */
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Odwzorowanie pliku w pamięci tylko do odczytu (RAII)
+ *
+ * Zawartość pliku jest dostępna bez kopiowania do bufora programu.
+ * Obiekt można przenosić, ale nie kopiować.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Otwiera i odwzorowuje plik w pamięci
+     * @param path Ścieżka do pliku
+     * @throws std::runtime_error jeśli pliku nie można otworzyć lub odwzorować
+     */
+    explicit MappedFile(const std::string& path);
+
+    /**
+     * @brief Destruktor - zwalnia odwzorowanie
+     */
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Zwraca wskaźnik na początek danych pliku
+     */
+    const char* data() const { return data_; }
+
+    /**
+     * @brief Zwraca rozmiar pliku w bajtach
+     */
+    std::size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+#endif
+
+    void release();
+};
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,135 @@
+/**
+ * @file measurement_file.hpp
+ * @brief Wczytywanie zapisanych plików z pomiarami (format eksportu aplikacji)
+ */
+#ifndef MEASUREMENT_FILE_HPP
+#define MEASUREMENT_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "api_client.hpp"
+#include "measurement_series.hpp"
+
+/**
+ * @brief Kolor zapisany dla jednego czujnika (tryb "Wszystkie")
+ */
+struct SensorColorEntry {
+    int sensorId;
+    std::string paramName;
+    std::string paramFormula;
+    std::string color;
+};
+
+/**
+ * @brief Zawartość zapisanego pliku z pomiarami
+ */
+struct SavedMeasurementFile {
+    Station station;                          ///< Metadane stacji
+    Sensor sensor;                            ///< Metadane czujnika (id == -1 dla "Wszystkie")
+    std::string sensorColor;                  ///< Kolor pojedynczego czujnika (może być pusty)
+    std::vector<SensorColorEntry> sensorColors; ///< Kolory czujników w trybie "Wszystkie"
+    std::string exportDate;                   ///< Data eksportu
+    MeasurementSeries series;                 ///< Pomiary posortowane rosnąco po czasie
+
+    /**
+     * @brief Sprawdza, czy plik zawiera pomiary wszystkich czujników stacji
+     */
+    bool isAllSensors() const { return sensor.paramName == "Wszystkie"; }
+};
+
+/**
+ * @brief Wczytuje pliki z pomiarami zapisane przez aplikację
+ *
+ * Plik jest odwzorowywany w pamięci i parsowany strumieniowo (SAX) bezpośrednio
+ * do kolumnowej serii, bez budowania drzewa JSON i bez kopii pośrednich.
+ * Pliki skompresowane (.aqz) i przyrostowe (.jsonl) są rozpoznawane po początku pliku.
+ * Metody są bezstanowe, więc można je wywoływać z wątków roboczych.
+ */
+class MeasurementFileLoader {
+public:
+    /**
+     * @brief Wczytuje plik z pomiarami
+     * @param path Ścieżka do pliku
+     * @return Metadane i pomiary z pliku
+     * @throws std::runtime_error jeśli plik nie istnieje lub ma niepoprawny format
+     */
+    static SavedMeasurementFile load(const std::string& path);
+
+    /**
+     * @brief Parsuje zawartość pliku z pomiarami z bufora w pamięci
+     * @param data Wskaźnik na dane
+     * @param size Rozmiar danych w bajtach
+     * @return Metadane i pomiary
+     * @throws std::runtime_error jeśli dane mają niepoprawny format
+     */
+    static SavedMeasurementFile parse(const char* data, std::size_t size);
+};
+
+/**
+ * @brief Wynik dopisania pomiarów do eksportu przyrostowego
+ */
+struct AppendResult {
+    std::size_t appended = 0;       ///< Liczba dopisanych pomiarów
+    std::size_t skipped = 0;        ///< Pomiary nie nowsze niż punkt kontrolny (już zapisane)
+    std::int64_t lastTimestamp = 0; ///< Czas ostatniego zapisanego pomiaru (nowy punkt kontrolny)
+    bool created = false;           ///< Czy plik został utworzony
+};
+
+/**
+ * @brief Zapisuje pliki z pomiarami w formacie skompresowanym (.aqz) i przyrostowym (.jsonl)
+ *
+ * Plik skompresowany zawiera znacznik "AQZF", długość metadanych, metadane w postaci JSON
+ * (jak w eksporcie JSON) oraz pomiary jako blok SeriesCodec.
+ *
+ * Plik przyrostowy (JSON Lines) zaczyna się wierszem {"format":"jsonl","metadata":{...}},
+ * po którym następują wiersze {"date":...,"value":...}. Każde dopisanie kończy się wierszem
+ * punktu kontrolnego {"checkpoint":"<data ostatniego pomiaru>","appended":N}, więc kolejny
+ * eksport czyta tylko koniec pliku i dopisuje wyłącznie nowsze pomiary.
+ * MeasurementFileLoader rozpoznaje oba formaty.
+ */
+class MeasurementFileWriter {
+public:
+    /**
+     * @brief Tworzy zawartość pliku skompresowanego
+     * @param metadata Obiekt "metadata" eksportu (stacja, czujnik, kolory)
+     * @param series Pomiary
+     * @return Zawartość pliku
+     */
+    static std::string compressed(const json& metadata, const MeasurementSeries& series);
+
+    /**
+     * @brief Zapisuje plik skompresowany
+     * @param path Ścieżka do pliku
+     * @param metadata Obiekt "metadata" eksportu
+     * @param series Pomiary
+     * @throws std::runtime_error jeśli pliku nie można zapisać
+     */
+    static void saveCompressed(const std::string& path, const json& metadata, const MeasurementSeries& series);
+
+    /**
+     * @brief Dopisuje do pliku przyrostowego pomiary nowsze niż jego punkt kontrolny
+     * @param path Ścieżka do pliku (tworzonego z metadanymi, jeśli nie istnieje)
+     * @param metadata Obiekt "metadata" eksportu (zapisywany tylko przy tworzeniu pliku)
+     * @param series Pomiary w dowolnej kolejności (np. pełna odpowiedź API)
+     * @return Liczba dopisanych i pominiętych pomiarów oraz nowy punkt kontrolny
+     * @throws std::runtime_error jeśli pliku nie można odczytać lub zapisać
+     *
+     * Koszt zależy od liczby nowych pomiarów, a nie od rozmiaru pliku. Niedokończony
+     * ostatni wiersz (przerwany zapis) jest obcinany przed dopisaniem.
+     */
+    static AppendResult appendJsonLines(const std::string& path, const json& metadata, const MeasurementSeries& series);
+
+    /**
+     * @brief Odczytuje punkt kontrolny pliku przyrostowego
+     * @param path Ścieżka do pliku
+     * @param timestamp Wynik - czas ostatniego zapisanego pomiaru
+     * @return true jeśli plik zawiera pomiary, false dla braku pliku lub pliku bez pomiarów
+     * @throws std::runtime_error jeśli plik nie jest plikiem przyrostowym
+     */
+    static bool lastCheckpoint(const std::string& path, std::int64_t& timestamp);
+};
+
+#endif // MEASUREMENT_FILE_HPP
@@ -0,0 +1,179 @@
+/**
+ * @file measurement_series.hpp
+ * @brief Kolumnowa reprezentacja serii pomiarowej oraz konwersje dat GIOŚ
+ */
+#ifndef MEASUREMENT_SERIES_HPP
+#define MEASUREMENT_SERIES_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "api_client.hpp"
+
+/**
+ * @brief Zamienia datę w formacie GIOŚ ("yyyy-MM-dd hh:mm:ss") na liczbę sekund
+ * @param date Data w formacie "yyyy-MM-dd hh:mm:ss" (dopuszczalny separator 'T')
+ * @param length Długość tekstu daty
+ * @param timestamp Wynik - sekundy od 1970-01-01 00:00:00 (czas lokalny GIOŚ traktowany jak UTC)
+ * @return true jeśli data została poprawnie sparsowana
+ */
+bool parseMeasurementDate(const char* date, std::size_t length, std::int64_t& timestamp);
+
+/**
+ * @brief Wersja parseMeasurementDate dla std::string
+ * @param date Data w formacie "yyyy-MM-dd hh:mm:ss"
+ * @return Liczba sekund od epoki lub -1 w przypadku błędu
+ */
+std::int64_t parseMeasurementDate(const std::string& date);
+
+/**
+ * @brief Zamienia liczbę sekund na datę w formacie GIOŚ ("yyyy-MM-dd hh:mm:ss")
+ * @param timestamp Sekundy od epoki
+ * @return Data w formacie tekstowym
+ */
+std::string formatMeasurementDate(std::int64_t timestamp);
+
+/**
+ * @brief Widok fragmentu kolumn serii (bez kopiowania danych)
+ *
+ * Wskaźniki są ważne, dopóki seria źródłowa nie zostanie zmieniona.
+ */
+struct SeriesSlice {
+    const std::int64_t* timestamps = nullptr; ///< Pierwszy znacznik czasu fragmentu
+    const double* values = nullptr;           ///< Pierwsza wartość fragmentu
+    std::size_t count = 0;                    ///< Liczba pomiarów we fragmencie
+    std::size_t offset = 0;                   ///< Indeks pierwszego pomiaru w serii źródłowej
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+/**
+ * @brief Seria pomiarowa przechowywana kolumnowo (osobno czasy i wartości)
+ *
+ * Kolumny mają zawsze równą długość. Po wywołaniu sortByTime() znaczniki czasu
+ * są posortowane rosnąco, co pozwala na wyszukiwanie binarne zakresów.
+ */
+struct MeasurementSeries {
+    std::vector<std::int64_t> timestamps; ///< Znaczniki czasu w sekundach
+    std::vector<double> values;           ///< Wartości pomiarów
+
+    std::size_t size() const { return timestamps.size(); }
+    bool empty() const { return timestamps.empty(); }
+
+    void reserve(std::size_t count) {
+        timestamps.reserve(count);
+        values.reserve(count);
+    }
+
+    void append(std::int64_t timestamp, double value) {
+        timestamps.push_back(timestamp);
+        values.push_back(value);
+    }
+
+    void clear() {
+        timestamps.clear();
+        values.clear();
+    }
+
+    /**
+     * @brief Sortuje serię rosnąco po czasie (stabilnie)
+     */
+    void sortByTime();
+
+    /**
+     * @brief Sprawdza, czy znaczniki czasu są posortowane rosnąco
+     */
+    bool isSorted() const;
+
+    /**
+     * @brief Zwraca pomiary z zakresu czasu (wyszukiwanie binarne, bez kopiowania)
+     * @param from Początek zakresu (włącznie)
+     * @param to Koniec zakresu (włącznie)
+     * @return Widok fragmentu serii; seria musi być posortowana po czasie
+     */
+    SeriesSlice range(std::int64_t from, std::int64_t to) const;
+
+    /**
+     * @brief Konwertuje serię do wektora struktur Measurement
+     * @return Wektor pomiarów z datami w formacie GIOŚ
+     */
+    std::vector<Measurement> toMeasurements() const;
+
+    /**
+     * @brief Tworzy serię kolumnową z wektora struktur Measurement
+     * @param measurements Pomiary (pomiary z niepoprawną datą są pomijane)
+     * @return Seria kolumnowa w kolejności wejściowej
+     */
+    static MeasurementSeries fromMeasurements(const std::vector<Measurement>& measurements);
+};
+
+/**
+ * @brief Podstawowe statystyki serii pomiarowej
+ */
+struct SeriesStatistics {
+    std::size_t count = 0;          ///< Liczba pomiarów
+    double min = 0.0;               ///< Wartość minimalna
+    double max = 0.0;               ///< Wartość maksymalna
+    double mean = 0.0;              ///< Średnia arytmetyczna
+    std::int64_t firstTimestamp = 0; ///< Najwcześniejszy znacznik czasu
+    std::int64_t lastTimestamp = 0;  ///< Najpóźniejszy znacznik czasu
+    double lastValue = 0.0;          ///< Wartość najnowszego pomiaru
+};
+
+/**
+ * @brief Oblicza statystyki dla fragmentu kolumn serii
+ * @param timestamps Znaczniki czasu
+ * @param values Wartości
+ * @param count Liczba pomiarów
+ * @return Statystyki (count == 0 dla pustego zakresu)
+ */
+SeriesStatistics computeStatistics(const std::int64_t* timestamps, const double* values, std::size_t count);
+
+/**
+ * @brief Oblicza statystyki całej serii
+ */
+inline SeriesStatistics computeStatistics(const MeasurementSeries& series) {
+    return computeStatistics(series.timestamps.data(), series.values.data(), series.size());
+}
+
+/**
+ * @brief Oblicza statystyki fragmentu serii
+ */
+inline SeriesStatistics computeStatistics(const SeriesSlice& slice) {
+    return computeStatistics(slice.timestamps, slice.values, slice.count);
+}
+
+/**
+ * @brief Kilka serii na wspólnej osi czasu
+ *
+ * Kolumna i zawiera wartości serii i dla kolejnych znaczników czasu; brak pomiaru
+ * w danej chwili oznacza NaN.
+ */
+struct AlignedSeries {
+    std::vector<std::int64_t> timestamps;     ///< Suma znaczników czasu wszystkich serii (rosnąco, bez powtórzeń)
+    std::vector<std::vector<double>> columns; ///< Wartości każdej serii (NaN - brak pomiaru)
+};
+
+/**
+ * @brief Wyrównuje serie do wspólnej osi czasu scalaniem k-drożnym
+ * @param series Serie posortowane rosnąco po czasie
+ * @return Serie na wspólnej osi; przy powtórzonym czasie w jednej serii wygrywa ostatnia wartość
+ * @throws std::runtime_error jeśli któraś seria nie jest posortowana
+ * Złożoność O(N log k) dla N pomiarów w k seriach.
+ */
+AlignedSeries alignSeries(const std::vector<MeasurementSeries>& series);
+
+/**
+ * @brief Zmniejsza liczbę punktów do narysowania, zachowując minima i maksima
+ * @param timestamps Znaczniki czasu (rosnąco)
+ * @param values Wartości (NaN są pomijane)
+ * @param count Liczba pomiarów
+ * @param maxPoints Maksymalna liczba punktów wyniku (co najmniej 2)
+ * @return Seria o co najwyżej maxPoints punktach: minimum i maksimum każdego przedziału w kolejności czasu
+ */
+MeasurementSeries decimateMinMax(const std::int64_t* timestamps, const double* values,
+                                 std::size_t count, std::size_t maxPoints);
+
+#endif // MEASUREMENT_SERIES_HPP
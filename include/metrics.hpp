@@ -0,0 +1,243 @@
+/**
+ * @file metrics.hpp
+ * @brief Metryki klienta API: liczniki, histogramy opóźnień i eksport w formacie Prometheus
+ */
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Histogram opóźnień o stałej precyzji względnej (w stylu HDR)
+ *
+ * Wartości (w mikrosekundach) trafiają do kubełków logarytmiczno-liniowych:
+ * każdy przedział [2^k, 2^(k+1)) jest podzielony na 32 równe części, więc błąd
+ * względny odczytanego percentyla nie przekracza ok. 3%. Zapis jest bezblokadowy
+ * (liczniki atomowe), dzięki czemu histogram może być aktualizowany z wielu wątków.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;                      ///< log2 liczby podziałów przedziału
+    static constexpr int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;  ///< Podziały jednego przedziału
+    static constexpr int MAX_MAGNITUDE = 36;                       ///< Zakres wartości: do 2^36 µs (ok. 19 h)
+    static constexpr int BUCKET_COUNT = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    /**
+     * @brief Zapisuje pomiar
+     * @param micros Wartość w mikrosekundach
+     */
+    void record(std::uint64_t micros);
+
+    /**
+     * @brief Zwraca liczbę zapisanych pomiarów
+     */
+    std::uint64_t count() const { return total.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Zwraca sumę zapisanych wartości (µs)
+     */
+    std::uint64_t sum() const { return sumMicros.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Zwraca największą zapisaną wartość (µs)
+     */
+    std::uint64_t max() const { return maxMicros.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Zwraca percentyl
+     * @param percentile Percentyl z zakresu 0..100
+     * @return Górna granica kubełka zawierającego percentyl (µs), 0 dla pustego histogramu
+     */
+    std::uint64_t percentile(double percentile) const;
+
+    /**
+     * @brief Zwraca liczbę pomiarów nie większych niż podana wartość (przybliżenie do granicy kubełka)
+     * @param micros Próg w mikrosekundach
+     */
+    std::uint64_t countAtOrBelow(std::uint64_t micros) const;
+
+    /**
+     * @brief Zeruje histogram
+     */
+    void reset();
+
+    /**
+     * @brief Zwraca indeks kubełka dla wartości
+     */
+    static int bucketIndex(std::uint64_t micros);
+
+    /**
+     * @brief Zwraca największą wartość należącą do kubełka
+     */
+    static std::uint64_t bucketUpperBound(int index);
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets{};
+    std::atomic<std::uint64_t> total{0};
+    std::atomic<std::uint64_t> sumMicros{0};
+    std::atomic<std::uint64_t> maxMicros{0};
+};
+
+/**
+ * @brief Klasa endpointu API (metryki są agregowane per klasa, nie per ID)
+ */
+enum class EndpointClass {
+    Stations,       ///< /station/findAll
+    Sensors,        ///< /station/sensors/{id}
+    Measurements,   ///< /data/getData/{id}
+    Other,          ///< Pozostałe zapytania
+    Count
+};
+
+/**
+ * @brief Etap obsługi zapytania mierzony osobnym histogramem
+ */
+enum class RequestPhase {
+    Total,      ///< Całe zapytanie HTTP (curl)
+    Dns,        ///< Rozwiązywanie nazwy
+    Connect,    ///< Nawiązanie połączenia TCP
+    Tls,        ///< Negocjacja TLS
+    Wait,       ///< Oczekiwanie na pierwszy bajt odpowiedzi
+    Transfer,   ///< Odbiór treści odpowiedzi
+    Parse,      ///< Parsowanie JSON
+    Decode,     ///< Konwersja JSON na struktury aplikacji
+    Count
+};
+
+/**
+ * @brief Czasy etapów zapytania HTTP odczytane z curl_easy_getinfo (µs)
+ */
+struct RequestTimings {
+    std::uint64_t dns = 0;
+    std::uint64_t connect = 0;
+    std::uint64_t tls = 0;
+    std::uint64_t wait = 0;
+    std::uint64_t transfer = 0;
+    std::uint64_t total = 0;
+};
+
+/**
+ * @brief Zwraca nazwę klasy endpointu (etykieta w metrykach)
+ */
+const char* endpointClassName(EndpointClass endpointClass);
+
+/**
+ * @brief Zwraca nazwę etapu zapytania (etykieta w metrykach)
+ */
+const char* requestPhaseName(RequestPhase phase);
+
+/**
+ * @brief Przypisuje ścieżkę endpointu do klasy
+ * @param endpoint Ścieżka, np. "/data/getData/92"
+ */
+EndpointClass classifyEndpoint(const std::string& endpoint);
+
+/**
+ * @brief Metryki jednej klasy endpointów
+ */
+struct EndpointMetrics {
+    std::atomic<std::uint64_t> requests{0};     ///< Zapytania HTTP
+    std::atomic<std::uint64_t> failures{0};     ///< Zapytania zakończone błędem
+    std::atomic<std::uint64_t> bytes{0};        ///< Odebrane bajty treści (po dekompresji)
+    std::atomic<std::uint64_t> wireBytes{0};    ///< Bajty treści przesłane siecią (przed dekompresją)
+    std::atomic<std::uint64_t> connections{0};  ///< Nowo otwarte połączenia (pozostałe zapytania użyły istniejących)
+    std::atomic<std::uint64_t> http2Requests{0}; ///< Zapytania obsłużone przez HTTP/2
+    std::atomic<std::uint64_t> cacheHits{0};    ///< Odczyty obsłużone z cache
+    std::atomic<std::uint64_t> cacheMisses{0};  ///< Odczyty wymagające zapytania do API
+    std::atomic<std::uint64_t> coalesced{0};    ///< Wywołania dołączone do trwającego pobrania
+    std::atomic<std::uint64_t> retries{0};      ///< Ponowienia po błędzie przejściowym
+    std::atomic<std::uint64_t> hedged{0};       ///< Wysłane zapytania zapasowe
+    std::atomic<std::uint64_t> hedgeWins{0};    ///< Zapytania zapasowe, które odpowiedziały pierwsze
+    std::atomic<std::uint64_t> staleServed{0};  ///< Odczyty obsłużone nieaktualnymi danymi po błędzie API
+    std::atomic<std::uint64_t> breakerRejections{0}; ///< Zapytania odrzucone przez otwarty wyłącznik obwodu
+    std::array<LatencyHistogram, static_cast<int>(RequestPhase::Count)> phases; ///< Histogramy etapów
+
+    /**
+     * @brief Zwraca histogram etapu
+     */
+    LatencyHistogram& phase(RequestPhase p) { return phases[static_cast<int>(p)]; }
+    const LatencyHistogram& phase(RequestPhase p) const { return phases[static_cast<int>(p)]; }
+};
+
+/**
+ * @brief Zbiór metryk klienta API
+ *
+ * Wszystkie operacje zapisu są bezblokadowe i bezpieczne wątkowo. Odczyt w trakcie
+ * zapisu daje spójny obraz pojedynczych liczników (nie całego zbioru naraz).
+ */
+class ApiMetrics {
+public:
+    /**
+     * @brief Zwraca metryki klasy endpointów
+     */
+    EndpointMetrics& endpoint(EndpointClass endpointClass) {
+        return endpoints[static_cast<int>(endpointClass)];
+    }
+    const EndpointMetrics& endpoint(EndpointClass endpointClass) const {
+        return endpoints[static_cast<int>(endpointClass)];
+    }
+
+    /**
+     * @brief Zapisuje odczyt z cache
+     */
+    void recordCacheHit(EndpointClass endpointClass);
+
+    /**
+     * @brief Zapisuje odczyt, który wymagał zapytania do API
+     */
+    void recordCacheMiss(EndpointClass endpointClass);
+
+    /**
+     * @brief Zapisuje wywołanie obsłużone przez trwające już pobranie tych samych danych
+     */
+    void recordCoalesced(EndpointClass endpointClass);
+
+    /**
+     * @brief Zapisuje zakończone zapytanie HTTP
+     * @param endpointClass Klasa endpointu
+     * @param timings Czasy etapów
+     * @param bytes Liczba odebranych bajtów treści
+     * @param success Czy zapytanie się powiodło
+     */
+    void recordRequest(EndpointClass endpointClass, const RequestTimings& timings,
+                       std::uint64_t bytes, bool success);
+
+    /**
+     * @brief Zapisuje parametry transferu zakończonego zapytania
+     * @param endpointClass Klasa endpointu
+     * @param wireBytes Liczba bajtów treści przesłanych siecią (przed dekompresją)
+     * @param newConnection Czy zapytanie otworzyło nowe połączenie
+     * @param http2 Czy zapytanie zostało obsłużone przez HTTP/2
+     */
+    void recordTransfer(EndpointClass endpointClass, std::uint64_t wireBytes, bool newConnection, bool http2);
+
+    /**
+     * @brief Zapisuje czas pojedynczego etapu (np. parsowania)
+     */
+    void recordPhase(EndpointClass endpointClass, RequestPhase phase, std::uint64_t micros);
+
+    /**
+     * @brief Zeruje wszystkie metryki
+     */
+    void reset();
+
+    /**
+     * @brief Serializuje metryki w formacie tekstowym Prometheus
+     */
+    std::string toPrometheus() const;
+
+    /**
+     * @brief Zapisuje metryki w formacie Prometheus do pliku (atomowo, przez plik tymczasowy)
+     * @param path Ścieżka pliku
+     * @return true jeśli zapis się powiódł
+     */
+    bool writePrometheus(const std::string& path) const;
+
+private:
+    std::array<EndpointMetrics, static_cast<int>(EndpointClass::Count)> endpoints;
+};
+
+#endif // METRICS_HPP
@@ -0,0 +1,229 @@
+/**
+ * @file pollutant.hpp
+ * @brief Tabela parametrów mierzonych przez GIOŚ (stała czasu kompilacji)
+ */
+#ifndef POLLUTANT_HPP
+#define POLLUTANT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Typowany identyfikator parametru (substancji)
+ * Kolejność odpowiada kolejności w tabeli POLLUTANTS (Unknown nie ma wpisu).
+ */
+enum class Pollutant : std::uint8_t {
+    Unknown = 0,
+    SO2,
+    PM10,
+    O3,
+    NO2,
+    CO,
+    C6H6,
+    PM25
+};
+
+/**
+ * @brief Okres uśredniania stężenia
+ */
+enum class AveragingPeriod : std::uint8_t {
+    Hour,
+    EightHours,
+    Day,
+    Year
+};
+
+/**
+ * @brief Opis parametru: identyfikatory GIOŚ, jednostka, normy i progi indeksu jakości powietrza
+ */
+struct PollutantInfo {
+    Pollutant id;
+    int giosParamId;                ///< idParam w API GIOŚ
+    std::string_view code;          ///< paramCode w API GIOŚ
+    std::string_view formula;       ///< paramFormula w API GIOŚ
+    std::string_view name;          ///< paramName w API GIOŚ
+    std::string_view unit;          ///< Jednostka wartości zwracanych przez API
+    double limitValue;              ///< Poziom dopuszczalny (dla O3 - docelowy)
+    AveragingPeriod limitPeriod;    ///< Okres uśredniania poziomu dopuszczalnego
+    int allowedExceedances;         ///< Dopuszczalna liczba przekroczeń w roku
+    double annualLimit;             ///< Poziom dopuszczalny dla średniej rocznej (0 - brak)
+    std::array<double, 5> indexBreakpoints; ///< Górne granice klas indeksu (stężenia 1-godzinne)
+    std::string_view color;         ///< Kolor serii na wykresach (#rrggbb)
+};
+
+/**
+ * @brief Parametry GIOŚ: normy wg rozporządzenia w sprawie poziomów substancji w powietrzu,
+ * progi według Polskiego Indeksu Jakości Powietrza
+ */
+inline constexpr std::array<PollutantInfo, 7> POLLUTANTS = {{
+    {Pollutant::SO2, 1, "SO2", "SO2", "dwutlenek siarki", "µg/m³",
+     350.0, AveragingPeriod::Hour, 24, 0.0, {50.0, 100.0, 200.0, 350.0, 500.0}, "#8c564b"},
+    {Pollutant::PM10, 3, "PM10", "PM10", "pył zawieszony PM10", "µg/m³",
+     50.0, AveragingPeriod::Day, 35, 40.0, {20.0, 50.0, 80.0, 110.0, 150.0}, "#1f77b4"},
+    {Pollutant::O3, 5, "O3", "O3", "ozon", "µg/m³",
+     120.0, AveragingPeriod::EightHours, 25, 0.0, {70.0, 120.0, 150.0, 180.0, 240.0}, "#2ca02c"},
+    {Pollutant::NO2, 6, "NO2", "NO2", "dwutlenek azotu", "µg/m³",
+     200.0, AveragingPeriod::Hour, 18, 40.0, {40.0, 100.0, 150.0, 230.0, 400.0}, "#d62728"},
+    {Pollutant::CO, 8, "CO", "CO", "tlenek węgla", "µg/m³",
+     10000.0, AveragingPeriod::EightHours, 0, 0.0, {3000.0, 7000.0, 11000.0, 15000.0, 21000.0}, "#7f7f7f"},
+    {Pollutant::C6H6, 10, "C6H6", "C6H6", "benzen", "µg/m³",
+     5.0, AveragingPeriod::Year, 0, 5.0, {6.0, 11.0, 16.0, 21.0, 51.0}, "#9467bd"},
+    {Pollutant::PM25, 69, "PM2.5", "PM2.5", "pył zawieszony PM2.5", "µg/m³",
+     20.0, AveragingPeriod::Year, 0, 20.0, {13.0, 35.0, 55.0, 75.0, 110.0}, "#ff7f0e"},
+}};
+
+/**
+ * @brief Nazwy klas indeksu jakości powietrza (od 0 - najlepsza)
+ */
+inline constexpr std::array<std::string_view, 6> AIR_QUALITY_LEVELS = {
+    "Bardzo dobry", "Dobry", "Umiarkowany", "Dostateczny", "Zły", "Bardzo zły"
+};
+
+namespace pollutant_detail {
+
+// Wpis parametru o identyfikatorze N musi być na pozycji N-1 (zob. pollutantInfo)
+constexpr bool tableOrderMatchesIds() {
+    for (std::size_t i = 0; i < POLLUTANTS.size(); ++i) {
+        if (static_cast<std::size_t>(POLLUTANTS[i].id) != i + 1) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(tableOrderMatchesIds(), "Kolejnosc tabeli POLLUTANTS musi odpowiadac wartosciom Pollutant");
+
+constexpr std::uint32_t fnv1a(std::string_view text) {
+    std::uint32_t hash = 2166136261u;
+    for (char c : text) {
+        hash = (hash ^ static_cast<std::uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+constexpr std::uint32_t codeKey(const PollutantInfo& info) { return fnv1a(info.code); }
+constexpr std::uint32_t paramIdKey(const PollutantInfo& info) { return static_cast<std::uint32_t>(info.giosParamId); }
+
+// Najmniejszy moduł, dla którego klucze wszystkich parametrów trafiają do różnych pól (0 - brak)
+constexpr std::size_t findModulus(std::uint32_t (*keyOf)(const PollutantInfo&)) {
+    for (std::size_t modulus = POLLUTANTS.size(); modulus <= 64; ++modulus) {
+        bool collision = false;
+        for (std::size_t i = 0; i < POLLUTANTS.size() && !collision; ++i) {
+            for (std::size_t j = i + 1; j < POLLUTANTS.size(); ++j) {
+                if (keyOf(POLLUTANTS[i]) % modulus == keyOf(POLLUTANTS[j]) % modulus) {
+                    collision = true;
+                    break;
+                }
+            }
+        }
+        if (!collision) {
+            return modulus;
+        }
+    }
+    return 0;
+}
+
+inline constexpr std::size_t CODE_MODULUS = findModulus(codeKey);
+inline constexpr std::size_t PARAM_ID_MODULUS = findModulus(paramIdKey);
+static_assert(CODE_MODULUS != 0, "Brak doskonalej funkcji skrotu dla kodow parametrow");
+static_assert(PARAM_ID_MODULUS != 0, "Brak doskonalej funkcji skrotu dla idParam");
+
+inline constexpr std::uint8_t EMPTY_SLOT = 0xFF;
+
+// Pole -> indeks w POLLUTANTS
+template <std::size_t Modulus>
+constexpr std::array<std::uint8_t, Modulus> buildSlots(std::uint32_t (*keyOf)(const PollutantInfo&)) {
+    std::array<std::uint8_t, Modulus> slots{};
+    for (auto& slot : slots) {
+        slot = EMPTY_SLOT;
+    }
+    for (std::size_t i = 0; i < POLLUTANTS.size(); ++i) {
+        slots[keyOf(POLLUTANTS[i]) % Modulus] = static_cast<std::uint8_t>(i);
+    }
+    return slots;
+}
+
+inline constexpr auto CODE_SLOTS = buildSlots<CODE_MODULUS>(codeKey);
+inline constexpr auto PARAM_ID_SLOTS = buildSlots<PARAM_ID_MODULUS>(paramIdKey);
+
+} // namespace pollutant_detail
+
+/**
+ * @brief Zwraca opis parametru
+ * @param pollutant Identyfikator parametru
+ * @return Wpis tabeli lub nullptr dla Pollutant::Unknown
+ */
+constexpr const PollutantInfo* pollutantInfo(Pollutant pollutant) {
+    const auto index = static_cast<std::size_t>(pollutant);
+    return index == 0 || index > POLLUTANTS.size() ? nullptr : &POLLUTANTS[index - 1];
+}
+
+/**
+ * @brief Wyszukuje parametr po kodzie GIOŚ (paramCode), jednym porównaniem napisów
+ * @param code Kod parametru, np. "PM2.5"
+ * @return Identyfikator parametru lub Pollutant::Unknown
+ */
+constexpr Pollutant pollutantFromCode(std::string_view code) {
+    using namespace pollutant_detail;
+    const std::uint8_t slot = CODE_SLOTS[fnv1a(code) % CODE_MODULUS];
+    return slot != EMPTY_SLOT && POLLUTANTS[slot].code == code ? POLLUTANTS[slot].id : Pollutant::Unknown;
+}
+
+/**
+ * @brief Wyszukuje parametr po identyfikatorze GIOŚ (idParam)
+ * @param paramId Identyfikator parametru w API
+ * @return Identyfikator parametru lub Pollutant::Unknown
+ */
+constexpr Pollutant pollutantFromParamId(int paramId) {
+    using namespace pollutant_detail;
+    if (paramId <= 0) {
+        return Pollutant::Unknown;
+    }
+    const std::uint8_t slot = PARAM_ID_SLOTS[static_cast<std::uint32_t>(paramId) % PARAM_ID_MODULUS];
+    return slot != EMPTY_SLOT && POLLUTANTS[slot].giosParamId == paramId ? POLLUTANTS[slot].id : Pollutant::Unknown;
+}
+
+/**
+ * @brief Ustala parametr czujnika na podstawie idParam, a gdy jest nieznany - kodu parametru
+ */
+constexpr Pollutant resolvePollutant(int paramId, std::string_view code) {
+    const Pollutant byId = pollutantFromParamId(paramId);
+    return byId != Pollutant::Unknown ? byId : pollutantFromCode(code);
+}
+
+/**
+ * @brief Wyznacza klasę indeksu jakości powietrza dla stężenia 1-godzinnego
+ * @param pollutant Identyfikator parametru
+ * @param value Stężenie w jednostce parametru
+ * @return Indeks w AIR_QUALITY_LEVELS (0-5) lub -1 dla nieznanego parametru
+ */
+constexpr int airQualityIndex(Pollutant pollutant, double value) {
+    const PollutantInfo* info = pollutantInfo(pollutant);
+    if (!info) {
+        return -1;
+    }
+    int level = 0;
+    while (level < static_cast<int>(info->indexBreakpoints.size()) &&
+           value > info->indexBreakpoints[static_cast<std::size_t>(level)]) {
+        ++level;
+    }
+    return level;
+}
+
+/**
+ * @brief Zwraca opis okresu uśredniania
+ */
+constexpr std::string_view averagingPeriodName(AveragingPeriod period) {
+    switch (period) {
+        case AveragingPeriod::Hour: return "1h";
+        case AveragingPeriod::EightHours: return "8h";
+        case AveragingPeriod::Day: return "24h";
+        default: return "rok";
+    }
+}
+
+static_assert(pollutantFromCode("PM2.5") == Pollutant::PM25, "Niepoprawna tabela parametrow");
+static_assert(pollutantFromParamId(3) == Pollutant::PM10, "Niepoprawna tabela parametrow");
+
+#endif // POLLUTANT_HPP
@@ -0,0 +1,35 @@
+/**
+ * @file qt_executor.hpp
+ * @brief Wykonawca wznawiający korutyny w pętli zdarzeń Qt
+ */
+#ifndef QT_EXECUTOR_HPP
+#define QT_EXECUTOR_HPP
+
+#include <QMetaObject>
+#include <QObject>
+
+#include "executor.hpp"
+
+/**
+ * @brief Przekazuje pracę do wątku obiektu kontekstu (dla okna - wątku interfejsu)
+ *
+ * Praca jest wstawiana do kolejki zdarzeń, więc korutyna wznowiona po co_await może
+ * bezpiecznie modyfikować widgety. Po zniszczeniu kontekstu praca nie jest wykonywana.
+ */
+class QtExecutor : public Executor {
+public:
+    /**
+     * @brief Konstruktor
+     * @param context Obiekt, w którego wątku wykonywana jest praca
+     */
+    explicit QtExecutor(QObject* context) : context(context) {}
+
+    void post(std::function<void()> work) override {
+        QMetaObject::invokeMethod(context, std::move(work), Qt::QueuedConnection);
+    }
+
+private:
+    QObject* context;
+};
+
+#endif // QT_EXECUTOR_HPP
@@ -0,0 +1,138 @@
+/**
+ * @file resampler.hpp
+ * @brief Przeliczanie serii pomiarowych na regularną siatkę czasu (godzinową lub dobową)
+ */
+#ifndef RESAMPLER_HPP
+#define RESAMPLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "measurement_series.hpp"
+
+/**
+ * @brief Krok siatki czasu w sekundach
+ */
+enum class ResampleStep : std::int64_t {
+    Hour = 3600,
+    Day = 86400
+};
+
+/**
+ * @brief Sposób uzupełniania luk
+ */
+enum class GapFill {
+    None,     ///< Luki pozostają jako NaN
+    Linear,   ///< Interpolacja liniowa między sąsiednimi pomiarami
+    Previous  ///< Ostatnia znana wartość
+};
+
+/**
+ * @brief Luka w serii: kolejne puste węzły siatki między dwoma pomiarami
+ */
+struct SeriesGap {
+    std::size_t column;     ///< Indeks kolumny
+    std::size_t firstRow;   ///< Pierwszy pusty wiersz
+    std::size_t rowCount;   ///< Liczba pustych wierszy
+};
+
+/**
+ * @brief Serie na wspólnej, regularnej siatce czasu
+ *
+ * Wiersz i odpowiada chwili start + i * step. Każda kolumna jest ciągłą tablicą double
+ * o długości rows(), więc można ją przetwarzać w pętlach wektoryzowanych. Brak wartości to NaN.
+ */
+struct ResampledFrame {
+    std::int64_t start = 0;                   ///< Znacznik czasu pierwszego wiersza
+    std::int64_t step = 3600;                 ///< Krok siatki w sekundach
+    std::vector<std::string> names;           ///< Nazwy kolumn
+    std::vector<std::vector<double>> columns; ///< Wartości kolumn
+    std::vector<SeriesGap> gaps;              ///< Luki wykryte przed uzupełnieniem
+
+    std::size_t rows() const { return columns.empty() ? 0 : columns.front().size(); }
+    std::int64_t timestamp(std::size_t row) const { return start + static_cast<std::int64_t>(row) * step; }
+    const double* column(std::size_t index) const { return columns[index].data(); }
+};
+
+/**
+ * @brief Przyrostowe przeliczanie wielu serii na siatkę czasu
+ *
+ * Pomiary trafiają do węzła siatki zawierającego ich czas (dla kroku dobowego wartością
+ * jest średnia pomiarów z doby). Dla każdej kolumny pamiętany jest czas ostatniego
+ * przyjętego pomiaru: ponowne dodanie odpowiedzi API, która częściowo pokrywa się
+ * z poprzednią, dopisuje tylko nowe godziny, a przeliczane są wyłącznie dotknięte węzły.
+ */
+class Resampler {
+public:
+    /**
+     * @brief Tworzy pusty resampler
+     * @param step Krok siatki
+     */
+    explicit Resampler(ResampleStep step = ResampleStep::Hour);
+
+    /**
+     * @brief Dodaje kolumnę
+     * @param name Nazwa kolumny (np. kod parametru)
+     * @return Indeks kolumny
+     */
+    std::size_t addColumn(std::string name);
+
+    /**
+     * @brief Dodaje pomiary do kolumny
+     * @param column Indeks kolumny
+     * @param series Pomiary w dowolnej kolejności
+     * @return Liczba przyjętych pomiarów (nowszych niż ostatni przyjęty)
+     * @throws std::runtime_error dla nieistniejącej kolumny
+     */
+    std::size_t append(std::size_t column, const MeasurementSeries& series);
+
+    /**
+     * @brief Zwraca liczbę wierszy siatki
+     */
+    std::size_t rows() const { return sums.empty() ? 0 : sums.front().size(); }
+
+    /**
+     * @brief Tworzy ramkę z bieżącymi wartościami
+     * @param fill Sposób uzupełniania luk
+     * @param maxGapRows Najdłuższa uzupełniana luka (dłuższe pozostają jako NaN)
+     * @return Ramka z wykrytymi lukami
+     */
+    ResampledFrame frame(GapFill fill = GapFill::None,
+                         std::size_t maxGapRows = std::numeric_limits<std::size_t>::max()) const;
+
+    /**
+     * @brief Przelicza serie jednorazowo
+     * @param series Serie
+     * @param names Nazwy kolumn (tyle, ile serii)
+     * @param step Krok siatki
+     * @param fill Sposób uzupełniania luk
+     * @return Ramka ze wszystkimi seriami
+     */
+    static ResampledFrame resample(const std::vector<MeasurementSeries>& series, const std::vector<std::string>& names,
+                                   ResampleStep step = ResampleStep::Hour, GapFill fill = GapFill::None);
+
+private:
+    std::int64_t step;
+    std::int64_t start = 0;
+    std::vector<std::string> names;
+    std::vector<std::vector<double>> sums;        // Suma wartości w węźle
+    std::vector<std::vector<std::uint32_t>> counts; // Liczba pomiarów w węźle
+    std::vector<std::int64_t> watermarks;         // Czas ostatniego przyjętego pomiaru kolumny
+
+    std::int64_t snap(std::int64_t timestamp) const;
+    void ensureRange(std::int64_t first, std::int64_t last);
+};
+
+/**
+ * @brief Współczynnik korelacji Pearsona dwóch kolumn (pary z NaN są pomijane)
+ * @param a Pierwsza kolumna
+ * @param b Druga kolumna
+ * @param count Liczba wierszy
+ * @return Współczynnik z przedziału [-1, 1] lub NaN, jeśli par jest mniej niż dwie lub wariancja jest zerowa
+ */
+double pearsonCorrelation(const double* a, const double* b, std::size_t count);
+
+#endif // RESAMPLER_HPP
@@ -0,0 +1,65 @@
+/**
+ * @file response_decoder.hpp
+ * @brief Dekodowanie odpowiedzi API GIOŚ bez drzewa JSON, z pamięcią tymczasową w arenie
+ */
+#ifndef RESPONSE_DECODER_HPP
+#define RESPONSE_DECODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "api_client.hpp"
+
+/**
+ * @brief Czasy etapów dekodowania jednej odpowiedzi
+ */
+struct DecodeStats {
+    std::uint64_t parseMicros = 0; ///< Parsowanie SAX do rekordów tymczasowych w arenie
+    std::uint64_t copyMicros = 0;  ///< Kopiowanie wyników do pamięci trwałej
+};
+
+/**
+ * @brief Dekoder odpowiedzi /station/findAll, /station/sensors/{id} i /data/getData/{id}
+ *
+ * Odpowiedź jest parsowana strumieniowo (SAX). Wszystkie dane tymczasowe - stos kontekstów,
+ * ostatni klucz, rekordy pośrednie i ich napisy - trafiają do areny monotonicznej
+ * (std::pmr::monotonic_buffer_resource) o czasie życia jednej odpowiedzi, zwalnianej w całości
+ * naraz. Do pamięci trwałej kopiowane są tylko wyniki, z dokładnie zarezerwowanym miejscem.
+ * Wynik jest taki sam jak ApiClient::parseStations/parseSensors/parseMeasurements.
+ * Metody są bezstanowe i bezpieczne wątkowo.
+ */
+class ResponseDecoder {
+public:
+    /**
+     * @brief Dekoduje listę stacji
+     * @param data Treść odpowiedzi
+     * @param size Rozmiar treści w bajtach
+     * @param stats Opcjonalnie: czasy etapów dekodowania
+     * @return Wektor struktur Station
+     * @throws std::runtime_error jeśli treść nie jest poprawnym JSON
+     */
+    static std::vector<Station> decodeStations(const char* data, std::size_t size, DecodeStats* stats = nullptr);
+
+    /**
+     * @brief Dekoduje listę czujników stacji
+     * @param data Treść odpowiedzi
+     * @param size Rozmiar treści w bajtach
+     * @param stats Opcjonalnie: czasy etapów dekodowania
+     * @return Wektor struktur Sensor
+     * @throws std::runtime_error jeśli treść nie jest poprawnym JSON
+     */
+    static std::vector<Sensor> decodeSensors(const char* data, std::size_t size, DecodeStats* stats = nullptr);
+
+    /**
+     * @brief Dekoduje pomiary czujnika
+     * @param data Treść odpowiedzi
+     * @param size Rozmiar treści w bajtach
+     * @param stats Opcjonalnie: czasy etapów dekodowania
+     * @return Wektor struktur Measurement (bez pomiarów o wartości null)
+     * @throws std::runtime_error jeśli treść nie jest poprawnym JSON
+     */
+    static std::vector<Measurement> decodeMeasurements(const char* data, std::size_t size, DecodeStats* stats = nullptr);
+};
+
+#endif // RESPONSE_DECODER_HPP
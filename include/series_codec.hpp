@@ -0,0 +1,69 @@
+/**
+ * @file series_codec.hpp
+ * @brief Kompresja serii pomiarowych (delta-of-delta czasu, wartości dziesiętne lub XOR)
+ */
+#ifndef SERIES_CODEC_HPP
+#define SERIES_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "measurement_series.hpp"
+
+/**
+ * @brief Sposób zapisu wartości w bloku
+ */
+enum class ValueEncoding : std::uint8_t {
+    Decimal = 0, ///< Liczby całkowite po przeskalowaniu o 10^decimals, różnice upakowane bitowo
+    Xor = 1      ///< Bity double XOR poprzednia wartość (Gorilla) - dla wartości bez krótkiego zapisu dziesiętnego
+};
+
+/**
+ * @brief Koder i dekoder skompresowanych bloków serii
+ *
+ * Znaczniki czasu są zapisywane jako różnice drugiego rzędu (dla pomiarów godzinowych
+ * prawie zawsze 0), upakowane w ramki po 128 wartości o wspólnej szerokości bitowej.
+ * Wartości z co najwyżej 6 cyframi po przecinku (typowe dla GIOŚ) są zapisywane bezstratnie
+ * jako przeskalowane liczby całkowite w takich samych ramkach, a pozostałe kodowaniem XOR.
+ * Ramki są dekodowane bez rozgałęzień zależnych od danych, prosto do tablic kolumnowych.
+ * Liczby są zapisywane w kolejności bajtów little-endian.
+ */
+class SeriesCodec {
+public:
+    /**
+     * @brief Koduje serię do bloku
+     * @param timestamps Znaczniki czasu (w dowolnej kolejności)
+     * @param values Wartości
+     * @param count Liczba pomiarów
+     * @return Blok bajtów
+     */
+    static std::string encode(const std::int64_t* timestamps, const double* values, std::size_t count);
+
+    /**
+     * @brief Koduje serię do bloku
+     * @param series Seria
+     * @return Blok bajtów
+     */
+    static std::string encode(const MeasurementSeries& series) {
+        return encode(series.timestamps.data(), series.values.data(), series.size());
+    }
+
+    /**
+     * @brief Dekoduje blok do serii
+     * @param data Wskaźnik na blok
+     * @param size Rozmiar dostępnych danych (może być większy niż blok)
+     * @param consumed Wynik - rozmiar bloku w bajtach (opcjonalnie)
+     * @return Seria w kolejności zapisu
+     * @throws std::runtime_error dla uszkodzonego bloku
+     */
+    static MeasurementSeries decode(const char* data, std::size_t size, std::size_t* consumed = nullptr);
+
+    /**
+     * @brief Zwraca sposób zapisu wartości w bloku
+     * @throws std::runtime_error dla uszkodzonego bloku
+     */
+    static ValueEncoding valueEncoding(const char* data, std::size_t size);
+};
+
+#endif // SERIES_CODEC_HPP
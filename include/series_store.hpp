@@ -0,0 +1,134 @@
+/**
+ * @file series_store.hpp
+ * @brief Lokalne archiwum pomiarów: dziennik tylko do dopisywania z segmentami i indeksem min/max
+ */
+#ifndef SERIES_STORE_HPP
+#define SERIES_STORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "measurement_series.hpp"
+
+/**
+ * @brief Nagłówek segmentu dziennika (zapisywany na dysku, 64 bajty)
+ *
+ * Segment ma stałą pojemność; po nagłówku leżą kolumny znaczników czasu i wartości
+ * (każda na capacity elementów). Zakres czasu i wartości pozwala pominąć segment
+ * bez czytania jego danych.
+ */
+struct SegmentHeader {
+    std::uint32_t magic;      ///< Znacznik segmentu
+    std::uint32_t count;      ///< Liczba zapisanych pomiarów
+    std::int64_t firstTime;   ///< Czas pierwszego pomiaru
+    std::int64_t lastTime;    ///< Czas ostatniego pomiaru
+    double minValue;          ///< Najmniejsza wartość
+    double maxValue;          ///< Największa wartość
+    std::uint8_t reserved[24];
+};
+static_assert(sizeof(SegmentHeader) == 64, "Naglowek segmentu musi miec 64 bajty");
+
+/**
+ * @brief Wynik scalenia odpowiedzi API z dziennikiem
+ */
+struct StoreMergeResult {
+    std::size_t appended = 0;   ///< Dopisane pomiary
+    std::size_t duplicates = 0; ///< Pomiary już zapisane (ten sam znacznik czasu)
+    std::size_t late = 0;       ///< Pomiary starsze niż koniec dziennika, których w nim brak (pominięte)
+};
+
+/**
+ * @brief Archiwum pomiarów: jeden plik-dziennik na czujnik
+ *
+ * Dziennik jest ciągiem segmentów o stałym rozmiarze, a pomiary są w nim posortowane
+ * po czasie. Nowe pomiary trafiają zawsze na koniec: najpierw do wolnych miejsc ostatniego
+ * segmentu, potem do nowych segmentów. Nagłówek segmentu jest aktualizowany po zapisaniu
+ * danych, więc przerwany zapis nie zmienia widocznej zawartości. Odczyt odwzorowuje plik
+ * w pamięci i pomija segmenty spoza zakresu zapytania.
+ *
+ * Operacje na różnych czujnikach można wykonywać równolegle; zapisy do jednego czujnika
+ * muszą być szeregowane przez wywołującego.
+ */
+class SeriesStore {
+public:
+    /// Domyślna pojemność segmentu (ok. 6 tygodni pomiarów godzinowych, 16 KB)
+    static constexpr std::uint32_t DEFAULT_SEGMENT_CAPACITY = 1020;
+
+    /**
+     * @brief Tworzy archiwum w katalogu
+     * @param directory Katalog archiwum (tworzony przy pierwszym zapisie)
+     * @param segmentCapacity Pojemność segmentu nowych dzienników (istniejące zachowują swoją)
+     * @throws std::runtime_error dla zerowej pojemności
+     */
+    explicit SeriesStore(std::string directory, std::uint32_t segmentCapacity = DEFAULT_SEGMENT_CAPACITY);
+
+    /**
+     * @brief Scala pomiary z dziennikiem czujnika (deduplikacja po znaczniku czasu)
+     * @param sensorId ID czujnika
+     * @param series Pomiary w dowolnej kolejności (np. odpowiedź getData)
+     * @return Liczba dopisanych, powtórzonych i spóźnionych pomiarów
+     * @throws std::runtime_error jeśli dziennika nie można odczytać lub zapisać
+     */
+    StoreMergeResult merge(int sensorId, MeasurementSeries series) const;
+
+    /**
+     * @brief Scala pomiary z dziennikiem czujnika, wstawiając także pomiary spóźnione
+     * @param sensorId ID czujnika
+     * @param series Pomiary w dowolnej kolejności (np. z importowanych plików eksportu)
+     * @return Liczba dopisanych (w tym wstawionych w środek) i powtórzonych pomiarów; late == 0
+     * @throws std::runtime_error jeśli dziennika nie można odczytać lub zapisać
+     *
+     * Bez pomiarów spóźnionych działa jak merge. W przeciwnym razie dziennik jest budowany
+     * od nowa w pliku tymczasowym i podmieniany, więc czytelnicy widzą starą albo nową wersję.
+     */
+    StoreMergeResult backfill(int sensorId, MeasurementSeries series) const;
+
+    /**
+     * @brief Zwraca pomiary z zakresu czasu
+     * @param sensorId ID czujnika
+     * @param from Początek zakresu (włącznie)
+     * @param to Koniec zakresu (włącznie)
+     * @return Pomiary posortowane po czasie (pusta seria, jeśli dziennik nie istnieje)
+     * @throws std::runtime_error dla uszkodzonego dziennika
+     */
+    MeasurementSeries scan(int sensorId,
+                           std::int64_t from = std::numeric_limits<std::int64_t>::min(),
+                           std::int64_t to = std::numeric_limits<std::int64_t>::max()) const;
+
+    /**
+     * @brief Zwraca pomiary z zakresu czasu o wartości większej niż próg
+     * @param sensorId ID czujnika
+     * @param threshold Próg (np. norma dobowa)
+     * @param from Początek zakresu (włącznie)
+     * @param to Koniec zakresu (włącznie)
+     * @return Pomiary przekraczające próg, posortowane po czasie
+     * @throws std::runtime_error dla uszkodzonego dziennika
+     */
+    MeasurementSeries scanAbove(int sensorId, double threshold,
+                                std::int64_t from = std::numeric_limits<std::int64_t>::min(),
+                                std::int64_t to = std::numeric_limits<std::int64_t>::max()) const;
+
+    /**
+     * @brief Zwraca nagłówki segmentów dziennika czujnika
+     * @param sensorId ID czujnika
+     * @return Nagłówki w kolejności segmentów (puste, jeśli dziennik nie istnieje)
+     */
+    std::vector<SegmentHeader> segments(int sensorId) const;
+
+    /**
+     * @brief Zwraca ścieżkę dziennika czujnika
+     */
+    std::string logPath(int sensorId) const;
+
+private:
+    std::string directory;
+    std::uint32_t segmentCapacity;
+
+    template <typename Visitor>
+    void visitRange(int sensorId, std::int64_t from, std::int64_t to, Visitor&& visitor) const;
+};
+
+#endif // SERIES_STORE_HPP
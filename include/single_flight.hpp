@@ -0,0 +1,105 @@
+/**
+ * @file single_flight.hpp
+ * @brief Scalanie równoczesnych wywołań tej samej operacji (single-flight)
+ */
+#ifndef SINGLE_FLIGHT_HPP
+#define SINGLE_FLIGHT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+/**
+ * @brief Wykonuje operację raz dla wszystkich równoczesnych wywołań z tym samym kluczem
+ *
+ * Pierwsze wywołanie dla klucza (lider) wykonuje operację, a wywołania, które pojawią się
+ * zanim się zakończy, czekają na jej wynik zamiast powtarzać pracę. Wszyscy wywołujący
+ * otrzymują ten sam wynik albo ten sam wyjątek. Po zakończeniu operacji klucz jest
+ * zwalniany, więc kolejne wywołanie wykona ją ponownie (zapamiętywanie wyników
+ * pozostaje zadaniem cache wywołującego).
+ *
+ * @tparam Key Typ klucza (np. ID czujnika)
+ * @tparam Value Typ wyniku (kopiowany do każdego wywołującego)
+ */
+template <typename Key, typename Value>
+class SingleFlight {
+public:
+    /**
+     * @brief Wykonuje operację lub dołącza do trwającego wykonania
+     * @param key Klucz operacji
+     * @param operation Funkcja zwracająca Value
+     * @param joined Opcjonalnie: ustawiane na true, jeśli wynik pochodzi z cudzego wykonania
+     * @param deadline Termin oczekiwania na cudze wykonanie (lider nie jest przerywany)
+     * @return Wynik operacji
+     * @throws Wyjątek rzucony przez operację (każdemu wywołującemu)
+     * @throws std::runtime_error gdy cudze wykonanie nie zakończyło się przed terminem
+     */
+    template <typename Operation>
+    Value run(const Key& key, Operation&& operation, bool* joined = nullptr,
+              std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()) {
+        std::promise<Value> promise;
+        std::shared_future<Value> pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = calls.find(key);
+            if (it != calls.end()) {
+                pending = it->second;
+            } else {
+                calls.emplace(key, promise.get_future().share());
+            }
+        }
+
+        // Dołączenie do trwającego wykonania (oczekiwanie poza blokadą)
+        if (pending.valid()) {
+            joinedCalls.fetch_add(1, std::memory_order_relaxed);
+            if (joined) *joined = true;
+            if (deadline != std::chrono::steady_clock::time_point::max() &&
+                pending.wait_until(deadline) != std::future_status::ready) {
+                throw std::runtime_error("Przekroczono termin oczekiwania na trwajace pobranie");
+            }
+            return pending.get();
+        }
+        if (joined) *joined = false;
+
+        try {
+            Value value = operation();
+            promise.set_value(value);
+            release(key);
+            return value;
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+            release(key);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Zwraca liczbę wywołań obsłużonych przez cudze wykonanie (zaoszczędzonych operacji)
+     */
+    std::uint64_t joinedCount() const { return joinedCalls.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Zwraca liczbę trwających operacji
+     */
+    std::size_t inFlightCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return calls.size();
+    }
+
+private:
+    void release(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        calls.erase(key);
+    }
+
+    mutable std::mutex mutex;
+    std::unordered_map<Key, std::shared_future<Value>> calls;
+    std::atomic<std::uint64_t> joinedCalls{0};
+};
+
+#endif // SINGLE_FLIGHT_HPP
@@ -0,0 +1,42 @@
+/**
+ * @file station_comparison.hpp
+ * @brief Porównanie jednego parametru na wielu stacjach (wspólna oś czasu)
+ */
+#ifndef STATION_COMPARISON_HPP
+#define STATION_COMPARISON_HPP
+
+#include <string>
+#include <vector>
+
+#include "api_client.hpp"
+#include "measurement_series.hpp"
+
+/**
+ * @brief Wynik porównania: stacje z danymi i ich serie na wspólnej osi czasu
+ */
+struct StationComparison {
+    Pollutant pollutant = Pollutant::Unknown; ///< Porównywany parametr
+    std::vector<Station> stations;           ///< Stacje z pomiarami (kolejność kolumn)
+    std::vector<int> sensorIds;              ///< Czujnik parametru na każdej stacji
+    AlignedSeries aligned;                   ///< Pomiary na wspólnej osi czasu
+    std::vector<std::string> skipped;        ///< Nazwy stacji bez czujnika parametru lub bez pomiarów
+};
+
+/**
+ * @brief Pobiera pomiary jednego parametru z wielu stacji równolegle
+ */
+class StationComparisonLoader {
+public:
+    /**
+     * @brief Pobiera czujniki i pomiary stacji i wyrównuje serie do wspólnej osi czasu
+     * @param client Klient API (bezpieczny wątkowo)
+     * @param stations Porównywane stacje
+     * @param pollutant Porównywany parametr
+     * @param jobs Maksymalna liczba równoległych pobrań
+     * @return Wynik porównania w kolejności stacji wejściowych
+     */
+    static StationComparison load(ApiClient& client, const std::vector<Station>& stations,
+                                  Pollutant pollutant, int jobs = 8);
+};
+
+#endif // STATION_COMPARISON_HPP
@@ -0,0 +1,129 @@
+/**
+ * @file string_pool.hpp
+ * @brief Pula internowanych napisów dla powtarzających się pól (miasta, województwa, parametry)
+ */
+#ifndef STRING_POOL_HPP
+#define STRING_POOL_HPP
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @brief Globalna pula niezmiennych napisów
+ *
+ * Każda wartość jest przechowywana dokładnie raz, a jej adres nie zmienia się do końca
+ * działania programu. Pula tylko rośnie - jest przeznaczona dla pól o małej liczbie
+ * różnych wartości (16 województw, kilkaset miast, kilka parametrów), nie dla danych
+ * unikalnych, takich jak nazwy stacji czy adresy.
+ */
+class StringPool {
+public:
+    /**
+     * @brief Zwraca globalną pulę
+     */
+    static StringPool& instance();
+
+    /**
+     * @brief Zwraca wspólną kopię napisu, dodając go do puli przy pierwszym użyciu
+     * @param value Napis
+     * @return Wskaźnik ważny do końca działania programu
+     */
+    const std::string* intern(std::string_view value);
+
+    /**
+     * @brief Zwraca wspólny pusty napis
+     */
+    const std::string* empty() const { return emptyEntry; }
+
+    /**
+     * @brief Zwraca liczbę różnych napisów w puli
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Zwraca łączną długość napisów w puli (bajty)
+     */
+    std::size_t bytes() const;
+
+private:
+    StringPool();
+
+    mutable std::shared_mutex mutex;
+    std::deque<std::string> entries; // deque nie przenosi elementów przy dodawaniu
+    std::unordered_map<std::string_view, const std::string*> index;
+    std::size_t totalBytes = 0;
+    const std::string* emptyEntry;
+};
+
+/**
+ * @brief Napis internowany w globalnej puli
+ *
+ * Zajmuje jeden wskaźnik; porównanie i hash są operacjami na adresie, a nie na treści.
+ * Konwersja do const std::string& pozwala używać go tam, gdzie wcześniej był std::string.
+ * Porządek (operator<) jest leksykograficzny, aby sortowanie po nazwie działało jak dotąd.
+ */
+class InternedString {
+public:
+    InternedString() : value(StringPool::instance().empty()) {}
+    InternedString(std::string_view text) : value(StringPool::instance().intern(text)) {}
+    InternedString(const std::string& text) : InternedString(std::string_view(text)) {}
+    InternedString(const char* text) : InternedString(std::string_view(text)) {}
+
+    /**
+     * @brief Zwraca treść napisu
+     */
+    const std::string& str() const { return *value; }
+    operator const std::string&() const { return *value; }
+
+    const char* c_str() const { return value->c_str(); }
+    std::size_t size() const { return value->size(); }
+    bool empty() const { return value->empty(); }
+
+    /**
+     * @brief Zwraca identyfikator wartości (równy dla równych napisów)
+     */
+    std::size_t id() const { return reinterpret_cast<std::size_t>(value); }
+
+    friend bool operator==(const InternedString& a, const InternedString& b) { return a.value == b.value; }
+    friend bool operator!=(const InternedString& a, const InternedString& b) { return a.value != b.value; }
+    friend bool operator==(const InternedString& a, const std::string& b) { return *a.value == b; }
+    friend bool operator!=(const InternedString& a, const std::string& b) { return *a.value != b; }
+    friend bool operator==(const InternedString& a, const char* b) { return *a.value == b; }
+    friend bool operator!=(const InternedString& a, const char* b) { return *a.value != b; }
+    friend bool operator<(const InternedString& a, const InternedString& b) {
+        return a.value != b.value && *a.value < *b.value;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const InternedString& text) { return out << *text.value; }
+
+private:
+    const std::string* value;
+};
+
+// Serializacja nlohmann/json (wyszukiwana przez ADL)
+template <typename BasicJson>
+void to_json(BasicJson& j, const InternedString& text) {
+    j = text.str();
+}
+
+template <typename BasicJson>
+void from_json(const BasicJson& j, InternedString& text) {
+    text = InternedString(j.template get_ref<const std::string&>());
+}
+
+namespace std {
+template <>
+struct hash<InternedString> {
+    std::size_t operator()(const InternedString& text) const noexcept {
+        return std::hash<std::size_t>()(text.id());
+    }
+};
+} // namespace std
+
+#endif // STRING_POOL_HPP
@@ -0,0 +1,290 @@
+/**
+ * @file task.hpp
+ * @brief Korutyny C++20: leniwe zadanie Task<T>, oczekiwanie na wiele zadań i uruchamianie zadań
+ */
+#ifndef TASK_HPP
+#define TASK_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "logger.hpp"
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/**
+ * @brief Wspólna część obietnicy zadania: kontynuacja i wyjątek
+ */
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr error;
+
+    // Po zakończeniu sterowanie przechodzi wprost do oczekującej korutyny (bez rekurencji stosu)
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            return handle.promise().continuation;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& result) {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T result() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void result() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+/**
+ * @brief Korutyna uruchamiana od razu i niszcząca się sama po zakończeniu
+ */
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+} // namespace detail
+
+/**
+ * @brief Leniwe zadanie asynchroniczne zwracające T
+ *
+ * Ciało korutyny rusza dopiero przy co_await (albo w spawn/syncWait), a po zakończeniu
+ * wznawia korutynę oczekującą. Wyjątek rzucony w zadaniu jest przekazywany oczekującemu.
+ * Zadanie jest właścicielem ramki korutyny i można je tylko przenosić.
+ *
+ * @tparam T Typ wyniku (void - bez wyniku)
+ */
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    Task() = default;
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    // Obiekt oczekiwania: co_await task uruchamia zadanie i zwraca jego wynik
+    bool await_ready() const noexcept { return !handle || handle.done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    T await_resume() { return handle.promise().result(); }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief Licznik zadań whenAll; ostatnie zakończone zadanie wznawia oczekującego
+ */
+struct WhenAllCounter {
+    std::atomic<std::size_t> remaining;
+    std::coroutine_handle<> parent;
+
+    void arrive() {
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            parent.resume();
+        }
+    }
+};
+
+template <typename T>
+DetachedTask runAndArrive(Task<T> task, std::optional<T>& result, std::exception_ptr& error, WhenAllCounter& counter) {
+    try {
+        result.emplace(co_await std::move(task));
+    } catch (...) {
+        error = std::current_exception();
+    }
+    counter.arrive();
+}
+
+} // namespace detail
+
+/**
+ * @brief Uruchamia wszystkie zadania jednocześnie i czeka na ich zakończenie
+ * @param tasks Zadania (startują w kolejności, ale bez czekania jedno na drugie)
+ * @return Wyniki w kolejności zadań
+ * @throws Pierwszy (wg kolejności zadań) wyjątek, jeśli któreś zadanie się nie powiodło
+ */
+template <typename T>
+Task<std::vector<T>> whenAll(std::vector<Task<T>> tasks) {
+    static_assert(!std::is_void_v<T>, "whenAll wymaga zadan zwracajacych wynik");
+    std::vector<std::optional<T>> results(tasks.size());
+    std::vector<std::exception_ptr> errors(tasks.size());
+    detail::WhenAllCounter counter{tasks.size() + 1, nullptr};
+
+    struct StartAll {
+        std::vector<Task<T>>& tasks;
+        std::vector<std::optional<T>>& results;
+        std::vector<std::exception_ptr>& errors;
+        detail::WhenAllCounter& counter;
+
+        bool await_ready() const noexcept { return tasks.empty(); }
+        bool await_suspend(std::coroutine_handle<> handle) {
+            counter.parent = handle;
+            for (std::size_t i = 0; i < tasks.size(); ++i) {
+                detail::runAndArrive(std::move(tasks[i]), results[i], errors[i], counter);
+            }
+            // Dodatkowa jednostka licznika chroni przed wznowieniem, zanim wszystkie zadania wystartują
+            return counter.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+        }
+        void await_resume() const noexcept {}
+    };
+    co_await StartAll{tasks, results, errors, counter};
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    std::vector<T> values;
+    values.reserve(results.size());
+    for (auto& result : results) {
+        values.push_back(std::move(*result));
+    }
+    co_return values;
+}
+
+/**
+ * @brief Uruchamia zadanie bez oczekiwania na jego wynik
+ * @param task Zadanie; działa do końca niezależnie od wywołującego
+ *
+ * Zadanie startuje w bieżącym wątku i działa do pierwszego zawieszenia. Wyjątek,
+ * który wydostanie się z zadania, jest tylko zapisywany w dzienniku.
+ */
+inline void spawn(Task<void> task) {
+    [](Task<void> task) -> detail::DetachedTask {
+        try {
+            co_await std::move(task);
+        } catch (const std::exception& e) {
+            LOG_ERROR("async", "Nieobsluzony wyjatek w zadaniu: " << e.what());
+        }
+    }(std::move(task));
+}
+
+/**
+ * @brief Uruchamia zadanie i blokuje bieżący wątek do jego zakończenia
+ * @param task Zadanie
+ * @return Wynik zadania
+ * @throws Wyjątek rzucony przez zadanie
+ *
+ * Przeznaczone dla narzędzi wiersza poleceń i testów; nie wolno wywoływać z wątku
+ * wykonawcy, który wznawia to zadanie.
+ */
+template <typename T>
+T syncWait(Task<T> task) {
+    struct State {
+        std::mutex mutex;
+        std::condition_variable finished;
+        bool done = false;
+        std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> value;
+        std::exception_ptr error;
+    } state;
+
+    [](Task<T> task, State& state) -> detail::DetachedTask {
+        std::exception_ptr error;
+        std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> value;
+        try {
+            if constexpr (std::is_void_v<T>) {
+                co_await std::move(task);
+                value.emplace(true);
+            } else {
+                value.emplace(co_await std::move(task));
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // Powiadomienie pod blokadą: wywołujący nie zniszczy stanu, zanim blokada zostanie zwolniona
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.value = std::move(value);
+        state.error = error;
+        state.done = true;
+        state.finished.notify_all();
+    }(std::move(task), state);
+
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.finished.wait(lock, [&state]() { return state.done; });
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*state.value);
+    }
+}
+
+#endif // TASK_HPP
@@ -0,0 +1,161 @@
+/**
+ * @file trace.hpp
+ * @brief Lekkie śledzenie zakresów (spans) z zapisem w formacie Chrome trace-event
+ *
+ * Śledzenie włącza zmienna środowiskowa AIRQUALITY_TRACE zawierająca ścieżkę pliku
+ * wynikowego (albo wywołanie Tracer::enable). Zdarzenia trafiają do buforów
+ * cyklicznych per wątek, a plik JSON jest zapisywany przy zakończeniu procesu
+ * (lub jawnie przez Tracer::writeChromeTrace) i można go otworzyć w
+ * chrome://tracing albo ui.perfetto.dev.
+ */
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+/**
+ * @brief Globalny rejestr zdarzeń śledzenia
+ */
+class Tracer {
+public:
+    static constexpr std::size_t DEFAULT_BUFFER_CAPACITY = 16384; ///< Liczba zdarzeń w buforze jednego wątku
+
+    /**
+     * @brief Sprawdza, czy śledzenie jest włączone
+     *
+     * Przy pierwszym wywołaniu odczytuje zmienną AIRQUALITY_TRACE. Kolejne wywołania
+     * to jeden odczyt zmiennej atomowej.
+     */
+    static bool enabled() {
+        int state = enabledState.load(std::memory_order_relaxed);
+        if (state < 0) {
+            state = initializeFromEnvironment();
+        }
+        return state > 0;
+    }
+
+    /**
+     * @brief Włącza śledzenie
+     * @param outputPath Plik zapisywany przy zakończeniu procesu (pusty - bez automatycznego zapisu)
+     * @param bufferCapacity Pojemność bufora cyklicznego każdego wątku
+     */
+    static void enable(const std::string& outputPath = std::string(),
+                       std::size_t bufferCapacity = DEFAULT_BUFFER_CAPACITY);
+
+    /**
+     * @brief Wyłącza śledzenie (zebrane zdarzenia pozostają w buforach)
+     */
+    static void disable();
+
+    /**
+     * @brief Nadaje nazwę bieżącemu wątkowi (widoczną w przeglądarce śladów)
+     */
+    static void setThreadName(const std::string& name);
+
+    /**
+     * @brief Zwraca czas w mikrosekundach od początku śledzenia
+     */
+    static std::uint64_t now();
+
+    /**
+     * @brief Zapisuje zakończony zakres w buforze bieżącego wątku
+     * @param name Nazwa zakresu (literał o statycznym czasie życia)
+     * @param detail Dodatkowy opis (np. endpoint), może być pusty
+     * @param start Początek zakresu (µs, z Tracer::now)
+     * @param duration Czas trwania (µs)
+     */
+    static void record(const char* name, std::string detail, std::uint64_t start, std::uint64_t duration);
+
+    /**
+     * @brief Zwraca liczbę zdarzeń przechowywanych we wszystkich buforach
+     */
+    static std::size_t eventCount();
+
+    /**
+     * @brief Usuwa wszystkie zebrane zdarzenia
+     */
+    static void clear();
+
+    /**
+     * @brief Serializuje zebrane zdarzenia do formatu Chrome trace-event (JSON)
+     */
+    static std::string toChromeTrace();
+
+    /**
+     * @brief Zapisuje zebrane zdarzenia do pliku JSON
+     * @param path Ścieżka pliku
+     * @return true jeśli zapis się powiódł
+     */
+    static bool writeChromeTrace(const std::string& path);
+
+private:
+    static int initializeFromEnvironment();
+
+    static std::atomic<int> enabledState; ///< -1: nieustalony, 0: wyłączony, 1: włączony
+};
+
+/**
+ * @brief Zakres śledzenia mierzony od konstrukcji do destrukcji obiektu
+ *
+ * Gdy śledzenie jest wyłączone, konstruktor i destruktor sprowadzają się do
+ * sprawdzenia jednej flagi.
+ */
+class TraceScope {
+public:
+    /**
+     * @brief Rozpoczyna zakres
+     * @param name Nazwa zakresu (literał o statycznym czasie życia)
+     */
+    explicit TraceScope(const char* name)
+        : name(name), start(0), active(Tracer::enabled()) {
+        if (active) {
+            start = Tracer::now();
+        }
+    }
+
+    ~TraceScope() {
+        if (active) {
+            Tracer::record(name, std::move(detail), start, Tracer::now() - start);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    /**
+     * @brief Sprawdza, czy zakres jest rejestrowany
+     */
+    bool isActive() const { return active; }
+
+    /**
+     * @brief Ustawia opis zakresu (widoczny jako argument zdarzenia)
+     */
+    void setDetail(std::string value) { detail = std::move(value); }
+
+private:
+    const char* name;
+    std::string detail;
+    std::uint64_t start;
+    bool active;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Śledzi zakres do końca bieżącego bloku
+ */
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
+
+/**
+ * @brief Śledzi zakres z opisem; wyrażenie opisu jest obliczane tylko przy włączonym śledzeniu
+ */
+#define TRACE_SCOPE_DETAIL(name, detailExpr)                                   \
+    TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name);                      \
+    if (TRACE_CONCAT(traceScope_, __LINE__).isActive())                        \
+        TRACE_CONCAT(traceScope_, __LINE__).setDetail(detailExpr)
+
+#endif // TRACE_HPP
@@ -1,29 +1,43 @@
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QIcon>
 #include <QSplashScreen>
-#include <QTimer>
+#include "logger.hpp"
 #include "main_window.hpp"
 
 int main(int argc, char *argv[]) {
+    // Czas uruchamiania liczony od początku programu
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+
     QApplication app(argc, argv);
-    
+
     // Ustawienie informacji o aplikacji
     QApplication::setApplicationName("Monitor Jakości Powietrza");
     QApplication::setApplicationVersion("1.0");
-    
+
     // Ustawienie ikony aplikacji
     app.setWindowIcon(QIcon("../icons/app_icon.png"));
-    
-    // Ekran powitalny
+
+    // Ekran powitalny (narysowany przed budową głównego okna)
     QSplashScreen splash(QPixmap("../welcome.png"));
     splash.show();
-    
+    app.processEvents();
+
     // Inicjalizacja głównego okna
     MainWindow mainWindow;
-    
-    // Pokazanie głównego okna po krótkim opóźnieniu
-    QTimer::singleShot(1500, &splash, &QSplashScreen::close);
-    QTimer::singleShot(1500, &mainWindow, &MainWindow::show);
-    
+
+    // Pomiar czasu do pierwszej klatki i do gotowości okna (wczytana lista stacji)
+    QObject::connect(&mainWindow, &MainWindow::firstFrameShown, [&startupTimer]() {
+        LOG_INFO("startup", "Pierwsza klatka okna po " << startupTimer.elapsed() << " ms");
+    });
+    QObject::connect(&mainWindow, &MainWindow::interactive, [&startupTimer]() {
+        LOG_INFO("startup", "Okno gotowe do pracy po " << startupTimer.elapsed() << " ms");
+    });
+
+    // Okno jest pokazywane od razu po zbudowaniu; ekran powitalny znika, gdy okno się pojawi
+    mainWindow.show();
+    splash.finish(&mainWindow);
+
     return app.exec();
-}
\ No newline at end of file
+}
@@ -4,37 +4,97 @@
  */
 
  #include "api_client.hpp"
+ #include "http_transfer.hpp"
+ #include "logger.hpp"
+ #include "response_decoder.hpp"
+ #include "trace.hpp"
  #include <curl/curl.h>
+ #include <algorithm>
+ #include <chrono>
+ #include <cstdlib>
  #include <fstream>
- #include <iostream>
+ #include <mutex>
+ #include <random>
  #include <stdexcept>
+ #include <thread>
  #include <unordered_map>
  
- // Definicje kodów kolorów ANSI
- #define COLOR_RESET   "\033[0m"
- #define COLOR_RED     "\033[31m"
- #define COLOR_GREEN   "\033[32m"
- #define COLOR_YELLOW  "\033[33m"
- #define COLOR_BLUE    "\033[34m"
- #define COLOR_MAGENTA "\033[35m"
- #define COLOR_CYAN    "\033[36m"
- 
- // Funkcja pomocnicza do zapisywania odpowiedzi z libcurl
- static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp){
-     ((std::string*)userp)->append((char*)contents, size * nmemb);
-     return size * nmemb;
- }
  
- ApiClient::ApiClient() : verbose(true){
+ namespace {
+ // Pojedynczy transfer HTTP w ramach jednej próby zapytania
+ struct Transfer {
+     CURL* handle = nullptr;
+     std::string buffer;
+     bool hedge = false;
+ };
+ } // namespace
+ 
+ // Współdzielona pula połączeń: kolejne zapytania (także z innych wątków) używają otwartych połączeń
+ struct ApiClient::ConnectionPool {
+     CURLSH* share = nullptr;
+     std::mutex locks[CURL_LOCK_DATA_LAST];
+     
+     ConnectionPool() {
+         share = curl_share_init();
+         if (!share) {
+             throw std::runtime_error("Blad inicjalizacji wspoldzielonych polaczen libcurl");
+         }
+         curl_share_setopt(share, CURLSHOPT_LOCKFUNC, &ConnectionPool::lock);
+         curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, &ConnectionPool::unlock);
+         curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+         curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+         curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+         curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+     }
+     
+     ~ConnectionPool() {
+         curl_share_cleanup(share);
+     }
+     
+     static void lock(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+         static_cast<ConnectionPool*>(userptr)->locks[data].lock();
+     }
+     
+     static void unlock(CURL*, curl_lock_data data, void* userptr) {
+         static_cast<ConnectionPool*>(userptr)->locks[data].unlock();
+     }
+ };
+ 
+ // Domyślny adres API GIOŚ
+ static const char* const DEFAULT_BASE_URL = "http://api.gios.gov.pl/pjp-api/rest";
+ 
+ ApiClient::ApiClient(const std::string& baseUrl)
+     : verbose(true), breaker(requestPolicy.breakerFailureThreshold, requestPolicy.breakerOpenDuration){
      curl_global_init(CURL_GLOBAL_DEFAULT);
-     baseUrl = "http://api.gios.gov.pl/pjp-api/rest";
-     if (verbose) std::cout << COLOR_CYAN << "Inicjalizacja API z URL: " << baseUrl << COLOR_RESET << std::endl;
+     connectionPool = std::make_unique<ConnectionPool>();
+     const char* envUrl = std::getenv("AIRQUALITY_API_URL");
+     if (!baseUrl.empty()) {
+         setBaseUrl(baseUrl);
+     } else if (envUrl && *envUrl) {
+         setBaseUrl(envUrl);
+     } else {
+         setBaseUrl(DEFAULT_BASE_URL);
+     }
+     if (verbose) LOG_INFO("api", "Inicjalizacja API z URL: " << this->baseUrl);
  }
  
  ApiClient::~ApiClient(){
+     // Pula musi zostać zwolniona przed curl_global_cleanup
+     connectionPool.reset();
      curl_global_cleanup();
  }
 
+ void ApiClient::setBaseUrl(const std::string& url){
+     baseUrl = url;
+     while (!baseUrl.empty() && baseUrl.back() == '/') {
+         baseUrl.pop_back();
+     }
+ }
+ 
+ const std::string& ApiClient::getBaseUrl() const{
+     return baseUrl;
+ }
+ 
  void ApiClient::setVerbose(bool enabled){
      verbose = enabled;
  }
@@ -43,89 +103,213 @@
      return verbose;
  }
  
- json ApiClient::makeRequest(const std::string& endpoint){
-     // Sprawdź cache
-     auto cacheIt = responseCache.find(endpoint);
-     if (cacheIt != responseCache.end()) {
-         if (verbose) std::cout << COLOR_BLUE << "Uzywam danych z cache dla: " << endpoint << COLOR_RESET << std::endl;
-         return cacheIt->second;
-     }
+ void ApiClient::setRequestPolicy(const RequestPolicy& policy){
+     std::lock_guard<std::mutex> lock(policyMutex);
+     requestPolicy = policy;
+     breaker.configure(policy.breakerFailureThreshold, policy.breakerOpenDuration);
+ }
+ 
+ RequestPolicy ApiClient::getRequestPolicy() const{
+     std::lock_guard<std::mutex> lock(policyMutex);
+     return requestPolicy;
+ }
+ 
+ CircuitBreaker::State ApiClient::getCircuitState() const{
+     return breaker.state();
+ }
+ 
+ std::string ApiClient::makeRequest(const std::string& endpoint, std::chrono::steady_clock::time_point deadline){
+     TRACE_SCOPE_DETAIL("ApiClient::makeRequest", endpoint);
+     const EndpointClass endpointClass = classifyEndpoint(endpoint);
+     metrics.recordCacheMiss(endpointClass);
      
-     CURL* curl;
-     CURLcode res;
+     const RequestPolicy policy = getRequestPolicy();
      std::string readBuffer;
-     json responseJson;
- 
-     curl = curl_easy_init();
-     if (!curl) {
-         throw std::runtime_error("Blad inicjalizacji libcurl");
+     
+     // Ponowienia z wykładniczym opóźnieniem i pełnym losowym rozrzutem, w granicach terminu
+     for (int attempt = 0; ; ++attempt) {
+         if (!breaker.allowRequest()) {
+             metrics.endpoint(endpointClass).breakerRejections.fetch_add(1, std::memory_order_relaxed);
+             throw std::runtime_error("API oznaczone jako niedostepne (obwod otwarty), zapytanie nie zostalo wyslane");
+         }
+         
+         bool retryable = false;
+         bool upstreamFailure = false;
+         std::string errorMsg = performAttempt(endpoint, deadline, policy, readBuffer, retryable, upstreamFailure);
+         if (errorMsg.empty()) {
+             breaker.recordSuccess();
+             break;
+         }
+         // Błędy klienta (np. 404) nie świadczą o awarii API
+         if (upstreamFailure) {
+             breaker.recordFailure();
+         } else {
+             breaker.recordSuccess();
+         }
+         
+         if (!retryable || attempt >= policy.maxRetries) {
+             LOG_ERROR("api", errorMsg);
+             throw std::runtime_error(errorMsg);
+         }
+         
+         const auto delay = retryDelay(policy, attempt);
+         if (std::chrono::steady_clock::now() + delay >= deadline) {
+             errorMsg += " (brak czasu na ponowienie przed terminem)";
+             LOG_ERROR("api", errorMsg);
+             throw std::runtime_error(errorMsg);
+         }
+         metrics.endpoint(endpointClass).retries.fetch_add(1, std::memory_order_relaxed);
+         LOG_WARNING("api", errorMsg << " - ponowienie " << attempt + 1 << "/" << policy.maxRetries
+                     << " za " << delay.count() << " ms");
+         std::this_thread::sleep_for(delay);
      }
+     
+     // Wyświetlenie odpowiedzi
+     if (verbose) LOG_DEBUG("api", "Otrzymana odpowiedz (pierwsze 50 znakow): " << readBuffer.substr(0, 50) << "...");
+     
+     if (readBuffer.empty()) {
+         throw std::runtime_error("Pusta odpowiedz z API");
+     }
+     return readBuffer;
+ }
  
-     std::string url = baseUrl + endpoint;
-     if (verbose) std::cout << COLOR_BLUE << "Wykonywanie zapytania do: " << url << COLOR_RESET << std::endl;
+ std::string ApiClient::performAttempt(const std::string& endpoint, std::chrono::steady_clock::time_point deadline,
+                                       const RequestPolicy& policy, std::string& body,
+                                       bool& retryable, bool& upstreamFailure){
+     const EndpointClass endpointClass = classifyEndpoint(endpoint);
+     retryable = false;
+     upstreamFailure = false;
      
-     curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-     curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10);
-     curl_easy_setopt(curl, CURLOPT_USERAGENT, "AirQualityApp/1.0");
+     auto start = std::chrono::steady_clock::now();
+     if (start >= deadline) {
+         return "Przekroczono termin zapytania do: " + endpoint;
+     }
      
-     // Opcjonalnie wyłączenie weryfikacji SSL bo do raspberry
-     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
-     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+     // Zapytanie zapasowe jest wysyłane, gdy odpowiedź trwa dłużej niż zwykle (percentyl czasu całkowitego)
+     auto hedgeAt = std::chrono::steady_clock::time_point::max();
+     if (policy.hedging) {
+         const LatencyHistogram& totals = metrics.endpoint(endpointClass).phase(RequestPhase::Total);
+         std::chrono::milliseconds hedgeDelay = policy.initialHedgeDelay;
+         if (totals.count() >= policy.hedgeMinSamples) {
+             hedgeDelay = std::max(policy.minHedgeDelay, std::chrono::milliseconds(
+                 (totals.percentile(policy.hedgePercentile) + 999) / 1000));
+         }
+         hedgeAt = start + hedgeDelay;
+     }
      
-     // Wykonanie zapytania
-     res = curl_easy_perform(curl);
+     const std::string url = baseUrl + endpoint;
+     if (verbose) LOG_DEBUG("api", "Wykonywanie zapytania do: " << url);
+     TRACE_SCOPE_DETAIL("http", url);
      
-     // Sprawdzenie czy zapytanie się powiodło
-     if (res != CURLE_OK) {
-         std::string errorMsg = "Blad podczas wykonywania zapytania: " + std::string(curl_easy_strerror(res));
-         std::cerr << COLOR_RED << errorMsg << COLOR_RESET << std::endl;
-         curl_easy_cleanup(curl);
-         throw std::runtime_error(errorMsg);
+     CURLM* multi = curl_multi_init();
+     if (!multi) {
+         throw std::runtime_error("Blad inicjalizacji libcurl");
      }
      
-     // Wyświetlenie odpowiedzi
-     if (verbose) std::cout << COLOR_GREEN << "Otrzymana odpowiedz (pierwsze 50 znakow): " << COLOR_RESET 
-               << readBuffer.substr(0, 50) << "..." << std::endl;
+     // Najwyżej dwa równoległe transfery: podstawowy i zapasowy
+     Transfer transfers[2];
+     int started = 0;
+     int pending = 0;
+     auto startTransfer = [&](bool hedge) {
+         Transfer& transfer = transfers[started];
+         transfer.hedge = hedge;
+         transfer.handle = createTransfer(url, transfer.buffer, std::chrono::duration_cast<std::chrono::milliseconds>(
+             deadline - std::chrono::steady_clock::now()), policy, connectionPool->share);
+         if (!transfer.handle) {
+             return false;
+         }
+         curl_multi_add_handle(multi, transfer.handle);
+         ++started;
+         ++pending;
+         return true;
+     };
      
-     // Czyszczenie zasobów
-     curl_easy_cleanup(curl);
+     std::string errorMsg;
+     Transfer* winner = nullptr;
+     if (!startTransfer(false)) {
+         curl_multi_cleanup(multi);
+         throw std::runtime_error("Blad inicjalizacji libcurl");
+     }
      
-     try {
-         if (readBuffer.empty()) {
-             throw std::runtime_error("Pusta odpowiedz z API");
+     while (!winner) {
+         int running = 0;
+         curl_multi_perform(multi, &running);
+         
+         int queued = 0;
+         while (CURLMsg* message = curl_multi_info_read(multi, &queued)) {
+             if (message->msg != CURLMSG_DONE) {
+                 continue;
+             }
+             Transfer* transfer = transfers[0].handle == message->easy_handle ? &transfers[0] : &transfers[1];
+             --pending;
+             recordTransferInfo(metrics, endpointClass, transfer->handle);
+             if (message->data.result == CURLE_OK) {
+                 winner = transfer;
+                 break;
+             }
+             metrics.recordRequest(endpointClass, readTimings(transfer->handle), transfer->buffer.size(), false);
+             errorMsg = describeFailure(transfer->handle, message->data.result, retryable, upstreamFailure);
+         }
+         if (winner || pending == 0) {
+             break;
          }
-         responseJson = json::parse(readBuffer);
          
-         // Zapisz do cache
-         responseCache[endpoint] = responseJson;
+         auto now = std::chrono::steady_clock::now();
+         if (now >= deadline) {
+             errorMsg = "Przekroczono termin zapytania do: " + url;
+             retryable = false;
+             upstreamFailure = true;
+             break;
+         }
+         if (started == 1 && now >= hedgeAt) {
+             if (startTransfer(true)) {
+                 metrics.endpoint(endpointClass).hedged.fetch_add(1, std::memory_order_relaxed);
+                 if (verbose) LOG_DEBUG("api", "Wysylanie zapytania zapasowego do: " << url);
+             } else {
+                 hedgeAt = std::chrono::steady_clock::time_point::max();
+             }
+         }
          
-     } catch (const json::parse_error& e) {
-         std::string errorMsg = "Blad parsowania JSON: " + std::string(e.what()) + "\nOdpowiedz: " + readBuffer;
-         std::cerr << COLOR_RED << errorMsg << COLOR_RESET << std::endl;
-         throw std::runtime_error(errorMsg);
+         // Oczekiwanie na aktywność do najbliższego terminu (koniec lub wysłanie zapasowego zapytania)
+         auto wakeAt = started == 1 ? std::min(deadline, hedgeAt) : deadline;
+         auto waitMs = std::chrono::duration_cast<std::chrono::milliseconds>(wakeAt - now).count() + 1;
+         curl_multi_poll(multi, nullptr, 0, static_cast<int>(waitMs), nullptr);
      }
      
-     return responseJson;
+     if (winner) {
+         body = std::move(winner->buffer);
+         metrics.recordRequest(endpointClass, readTimings(winner->handle), body.size(), true);
+         if (winner->hedge) {
+             metrics.endpoint(endpointClass).hedgeWins.fetch_add(1, std::memory_order_relaxed);
+         }
+     }
+     
+     // Przerwanie i zwolnienie pozostałych transferów
+     for (int i = 0; i < started; ++i) {
+         curl_multi_remove_handle(multi, transfers[i].handle);
+         curl_easy_cleanup(transfers[i].handle);
+     }
+     curl_multi_cleanup(multi);
+     return winner ? std::string() : errorMsg;
  }
  
  bool ApiClient::isApiAvailable() {
      try {
-         if (verbose) std::cout << COLOR_CYAN << "Sprawdzanie dostepnosci API..." << COLOR_RESET << std::endl;
+         if (verbose) LOG_DEBUG("api", "Sprawdzanie dostepnosci API...");
          
          // Inicjalizacja CURL
          CURL* curl = curl_easy_init();
          if (!curl) {
-             std::cerr << COLOR_RED << "Nie mozna zainicjalizowac CURL" << COLOR_RESET << std::endl;
+             LOG_ERROR("api", "Nie mozna zainicjalizowac CURL");
              return false;
          }
          
          // Przygotowanie zapytania
          std::string url = baseUrl + "/station/findAll";
-         if (verbose) std::cout << COLOR_CYAN << "Testowanie URL: " << url << COLOR_RESET << std::endl;
+         if (verbose) LOG_DEBUG("api", "Testowanie URL: " << url);
          
          curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+         curl_easy_setopt(curl, CURLOPT_SHARE, connectionPool->share); // Połączenie zostaje dla kolejnych zapytań
          curl_easy_setopt(curl, CURLOPT_NOBODY, 1L); // Tylko nagłówek odpowiedzi
          curl_easy_setopt(curl, CURLOPT_TIMEOUT, 5L); // 5 sekund timeout
          curl_easy_setopt(curl, CURLOPT_USERAGENT, "AirQualityApp/1.0");
@@ -146,78 +330,125 @@
          bool success = (res == CURLE_OK && http_code == 200);
          if (verbose) {
              if (success) {
-                 std::cout << COLOR_GREEN << "API dostepne: TAK, kod HTTP: " << http_code << COLOR_RESET << std::endl;
+                 LOG_INFO("api", "API dostepne: TAK, kod HTTP: " << http_code);
              } else {
-                 std::cout << COLOR_RED << "API niedostepne, kod HTTP: " << http_code << COLOR_RESET << std::endl;
+                 LOG_WARNING("api", "API niedostepne, kod HTTP: " << http_code);
              }
          }
          return success;
      } catch (const std::exception& e) {
-         std::cerr << COLOR_RED << "Blad podczas sprawdzania dostepnosci API: " << e.what() << COLOR_RESET << std::endl;
+         LOG_ERROR("api", "Blad podczas sprawdzania dostepnosci API: " << e.what());
          return false;
      }
  }
  
  void ApiClient::clearCache() {
-     responseCache.clear();
+     std::lock_guard<std::mutex> lock(cacheMutex);
+     // Usunięte dane pozostają jako nieaktualne na wypadek niedostępności API
+     if (!cachedStations.empty()) {
+         staleStations = std::move(cachedStations);
+     }
+     for (auto& entry : sensorCache) {
+         staleSensors[entry.first] = std::move(entry.second);
+     }
+     for (auto& entry : measurementCache) {
+         staleMeasurements[entry.first] = std::move(entry.second);
+     }
      cachedStations.clear();
      sensorCache.clear();
      measurementCache.clear();
  }
  
+ void ApiClient::clearMeasurementCache(int sensorId) {
+     std::lock_guard<std::mutex> lock(cacheMutex);
+     auto cacheIt = measurementCache.find(sensorId);
+     if (cacheIt != measurementCache.end()) {
+         staleMeasurements[sensorId] = std::move(cacheIt->second);
+         measurementCache.erase(cacheIt);
+     }
+ }
+ 
+ bool ApiClient::lookupMeasurementCache(int sensorId, std::vector<Measurement>& measurements) {
+     std::lock_guard<std::mutex> lock(cacheMutex);
+     auto cacheIt = measurementCache.find(sensorId);
+     if (cacheIt == measurementCache.end()) {
+         return false;
+     }
+     metrics.recordCacheHit(EndpointClass::Measurements);
+     measurements = cacheIt->second;
+     return true;
+ }
+ 
+ void ApiClient::updateMeasurementCache(int sensorId, std::vector<Measurement> measurements) {
+     std::lock_guard<std::mutex> lock(cacheMutex);
+     measurementCache[sensorId] = std::move(measurements);
+     staleMeasurements.erase(sensorId);
+ }
+ 
  std::vector<Station> ApiClient::getAllStations() {
+     return getAllStations(getRequestPolicy().deadline);
+ }
+ 
+ std::vector<Station> ApiClient::getAllStations(std::chrono::milliseconds timeout) {
+     TRACE_SCOPE("ApiClient::getAllStations");
+     const auto deadline = std::chrono::steady_clock::now() + timeout;
      // Jeśli mamy w cache, zwróć od razu
-     if (!cachedStations.empty()) {
-         if (verbose) std::cout << COLOR_CYAN << "Uzywam zachowanych stacji z cache (" << cachedStations.size() << " stacji)" << COLOR_RESET << std::endl;
-         return cachedStations;
+     {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         if (!cachedStations.empty()) {
+             metrics.recordCacheHit(EndpointClass::Stations);
+             if (verbose) LOG_DEBUG("api", "Uzywam zachowanych stacji z cache (" << cachedStations.size() << " stacji)");
+             return cachedStations;
+         }
      }
      
      std::vector<Station> stations;
      
      try {
-         if (verbose) std::cout << COLOR_CYAN << "Proba pobrania stacji pomiarowych..." << COLOR_RESET << std::endl;
-         json response = makeRequest("/station/findAll");
-         if (verbose) std::cout << COLOR_GREEN << "Otrzymano odpowiedz. Liczba stacji: " << response.size() << COLOR_RESET << std::endl;
-         
-         for (const auto& item : response) {
-             Station station;
-             
-             // Konwersja id na liczbę
-             station.id = item["id"].get<int>();
-             station.name = item["stationName"].get<std::string>();
-             
-             // Konwersja współrzędnych geograficznych ze stringów na liczby
-             if (!item["gegrLat"].is_null()) {
-                 station.lat = std::stod(item["gegrLat"].get<std::string>());
-             }
-             if (!item["gegrLon"].is_null()) {
-                 station.lon = std::stod(item["gegrLon"].get<std::string>());
-             }
-             
-             // Pobieranie informacji o mieście i adresie
-             if (!item["city"].is_null()) {
-                 station.city = item["city"]["name"].get<std::string>();
-                 
-                 if (!item["city"]["commune"].is_null()) {
-                     station.province = item["city"]["commune"]["provinceName"].get<std::string>();
-                 }
-             }
-             
-             if (!item["addressStreet"].is_null()) {
-                 station.address = item["addressStreet"].get<std::string>();
-             }
-             
-             stations.push_back(station);
+         // Równoczesne wywołania czekają na jedno pobranie
+         bool joined = false;
+         stations = stationFlight.run(0, [this, deadline]() { return fetchStations(deadline); }, &joined, deadline);
+         if (joined) {
+             metrics.recordCoalesced(EndpointClass::Stations);
+             if (verbose) LOG_DEBUG("api", "Dolaczono do trwajacego pobierania stacji");
          }
-         
-         if (verbose) std::cout << COLOR_GREEN << "Przetworzono " << stations.size() << " stacji pomiarowych" << COLOR_RESET << std::endl;
-         
-         // Zapisz do cache
-         cachedStations = stations;
      } catch (const std::exception& e) {
-         std::cerr << COLOR_RED << "Blad podczas pobierania stacji: " << e.what() << COLOR_RESET << std::endl;
+         LOG_ERROR("api", "Blad podczas pobierania stacji: " << e.what());
+     }
+     
+     return stations;
+ }
+ 
+ std::vector<Station> ApiClient::fetchStations(std::chrono::steady_clock::time_point deadline) {
+     // Poprzednie pobranie mogło zakończyć się po sprawdzeniu cache przez wywołującego
+     {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         if (!cachedStations.empty()) {
+             return cachedStations;
+         }
+     }
+     
+     if (verbose) LOG_INFO("api", "Proba pobrania stacji pomiarowych...");
+     std::vector<Station> stations;
+     try {
+         const std::string body = makeRequest("/station/findAll", deadline);
+         stations = decodeResponse(metrics, EndpointClass::Stations, body, &ResponseDecoder::decodeStations);
+     } catch (const std::exception& e) {
+         // Po błędzie API zwracane są ostatnie znane (nieaktualne) dane, jeśli istnieją
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         if (staleStations.empty()) {
+             throw;
+         }
+         metrics.endpoint(EndpointClass::Stations).staleServed.fetch_add(1, std::memory_order_relaxed);
+         LOG_WARNING("api", "API niedostepne (" << e.what() << "), zwracam nieaktualne dane stacji");
+         return staleStations;
      }
+     if (verbose) LOG_INFO("api", "Przetworzono " << stations.size() << " stacji pomiarowych");
      
+     // Zapisz do cache
+     std::lock_guard<std::mutex> lock(cacheMutex);
+     cachedStations = stations;
+     staleStations.clear();
      return stations;
  }
  
@@ -241,28 +472,29 @@
         
         std::ofstream file(filename.empty() ? "../data/stations.json" : filename); // Zmiana ścieżki
         if (!file.is_open()) {
-            std::cerr << COLOR_RED << "Nie mozna otworzyc pliku do zapisu: " << filename << COLOR_RESET << std::endl;
+            LOG_ERROR("api", "Nie mozna otworzyc pliku do zapisu: " << filename);
             return false;
         }
         
         file << stationsJson.dump(4);
         file.close();
         
-        std::cout << COLOR_GREEN << "Zapisano dane stacji do pliku: " << (filename.empty() ? "../data/stations.json" : filename) << COLOR_RESET << std::endl;
+        if (verbose) LOG_INFO("api", "Zapisano dane stacji do pliku: " << (filename.empty() ? "../data/stations.json" : filename));
         return true;
     } catch (const std::exception& e) {
-        std::cerr << COLOR_RED << "Blad podczas zapisywania stacji do pliku: " << e.what() << COLOR_RESET << std::endl;
+        LOG_ERROR("api", "Blad podczas zapisywania stacji do pliku: " << e.what());
         return false;
     }
 }
 
 std::vector<Station> ApiClient::loadStationsFromFile(const std::string& filename) {
+    TRACE_SCOPE("ApiClient::loadStationsFromFile");
     std::vector<Station> stations;
     
     try {
         std::ifstream file(filename.empty() ? "../data/stations.json" : filename); // Zmiana ścieżki
         if (!file.is_open()) {
-            std::cerr << COLOR_RED << "Nie mozna otworzyc pliku: " << filename << COLOR_RESET << std::endl;
+            LOG_ERROR("api", "Nie mozna otworzyc pliku: " << filename);
             return stations;
         }
         
@@ -282,98 +514,254 @@ std::vector<Station> ApiClient::loadStationsFromFile(const std::string& filename
             stations.push_back(station);
         }
         
-        cachedStations = stations;
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex);
+            cachedStations = stations;
+        }
         
-        std::cout << COLOR_GREEN << "Wczytano " << stations.size() << " stacji z pliku: " << (filename.empty() ? "../data/stations.json" : filename) << COLOR_RESET << std::endl;
+        if (verbose) LOG_INFO("api", "Wczytano " << stations.size() << " stacji z pliku: " << (filename.empty() ? "../data/stations.json" : filename));
     } catch (const std::exception& e) {
-        std::cerr << COLOR_RED << "Blad podczas wczytywania stacji z pliku: " << e.what() << COLOR_RESET << std::endl;
+        LOG_ERROR("api", "Blad podczas wczytywania stacji z pliku: " << e.what());
     }
     
     return stations;
 }
  
  std::vector<Sensor> ApiClient::getSensors(int stationId) {
+     return getSensors(stationId, getRequestPolicy().deadline);
+ }
+ 
+ std::vector<Sensor> ApiClient::getSensors(int stationId, std::chrono::milliseconds timeout) {
+     const auto deadline = std::chrono::steady_clock::now() + timeout;
+     TRACE_SCOPE_DETAIL("ApiClient::getSensors", "stationId=" + std::to_string(stationId));
      // Sprawdź cache
-     auto cacheIt = sensorCache.find(stationId);
-     if (cacheIt != sensorCache.end()) {
-         if (verbose) std::cout << COLOR_CYAN << "Uzywam zachowanych czujnikow z cache dla stacji ID: " << stationId << COLOR_RESET << std::endl;
-         return cacheIt->second;
+     {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         auto cacheIt = sensorCache.find(stationId);
+         if (cacheIt != sensorCache.end()) {
+             metrics.recordCacheHit(EndpointClass::Sensors);
+             if (verbose) LOG_DEBUG("api", "Uzywam zachowanych czujnikow z cache dla stacji ID: " << stationId);
+             return cacheIt->second;
+         }
      }
      
      std::vector<Sensor> sensors;
      
      try {
-         if (verbose) std::cout << COLOR_CYAN << "Pobieranie czujnikow dla stacji ID: " << stationId << COLOR_RESET << std::endl;
-         json response = makeRequest("/station/sensors/" + std::to_string(stationId));
-         
-         for (const auto& item : response) {
-             Sensor sensor;
-             sensor.id = item["id"].get<int>();
-             sensor.stationId = item["stationId"].get<int>();
-             
-             if (!item["param"].is_null()) {
-                 sensor.paramName = item["param"]["paramName"].get<std::string>();
-                 sensor.paramFormula = item["param"]["paramFormula"].get<std::string>();
-                 sensor.paramCode = item["param"]["paramCode"].get<std::string>();
-                 sensor.paramId = item["param"]["idParam"].get<int>();
-             }
-             
-             sensors.push_back(sensor);
+         // Równoczesne wywołania dla tej samej stacji czekają na jedno pobranie
+         bool joined = false;
+         sensors = sensorFlights.run(stationId, [this, stationId, deadline]() { return fetchSensors(stationId, deadline); },
+                                     &joined, deadline);
+         if (joined) {
+             metrics.recordCoalesced(EndpointClass::Sensors);
+             if (verbose) LOG_DEBUG("api", "Dolaczono do trwajacego pobierania czujnikow stacji ID: " << stationId);
          }
-         
-         // Zapisz do cache
-         sensorCache[stationId] = sensors;
-         
-         if (verbose) std::cout << COLOR_GREEN << "Znaleziono " << sensors.size() << " czujnikow" << COLOR_RESET << std::endl;
      } catch (const std::exception& e) {
-         std::cerr << COLOR_RED << "Blad podczas pobierania czujnikow: " << e.what() << COLOR_RESET << std::endl;
+         LOG_ERROR("api", "Blad podczas pobierania czujnikow: " << e.what());
      }
      
      return sensors;
  }
  
+ std::vector<Sensor> ApiClient::fetchSensors(int stationId, std::chrono::steady_clock::time_point deadline) {
+     // Poprzednie pobranie mogło zakończyć się po sprawdzeniu cache przez wywołującego
+     {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         auto cacheIt = sensorCache.find(stationId);
+         if (cacheIt != sensorCache.end()) {
+             return cacheIt->second;
+         }
+     }
+     
+     if (verbose) LOG_DEBUG("api", "Pobieranie czujnikow dla stacji ID: " << stationId);
+     std::vector<Sensor> sensors;
+     try {
+         const std::string body = makeRequest("/station/sensors/" + std::to_string(stationId), deadline);
+         sensors = decodeResponse(metrics, EndpointClass::Sensors, body, &ResponseDecoder::decodeSensors);
+     } catch (const std::exception& e) {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         auto staleIt = staleSensors.find(stationId);
+         if (staleIt == staleSensors.end()) {
+             throw;
+         }
+         metrics.endpoint(EndpointClass::Sensors).staleServed.fetch_add(1, std::memory_order_relaxed);
+         LOG_WARNING("api", "API niedostepne (" << e.what() << "), zwracam nieaktualne czujniki stacji ID: " << stationId);
+         return staleIt->second;
+     }
+     
+     // Zapisz do cache
+     {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         sensorCache[stationId] = sensors;
+         staleSensors.erase(stationId);
+     }
+     
+     if (verbose) LOG_INFO("api", "Znaleziono " << sensors.size() << " czujnikow");
+     return sensors;
+ }
+ 
  std::vector<Measurement> ApiClient::getMeasurements(int sensorId) {
+     return getMeasurements(sensorId, getRequestPolicy().deadline);
+ }
+ 
+ std::vector<Measurement> ApiClient::getMeasurements(int sensorId, std::chrono::milliseconds timeout) {
+     const auto deadline = std::chrono::steady_clock::now() + timeout;
+     TRACE_SCOPE_DETAIL("ApiClient::getMeasurements", "sensorId=" + std::to_string(sensorId));
      // Sprawdź cache
-     auto cacheIt = measurementCache.find(sensorId);
-     if (cacheIt != measurementCache.end()) {
-         if (verbose) std::cout << COLOR_CYAN << "Uzywam zachowanych pomiarow z cache dla czujnika ID: " << sensorId << COLOR_RESET << std::endl;
-         return cacheIt->second;
+     {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         auto cacheIt = measurementCache.find(sensorId);
+         if (cacheIt != measurementCache.end()) {
+             metrics.recordCacheHit(EndpointClass::Measurements);
+             if (verbose) LOG_DEBUG("api", "Uzywam zachowanych pomiarow z cache dla czujnika ID: " << sensorId);
+             return cacheIt->second;
+         }
      }
      
      std::vector<Measurement> measurements;
      
      try {
-         if (verbose) std::cout << COLOR_CYAN << "Pobieranie pomiarow dla czujnika ID: " << sensorId << COLOR_RESET << std::endl;
-         json response = makeRequest("/data/getData/" + std::to_string(sensorId));
+         // Równoczesne wywołania dla tego samego czujnika czekają na jedno pobranie
+         bool joined = false;
+         measurements = measurementFlights.run(sensorId, [this, sensorId, deadline]() { return fetchMeasurements(sensorId, deadline); },
+                                           &joined, deadline);
+         if (joined) {
+             metrics.recordCoalesced(EndpointClass::Measurements);
+             if (verbose) LOG_DEBUG("api", "Dolaczono do trwajacego pobierania pomiarow czujnika ID: " << sensorId);
+         }
+     } catch (const std::exception& e) {
+         LOG_ERROR("api", "Blad podczas pobierania pomiarow: " << e.what());
+     }
+     
+     return measurements;
+ }
+ 
+ std::vector<Measurement> ApiClient::fetchMeasurements(int sensorId, std::chrono::steady_clock::time_point deadline) {
+     // Poprzednie pobranie mogło zakończyć się po sprawdzeniu cache przez wywołującego
+     {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         auto cacheIt = measurementCache.find(sensorId);
+         if (cacheIt != measurementCache.end()) {
+             return cacheIt->second;
+         }
+     }
+     
+     if (verbose) LOG_DEBUG("api", "Pobieranie pomiarow dla czujnika ID: " << sensorId);
+     std::vector<Measurement> measurements;
+     try {
+         const std::string body = makeRequest("/data/getData/" + std::to_string(sensorId), deadline);
+         measurements = decodeResponse(metrics, EndpointClass::Measurements, body, &ResponseDecoder::decodeMeasurements);
+     } catch (const std::exception& e) {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         auto staleIt = staleMeasurements.find(sensorId);
+         if (staleIt == staleMeasurements.end()) {
+             throw;
+         }
+         metrics.endpoint(EndpointClass::Measurements).staleServed.fetch_add(1, std::memory_order_relaxed);
+         LOG_WARNING("api", "API niedostepne (" << e.what() << "), zwracam nieaktualne pomiary czujnika ID: " << sensorId);
+         return staleIt->second;
+     }
+     
+     // Zapisz do cache
+     {
+         std::lock_guard<std::mutex> lock(cacheMutex);
+         measurementCache[sensorId] = measurements;
+         staleMeasurements.erase(sensorId);
+     }
+     
+     if (verbose) LOG_INFO("api", "Znaleziono " << measurements.size() << " pomiarow");
+     return measurements;
+ }
+ 
+ std::uint64_t ApiClient::getCoalescedRequestCount() const {
+     return stationFlight.joinedCount() + sensorFlights.joinedCount() + measurementFlights.joinedCount();
+ }
+
+ std::vector<Station> ApiClient::parseStations(const json& response) {
+     std::vector<Station> stations;
+     stations.reserve(response.size());
+     
+     for (const auto& item : response) {
+         Station station;
          
-         if (response.contains("values") && response["values"].is_array()) {
-             for (const auto& item : response["values"]) {
-                 if (!item["value"].is_null()) {
-                     Measurement measurement;
-                     measurement.date = item["date"].get<std::string>();
-                     
-                     // Konwersja wartości ze stringa na liczbę
-                     try {
-                         if (item["value"].is_string()) {
-                             measurement.value = std::stod(item["value"].get<std::string>());
-                         } else {
-                             measurement.value = item["value"].get<double>();
-                         }
-                         measurements.push_back(measurement);
-                     } catch (const std::exception& e) {
-                         std::cerr << COLOR_RED << "Blad konwersji wartosci: " << e.what() << COLOR_RESET << std::endl;
-                     }
-                 }
+         // Konwersja id na liczbę
+         station.id = item["id"].get<int>();
+         station.name = item["stationName"].get<std::string>();
+         
+         // Konwersja współrzędnych geograficznych ze stringów na liczby
+         if (!item["gegrLat"].is_null()) {
+             station.lat = std::stod(item["gegrLat"].get<std::string>());
+         }
+         if (!item["gegrLon"].is_null()) {
+             station.lon = std::stod(item["gegrLon"].get<std::string>());
+         }
+         
+         // Pobieranie informacji o mieście i adresie
+         if (!item["city"].is_null()) {
+             // Internowanie bez tymczasowej kopii napisu
+             station.city = item["city"]["name"].get_ref<const std::string&>();
+             
+             if (!item["city"]["commune"].is_null()) {
+                 station.province = item["city"]["commune"]["provinceName"].get_ref<const std::string&>();
              }
          }
          
-         // Zapisz do cache
-         measurementCache[sensorId] = measurements;
+         if (!item["addressStreet"].is_null()) {
+             station.address = item["addressStreet"].get<std::string>();
+         }
          
-         if (verbose) std::cout << COLOR_GREEN << "Znaleziono " << measurements.size() << " pomiarow" << COLOR_RESET << std::endl;
-     } catch (const std::exception& e) {
-         std::cerr << COLOR_RED << "Blad podczas pobierania pomiarow: " << e.what() << COLOR_RESET << std::endl;
+         stations.push_back(station);
+     }
+     
+     return stations;
+ }
+ 
+ std::vector<Sensor> ApiClient::parseSensors(const json& response) {
+     std::vector<Sensor> sensors;
+     sensors.reserve(response.size());
+     
+     for (const auto& item : response) {
+         Sensor sensor;
+         sensor.id = item["id"].get<int>();
+         sensor.stationId = item["stationId"].get<int>();
+         
+         if (!item["param"].is_null()) {
+             sensor.paramName = item["param"]["paramName"].get_ref<const std::string&>();
+             sensor.paramFormula = item["param"]["paramFormula"].get_ref<const std::string&>();
+             sensor.paramCode = item["param"]["paramCode"].get_ref<const std::string&>();
+             sensor.paramId = item["param"]["idParam"].get<int>();
+             sensor.pollutant = resolvePollutant(sensor.paramId, sensor.paramCode.str());
+         }
+         
+         sensors.push_back(sensor);
+     }
+     
+     return sensors;
+ }
+ 
+ std::vector<Measurement> ApiClient::parseMeasurements(const json& response) {
+     std::vector<Measurement> measurements;
+     
+     if (response.contains("values") && response["values"].is_array()) {
+         for (const auto& item : response["values"]) {
+             if (!item["value"].is_null()) {
+                 Measurement measurement;
+                 measurement.date = item["date"].get<std::string>();
+                 
+                 // Konwersja wartości ze stringa na liczbę
+                 try {
+                     if (item["value"].is_string()) {
+                         measurement.value = std::stod(item["value"].get<std::string>());
+                     } else {
+                         measurement.value = item["value"].get<double>();
+                     }
+                     measurements.push_back(measurement);
+                 } catch (const std::exception& e) {
+                     LOG_ERROR("api", "Blad konwersji wartosci: " << e.what());
+                 }
+             }
+         }
      }
      
      return measurements;
- }
\ No newline at end of file
+ }
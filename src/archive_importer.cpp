@@ -0,0 +1,254 @@
+/**
+ * @file archive_importer.cpp
+ * @brief Implementacja równoległego importu plików z pomiarami do archiwum
+ */
+
+#include "archive_importer.hpp"
+#include "mapped_file.hpp"
+#include "measurement_file.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Wynik wczytania jednego pliku
+ */
+struct ParsedFile {
+    enum class Status { Parsed, Unchanged, Duplicate, Skipped, Failed };
+
+    Status status = Status::Failed;
+    std::uint64_t hash = 0;
+    std::size_t original = 0; ///< Dla kopii (Duplicate): indeks pliku z tą samą zawartością, który jest wczytywany
+    int sensorId = -1;
+    MeasurementSeries series;
+};
+
+bool isMeasurementFile(const fs::path& path) {
+    const std::string extension = path.extension().string();
+    return extension == ".json" || extension == ".aqz" || extension == ".jsonl";
+}
+
+std::string hashKey(std::uint64_t hash) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+    return buffer;
+}
+
+/**
+ * @brief Wykonuje funkcję dla indeksów [0, count) na jobs wątkach (w tym bieżącym)
+ */
+template <typename Function>
+void parallelFor(std::size_t count, int jobs, Function function) {
+    std::atomic<std::size_t> nextIndex{0};
+    auto worker = [&]() {
+        for (std::size_t i = nextIndex++; i < count; i = nextIndex++) {
+            function(i);
+        }
+    };
+    const int workerCount = std::max(1, std::min<int>(jobs, static_cast<int>(count)));
+    std::vector<std::thread> workers;
+    for (int w = 1; w < workerCount; ++w) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+}
+
+} // namespace
+
+ArchiveImporter::ArchiveImporter(const SeriesStore& store, std::string indexPath)
+    : store(store), indexPath(std::move(indexPath)) {}
+
+std::uint64_t ArchiveImporter::contentHash(const char* data, std::size_t size) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ static_cast<std::uint8_t>(data[i])) * 1099511628211ull;
+    }
+    return hash;
+}
+
+ImportReport ArchiveImporter::importDirectory(const std::string& directory, int jobs) {
+    const auto startTime = std::chrono::steady_clock::now();
+    if (!fs::is_directory(directory)) {
+        throw std::runtime_error("Katalog nie istnieje: " + directory);
+    }
+    if (jobs <= 0) {
+        jobs = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    ImportReport report;
+
+    // Indeks poprzednich importów: skrót zawartości -> ścieżka pliku
+    json index = json::object();
+    {
+        std::ifstream file(indexPath);
+        if (file.is_open()) {
+            try {
+                file >> index;
+            } catch (const std::exception& e) {
+                report.errors.push_back(indexPath + ": uszkodzony indeks, import wszystkich plikow (" + e.what() + ")");
+                index = json::object();
+            }
+        }
+    }
+    if (!index.contains("files") || !index["files"].is_object()) {
+        index["files"] = json::object();
+    }
+    const json& importedFiles = index["files"];
+
+    std::vector<std::string> paths;
+    for (const auto& entry : fs::recursive_directory_iterator(directory)) {
+        if (entry.is_regular_file() && isMeasurementFile(entry.path())) {
+            paths.push_back(entry.path().string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    report.files = paths.size();
+
+    // Etap 1: skróty i parsowanie plików; kopie tej samej zawartości są wczytywane raz
+    std::vector<ParsedFile> parsed(paths.size());
+    std::mutex mutex;
+    std::unordered_map<std::uint64_t, std::size_t> seenHashes;
+    std::atomic<std::size_t> bytes{0};
+
+    parallelFor(paths.size(), jobs, [&](std::size_t i) {
+        ParsedFile& result = parsed[i];
+        try {
+            MappedFile file(paths[i]);
+            result.hash = contentHash(file.data(), file.size());
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (importedFiles.contains(hashKey(result.hash))) {
+                    result.status = ParsedFile::Status::Unchanged;
+                    return;
+                }
+                auto [seen, inserted] = seenHashes.emplace(result.hash, i);
+                if (!inserted) {
+                    // Wynik kopii zależy od pierwszego egzemplarza - ustalany po zapisie (etap 2)
+                    result.status = ParsedFile::Status::Duplicate;
+                    result.original = seen->second;
+                    return;
+                }
+            }
+            if (file.size() == 0) {
+                throw std::runtime_error("Pusty plik");
+            }
+            SavedMeasurementFile saved = MeasurementFileLoader::parse(file.data(), file.size());
+            bytes += file.size();
+            if (saved.sensor.id < 0) {
+                // Pomiary trybu "Wszystkie" nie wskazują czujnika
+                result.status = ParsedFile::Status::Skipped;
+                return;
+            }
+            result.sensorId = saved.sensor.id;
+            result.series = std::move(saved.series);
+            result.status = ParsedFile::Status::Parsed;
+        } catch (const std::exception& e) {
+            result.status = ParsedFile::Status::Failed;
+            std::lock_guard<std::mutex> lock(mutex);
+            report.errors.push_back(paths[i] + ": " + e.what());
+        }
+    });
+    report.bytes = bytes;
+
+    // Etap 2: jedno scalenie na czujnik (dzienniki różnych czujników równolegle)
+    std::map<int, std::vector<std::size_t>> filesBySensor;
+    for (std::size_t i = 0; i < parsed.size(); ++i) {
+        if (parsed[i].status == ParsedFile::Status::Parsed) {
+            filesBySensor[parsed[i].sensorId].push_back(i);
+            report.measurements += parsed[i].series.size();
+        }
+    }
+    std::vector<std::pair<int, std::vector<std::size_t>>> sensors(filesBySensor.begin(), filesBySensor.end());
+    std::atomic<std::size_t> appended{0};
+    std::atomic<std::size_t> duplicates{0};
+
+    parallelFor(sensors.size(), jobs, [&](std::size_t s) {
+        const int sensorId = sensors[s].first;
+        std::vector<std::size_t>& files = sensors[s].second;
+        MeasurementSeries combined;
+        std::size_t total = 0;
+        for (std::size_t i : files) {
+            total += parsed[i].series.size();
+        }
+        combined.reserve(total);
+        for (std::size_t i : files) {
+            MeasurementSeries& series = parsed[i].series;
+            combined.timestamps.insert(combined.timestamps.end(), series.timestamps.begin(), series.timestamps.end());
+            combined.values.insert(combined.values.end(), series.values.begin(), series.values.end());
+            series = MeasurementSeries();
+        }
+        try {
+            const StoreMergeResult result = store.backfill(sensorId, std::move(combined));
+            appended += result.appended;
+            duplicates += result.duplicates;
+        } catch (const std::exception& e) {
+            std::lock_guard<std::mutex> lock(mutex);
+            report.errors.push_back("Czujnik " + std::to_string(sensorId) + ": " + e.what());
+            for (std::size_t i : files) {
+                parsed[i].status = ParsedFile::Status::Failed;
+            }
+        }
+    });
+    report.appended = appended;
+    report.duplicates = duplicates;
+    report.sensors = sensors.size();
+
+    // Kopia dzieli los pierwszego egzemplarza: nieudane wczytanie lub zapis oznacza błąd także dla kopii
+    for (std::size_t i = 0; i < parsed.size(); ++i) {
+        if (parsed[i].status != ParsedFile::Status::Duplicate) {
+            continue;
+        }
+        const std::size_t original = parsed[i].original;
+        if (parsed[original].status == ParsedFile::Status::Failed) {
+            parsed[i].status = ParsedFile::Status::Failed;
+            report.errors.push_back(paths[i] + ": kopia pliku, ktorego import sie nie powiodl: " + paths[original]);
+        } else {
+            parsed[i].status = ParsedFile::Status::Unchanged;
+        }
+    }
+    for (const auto& file : parsed) {
+        report.unchanged += file.status == ParsedFile::Status::Unchanged;
+        report.skipped += file.status == ParsedFile::Status::Skipped;
+    }
+
+    // Etap 3: indeks plików, których pomiary są już w archiwum (także pominiętych - ich treść się nie zmieni)
+    for (std::size_t i = 0; i < parsed.size(); ++i) {
+        if (parsed[i].status == ParsedFile::Status::Parsed || parsed[i].status == ParsedFile::Status::Skipped) {
+            index["files"][hashKey(parsed[i].hash)] = paths[i];
+            report.imported += parsed[i].status == ParsedFile::Status::Parsed;
+        }
+    }
+    report.failed = report.files - report.imported - report.unchanged - report.skipped;
+
+    // Zapis przez plik tymczasowy, aby przerwanie programu nie uszkodziło indeksu
+    const std::string tmpPath = indexPath + ".tmp";
+    {
+        std::ofstream file(tmpPath);
+        if (!file.is_open() || !(file << index.dump())) {
+            throw std::runtime_error("Nie mozna zapisac indeksu importu: " + tmpPath);
+        }
+    }
+    std::error_code error;
+    fs::rename(tmpPath, indexPath, error);
+    if (error) {
+        throw std::runtime_error("Nie mozna zapisac indeksu importu: " + indexPath);
+    }
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return report;
+}
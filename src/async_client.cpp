@@ -0,0 +1,380 @@
+/**
+ * @file async_client.cpp
+ * @brief Implementacja asynchronicznego klienta API: pętla curl_multi w jednym wątku I/O
+ */
+
+#include "async_client.hpp"
+#include "http_transfer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+
+/**
+ * @brief Transfer HTTP zlecony pętli I/O; leży w ramce oczekującej korutyny
+ */
+struct PendingTransfer {
+    std::string url;
+    std::chrono::steady_clock::time_point deadline;
+    RequestPolicy policy;
+    EndpointClass endpointClass = EndpointClass::Other;
+    CURL* handle = nullptr;
+    std::string body;
+    std::string error;          ///< Pusty w przypadku sukcesu
+    bool retryable = false;
+    bool upstreamFailure = false;
+    std::coroutine_handle<> waiter;
+};
+
+/**
+ * @brief Korutyna czekająca na upływ czasu
+ */
+struct PendingTimer {
+    std::chrono::steady_clock::time_point at;
+    std::coroutine_handle<> waiter;
+
+    bool operator>(const PendingTimer& other) const { return at > other.at; }
+};
+
+} // namespace
+
+// Pętla zdarzeń: uchwyt multi, zlecone transfery i zegary; tylko kolejki zleceń są współdzielone z innymi wątkami
+struct AsyncApiClient::Loop {
+    ApiMetrics& metrics;
+    Executor& executor;
+    CURLM* multi = nullptr;
+
+    std::mutex mutex; // Chroni submitted*, stopping
+    std::vector<PendingTransfer*> submittedTransfers;
+    std::vector<PendingTimer> submittedTimers;
+    bool stopping = false;
+
+    std::atomic<std::size_t> active{0};
+    std::thread thread;
+
+    Loop(ApiMetrics& metrics, Executor& executor, int maxConnections)
+        : metrics(metrics), executor(executor) {
+        multi = curl_multi_init();
+        if (!multi) {
+            throw std::runtime_error("Blad inicjalizacji libcurl");
+        }
+        // Zapytania ponad limit czekają w kolejce libcurl na wolne połączenie
+        curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, static_cast<long>(std::max(1, maxConnections)));
+        thread = std::thread([this]() { run(); });
+    }
+
+    ~Loop() {
+        stop();
+        thread.join();
+        curl_multi_cleanup(multi);
+    }
+
+    // Kończy pętlę: trwające transfery kończą się błędem, a nowe zlecenia są odrzucane
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        curl_multi_wakeup(multi);
+    }
+
+    // Wznawia korutynę w wątku wykonawcy
+    void resume(std::coroutine_handle<> waiter) {
+        executor.post([waiter]() { waiter.resume(); });
+    }
+
+    void submit(PendingTransfer* transfer) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!stopping) {
+                submittedTransfers.push_back(transfer);
+                transfer = nullptr;
+            }
+        }
+        if (transfer) {
+            transfer->error = "Klient asynchroniczny zostal zatrzymany";
+            resume(transfer->waiter);
+            return;
+        }
+        curl_multi_wakeup(multi);
+    }
+
+    void submit(PendingTimer timer) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!stopping) {
+                submittedTimers.push_back(timer);
+                timer.waiter = nullptr;
+            }
+        }
+        if (timer.waiter) {
+            resume(timer.waiter);
+            return;
+        }
+        curl_multi_wakeup(multi);
+    }
+
+    // Dodaje transfer do uchwytu multi z limitem czasu równym pozostałemu terminowi
+    void start(PendingTransfer* transfer, std::unordered_set<PendingTransfer*>& inFlight) {
+        const auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(
+            transfer->deadline - std::chrono::steady_clock::now());
+        transfer->handle = createTransfer(transfer->url, transfer->body, timeout, transfer->policy, nullptr);
+        if (!transfer->handle) {
+            transfer->error = "Blad inicjalizacji libcurl";
+            resume(transfer->waiter);
+            return;
+        }
+        curl_easy_setopt(transfer->handle, CURLOPT_PRIVATE, transfer);
+        curl_multi_add_handle(multi, transfer->handle);
+        inFlight.insert(transfer);
+        active.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Zapisuje metryki i wynik zakończonego transferu, zwalnia uchwyt i wznawia korutynę
+    void finish(PendingTransfer* transfer, CURLcode result, std::unordered_set<PendingTransfer*>& inFlight) {
+        CURL* handle = transfer->handle;
+        recordTransferInfo(metrics, transfer->endpointClass, handle);
+        const bool success = result == CURLE_OK;
+        metrics.recordRequest(transfer->endpointClass, readTimings(handle), transfer->body.size(), success);
+        if (!success) {
+            transfer->error = describeFailure(handle, result, transfer->retryable, transfer->upstreamFailure);
+        }
+        curl_multi_remove_handle(multi, handle);
+        curl_easy_cleanup(handle);
+        transfer->handle = nullptr;
+        inFlight.erase(transfer);
+        active.fetch_sub(1, std::memory_order_relaxed);
+        resume(transfer->waiter);
+    }
+
+    void run() {
+        std::unordered_set<PendingTransfer*> inFlight;
+        std::priority_queue<PendingTimer, std::vector<PendingTimer>, std::greater<PendingTimer>> timers;
+        std::vector<PendingTransfer*> newTransfers;
+        std::vector<PendingTimer> newTimers;
+
+        for (;;) {
+            bool stop = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                newTransfers.swap(submittedTransfers);
+                newTimers.swap(submittedTimers);
+                stop = stopping;
+            }
+            for (const PendingTimer& timer : newTimers) {
+                timers.push(timer);
+            }
+            newTimers.clear();
+            for (PendingTransfer* transfer : newTransfers) {
+                start(transfer, inFlight);
+            }
+            newTransfers.clear();
+            if (stop) {
+                break;
+            }
+
+            int running = 0;
+            curl_multi_perform(multi, &running);
+            int queued = 0;
+            while (CURLMsg* message = curl_multi_info_read(multi, &queued)) {
+                if (message->msg != CURLMSG_DONE) {
+                    continue;
+                }
+                PendingTransfer* transfer = nullptr;
+                curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &transfer);
+                finish(transfer, message->data.result, inFlight);
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            while (!timers.empty() && timers.top().at <= now) {
+                resume(timers.top().waiter);
+                timers.pop();
+            }
+
+            // Oczekiwanie na aktywność gniazd, najbliższy zegar albo nowe zlecenie (curl_multi_wakeup)
+            long waitMs = 1000;
+            if (!timers.empty()) {
+                waitMs = std::min<long>(waitMs, static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                    timers.top().at - now).count()) + 1);
+            }
+            curl_multi_poll(multi, nullptr, 0, static_cast<int>(waitMs), nullptr);
+        }
+
+        // Zatrzymanie: trwające transfery kończą się błędem, oczekujące zegary są wznawiane od razu
+        for (PendingTransfer* transfer : inFlight) {
+            curl_multi_remove_handle(multi, transfer->handle);
+            curl_easy_cleanup(transfer->handle);
+            transfer->handle = nullptr;
+            transfer->error = "Klient asynchroniczny zostal zatrzymany";
+            resume(transfer->waiter);
+        }
+        active.store(0, std::memory_order_relaxed);
+        for (; !timers.empty(); timers.pop()) {
+            resume(timers.top().waiter);
+        }
+    }
+};
+
+AsyncApiClient::AsyncApiClient(ApiClient& client, Executor& executor, int maxConnections)
+    : client(client), loop(std::make_unique<Loop>(client.getMetrics(), executor, maxConnections)) {}
+
+AsyncApiClient::~AsyncApiClient() = default;
+
+void AsyncApiClient::stop() {
+    loop->stop();
+}
+
+std::size_t AsyncApiClient::activeTransfers() const {
+    return loop->active.load(std::memory_order_relaxed);
+}
+
+Task<void> AsyncApiClient::sleepFor(std::chrono::milliseconds delay) {
+    struct TimerAwaiter {
+        Loop& loop;
+        std::chrono::steady_clock::time_point at;
+
+        bool await_ready() const { return at <= std::chrono::steady_clock::now(); }
+        void await_suspend(std::coroutine_handle<> handle) { loop.submit(PendingTimer{at, handle}); }
+        void await_resume() const noexcept {}
+    };
+    co_await TimerAwaiter{*loop, std::chrono::steady_clock::now() + delay};
+}
+
+Task<std::string> AsyncApiClient::request(std::string endpoint, std::chrono::steady_clock::time_point deadline) {
+    struct TransferAwaiter {
+        Loop& loop;
+        PendingTransfer& transfer;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            transfer.waiter = handle;
+            loop.submit(&transfer);
+        }
+        void await_resume() const noexcept {}
+    };
+
+    const EndpointClass endpointClass = classifyEndpoint(endpoint);
+    client.metrics.recordCacheMiss(endpointClass);
+    const RequestPolicy policy = client.getRequestPolicy();
+    const std::string url = client.getBaseUrl() + endpoint;
+    if (client.verbose) LOG_DEBUG("api", "Wykonywanie zapytania asynchronicznego do: " << url);
+
+    // Ponowienia jak w ApiClient::makeRequest; opóźnienie odmierza zegar pętli I/O
+    for (int attempt = 0; ; ++attempt) {
+        if (!client.breaker.allowRequest()) {
+            client.metrics.endpoint(endpointClass).breakerRejections.fetch_add(1, std::memory_order_relaxed);
+            throw std::runtime_error("API oznaczone jako niedostepne (obwod otwarty), zapytanie nie zostalo wyslane");
+        }
+
+        PendingTransfer transfer;
+        if (std::chrono::steady_clock::now() >= deadline) {
+            transfer.error = "Przekroczono termin zapytania do: " + endpoint;
+        } else {
+            transfer.url = url;
+            transfer.deadline = deadline;
+            transfer.policy = policy;
+            transfer.endpointClass = endpointClass;
+            co_await TransferAwaiter{*loop, transfer};
+        }
+
+        if (transfer.error.empty()) {
+            client.breaker.recordSuccess();
+            if (transfer.body.empty()) {
+                throw std::runtime_error("Pusta odpowiedz z API");
+            }
+            co_return std::move(transfer.body);
+        }
+        // Błędy klienta (np. 404) nie świadczą o awarii API
+        if (transfer.upstreamFailure) {
+            client.breaker.recordFailure();
+        } else {
+            client.breaker.recordSuccess();
+        }
+
+        if (!transfer.retryable || attempt >= policy.maxRetries) {
+            LOG_ERROR("api", transfer.error);
+            throw std::runtime_error(transfer.error);
+        }
+
+        const auto delay = retryDelay(policy, attempt);
+        if (std::chrono::steady_clock::now() + delay >= deadline) {
+            transfer.error += " (brak czasu na ponowienie przed terminem)";
+            LOG_ERROR("api", transfer.error);
+            throw std::runtime_error(transfer.error);
+        }
+        client.metrics.endpoint(endpointClass).retries.fetch_add(1, std::memory_order_relaxed);
+        LOG_WARNING("api", transfer.error << " - ponowienie " << attempt + 1 << "/" << policy.maxRetries
+                    << " za " << delay.count() << " ms");
+        co_await sleepFor(delay);
+    }
+}
+
+template <typename Item>
+Task<std::vector<Item>> AsyncApiClient::fetchCached(EndpointClass endpointClass, std::string endpoint, int key,
+                                                    std::unordered_map<int, std::vector<Item>> ApiClient::* cache,
+                                                    std::unordered_map<int, std::vector<Item>> ApiClient::* stale,
+                                                    std::vector<Item> (*decoder)(const char*, std::size_t, DecodeStats*)) {
+    {
+        std::lock_guard<std::mutex> lock(client.cacheMutex);
+        auto cacheIt = (client.*cache).find(key);
+        if (cacheIt != (client.*cache).end()) {
+            client.metrics.recordCacheHit(endpointClass);
+            co_return cacheIt->second;
+        }
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + client.getRequestPolicy().deadline;
+    std::vector<Item> items;
+    bool failed = false;
+    std::string failure;
+    try {
+        const std::string body = co_await request(endpoint, deadline);
+        // Dekodowanie w wątku wykonawcy, nie w wątku I/O
+        items = decodeResponse(client.metrics, endpointClass, body, decoder);
+    } catch (const std::exception& e) {
+        failed = true;
+        failure = e.what();
+    }
+
+    std::lock_guard<std::mutex> lock(client.cacheMutex);
+    if (failed) {
+        // Po błędzie API zwracane są ostatnie znane (nieaktualne) dane, jeśli istnieją
+        auto staleIt = (client.*stale).find(key);
+        if (staleIt == (client.*stale).end()) {
+            LOG_ERROR("api", "Blad podczas pobierania " << endpoint << ": " << failure);
+            co_return std::vector<Item>();
+        }
+        client.metrics.endpoint(endpointClass).staleServed.fetch_add(1, std::memory_order_relaxed);
+        LOG_WARNING("api", "API niedostepne (" << failure << "), zwracam nieaktualne dane " << endpoint);
+        co_return staleIt->second;
+    }
+    (client.*cache)[key] = items;
+    (client.*stale).erase(key);
+    co_return items;
+}
+
+Task<std::vector<Sensor>> AsyncApiClient::sensors(int stationId) {
+    return fetchCached(EndpointClass::Sensors, "/station/sensors/" + std::to_string(stationId), stationId,
+                       &ApiClient::sensorCache, &ApiClient::staleSensors, &ResponseDecoder::decodeSensors);
+}
+
+Task<std::vector<Measurement>> AsyncApiClient::measurements(int sensorId) {
+    return fetchCached(EndpointClass::Measurements, "/data/getData/" + std::to_string(sensorId), sensorId,
+                       &ApiClient::measurementCache, &ApiClient::staleMeasurements, &ResponseDecoder::decodeMeasurements);
+}
+
+Task<std::vector<std::vector<Measurement>>> AsyncApiClient::measurements(std::vector<int> sensorIds) {
+    // Wszystkie zapytania trafiają do pętli I/O od razu; wyniki są zbierane po zakończeniu ostatniego
+    std::vector<Task<std::vector<Measurement>>> tasks;
+    tasks.reserve(sensorIds.size());
+    for (int sensorId : sensorIds) {
+        tasks.push_back(measurements(sensorId));
+    }
+    co_return co_await whenAll(std::move(tasks));
+}
@@ -0,0 +1,66 @@
+/**
+ * @file circuit_breaker.cpp
+ * @brief Implementacja wyłącznika obwodu
+ */
+
+#include "circuit_breaker.hpp"
+
+CircuitBreaker::CircuitBreaker(int failureThreshold, std::chrono::milliseconds openDuration)
+    : failureThreshold(failureThreshold), openDuration(openDuration) {
+}
+
+void CircuitBreaker::configure(int threshold, std::chrono::milliseconds duration) {
+    std::lock_guard<std::mutex> lock(mutex);
+    failureThreshold = threshold;
+    openDuration = duration;
+}
+
+bool CircuitBreaker::allowRequest() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (failureThreshold <= 0) {
+        return true;
+    }
+    switch (currentState) {
+        case State::Closed:
+            return true;
+        case State::Open:
+            if (std::chrono::steady_clock::now() - openedAt >= openDuration) {
+                // Jedno zapytanie próbne; pozostałe są odrzucane do czasu jego wyniku
+                currentState = State::HalfOpen;
+                return true;
+            }
+            return false;
+        case State::HalfOpen:
+        default:
+            return false;
+    }
+}
+
+void CircuitBreaker::recordSuccess() {
+    std::lock_guard<std::mutex> lock(mutex);
+    consecutiveFailures = 0;
+    currentState = State::Closed;
+}
+
+void CircuitBreaker::recordFailure() {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++consecutiveFailures;
+    if (failureThreshold > 0 &&
+        (currentState == State::HalfOpen || consecutiveFailures >= failureThreshold)) {
+        currentState = State::Open;
+        openedAt = std::chrono::steady_clock::now();
+    }
+}
+
+CircuitBreaker::State CircuitBreaker::state() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return currentState;
+}
+
+const char* CircuitBreaker::stateName(State state) {
+    switch (state) {
+        case State::Closed: return "closed";
+        case State::Open: return "open";
+        default: return "half-open";
+    }
+}
@@ -0,0 +1,56 @@
+/**
+ * @file executor.cpp
+ * @brief Implementacja wykonawcy z pulą wątków roboczych
+ */
+
+#include "executor.hpp"
+#include <algorithm>
+
+WorkerExecutor::WorkerExecutor(int threads) {
+    const int count = std::max(1, threads);
+    this->threads.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        this->threads.emplace_back([this]() { run(); });
+    }
+}
+
+WorkerExecutor::~WorkerExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkerExecutor::post(std::function<void()> work) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(work));
+    }
+    available.notify_one();
+}
+
+bool WorkerExecutor::runsInThisThread() const {
+    const auto id = std::this_thread::get_id();
+    return std::any_of(threads.begin(), threads.end(), [id](const std::thread& thread) { return thread.get_id() == id; });
+}
+
+void WorkerExecutor::run() {
+    for (;;) {
+        std::function<void()> work;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() { return stopping || !queue.empty(); });
+            // Przy zatrzymaniu kolejka jest opróżniana, aby żadna korutyna nie została porzucona
+            if (queue.empty()) {
+                return;
+            }
+            work = std::move(queue.front());
+            queue.pop_front();
+        }
+        work();
+    }
+}
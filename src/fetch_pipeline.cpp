@@ -0,0 +1,341 @@
+/**
+ * @file fetch_pipeline.cpp
+ * @brief Implementacja potoku pobierania pomiarów z ograniczonymi kolejkami między etapami
+ */
+
+#include "fetch_pipeline.hpp"
+#include "async_client.hpp"
+#include "http_transfer.hpp"
+#include "logger.hpp"
+#include "response_decoder.hpp"
+#include "task.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <semaphore>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::uint64_t microsecondsSince(Clock::time_point start) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+}
+
+/**
+ * @brief Liczniki etapu aktualizowane przez jego wątki
+ */
+struct StageCounters {
+    std::atomic<std::uint64_t> items{0};
+    std::atomic<std::uint64_t> busyMicros{0};
+    std::atomic<std::uint64_t> outputWaitMicros{0};
+
+    PipelineStageStats snapshot(const std::string& name, int workers) const {
+        PipelineStageStats stats;
+        stats.name = name;
+        stats.workers = workers;
+        stats.items = items.load(std::memory_order_relaxed);
+        stats.busyMicros = busyMicros.load(std::memory_order_relaxed);
+        stats.outputWaitMicros = outputWaitMicros.load(std::memory_order_relaxed);
+        return stats;
+    }
+};
+
+/**
+ * @brief Wstawia element do kolejki wyjściowej etapu, mierząc czas oczekiwania na miejsce
+ */
+void pushOutput(BoundedQueue<PipelineItem>& queue, PipelineItem item, StageCounters& counters) {
+    auto start = Clock::now();
+    queue.push(std::move(item));
+    counters.outputWaitMicros.fetch_add(microsecondsSince(start), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Publikacja elementu przekazana wykonawcy
+ *
+ * Stan rozstrzyga, kto ostatni korzysta z elementu: wykonawca (Running) albo
+ * przerwany potok (Abandoned) - po porzuceniu praca wykonawcy niczego nie dotyka.
+ */
+struct PublishSlot {
+    enum State { Pending, Running, Abandoned };
+
+    PipelineItem item;
+    std::atomic<int> state{Pending};
+    std::binary_semaphore done{0};
+    std::uint64_t micros = 0;
+};
+
+/**
+ * @brief Pobiera pomiary jednego czujnika i przekazuje odpowiedź do etapu dekodowania
+ *
+ * Zwolnienie miejsca (slots) następuje dopiero po wstawieniu do kolejki, więc pełna
+ * kolejka wstrzymuje wysyłanie kolejnych zapytań.
+ */
+Task<void> fetchOne(AsyncApiClient& async, int sensorId, Clock::time_point deadline,
+                    BoundedQueue<PipelineItem>& output, StageCounters& counters,
+                    std::counting_semaphore<>& slots) {
+    PipelineItem item;
+    item.sensorId = sensorId;
+    auto start = Clock::now();
+    try {
+        item.body = co_await async.request("/data/getData/" + std::to_string(sensorId), deadline);
+    } catch (const std::exception& e) {
+        item.error = e.what();
+    }
+    counters.busyMicros.fetch_add(microsecondsSince(start), std::memory_order_relaxed);
+    counters.items.fetch_add(1, std::memory_order_relaxed);
+    pushOutput(output, std::move(item), counters);
+    slots.release();
+}
+
+} // namespace
+
+double PipelineStageStats::utilization(double seconds) const {
+    if (seconds <= 0.0 || workers <= 0) {
+        return 0.0;
+    }
+    return std::min(1.0, static_cast<double>(busyMicros) / (seconds * 1e6 * workers));
+}
+
+std::string PipelineReport::bottleneck() const {
+    const PipelineStageStats* busiest = nullptr;
+    for (const auto& stage : stages) {
+        if (!busiest || stage.utilization(seconds) > busiest->utilization(seconds)) {
+            busiest = &stage;
+        }
+    }
+    return busiest ? busiest->name : std::string();
+}
+
+std::string PipelineReport::summary() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(0)
+        << items << " czujnikow (" << failed << " bledow) w " << std::setprecision(3) << seconds << " s; etapy:";
+    for (const auto& stage : stages) {
+        out << " " << stage.name << " " << std::setprecision(0) << stage.utilization(seconds) * 100.0
+            << "% x" << stage.workers;
+    }
+    out << "; kolejki (max/sr/pojemnosc):";
+    for (const auto& queue : queues) {
+        out << " " << queue.maxDepth << "/" << std::setprecision(1) << queue.averageDepth << "/" << queue.capacity;
+    }
+    out << "; waskie gardlo: " << bottleneck();
+    return out.str();
+}
+
+FetchPipeline::FetchPipeline(ApiClient& client, PipelineOptions options)
+    : client(client), options(std::move(options)) {
+    if (this->options.maxInFlight < 1) {
+        throw std::runtime_error("Limit rownoczesnych zapytan potoku musi byc dodatni");
+    }
+    if (this->options.decodeWorkers <= 0) {
+        this->options.decodeWorkers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+}
+
+void FetchPipeline::setStoreStage(Stage store) {
+    storeStage = std::move(store);
+}
+
+void FetchPipeline::setPublishStage(Stage publish, Executor* executor) {
+    publishStage = std::move(publish);
+    publishExecutor = executor;
+}
+
+void FetchPipeline::cancel() {
+    cancelled.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(fetchMutex);
+    if (activeClient) {
+        activeClient->stop();
+    }
+}
+
+bool FetchPipeline::isCancelled() const {
+    return cancelled.load(std::memory_order_acquire);
+}
+
+PipelineReport FetchPipeline::run(const std::vector<int>& sensorIds) {
+    TRACE_SCOPE("FetchPipeline::run");
+    const auto startTime = Clock::now();
+
+    BoundedQueue<PipelineItem> fetched(options.queueCapacity);
+    BoundedQueue<PipelineItem> decoded(options.queueCapacity);
+    BoundedQueue<PipelineItem> stored(options.queueCapacity);
+    StageCounters fetchCounters, decodeCounters, storeCounters, publishCounters;
+    std::atomic<std::size_t> failed{0};
+
+    // Etap 2: dekodowanie w puli wątków
+    std::vector<std::thread> decoders;
+    for (int i = 0; i < options.decodeWorkers; ++i) {
+        decoders.emplace_back([&] {
+            PipelineItem item;
+            while (fetched.pop(item)) {
+                auto start = Clock::now();
+                if (!item.fromCache && item.error.empty()) {
+                    try {
+                        item.measurements = decodeResponse(client.getMetrics(), EndpointClass::Measurements,
+                                                           item.body, &ResponseDecoder::decodeMeasurements);
+                        if (options.useCache) {
+                            client.updateMeasurementCache(item.sensorId, item.measurements);
+                        }
+                    } catch (const std::exception& e) {
+                        item.error = e.what();
+                    }
+                }
+                std::string().swap(item.body);
+                if (item.error.empty()) {
+                    item.series = MeasurementSeries::fromMeasurements(item.measurements);
+                }
+                decodeCounters.busyMicros.fetch_add(microsecondsSince(start), std::memory_order_relaxed);
+                decodeCounters.items.fetch_add(1, std::memory_order_relaxed);
+                pushOutput(decoded, std::move(item), decodeCounters);
+                item = PipelineItem();
+            }
+        });
+    }
+
+    // Etap 3: zapis w jednym wątku, więc funkcja etapu nie musi być bezpieczna wątkowo
+    std::thread storer([&] {
+        PipelineItem item;
+        while (decoded.pop(item)) {
+            auto start = Clock::now();
+            if (item.error.empty() && storeStage && !cancelled.load(std::memory_order_acquire)) {
+                try {
+                    storeStage(item);
+                } catch (const std::exception& e) {
+                    item.error = e.what();
+                }
+            }
+            storeCounters.busyMicros.fetch_add(microsecondsSince(start), std::memory_order_relaxed);
+            storeCounters.items.fetch_add(1, std::memory_order_relaxed);
+            pushOutput(stored, std::move(item), storeCounters);
+            item = PipelineItem();
+        }
+    });
+
+    // Etap 4: publikacja w wątku potoku albo przez wykonawcę (np. w wątku interfejsu)
+    std::thread publisher([&] {
+        PipelineItem item;
+        while (stored.pop(item)) {
+            if (!item.error.empty()) {
+                failed.fetch_add(1, std::memory_order_relaxed);
+            }
+            publishCounters.items.fetch_add(1, std::memory_order_relaxed);
+            if (!publishStage || cancelled.load(std::memory_order_acquire)) {
+                continue;
+            }
+            if (!publishExecutor) {
+                auto start = Clock::now();
+                try {
+                    publishStage(item);
+                } catch (const std::exception& e) {
+                    LOG_ERROR("pipeline", "Blad publikacji czujnika " << item.sensorId << ": " << e.what());
+                }
+                publishCounters.busyMicros.fetch_add(microsecondsSince(start), std::memory_order_relaxed);
+                continue;
+            }
+
+            auto slot = std::make_shared<PublishSlot>();
+            slot->item = std::move(item);
+            publishExecutor->post([this, slot] {
+                int expected = PublishSlot::Pending;
+                if (!slot->state.compare_exchange_strong(expected, PublishSlot::Running)) {
+                    return;
+                }
+                auto start = Clock::now();
+                try {
+                    publishStage(slot->item);
+                } catch (const std::exception& e) {
+                    LOG_ERROR("pipeline", "Blad publikacji czujnika " << slot->item.sensorId << ": " << e.what());
+                }
+                slot->micros = microsecondsSince(start);
+                slot->done.release();
+            });
+
+            // Oczekiwanie z limitem czasu: po cancel() wykonawca może już nie przetwarzać pracy
+            while (!slot->done.try_acquire_for(std::chrono::milliseconds(20))) {
+                if (!cancelled.load(std::memory_order_acquire)) {
+                    continue;
+                }
+                int expected = PublishSlot::Pending;
+                if (!slot->state.compare_exchange_strong(expected, PublishSlot::Abandoned)) {
+                    slot->done.acquire();
+                }
+                break;
+            }
+            publishCounters.busyMicros.fetch_add(slot->micros, std::memory_order_relaxed);
+            item = PipelineItem();
+        }
+    });
+
+    // Etap 1: pobieranie - wątek wywołujący wysyła zapytania, pętla I/O obsługuje je równocześnie
+    {
+        WorkerExecutor fetchExecutor;
+        AsyncApiClient async(client, fetchExecutor, options.maxInFlight);
+        std::counting_semaphore<> slots(options.maxInFlight);
+        {
+            std::lock_guard<std::mutex> lock(fetchMutex);
+            activeClient = &async;
+            if (cancelled.load(std::memory_order_acquire)) {
+                async.stop();
+            }
+        }
+
+        for (int sensorId : sensorIds) {
+            slots.acquire();
+            // Oczekiwanie na miejsce mogło się zakończyć z powodu przerwania
+            if (cancelled.load(std::memory_order_acquire)) {
+                slots.release();
+                break;
+            }
+
+            PipelineItem item;
+            item.sensorId = sensorId;
+            if (options.useCache && client.lookupMeasurementCache(sensorId, item.measurements)) {
+                item.fromCache = true;
+                fetchCounters.items.fetch_add(1, std::memory_order_relaxed);
+                pushOutput(fetched, std::move(item), fetchCounters);
+                slots.release();
+                continue;
+            }
+
+            if (options.throttle) {
+                options.throttle();
+            }
+            spawn(fetchOne(async, sensorId, Clock::now() + client.getRequestPolicy().deadline,
+                           fetched, fetchCounters, slots));
+        }
+
+        // Zajęcie wszystkich miejsc oznacza zakończenie wysłanych zapytań (po cancel() - przerwanych)
+        for (int i = 0; i < options.maxInFlight; ++i) {
+            slots.acquire();
+        }
+        std::lock_guard<std::mutex> lock(fetchMutex);
+        activeClient = nullptr;
+    }
+
+    fetched.close();
+    for (auto& decoder : decoders) {
+        decoder.join();
+    }
+    decoded.close();
+    storer.join();
+    stored.close();
+    publisher.join();
+
+    PipelineReport report;
+    report.seconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+    report.stages.push_back(fetchCounters.snapshot("pobieranie", options.maxInFlight));
+    report.stages.push_back(decodeCounters.snapshot("dekodowanie", options.decodeWorkers));
+    report.stages.push_back(storeCounters.snapshot("zapis", 1));
+    report.stages.push_back(publishCounters.snapshot("publikacja", 1));
+    report.queues = {fetched.stats(), decoded.stats(), stored.stats()};
+    report.items = static_cast<std::size_t>(publishCounters.items.load());
+    report.failed = failed.load();
+    return report;
+}
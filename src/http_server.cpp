@@ -0,0 +1,540 @@
+/**
+ * @file http_server.cpp
+ * @brief Implementacja sterowanego zdarzeniami serwera HTTP/1.1
+ */
+
+#include "http_server.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+namespace {
+
+// Maksymalny rozmiar nagłówków żądania
+constexpr std::size_t kMaxHeaderSize = 16 * 1024;
+
+// Maksymalna deklarowana treść żądania (Content-Length)
+constexpr std::size_t kMaxBodySize = 64 * 1024;
+
+// Nieprzetworzone dane połączenia, powyżej których odczyt jest wstrzymywany
+constexpr std::size_t kMaxBufferedInput = 1024 * 1024;
+
+void setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+const char* statusText(int status) {
+    switch (status) {
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 413: return "Payload Too Large";
+    case 431: return "Request Header Fields Too Large";
+    case 500: return "Internal Server Error";
+    case 502: return "Bad Gateway";
+    case 503: return "Service Unavailable";
+    case 504: return "Gateway Timeout";
+    default: return "Unknown";
+    }
+}
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+std::string trim(const std::string& text) {
+    std::size_t begin = text.find_first_not_of(" \t");
+    if (begin == std::string::npos) {
+        return {};
+    }
+    std::size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+} // namespace
+
+/**
+ * @brief Stan pojedynczego połączenia klienta
+ */
+struct HttpServer::Connection {
+    int fd = -1;
+    std::uint64_t id = 0;
+    std::string input;                       ///< Dane od klienta (przetworzone do inputOffset)
+    std::size_t inputOffset = 0;             ///< Początek pierwszego nieprzetworzonego żądania w input
+    std::deque<HttpResponsePtr> output;      ///< Odpowiedzi do wysłania
+    std::size_t outputOffset = 0;            ///< Pozycja w pierwszej odpowiedzi kolejki
+    bool awaitingResponse = false;           ///< Handler nie odpowiedział jeszcze na żądanie
+    bool closeAfterWrite = false;            ///< Zamknięcie po wysłaniu odpowiedzi
+    bool wantRead = true;                    ///< Zarejestrowane zainteresowanie odczytem
+    bool wantWrite = false;                  ///< Zarejestrowane zainteresowanie zapisem
+};
+
+#ifdef __linux__
+
+/**
+ * @brief Rejestracja deskryptorów w epoll
+ */
+class HttpServer::Poller {
+public:
+    Poller() : epollFd(epoll_create1(EPOLL_CLOEXEC)) {
+        if (epollFd < 0) {
+            throw std::runtime_error("Nie mozna utworzyc epoll: " + std::string(std::strerror(errno)));
+        }
+    }
+
+    ~Poller() { ::close(epollFd); }
+
+    void add(int fd, bool write) { control(EPOLL_CTL_ADD, fd, true, write); }
+    void modify(int fd, bool read, bool write) { control(EPOLL_CTL_MOD, fd, read, write); }
+    void remove(int fd) { epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr); }
+
+    /**
+     * @brief Czeka na zdarzenia i wywołuje callback(fd, readable, writable, error)
+     */
+    template <typename Callback>
+    void wait(int timeoutMs, Callback callback) {
+        epoll_event events[128];
+        int count = epoll_wait(epollFd, events, 128, timeoutMs);
+        for (int i = 0; i < count; ++i) {
+            const std::uint32_t flags = events[i].events;
+            callback(events[i].data.fd, (flags & EPOLLIN) != 0, (flags & EPOLLOUT) != 0,
+                     (flags & (EPOLLERR | EPOLLHUP)) != 0);
+        }
+    }
+
+private:
+    int epollFd;
+
+    void control(int operation, int fd, bool read, bool write) {
+        epoll_event event{};
+        event.events = (read ? static_cast<std::uint32_t>(EPOLLIN) : 0u) |
+                       (write ? static_cast<std::uint32_t>(EPOLLOUT) : 0u);
+        event.data.fd = fd;
+        epoll_ctl(epollFd, operation, fd, &event);
+    }
+};
+
+#else
+
+/**
+ * @brief Rejestracja deskryptorów dla poll() (systemy bez epoll)
+ */
+class HttpServer::Poller {
+public:
+    void add(int fd, bool write) { interest[fd] = {true, write}; }
+    void modify(int fd, bool read, bool write) { interest[fd] = {read, write}; }
+    void remove(int fd) { interest.erase(fd); }
+
+    template <typename Callback>
+    void wait(int timeoutMs, Callback callback) {
+        std::vector<pollfd> fds;
+        fds.reserve(interest.size());
+        for (const auto& entry : interest) {
+            fds.push_back({entry.first,
+                           static_cast<short>((entry.second.first ? POLLIN : 0) | (entry.second.second ? POLLOUT : 0)),
+                           0});
+        }
+        if (::poll(fds.data(), fds.size(), timeoutMs) <= 0) {
+            return;
+        }
+        for (const auto& fd : fds) {
+            if (fd.revents != 0) {
+                callback(fd.fd, (fd.revents & POLLIN) != 0, (fd.revents & POLLOUT) != 0,
+                         (fd.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0);
+            }
+        }
+    }
+
+private:
+    std::unordered_map<int, std::pair<bool, bool>> interest; // (odczyt, zapis)
+};
+
+#endif
+
+HttpServer::HttpServer(Handler handler) : handler(std::move(handler)), poller(new Poller()) {
+    int pipeFds[2];
+    if (::pipe(pipeFds) != 0) {
+        throw std::runtime_error("Nie mozna utworzyc potoku wybudzania: " + std::string(std::strerror(errno)));
+    }
+    wakeReadFd = pipeFds[0];
+    wakeWriteFd = pipeFds[1];
+    setNonBlocking(wakeReadFd);
+    setNonBlocking(wakeWriteFd);
+    poller->add(wakeReadFd, false);
+}
+
+HttpServer::~HttpServer() {
+    while (!connections.empty()) {
+        closeConnection(connections.begin()->first);
+    }
+    if (listenFd >= 0) {
+        ::close(listenFd);
+    }
+    ::close(wakeReadFd);
+    ::close(wakeWriteFd);
+}
+
+void HttpServer::listen(const std::string& host, std::uint16_t port) {
+    listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error("Nie mozna utworzyc gniazda: " + std::string(std::strerror(errno)));
+    }
+
+    int enable = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+        throw std::runtime_error("Niepoprawny adres: " + host);
+    }
+
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        throw std::runtime_error("Nie mozna powiazac gniazda z " + host + ":" + std::to_string(port) +
+                                 ": " + std::strerror(errno));
+    }
+    if (::listen(listenFd, SOMAXCONN) != 0) {
+        throw std::runtime_error("Blad listen(): " + std::string(std::strerror(errno)));
+    }
+
+    socklen_t length = sizeof(address);
+    getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+    boundPort = ntohs(address.sin_port);
+
+    setNonBlocking(listenFd);
+    poller->add(listenFd, false);
+}
+
+void HttpServer::run() {
+    while (running) {
+        poller->wait(1000, [this](int fd, bool readable, bool writable, bool error) {
+            if (fd == listenFd) {
+                acceptConnections();
+                return;
+            }
+            if (fd == wakeReadFd) {
+                char buffer[256];
+                while (::read(wakeReadFd, buffer, sizeof(buffer)) > 0) {
+                }
+                drainCompletions();
+                return;
+            }
+
+            auto it = connections.find(fd);
+            if (it == connections.end()) {
+                return;
+            }
+            if (error && !readable) {
+                closeConnection(fd);
+                return;
+            }
+            if (writable) {
+                handleWritable(*it->second);
+            }
+            // Połączenie mogło zostać zamknięte podczas zapisu
+            it = connections.find(fd);
+            if (it == connections.end()) {
+                return;
+            }
+            if (readable) {
+                handleReadable(*it->second);
+            } else if (writable) {
+                // Po opróżnieniu bufora wyjściowego mogą czekać kolejne żądania
+                processRequests(*it->second);
+            }
+        });
+    }
+}
+
+void HttpServer::stop() {
+    running = false;
+    wake();
+}
+
+void HttpServer::wake() {
+    char byte = 1;
+    // Pełny potok oznacza, że pętla i tak zostanie wybudzona
+    ssize_t written = ::write(wakeWriteFd, &byte, 1);
+    (void)written;
+}
+
+void HttpServer::acceptConnections() {
+    while (true) {
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        setNonBlocking(fd);
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connection->id = nextConnectionId++;
+        connectionFds[connection->id] = fd;
+        connections[fd] = std::move(connection);
+        ++openConnections;
+        poller->add(fd, false);
+    }
+}
+
+void HttpServer::closeConnection(int fd) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) {
+        return;
+    }
+    connectionFds.erase(it->second->id);
+    poller->remove(fd);
+    ::close(fd);
+    connections.erase(it);
+    --openConnections;
+}
+
+void HttpServer::handleReadable(Connection& connection) {
+    char buffer[16 * 1024];
+    // Powyżej limitu odczyt czeka, aż żądania zostaną obsłużone (przeciwciśnienie)
+    while (connection.input.size() - connection.inputOffset < kMaxBufferedInput) {
+        ssize_t count = ::read(connection.fd, buffer, sizeof(buffer));
+        if (count > 0) {
+            connection.input.append(buffer, static_cast<std::size_t>(count));
+            continue;
+        }
+        if (count == 0) {
+            // Klient zamknął połączenie - oczekujące odpowiedzi są porzucane
+            closeConnection(connection.fd);
+            return;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        closeConnection(connection.fd);
+        return;
+    }
+    processRequests(connection);
+}
+
+void HttpServer::processRequests(Connection& connection) {
+    // Żądania są obsługiwane po kolei - następne dopiero po wysłaniu odpowiedzi.
+    // Pętla jest jedynym miejscem przechodzenia do kolejnego żądania, więc dowolnie
+    // długi ciąg żądań potokowych nie zwiększa głębokości stosu.
+    const int fd = connection.fd;
+    while (!connection.awaitingResponse && connection.output.empty() && !connection.closeAfterWrite) {
+        const std::size_t start = connection.inputOffset;
+        std::size_t headerEnd = connection.input.find("\r\n\r\n", start);
+        if (headerEnd == std::string::npos) {
+            if (connection.input.size() - start > kMaxHeaderSize) {
+                connection.closeAfterWrite = true;
+                deliver(connection, makeResponse(431, "text/plain", "Naglowki zbyt duze\n"));
+                return;
+            }
+            break;
+        }
+
+        HttpRequest request;
+        std::string version;
+        std::size_t lineEnd = connection.input.find("\r\n", start);
+        {
+            std::string requestLine = connection.input.substr(start, lineEnd - start);
+            std::size_t firstSpace = requestLine.find(' ');
+            std::size_t secondSpace = requestLine.find(' ', firstSpace + 1);
+            if (firstSpace == std::string::npos || secondSpace == std::string::npos) {
+                connection.closeAfterWrite = true;
+                deliver(connection, makeResponse(400, "text/plain", "Niepoprawne zadanie\n"));
+                return;
+            }
+            request.method = requestLine.substr(0, firstSpace);
+            std::string target = requestLine.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+            version = requestLine.substr(secondSpace + 1);
+            std::size_t queryStart = target.find('?');
+            request.path = target.substr(0, queryStart);
+            if (queryStart != std::string::npos) {
+                request.query = target.substr(queryStart + 1);
+            }
+        }
+
+        std::size_t position = lineEnd + 2;
+        while (position < headerEnd) {
+            std::size_t end = connection.input.find("\r\n", position);
+            std::string line = connection.input.substr(position, end - position);
+            std::size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                request.headers[toLower(line.substr(0, colon))] = trim(line.substr(colon + 1));
+            }
+            position = end + 2;
+        }
+
+        // Treść żądania (jeśli jest) jest pomijana - serwer obsługuje tylko zapytania odczytu
+        std::size_t bodyLength = 0;
+        auto lengthIt = request.headers.find("content-length");
+        if (lengthIt != request.headers.end()) {
+            const unsigned long long declared = std::strtoull(lengthIt->second.c_str(), nullptr, 10);
+            if (declared > kMaxBodySize) {
+                connection.closeAfterWrite = true;
+                deliver(connection, makeResponse(413, "text/plain", "Tresc zadania zbyt duza\n"));
+                return;
+            }
+            bodyLength = static_cast<std::size_t>(declared);
+        }
+        if (connection.input.size() < headerEnd + 4 + bodyLength) {
+            break;
+        }
+        connection.inputOffset = headerEnd + 4 + bodyLength;
+
+        // HTTP/1.0 domyślnie zamyka połączenie, HTTP/1.1 domyślnie je utrzymuje
+        auto connectionIt = request.headers.find("connection");
+        std::string connectionHeader = connectionIt != request.headers.end() ? toLower(connectionIt->second) : "";
+        if (connectionHeader == "close" || (version == "HTTP/1.0" && connectionHeader != "keep-alive")) {
+            connection.closeAfterWrite = true;
+        }
+
+        connection.awaitingResponse = true;
+        const std::uint64_t connectionId = connection.id;
+        const std::thread::id loopThread = std::this_thread::get_id();
+        dispatchingConnection = connectionId;
+        handler(request, [this, connectionId, loopThread](HttpResponsePtr response) {
+            // Wątek pętli sprawdzany najpierw: pole dispatchingConnection zmienia tylko pętla
+            if (std::this_thread::get_id() == loopThread && dispatchingConnection == connectionId) {
+                inlineResponse = std::move(response);
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(completionMutex);
+                completions.emplace_back(connectionId, std::move(response));
+            }
+            wake();
+        });
+        dispatchingConnection = 0;
+
+        // Handler odpowiedział synchronicznie (np. z cache) - wysyłamy od razu
+        if (inlineResponse) {
+            connection.awaitingResponse = false;
+            deliver(connection, std::move(inlineResponse));
+            inlineResponse.reset();
+            // deliver() mógł zamknąć połączenie
+            if (connections.find(fd) == connections.end()) {
+                return;
+            }
+        }
+    }
+
+    // Obsłużone żądania są usuwane z bufora raz na partię, a nie po każdym żądaniu
+    if (connection.inputOffset > 0) {
+        connection.input.erase(0, connection.inputOffset);
+        connection.inputOffset = 0;
+    }
+    updateInterest(connection);
+}
+
+void HttpServer::drainCompletions() {
+    std::vector<std::pair<std::uint64_t, HttpResponsePtr>> ready;
+    {
+        std::lock_guard<std::mutex> lock(completionMutex);
+        ready.swap(completions);
+    }
+
+    for (auto& completion : ready) {
+        auto fdIt = connectionFds.find(completion.first);
+        if (fdIt == connectionFds.end()) {
+            continue; // Klient rozłączył się przed otrzymaniem odpowiedzi
+        }
+        const int fd = fdIt->second;
+        Connection& connection = *connections[fd];
+        connection.awaitingResponse = false;
+        deliver(connection, std::move(completion.second));
+        // Po odpowiedzi można obsłużyć kolejne żądanie z bufora wejściowego
+        auto it = connections.find(fd);
+        if (it != connections.end()) {
+            processRequests(*it->second);
+        }
+    }
+}
+
+void HttpServer::deliver(Connection& connection, HttpResponsePtr response) {
+    if (!response) {
+        response = makeResponse(500, "text/plain", "Brak odpowiedzi\n");
+    }
+    connection.output.push_back(std::move(response));
+    handleWritable(connection);
+}
+
+void HttpServer::handleWritable(Connection& connection) {
+    const int fd = connection.fd;
+    while (!connection.output.empty()) {
+        const std::string& data = *connection.output.front();
+        ssize_t count = ::send(fd, data.data() + connection.outputOffset,
+                               data.size() - connection.outputOffset, MSG_NOSIGNAL);
+        if (count < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            closeConnection(fd);
+            return;
+        }
+        connection.outputOffset += static_cast<std::size_t>(count);
+        if (connection.outputOffset == data.size()) {
+            connection.output.pop_front();
+            connection.outputOffset = 0;
+        }
+    }
+
+    if (connection.output.empty() && connection.closeAfterWrite && !connection.awaitingResponse) {
+        closeConnection(fd);
+        return;
+    }
+    // Kolejne żądania obsługuje wywołujący (processRequests), nie zapis
+    updateInterest(connection);
+}
+
+void HttpServer::updateInterest(Connection& connection) {
+    const bool read = connection.input.size() - connection.inputOffset < kMaxBufferedInput;
+    const bool write = !connection.output.empty();
+    if (read != connection.wantRead || write != connection.wantWrite) {
+        connection.wantRead = read;
+        connection.wantWrite = write;
+        poller->modify(connection.fd, read, write);
+    }
+}
+
+HttpResponsePtr HttpServer::makeResponse(int status, const std::string& contentType, const std::string& body,
+                                         const std::vector<std::pair<std::string, std::string>>& extraHeaders) {
+    std::string response;
+    response.reserve(body.size() + 256);
+    response += "HTTP/1.1 " + std::to_string(status) + " " + statusText(status) + "\r\n";
+    response += "Content-Type: " + contentType + "\r\n";
+    response += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    for (const auto& header : extraHeaders) {
+        response += header.first + ": " + header.second + "\r\n";
+    }
+    response += "\r\n";
+    response += body;
+    return std::make_shared<const std::string>(std::move(response));
+}
@@ -0,0 +1,108 @@
+/**
+ * @file http_transfer.cpp
+ * @brief Implementacja wspólnych elementów transferów libcurl
+ */
+
+#include "http_transfer.hpp"
+#include <algorithm>
+#include <random>
+
+// Odczytuje czasy etapów zapytania z libcurl (wartości skumulowane od startu zapytania)
+RequestTimings readTimings(CURL* curl){
+    curl_off_t nameLookup = 0, connect = 0, appConnect = 0, startTransfer = 0, total = 0;
+    curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &nameLookup);
+    curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connect);
+    curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &appConnect);
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &startTransfer);
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total);
+    
+    auto difference = [](curl_off_t later, curl_off_t earlier) -> std::uint64_t {
+        return later > earlier ? static_cast<std::uint64_t>(later - earlier) : 0;
+    };
+    
+    RequestTimings timings;
+    timings.dns = static_cast<std::uint64_t>(nameLookup);
+    timings.connect = difference(connect, nameLookup);
+    timings.tls = appConnect > 0 ? difference(appConnect, connect) : 0;
+    timings.wait = startTransfer > 0 ? difference(startTransfer, appConnect > 0 ? appConnect : connect) : 0;
+    timings.transfer = difference(total, startTransfer);
+    timings.total = static_cast<std::uint64_t>(total);
+    return timings;
+}
+
+// Funkcja pomocnicza do zapisywania odpowiedzi z libcurl
+static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp){
+    ((std::string*)userp)->append((char*)contents, size * nmemb);
+    return size * nmemb;
+}
+
+// Tworzy uchwyt zapytania GET z limitem czasu równym pozostałemu terminowi
+CURL* createTransfer(const std::string& url, std::string& buffer, std::chrono::milliseconds timeout,
+                     const RequestPolicy& policy, CURLSH* share){
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        return nullptr;
+    }
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_SHARE, share);
+    // Pusty tekst: wszystkie kodowania wspierane przez libcurl; dekompresja strumieniowa w trakcie odbioru
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, policy.compression ? "" : nullptr);
+    if (policy.http2) {
+        // HTTP/2 przy TLS (ALPN), w przeciwnym razie HTTP/1.1
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+    } else {
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_1_1));
+    }
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &buffer);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(std::max<std::int64_t>(1, timeout.count())));
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L); // Wymagane przy zapytaniach z wielu wątków
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L); // Kody HTTP >= 400 traktowane jako błąd
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "AirQualityApp/1.0");
+    
+    // Opcjonalnie wyłączenie weryfikacji SSL bo do raspberry
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+    return curl;
+}
+
+// Zapisuje rozmiar przesłanej treści, użycie połączenia i wersję protokołu zakończonego transferu
+void recordTransferInfo(ApiMetrics& metrics, EndpointClass endpointClass, CURL* curl){
+    curl_off_t wireBytes = 0;
+    long newConnections = 0;
+    long httpVersion = 0;
+    curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &wireBytes);
+    curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &newConnections);
+    curl_easy_getinfo(curl, CURLINFO_HTTP_VERSION, &httpVersion);
+    metrics.recordTransfer(endpointClass, static_cast<std::uint64_t>(wireBytes), newConnections > 0,
+                           httpVersion == CURL_HTTP_VERSION_2_0);
+}
+
+// Opisuje nieudany transfer i klasyfikuje błąd: przejściowy (do ponowienia) i/lub po stronie API
+std::string describeFailure(CURL* curl, CURLcode result, bool& retryable, bool& upstreamFailure){
+    long httpCode = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
+    
+    std::string errorMsg = "Blad podczas wykonywania zapytania: " + std::string(curl_easy_strerror(result));
+    if (result == CURLE_HTTP_RETURNED_ERROR) {
+        errorMsg += " (HTTP " + std::to_string(httpCode) + ")";
+        // 5xx i 429 są przejściowe; pozostałe błędy 4xx wynikają z samego zapytania
+        upstreamFailure = httpCode >= 500 || httpCode == 429;
+        retryable = upstreamFailure;
+    } else {
+        // Błędy połączenia i przekroczenia czasu
+        upstreamFailure = true;
+        retryable = true;
+    }
+    return errorMsg;
+}
+
+// Opóźnienie przed ponowieniem: losowe z zakresu [0, min(limit, baza * 2^próba)]
+std::chrono::milliseconds retryDelay(const RequestPolicy& policy, int attempt){
+    thread_local std::mt19937 generator{std::random_device{}()};
+    const std::int64_t cap = policy.retryMaxDelay.count();
+    std::int64_t ceiling = policy.retryBaseDelay.count() << std::min(attempt, 20);
+    ceiling = std::max<std::int64_t>(0, std::min(cap, ceiling));
+    std::uniform_int_distribution<std::int64_t> distribution(0, ceiling);
+    return std::chrono::milliseconds(distribution(generator));
+}
@@ -0,0 +1,318 @@
+/**
+ * @file logger.cpp
+ * @brief Implementacja asynchronicznego loggera, kolejki komunikatów i wyjść
+ */
+
+#include "logger.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
+
+// Kody kolorów ANSI
+#define COLOR_RESET   "\033[0m"
+#define COLOR_RED     "\033[31m"
+#define COLOR_GREEN   "\033[32m"
+#define COLOR_YELLOW  "\033[33m"
+#define COLOR_BLUE    "\033[34m"
+#define COLOR_CYAN    "\033[36m"
+
+namespace {
+
+// Kolejny numer wątku (czytelniejszy w logu niż systemowy identyfikator)
+std::uint32_t currentThreadId() {
+    static std::atomic<std::uint32_t> nextId{1};
+    thread_local std::uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+std::size_t roundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// Kolory tylko wtedy, gdy oba strumienie trafiają na terminal (nie do pliku ani potoku)
+bool consoleSupportsColors() {
+    return isatty(fileno(stdout)) && isatty(fileno(stderr));
+}
+
+const char* levelColor(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return COLOR_BLUE;
+        case LogLevel::Debug: return COLOR_CYAN;
+        case LogLevel::Info: return COLOR_GREEN;
+        case LogLevel::Warning: return COLOR_YELLOW;
+        default: return COLOR_RED;
+    }
+}
+
+} // namespace
+
+// ======== ConsoleLogSink ========
+
+void ConsoleLogSink::write(const LogRecord& record, const std::string& line) {
+    std::FILE* stream = record.level >= LogLevel::Warning ? stderr : stdout;
+    if (useColors) {
+        std::fputs(levelColor(record.level), stream);
+        std::fputs(line.c_str(), stream);
+        std::fputs(COLOR_RESET "\n", stream);
+    } else {
+        std::fputs(line.c_str(), stream);
+        std::fputc('\n', stream);
+    }
+}
+
+void ConsoleLogSink::flush() {
+    std::fflush(stdout);
+    std::fflush(stderr);
+}
+
+// ======== RotatingFileLogSink ========
+
+RotatingFileLogSink::RotatingFileLogSink(const std::string& path, std::uint64_t maxBytes, int maxFiles)
+    : path(path), maxBytes(maxBytes), maxFiles(maxFiles), currentSize(0) {
+    {
+        std::ifstream existing(path, std::ios::binary | std::ios::ate);
+        if (existing) {
+            currentSize = static_cast<std::uint64_t>(existing.tellg());
+        }
+    }
+    file.open(path, std::ios::app | std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Nie mozna otworzyc pliku logu: " + path);
+    }
+}
+
+void RotatingFileLogSink::write(const LogRecord& /*record*/, const std::string& line) {
+    const std::uint64_t lineSize = line.size() + 1;
+    if (currentSize > 0 && currentSize + lineSize > maxBytes) {
+        rotate();
+    }
+    file << line << '\n';
+    currentSize += lineSize;
+}
+
+void RotatingFileLogSink::flush() {
+    file.flush();
+}
+
+void RotatingFileLogSink::rotate() {
+    file.close();
+    if (maxFiles > 0) {
+        std::remove((path + "." + std::to_string(maxFiles)).c_str());
+        for (int i = maxFiles - 1; i >= 1; --i) {
+            std::rename((path + "." + std::to_string(i)).c_str(), (path + "." + std::to_string(i + 1)).c_str());
+        }
+        std::rename(path.c_str(), (path + ".1").c_str());
+    }
+    file.open(path, std::ios::trunc | std::ios::binary);
+    currentSize = 0;
+}
+
+// ======== Logger ========
+
+Logger::Logger(std::size_t queueCapacity)
+    : slots(roundUpToPowerOfTwo(queueCapacity)), mask(slots.size() - 1) {
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    sinkThread = std::thread(&Logger::sinkLoop, this);
+}
+
+Logger::~Logger() {
+    stopping.store(true);
+    wakeCondition.notify_one();
+    if (sinkThread.joinable()) {
+        sinkThread.join();
+    }
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    static std::once_flag configured;
+    std::call_once(configured, []() {
+        if (const char* levelName = std::getenv("AIRQUALITY_LOG_LEVEL")) {
+            logger.setLevel(parseLevel(levelName, LogLevel::Info));
+        }
+        logger.addSink(std::make_unique<ConsoleLogSink>(consoleSupportsColors()));
+        if (const char* filePath = std::getenv("AIRQUALITY_LOG_FILE")) {
+            try {
+                logger.addSink(std::make_unique<RotatingFileLogSink>(filePath, 10 * 1024 * 1024, 3));
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+            }
+        }
+    });
+    return logger;
+}
+
+bool Logger::log(LogLevel level, const char* category, std::string message) {
+    std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+        slot = &slots[pos & mask];
+        const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+        if (difference == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // Kolejka pełna: komunikat jest odrzucany, aby nie blokować wywołującego
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->record.level = level;
+    slot->record.time = std::chrono::system_clock::now();
+    slot->record.threadId = currentThreadId();
+    slot->record.category = category;
+    slot->record.message = std::move(message);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    enqueued.fetch_add(1, std::memory_order_release);
+
+    if (sinkIdle.load(std::memory_order_acquire)) {
+        wakeCondition.notify_one();
+    }
+    return true;
+}
+
+bool Logger::tryPop(LogRecord& record) {
+    Slot& slot = slots[dequeuePos & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+        return false;
+    }
+    record = std::move(slot.record);
+    slot.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+    ++dequeuePos;
+    return true;
+}
+
+void Logger::sinkLoop() {
+    LogRecord record;
+    for (;;) {
+        bool wroteAny = false;
+        while (tryPop(record)) {
+            const std::string line = format(record);
+            {
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                for (auto& sink : sinks) {
+                    sink->write(record, line);
+                }
+            }
+            processed.fetch_add(1, std::memory_order_release);
+            wroteAny = true;
+        }
+
+        if (wroteAny) {
+            {
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                for (auto& sink : sinks) {
+                    sink->flush();
+                }
+            }
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            flushedCondition.notify_all();
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        if (stopping.load() && processed.load() >= enqueued.load()) {
+            break;
+        }
+        sinkIdle.store(true, std::memory_order_release);
+        // Limit czasu chroni przed utratą powiadomienia wysłanego bez blokady
+        wakeCondition.wait_for(lock, std::chrono::milliseconds(50), [this]() {
+            return stopping.load() ||
+                   slots[dequeuePos & mask].sequence.load(std::memory_order_acquire) == dequeuePos + 1;
+        });
+        sinkIdle.store(false, std::memory_order_release);
+    }
+}
+
+void Logger::setLevel(LogLevel level) {
+    minLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void Logger::addSink(std::unique_ptr<LogSink> sink) {
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    sinks.push_back(std::move(sink));
+}
+
+void Logger::clearSinks() {
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    for (auto& sink : sinks) {
+        sink->flush();
+    }
+    sinks.clear();
+}
+
+void Logger::flush() {
+    const std::uint64_t target = enqueued.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (processed.load(std::memory_order_acquire) < target) {
+        wakeCondition.notify_one();
+        flushedCondition.wait_for(lock, std::chrono::milliseconds(10));
+    }
+}
+
+const char* Logger::levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO";
+        case LogLevel::Warning: return "WARN";
+        case LogLevel::Error: return "ERROR";
+        default: return "OFF";
+    }
+}
+
+LogLevel Logger::parseLevel(const std::string& name, LogLevel fallback) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lower == "trace") return LogLevel::Trace;
+    if (lower == "debug") return LogLevel::Debug;
+    if (lower == "info") return LogLevel::Info;
+    if (lower == "warning" || lower == "warn") return LogLevel::Warning;
+    if (lower == "error") return LogLevel::Error;
+    if (lower == "off") return LogLevel::Off;
+    return fallback;
+}
+
+std::string Logger::format(const LogRecord& record) {
+    const std::time_t seconds = std::chrono::system_clock::to_time_t(record.time);
+    const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+        record.time.time_since_epoch()).count() % 1000;
+
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &local);
+
+    char prefix[96];
+    std::snprintf(prefix, sizeof(prefix), "%s.%03d %-5s [%s] #%u ", timestamp, static_cast<int>(millis),
+                  levelName(record.level), record.category, record.threadId);
+    return prefix + record.message;
+}
@@ -4,6 +4,8 @@
  */
 
  #include "main_window.hpp"
+ #include "logger.hpp"
+ #include "trace.hpp"
  #include <QMessageBox>
  #include <QFileInfo>
  #include <QDir>
@@ -18,12 +20,31 @@
  #include <QListWidget>
  #include <QPushButton>
  #include <QLabel>
+ #include <QTimer>
+ #include <QSignalBlocker>
  #include <fstream>
  #include <algorithm>
+ #include <cmath>
  #include <iostream>
+ #include <unordered_map>
  #include <QColor>
  #include <QGraphicsDropShadowEffect>
  
+ namespace {
+ 
+ /**
+  * @brief Zamienia znacznik czasu pomiaru na czas osi wykresu
+  * @param timestamp Sekundy od epoki; znaczniki GIOŚ są czasem lokalnym zapisanym jak UTC
+  * @return Milisekundy od epoki dla QDateTimeAxis
+  */
+ qint64 chartTime(std::int64_t timestamp) {
+     QDateTime dateTime = QDateTime::fromSecsSinceEpoch(timestamp, Qt::UTC);
+     dateTime.setTimeSpec(Qt::LocalTime);
+     return dateTime.toMSecsSinceEpoch();
+ }
+ 
+ } // namespace
+ 
  /**
   * @brief Konstruktor głównego okna
   * @param parent Wskaźnik na rodzica (domyślnie nullptr)
@@ -33,23 +54,41 @@
      setWindowTitle("Monitor Jakości Powietrza");
      resize(800, 600);
      
+     // Nazwa wątku interfejsu w śladzie wykonania (AIRQUALITY_TRACE)
+     if (Tracer::enabled()) {
+         Tracer::setThreadName("ui");
+     }
+     
      // Inicjalizacja klienta API
      apiClient = std::make_unique<ApiClient>();
      
+     // Korutyny wznawiane w pętli zdarzeń okna; potok trybu "Wszystkie" działa w osobnym wątku
+     uiExecutor = std::make_unique<QtExecutor>(this);
+     pipelineExecutor = std::make_unique<WorkerExecutor>();
+     
      // Ustawienie ścieżki eksportu
      exportPath = "../export";
      
      // Tworzenie katalogu eksportu, jeśli nie istnieje
      QDir().mkpath(exportPath);
      
-     // Inicjalizacja interfejsu użytkownika
+     // Inicjalizacja interfejsu użytkownika (bez wykresu i dialogów - powstają przy pierwszym użyciu)
      initUI();
      
+     // Pierwsze narysowanie okna jest wykrywane na centralnym widgecie
+     centralWidget()->installEventFilter(this);
+     
      // Wczytanie stacji pomiarowych
      loadStations();
      
      // Połączenie sygnału zakończenia wczytywania stacji
      connect(&stationsWatcher, &QFutureWatcher<std::vector<Station>>::finished, this, &MainWindow::onStationsLoaded);
+     
+     // Połączenie sygnału zakończenia wczytywania pliku z pomiarami
+     connect(&savedFileWatcher, &QFutureWatcher<SavedFileResult>::finished, this, &MainWindow::onSavedMeasurementLoaded);
+     
+     // Połączenie sygnału zakończenia pobierania porównania stacji
+     connect(&comparisonWatcher, &QFutureWatcher<StationComparison>::finished, this, &MainWindow::onComparisonLoaded);
  }
  
  /**
@@ -57,11 +96,33 @@
   * Zwalnia zasoby używane przez główne okno.
   */
  MainWindow::~MainWindow() {
+     // Przerwany potok kończy zapytania w toku i nie czeka na publikację w niszczonym oknie
+     if (activePipeline) {
+         activePipeline->cancel();
+     }
+     // Zakończenie wątku potoku, zanim zniknie okno: korutyna przerwanego przebiegu kończy się w nim
+     pipelineExecutor.reset();
+ }
+ 
+ /**
+  * @brief Wykrywa pierwsze narysowanie okna
+  * @param watched Obserwowany obiekt
+  * @param event Zdarzenie
+  * @return false - zdarzenie jest przekazywane dalej
+  * Po pierwszym zdarzeniu rysowania emituje firstFrameShown() i przestaje obserwować widget.
+  */
+ bool MainWindow::eventFilter(QObject *watched, QEvent *event) {
+     if (!firstFrameReported && watched == centralWidget() && event->type() == QEvent::Paint) {
+         firstFrameReported = true;
+         watched->removeEventFilter(this);
+         emit firstFrameShown();
+     }
+     return QMainWindow::eventFilter(watched, event);
  }
  
  /**
   * @brief Inicjalizuje interfejs użytkownika
-  * Tworzy elementy UI (ComboBox, przyciski, tabelę, wykres), ustala ich układ i łączy sygnały ze slotami.
+  * Tworzy elementy UI (ComboBox, przyciski, tabelę, zakładkę wykresu), ustala ich układ i łączy sygnały ze slotami.
   * Dodaje stylizację dla zaokrąglonych rogów i płynnego wyglądu.
   */
  void MainWindow::initUI() {
@@ -160,14 +221,40 @@
      //refreshButton = new QPushButton("Odśwież dane", this);
      saveButton = new QPushButton("Zapisz dane", this);
      openSavedButton = new QPushButton("Przeglądaj zapisane dane", this);
+     diagnosticsButton = new QPushButton("Diagnostyka", this);
+     compareButton = new QPushButton("Porównaj stacje", this);
+     saveFormatComboBox = new QComboBox(this);
+     saveFormatComboBox->addItem("JSON");
+     saveFormatComboBox->addItem("Skompresowany (.aqz)");
+     saveFormatComboBox->addItem("Przyrostowy (.jsonl)");
      saveButton->setEnabled(false);
      //buttonLayout->addWidget(refreshButton);
      buttonLayout->addWidget(saveButton);
+     buttonLayout->addWidget(saveFormatComboBox);
      buttonLayout->addWidget(openSavedButton);
+     buttonLayout->addWidget(compareButton);
+     buttonLayout->addWidget(diagnosticsButton);
+     
+     // Zakres dat wyświetlanych pomiarów
+     QHBoxLayout *rangeLayout = new QHBoxLayout();
+     fromDateEdit = new QDateEdit(this);
+     toDateEdit = new QDateEdit(this);
+     for (QDateEdit *dateEdit : {fromDateEdit, toDateEdit}) {
+         dateEdit->setCalendarPopup(true);
+         dateEdit->setDisplayFormat("dd.MM.yyyy");
+         dateEdit->setEnabled(false);
+     }
+     statisticsLabel = new QLabel(this);
+     rangeLayout->addWidget(new QLabel("Od:", this));
+     rangeLayout->addWidget(fromDateEdit);
+     rangeLayout->addWidget(new QLabel("Do:", this));
+     rangeLayout->addWidget(toDateEdit);
+     rangeLayout->addWidget(statisticsLabel, 1);
      
      // Dodanie układów do grupy wyboru
      selectionLayout->addLayout(stationLayout);
      selectionLayout->addLayout(sensorLayout);
+     selectionLayout->addLayout(rangeLayout);
      selectionLayout->addLayout(buttonLayout);
      
      // Zakładki dla tabeli i wykresu
@@ -179,17 +266,14 @@
      dataTable->setHorizontalHeaderLabels({"Data i czas", "Wartość"});
      dataTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
      
-     // Wykres
-     QChart *chart = new QChart();
-     chart->setTitle("Pomiary");
-     chart->legend()->hide();
-     
-     chartView = new QChartView(chart, this);
-     chartView->setRenderHint(QPainter::Antialiasing);
+     // Zakładka wykresu - QChartView jest tworzony przy pierwszym wykresie lub otwarciu zakładki
+     chartContainer = new QWidget(this);
+     QVBoxLayout *chartLayout = new QVBoxLayout(chartContainer);
+     chartLayout->setContentsMargins(0, 0, 0, 0);
      
      // Dodanie zakładek do tabWidget
      tabWidget->addTab(dataTable, "Dane tabelaryczne");
-     tabWidget->addTab(chartView, "Wykres");
+     tabWidget->addTab(chartContainer, "Wykres");
      
      // Pasek statusu
      statusLabel = new QLabel("Gotowy", this);
@@ -221,7 +305,36 @@
      connect(sensorComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::onSensorSelected);
      //connect(refreshButton, &QPushButton::clicked, this, &MainWindow::refreshData);
      connect(saveButton, &QPushButton::clicked, this, &MainWindow::saveMeasurements);
+     connect(fromDateEdit, &QDateEdit::dateChanged, this, &MainWindow::onDateRangeChanged);
+     connect(toDateEdit, &QDateEdit::dateChanged, this, &MainWindow::onDateRangeChanged);
      connect(openSavedButton, &QPushButton::clicked, this, &MainWindow::openSavedMeasurements);
+     connect(diagnosticsButton, &QPushButton::clicked, this, &MainWindow::openDiagnostics);
+     connect(compareButton, &QPushButton::clicked, this, &MainWindow::openComparison);
+     connect(tabWidget, &QTabWidget::currentChanged, this, [this](int index) {
+         if (index == 1) {
+             ensureChartView();
+         }
+     });
+ }
+ 
+ /**
+  * @brief Zwraca widok wykresu, tworząc go przy pierwszym użyciu
+  * @return Widok wykresu
+  * Utworzenie QChartView (scena graficzna, wygładzanie) jest najdroższą częścią budowy okna,
+  * więc odbywa się dopiero, gdy wykres jest potrzebny.
+  */
+ QChartView* MainWindow::ensureChartView() {
+     if (!chartView) {
+         TRACE_SCOPE("MainWindow::ensureChartView");
+         QChart *chart = new QChart();
+         chart->setTitle("Pomiary");
+         chart->legend()->hide();
+         
+         chartView = new QChartView(chart, chartContainer);
+         chartView->setRenderHint(QPainter::Antialiasing);
+         chartContainer->layout()->addWidget(chartView);
+     }
+     return chartView;
  }
  
  /**
@@ -233,6 +346,7 @@
     
     // Funkcja do asynchronicznego wczytywania stacji
     auto loadStationsAsync = [this]() -> std::vector<Station> {
+        TRACE_SCOPE("MainWindow::loadStationsAsync");
         if (!apiClient->isApiAvailable()) {
             QFileInfo checkFile("../data/stations.json"); // Zmiana ścieżki
             if (checkFile.exists() && checkFile.isFile()) {
@@ -260,11 +374,16 @@
   * Aktualizuje interfejs po zakończeniu operacji pobierania stacji.
   */
  void MainWindow::onStationsLoaded() {
+     TRACE_SCOPE("MainWindow::onStationsLoaded");
      stations = stationsWatcher.result();
      
      if (stations.empty()) {
-         QMessageBox::warning(this, "Błąd", "Nie udało się pobrać stacji pomiarowych");
          statusLabel->setText("Błąd pobierania danych");
+         if (!interactiveReported) {
+             interactiveReported = true;
+             emit interactive();
+         }
+         QMessageBox::warning(this, "Błąd", "Nie udało się pobrać stacji pomiarowych");
          return;
      }
      
@@ -280,6 +399,10 @@
      }
      
      statusLabel->setText("Gotowy");
+     if (!interactiveReported) {
+         interactiveReported = true;
+         emit interactive();
+     }
  }
  
  /**
@@ -294,6 +417,7 @@
      
      // Pobranie ID wybranej stacji
      int stationId = stations[index].id;
+     TRACE_SCOPE_DETAIL("MainWindow::onStationSelected", "stationId=" + std::to_string(stationId));
      
      statusLabel->setText("Ładowanie czujników...");
      
@@ -306,14 +430,18 @@
          return;
      }
      
-     // Przydzielanie kolorów czujnikom
+     // Przydzielanie kolorów czujnikom: znane parametry mają stały kolor na każdej stacji
      sensorColors.clear();
      QList<QColor> colors = {
          Qt::blue, Qt::red, Qt::green, Qt::magenta, Qt::cyan,
          Qt::darkYellow, Qt::darkCyan, Qt::darkMagenta
      };
      for (size_t i = 0; i < sensors.size(); ++i) {
-         sensorColors[sensors[i].id] = colors[i % colors.size()];
+         if (const PollutantInfo* info = pollutantInfo(sensors[i].pollutant)) {
+             sensorColors[sensors[i].id] = QColor(QString::fromLatin1(info->color.data(), static_cast<int>(info->color.size())));
+         } else {
+             sensorColors[sensors[i].id] = colors[i % colors.size()];
+         }
      }
      
      // Wypełnienie ComboBox czujnikami
@@ -339,58 +467,142 @@
      if (index < 0 || index >= static_cast<int>(sensors.size()) + 1) {
          return;
      }
+     TRACE_SCOPE_DETAIL("MainWindow::onSensorSelected", "index=" + std::to_string(index));
      
      statusLabel->setText("Ładowanie pomiarów...");
      
+     // Nowy wybór unieważnia trwające pobieranie trybu "Wszystkie"
+     const std::uint64_t requestId = startMeasurementRequest();
+     
      if (index == 0) { // Wybrano "Wszystkie"
-         measurements.clear();
-         bool anyMeasurements = false;
-         
-         // Pobranie pomiarów dla wszystkich czujników
+         // Pomiary czujników są pobierane równocześnie, a okno w tym czasie pozostaje responsywne
+         spawn(loadAllMeasurements(requestId));
+         return;
+     }
+     
+     // Pobranie ID wybranego czujnika
+     int sensorId = sensors[index - 1].id;
+     frame = ResampledFrame();
+     
+     // Pobranie pomiarów dla czujnika
+     measurements = apiClient->getMeasurements(sensorId);
+     
+     if (measurements.empty()) {
+         QMessageBox::warning(this, "Informacja", "Brak pomiarów dla wybranego czujnika");
+         setDisplayedSeries();
+         dataTable->setRowCount(0);
+         statusLabel->setText("Brak danych pomiarowych");
+         saveButton->setEnabled(false);
+         return;
+     }
+     
+     // Wypełnienie tabeli danymi
+     setDisplayedSeries();
+     fillDataTable();
+     
+     // Wyświetlenie wykresu dla wybranego parametru
+     QString paramName = QString::fromUtf8(sensors[index - 1].paramName.c_str());
+     QString paramFormula = QString::fromUtf8(sensors[index - 1].paramFormula.c_str());
+     displayChart(paramName, paramFormula, false);
+     
+     // Aktywacja przycisku zapisu
+     saveButton->setEnabled(true);
+     
+     statusLabel->setText("Gotowy");
+ }
+ 
+ /**
+  * @brief Unieważnia trwające pobieranie pomiarów przed zastąpieniem wyświetlanych danych
+  * @return Numer nowego żądania
+  * Trwający potok trybu "Wszystkie" jest przerywany, a wyniki ze starszym numerem są odrzucane.
+  */
+ std::uint64_t MainWindow::startMeasurementRequest() {
+     if (activePipeline) {
+         activePipeline->cancel();
+         activePipeline.reset();
+     }
+     return ++measurementRequestId;
+ }
+ 
+ /**
+  * @brief Pobiera równocześnie pomiary wszystkich czujników stacji i wyświetla je (tryb "Wszystkie")
+  * @param requestId Numer wyboru czujnika; wynik jest odrzucany, jeśli w międzyczasie wybrano inny
+  * Pomiary przechodzą przez potok FetchPipeline uruchomiony w wątku roboczym: zapytania obsługuje
+  * wątek I/O, dekodowanie pula wątków, a każdy gotowy czujnik jest dołączany do resamplera
+  * w wątku interfejsu, gdy kolejne są jeszcze pobierane. Tabela i wykres powstają na końcu.
+  */
+ Task<void> MainWindow::loadAllMeasurements(std::uint64_t requestId) {
+     // Nowa stacja - nowa siatka z kolumną na czujnik; przy odświeżeniu dopisywane są tylko nowe godziny
+     const int stationId = sensors.empty() ? -1 : sensors.front().stationId;
+     if (stationId != resamplerStationId) {
+         resampler = Resampler(ResampleStep::Hour);
          for (const auto& sensor : sensors) {
-             auto sensorMeasurements = apiClient->getMeasurements(sensor.id);
-             if (!sensorMeasurements.empty()) {
-                 measurements.insert(measurements.end(), sensorMeasurements.begin(), sensorMeasurements.end());
-                 anyMeasurements = true;
-             }
+             resampler.addColumn(sensor.paramFormula);
          }
-         
-         if (!anyMeasurements) {
-             QMessageBox::warning(this, "Informacja", "Brak pomiarów dla wszystkich czujników");
-             dataTable->setRowCount(0);
-             statusLabel->setText("Brak danych pomiarowych");
-             saveButton->setEnabled(false);
+         resamplerStationId = stationId;
+     }
+     measurements.clear();
+     saveButton->setEnabled(false);
+     
+     std::vector<int> sensorIds;
+     std::unordered_map<int, std::size_t> columnOfSensor;
+     for (std::size_t i = 0; i < sensors.size(); ++i) {
+         sensorIds.push_back(sensors[i].id);
+         columnOfSensor[sensors[i].id] = i;
+     }
+     
+     auto pipeline = std::make_shared<FetchPipeline>(*apiClient);
+     activePipeline = pipeline;
+     
+     // Publikacja w wątku interfejsu: dołączenie pomiarów czujnika do resamplera
+     std::size_t published = 0;
+     pipeline->setPublishStage([this, requestId, &columnOfSensor, &published, total = sensorIds.size()](PipelineItem& item) {
+         if (requestId != measurementRequestId) {
              return;
          }
-         
-         // Wypełnienie tabeli danymi
-         fillDataTable();
-         
-         // Wyświetlenie wykresu dla wszystkich parametrów
-         displayChart("Wszystkie parametry", "", false);
-     } else {
-         // Pobranie ID wybranego czujnika
-         int sensorId = sensors[index - 1].id;
-         
-         // Pobranie pomiarów dla czujnika
-         measurements = apiClient->getMeasurements(sensorId);
-         
-         if (measurements.empty()) {
-             QMessageBox::warning(this, "Informacja", "Brak pomiarów dla wybranego czujnika");
-             dataTable->setRowCount(0);
-             statusLabel->setText("Brak danych pomiarowych");
-             saveButton->setEnabled(false);
+         statusLabel->setText(QString("Ładowanie pomiarów... %1/%2").arg(++published).arg(total));
+         if (!item.error.empty() || item.measurements.empty()) {
              return;
          }
-         
-         // Wypełnienie tabeli danymi
-         fillDataTable();
-         
-         // Wyświetlenie wykresu dla wybranego parametru
-         QString paramName = QString::fromUtf8(sensors[index - 1].paramName.c_str());
-         QString paramFormula = QString::fromUtf8(sensors[index - 1].paramFormula.c_str());
-         displayChart(paramName, paramFormula, false);
+         resampler.append(columnOfSensor.at(item.sensorId), item.series);
+         measurements.insert(measurements.end(), item.measurements.begin(), item.measurements.end());
+     }, uiExecutor.get());
+     
+     co_await pipelineExecutor->schedule();
+     const PipelineReport report = pipeline->run(sensorIds);
+     // Przebieg przerwany (nowy wybór lub zamykane okno) kończy się w wątku potoku,
+     // bez powrotu do wątku interfejsu
+     if (pipeline->isCancelled()) {
+         co_return;
      }
+     co_await uiExecutor->schedule();
+     
+     LOG_INFO("pipeline", "Tryb Wszystkie: " << report.summary());
+     if (activePipeline == pipeline) {
+         activePipeline.reset();
+     }
+     // W międzyczasie wybrano inny czujnik lub stację
+     if (requestId != measurementRequestId) {
+         co_return;
+     }
+     const bool anyMeasurements = !measurements.empty();
+     frame = resampler.frame(GapFill::None);
+     
+     if (!anyMeasurements) {
+         QMessageBox::warning(this, "Informacja", "Brak pomiarów dla wszystkich czujników");
+         setDisplayedSeries();
+         dataTable->setRowCount(0);
+         statusLabel->setText("Brak danych pomiarowych");
+         saveButton->setEnabled(false);
+         co_return;
+     }
+     
+     // Wypełnienie tabeli danymi
+     setDisplayedSeries();
+     fillDataTable();
+     
+     // Wyświetlenie wykresu dla wszystkich parametrów
+     displayChart("Wszystkie parametry", "", false);
      
      // Aktywacja przycisku zapisu
      saveButton->setEnabled(true);
@@ -411,31 +623,265 @@
  
  /**
   * @brief Wypełnia tabelę danymi pomiarowymi
-  * Czyści tabelę i wypełnia ją danymi z wektora measurements, sortując po dacie malejąco.
+  * Wypełnia tabelę pomiarami z wybranego zakresu dat (najnowsze na górze). Istniejące komórki
+  * są ponownie używane, więc zmiana zakresu nie tworzy tabeli od nowa.
+  * W trybie "Wszystkie" wiersz odpowiada godzinie, a kolumny parametrom (brak pomiaru to "-").
   */
  void MainWindow::fillDataTable() {
-     // Czyszczenie tabeli
-     dataTable->setRowCount(0);
+     TRACE_SCOPE_DETAIL("MainWindow::fillDataTable", "rows=" + std::to_string(displayedSeries.size()));
+     const std::pair<std::int64_t, std::int64_t> range = selectedDateRange();
      
-     // Ustawienie liczby wierszy
-     dataTable->setRowCount(measurements.size());
+     // Ustawia tekst komórki, tworząc ją tylko wtedy, gdy jeszcze nie istnieje
+     auto setCell = [this](int row, int column, const QString& text) {
+         if (QTableWidgetItem *item = dataTable->item(row, column)) {
+             item->setText(text);
+         } else {
+             dataTable->setItem(row, column, new QTableWidgetItem(text));
+         }
+     };
      
-     // Wypełnienie tabeli danymi
-     for (size_t i = 0; i < measurements.size(); ++i) {
-         const auto& measurement = measurements[i];
+     if (!frame.columns.empty()) {
+         QStringList headers{"Data i czas"};
+         for (const auto& name : frame.names) {
+             headers << QString::fromStdString(name);
+         }
+         if (dataTable->columnCount() != headers.size()) {
+             dataTable->setRowCount(0);
+             dataTable->setColumnCount(headers.size());
+         }
+         dataTable->setHorizontalHeaderLabels(headers);
+         
+         const auto [first, last] = frameRowRange(range);
+         const int rows = static_cast<int>(std::max<std::int64_t>(0, last - first + 1));
+         dataTable->setRowCount(rows);
+         for (int row = 0; row < rows; ++row) {
+             const std::size_t source = static_cast<std::size_t>(last - row);
+             QDateTime dateTime = QDateTime::fromSecsSinceEpoch(frame.timestamp(source), Qt::UTC);
+             setCell(row, 0, dateTime.toString("dd.MM.yyyy hh:mm"));
+             for (std::size_t c = 0; c < frame.columns.size(); ++c) {
+                 const double value = frame.columns[c][source];
+                 setCell(row, static_cast<int>(c) + 1, std::isnan(value) ? QString("-") : QString::number(value, 'f', 2));
+             }
+         }
+         return;
+     }
+     
+     if (dataTable->columnCount() != 2) {
+         dataTable->setRowCount(0);
+         dataTable->setColumnCount(2);
+     }
+     dataTable->setHorizontalHeaderLabels({"Data i czas", "Wartość"});
+     
+     // Fragment posortowanej serii (wyszukiwanie binarne, bez kopiowania)
+     const SeriesSlice slice = displayedSeries.range(range.first, range.second);
+     const int rows = static_cast<int>(slice.size());
+     dataTable->setRowCount(rows);
+     for (int row = 0; row < rows; ++row) {
+         const std::size_t source = slice.size() - 1 - static_cast<std::size_t>(row);
+         QDateTime dateTime = QDateTime::fromSecsSinceEpoch(slice.timestamps[source], Qt::UTC);
+         setCell(row, 0, dateTime.toString("dd.MM.yyyy hh:mm"));
+         setCell(row, 1, QString::number(slice.values[source], 'f', 2));
+     }
+ }
+ 
+ /**
+  * @brief Ustawia serię wyświetlanych pomiarów i pełny zakres dat
+  * Tworzy posortowaną serię kolumnową z wektora measurements i ustawia kontrolki dat
+  * na pierwszy i ostatni dzień pomiarów.
+  */
+ void MainWindow::setDisplayedSeries() {
+     displayedSeries = MeasurementSeries::fromMeasurements(measurements);
+     displayedSeries.sortByTime();
+     
+     const bool hasData = !displayedSeries.empty();
+     fromDateEdit->setEnabled(hasData);
+     toDateEdit->setEnabled(hasData);
+     if (!hasData) {
+         statisticsLabel->clear();
+         return;
+     }
+     
+     const QDate firstDate = QDateTime::fromSecsSinceEpoch(displayedSeries.timestamps.front(), Qt::UTC).date();
+     const QDate lastDate = QDateTime::fromSecsSinceEpoch(displayedSeries.timestamps.back(), Qt::UTC).date();
+     const QSignalBlocker fromBlocker(fromDateEdit);
+     const QSignalBlocker toBlocker(toDateEdit);
+     fromDateEdit->setDateRange(firstDate, lastDate);
+     toDateEdit->setDateRange(firstDate, lastDate);
+     fromDateEdit->setDate(firstDate);
+     toDateEdit->setDate(lastDate);
+     updateRangeStatistics();
+ }
+ 
+ /**
+  * @brief Zwraca wybrany zakres dat jako znaczniki czasu
+  * @return Para (początek dnia "od", koniec dnia "do") w sekundach
+  */
+ std::pair<std::int64_t, std::int64_t> MainWindow::selectedDateRange() const {
+     if (!fromDateEdit->isEnabled()) {
+         return {std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()};
+     }
+     const std::int64_t from = QDateTime(fromDateEdit->date(), QTime(0, 0), Qt::UTC).toSecsSinceEpoch();
+     const std::int64_t to = QDateTime(toDateEdit->date(), QTime(23, 59, 59), Qt::UTC).toSecsSinceEpoch();
+     return {from, to};
+ }
+ 
+ /**
+  * @brief Zwraca wiersze ramki trybu "Wszystkie" leżące w zakresie dat
+  * @param range Zakres (od, do) w sekundach
+  * @return Para (pierwszy, ostatni) indeks wiersza; ostatni < pierwszy dla pustego zakresu
+  * Wiersze ramki leżą w stałych odstępach, więc zakres dat to zakres indeksów.
+  */
+ std::pair<std::int64_t, std::int64_t> MainWindow::frameRowRange(const std::pair<std::int64_t, std::int64_t>& range) const {
+     const std::int64_t lastRow = static_cast<std::int64_t>(frame.rows()) - 1;
+     const std::int64_t first = range.first <= frame.start ? 0 :
+         std::min(lastRow + 1, (range.first - frame.start + frame.step - 1) / frame.step);
+     const std::int64_t last = range.second < frame.start ? -1 :
+         std::min(lastRow, (range.second - frame.start) / frame.step);
+     return {first, last};
+ }
+ 
+ /**
+  * @brief Zwraca pomiary jednej kolumny ramki trybu "Wszystkie" z podanych wierszy
+  * @param column Indeks kolumny (parametru)
+  * @param rows Para (pierwszy, ostatni) indeks wiersza
+  * @return Seria bez godzin, w których brak pomiaru
+  */
+ MeasurementSeries MainWindow::frameColumnSeries(std::size_t column, const std::pair<std::int64_t, std::int64_t>& rows) const {
+     MeasurementSeries series;
+     const std::vector<double>& values = frame.columns[column];
+     for (std::int64_t row = rows.first; row <= rows.second; ++row) {
+         const double value = values[static_cast<std::size_t>(row)];
+         if (!std::isnan(value)) {
+             series.append(frame.timestamp(static_cast<std::size_t>(row)), value);
+         }
+     }
+     return series;
+ }
+ 
+ /**
+  * @brief Aktualizuje statystyki wybranego zakresu dat
+  * Statystyki są liczone tylko dla fragmentu serii w zakresie; w trybie "Wszystkie" osobno
+  * dla każdego parametru z kolumn ramki, bo parametry mają różne jednostki.
+  */
+ void MainWindow::updateRangeStatistics() {
+     const std::pair<std::int64_t, std::int64_t> range = selectedDateRange();
+     
+     // Tryb "Wszystkie": parametry mają różne jednostki, więc każda kolumna ramki ma własne statystyki
+     if (!frame.columns.empty()) {
+         const auto [first, last] = frameRowRange(range);
+         QStringList parts;
+         for (std::size_t c = 0; c < frame.columns.size(); ++c) {
+             std::size_t count = 0;
+             double min = 0.0, max = 0.0, sum = 0.0;
+             for (std::int64_t row = first; row <= last; ++row) {
+                 const double value = frame.columns[c][static_cast<std::size_t>(row)];
+                 if (std::isnan(value)) {
+                     continue;
+                 }
+                 min = count == 0 ? value : std::min(min, value);
+                 max = count == 0 ? value : std::max(max, value);
+                 sum += value;
+                 ++count;
+             }
+             if (count > 0) {
+                 parts << QString("%1: min %2, max %3, średnia %4")
+                     .arg(QString::fromStdString(frame.names[c]))
+                     .arg(min, 0, 'f', 2)
+                     .arg(max, 0, 'f', 2)
+                     .arg(sum / static_cast<double>(count), 0, 'f', 2);
+             }
+         }
+         statisticsLabel->setText(parts.isEmpty() ? QString("Brak pomiarów w wybranym zakresie") : parts.join("; "));
+         return;
+     }
+     
+     const SeriesStatistics statistics = computeStatistics(displayedSeries.range(range.first, range.second));
+     if (statistics.count == 0) {
+         statisticsLabel->setText("Brak pomiarów w wybranym zakresie");
+         return;
+     }
+     statisticsLabel->setText(QString("Pomiarów: %1, min: %2, max: %3, średnia: %4")
+         .arg(statistics.count)
+         .arg(statistics.min, 0, 'f', 2)
+         .arg(statistics.max, 0, 'f', 2)
+         .arg(statistics.mean, 0, 'f', 2));
+ }
+ 
+ /**
+  * @brief Obsługuje zmianę zakresu dat
+  * Aktualizuje tabelę, statystyki i wykres (pojedynczego parametru lub "Wszystkie") bez ich ponownego tworzenia.
+  */
+ void MainWindow::onDateRangeChanged() {
+     TRACE_SCOPE("MainWindow::onDateRangeChanged");
+     if (fromDateEdit->date() > toDateEdit->date()) {
+         const QSignalBlocker blocker(toDateEdit);
+         toDateEdit->setDate(fromDateEdit->date());
+     }
+     
+     fillDataTable();
+     updateRangeStatistics();
+     
+     // Wykres pojedynczego parametru lub "Wszystkie": nowe punkty każdej serii jednym wywołaniem
+     // replace() i nowy zakres osi; wykres porównania stacji nie zależy od zakresu dat
+     QChart *chart = chartView ? chartView->chart() : nullptr;
+     if (!chart || (chartKind != ChartKind::Single && chartKind != ChartKind::AllParameters)) {
+         return;
+     }
+     const QList<QAbstractAxis*> axesX = chart->axes(Qt::Horizontal);
+     const QList<QAbstractAxis*> axesY = chart->axes(Qt::Vertical);
+     QDateTimeAxis *axisX = axesX.isEmpty() ? nullptr : qobject_cast<QDateTimeAxis*>(axesX.first());
+     QValueAxis *axisY = axesY.isEmpty() ? nullptr : qobject_cast<QValueAxis*>(axesY.first());
+     if (!axisX || !axisY) {
+         return;
+     }
+     
+     const std::pair<std::int64_t, std::int64_t> range = selectedDateRange();
+     const QList<QAbstractSeries*> chartSeries = chart->series();
+     double minValue = std::numeric_limits<double>::max();
+     double maxValue = std::numeric_limits<double>::lowest();
+     qint64 minTime = std::numeric_limits<qint64>::max();
+     qint64 maxTime = std::numeric_limits<qint64>::lowest();
+     for (int s = 0; s < chartSeries.size(); ++s) {
+         QLineSeries *series = qobject_cast<QLineSeries*>(chartSeries[s]);
+         if (!series) {
+             continue;
+         }
          
-         // Data i czas
-         QDateTime dateTime = QDateTime::fromString(QString::fromStdString(measurement.date), Qt::ISODate);
-         QTableWidgetItem *dateItem = new QTableWidgetItem(dateTime.toString("dd.MM.yyyy hh:mm"));
-         dataTable->setItem(i, 0, dateItem);
+         // "Wszystkie": wiersze kolumny ramki w zakresie; pojedynczy parametr: fragment displayedSeries
+         MeasurementSeries column;
+         SeriesSlice slice;
+         if (chartKind == ChartKind::AllParameters) {
+             const std::size_t index = static_cast<std::size_t>(s);
+             if (index >= chartFrameColumns.size() || chartFrameColumns[index] >= frame.columns.size()) {
+                 continue;
+             }
+             column = frameColumnSeries(chartFrameColumns[index], frameRowRange(range));
+             slice = SeriesSlice{column.timestamps.data(), column.values.data(), column.size(), 0};
+         } else {
+             slice = displayedSeries.range(range.first, range.second);
+         }
          
-         // Wartość pomiaru
-         QTableWidgetItem *valueItem = new QTableWidgetItem(QString::number(measurement.value, 'f', 2));
-         dataTable->setItem(i, 1, valueItem);
+         QVector<QPointF> points;
+         points.reserve(static_cast<int>(slice.size()));
+         for (std::size_t i = 0; i < slice.size(); ++i) {
+             const qint64 timestamp = chartTime(slice.timestamps[i]);
+             points.append(QPointF(timestamp, slice.values[i]));
+             minValue = std::min(minValue, slice.values[i]);
+             maxValue = std::max(maxValue, slice.values[i]);
+             minTime = std::min(minTime, timestamp);
+             maxTime = std::max(maxTime, timestamp);
+         }
+         series->replace(points);
      }
      
-     // Sortowanie po dacie malejąco
-     dataTable->sortItems(0, Qt::DescendingOrder);
+     // Brak pomiarów w zakresie - osie pozostają bez zmian
+     if (minTime > maxTime) {
+         return;
+     }
+     double margin = (maxValue - minValue) * 0.1;
+     if (margin < 0.001) margin = 0.1;
+     axisX->setRange(QDateTime::fromMSecsSinceEpoch(minTime), QDateTime::fromMSecsSinceEpoch(maxTime));
+     axisY->setRange(minValue - margin, maxValue + margin);
  }
  
  /**
@@ -447,16 +893,14 @@
   * Generuje wykres dla pojedynczego parametru lub wszystkich parametrów, używając spójnych kolorów.
   */
  bool MainWindow::displayChart(const QString& paramName, const QString& paramFormula, bool switchToChartTab) {
+     TRACE_SCOPE_DETAIL("MainWindow::displayChart", paramName.toStdString());
      if (measurements.empty()) {
          QMessageBox::information(this, "Informacja", "Brak danych do wyświetlenia na wykresie");
          return false;
      }
      
-     // Sprawdzenie poprawności chartView
-     if (!chartView) {
-         QMessageBox::critical(this, "Błąd", "Błąd komponentu wykresu");
-         return false;
-     }
+     // Widok wykresu przy pierwszym wykresie
+     ensureChartView();
      
      // Utworzenie nowego wykresu
      QChart *chart = new QChart();
@@ -472,23 +916,23 @@
          qint64 minTime = std::numeric_limits<qint64>::max();
          qint64 maxTime = std::numeric_limits<qint64>::lowest();
          
+         // Kolumny ramki kolejnych serii wykresu "Wszystkie" (do zmiany zakresu dat)
+         std::vector<std::size_t> frameColumns;
+         
+         const QByteArray formulaUtf8 = paramFormula.toUtf8();
+         const Pollutant selectedPollutant = pollutantFromCode(std::string_view(formulaUtf8.constData(), formulaUtf8.size()));
+         
          if (paramName == "Wszystkie parametry") {
              // Włączenie legendy dla wielu parametrów
              chart->legend()->show();
              
-             // Grupowanie pomiarów według czujników
-             std::map<int, std::vector<Measurement>> sensorMeasurements;
-             for (const auto& sensor : sensors) {
-                 auto measurements = apiClient->getMeasurements(sensor.id);
-                 if (!measurements.empty()) {
-                     sensorMeasurements[sensor.id] = measurements;
-                 }
-             }
-             
-             // Tworzenie serii dla każdego czujnika
-             for (const auto& sensor : sensors) {
-                 auto it = sensorMeasurements.find(sensor.id);
-                 if (it == sensorMeasurements.end()) {
+             // Seria dla każdego czujnika z kolumny ramki (kolumna c odpowiada czujnikowi sensors[c]),
+             // bez ponownego pobierania pomiarów w wątku interfejsu
+             const std::pair<std::int64_t, std::int64_t> allRows(0, static_cast<std::int64_t>(frame.rows()) - 1);
+             for (std::size_t c = 0; c < frame.columns.size() && c < sensors.size(); ++c) {
+                 const Sensor& sensor = sensors[c];
+                 const MeasurementSeries column = frameColumnSeries(c, allRows);
+                 if (column.empty()) {
                      continue;
                  }
                  
@@ -506,20 +950,20 @@
                  }
                  
                  // Wypełnienie serii danymi
-                 for (const auto& measurement : it->second) {
-                     QDateTime dateTime = QDateTime::fromString(QString::fromStdString(measurement.date), Qt::ISODate);
-                     qint64 timestamp = dateTime.toMSecsSinceEpoch();
-                     series->append(timestamp, measurement.value);
+                 for (std::size_t i = 0; i < column.size(); ++i) {
+                     qint64 timestamp = chartTime(column.timestamps[i]);
+                     series->append(timestamp, column.values[i]);
                      
                      // Aktualizacja zakresów
-                     minValue = std::min(minValue, measurement.value);
-                     maxValue = std::max(maxValue, measurement.value);
+                     minValue = std::min(minValue, column.values[i]);
+                     maxValue = std::max(maxValue, column.values[i]);
                      minTime = std::min(minTime, timestamp);
                      maxTime = std::max(maxTime, timestamp);
                  }
                  
                  if (series->count() > 0) {
                      chart->addSeries(series);
+                     frameColumns.push_back(c);
                  } else {
                      delete series;
                  }
@@ -531,11 +975,14 @@
              QLineSeries *series = new QLineSeries();
              series->setName(paramName);
              
-             // Wyszukiwanie ID czujnika
+             // Wyszukiwanie ID czujnika po typowanym parametrze (napisy tylko dla parametrów spoza tabeli)
              int sensorId = -1;
              for (const auto& sensor : sensors) {
-                 if (QString::fromStdString(sensor.paramName) == paramName &&
-                     QString::fromStdString(sensor.paramFormula) == paramFormula) {
+                 bool matches = selectedPollutant != Pollutant::Unknown ?
+                     sensor.pollutant == selectedPollutant :
+                     QString::fromStdString(sensor.paramName) == paramName &&
+                         QString::fromStdString(sensor.paramFormula) == paramFormula;
+                 if (matches) {
                      sensorId = sensor.id;
                      break;
                  }
@@ -608,7 +1055,11 @@
          // Konfiguracja osi Y (wartości)
          QValueAxis *axisY = new QValueAxis;
          axisY->setLabelFormat("%.2f");
-         axisY->setTitleText(paramName == "Wszystkie parametry" ? "Wartości" : paramFormula);
+         QString axisTitle = paramFormula;
+         if (const PollutantInfo* info = pollutantInfo(selectedPollutant)) {
+             axisTitle += QString(" [%1]").arg(QString::fromUtf8(info->unit.data(), static_cast<int>(info->unit.size())));
+         }
+         axisY->setTitleText(paramName == "Wszystkie parametry" ? "Wartości" : axisTitle);
          axisY->setRange(minValue, maxValue);
          
          // Dodanie osi do wykresu
@@ -626,6 +1077,8 @@
          
          // Ustawienie wykresu w widoku
          chartView->setChart(chart);
+         chartKind = paramName == "Wszystkie parametry" ? ChartKind::AllParameters : ChartKind::Single;
+         chartFrameColumns = std::move(frameColumns);
          
          // Włączenie animacji
          chart->setAnimationOptions(QChart::SeriesAnimations);
@@ -667,6 +1120,23 @@
          return;
      }
      
+     // Eksport przyrostowy: stały plik na stację i czujnik, dopisywane są tylko nowe pomiary
+     if (saveFormatComboBox->currentIndex() == 2) {
+         if (sensorIndex != 0 && sensorIndex - 1 >= static_cast<int>(sensors.size())) {
+             QMessageBox::warning(this, "Błąd", "Nie wybrano prawidłowego czujnika");
+             return;
+         }
+         appendMeasurementsIncremental(stationIndex, sensorIndex);
+         return;
+     }
+     
+     // Plik skompresowany zawiera jedną serię, więc w trybie "Wszystkie" każdy czujnik ma własny plik
+     const bool compressed = saveFormatComboBox->currentIndex() == 1;
+     if (compressed && sensorIndex == 0) {
+         saveCompressedPerSensor(stationIndex);
+         return;
+     }
+     
      // Generowanie nazwy pliku
      QString defaultFileName;
      if (sensorIndex == 0) {
@@ -685,7 +1155,7 @@
      }
      
      // Ścieżka do pliku
-     QString filePath = exportPath + "/" + defaultFileName + ".json";
+     QString filePath = exportPath + "/" + defaultFileName + (compressed ? ".aqz" : ".json");
      
      bool success = saveMeasurementsToJSON(filePath);
      
@@ -699,6 +1169,162 @@
      }
  }
  
+ /**
+  * @brief Zapisuje pomiary trybu "Wszystkie" do plików skompresowanych, osobno dla każdego czujnika
+  * @param stationIndex Indeks stacji
+  * Każdy plik zawiera kolumnę czujnika z ramki i metadane tego czujnika, więc po wczytaniu
+  * lub imporcie pomiary różnych parametrów nie są ze sobą mieszane.
+  */
+ void MainWindow::saveCompressedPerSensor(int stationIndex) {
+     QDir().mkpath(exportPath);
+     const QString stationName = QString::fromStdString(stations[stationIndex].name).simplified().replace(" ", "_");
+     const QString date = QDateTime::currentDateTime().toString("yyyy-MM-dd_HH-mm");
+     
+     QStringList files;
+     try {
+         const std::pair<std::int64_t, std::int64_t> allRows(0, static_cast<std::int64_t>(frame.rows()) - 1);
+         for (std::size_t c = 0; c < frame.columns.size() && c < sensors.size(); ++c) {
+             const MeasurementSeries series = frameColumnSeries(c, allRows);
+             if (series.empty()) {
+                 continue;
+             }
+             const QString filePath = exportPath + "/" + QString("pomiary_%1_%2_%3.aqz")
+                 .arg(stationName)
+                 .arg(QString::fromStdString(sensors[c].paramFormula))
+                 .arg(date);
+             MeasurementFileWriter::saveCompressed(filePath.toStdString(),
+                                                   exportMetadata(stationIndex, static_cast<int>(c) + 1), series);
+             files << QFileInfo(filePath).fileName();
+         }
+     }
+     catch (const std::exception& e) {
+         statusLabel->setText("Błąd podczas zapisywania danych");
+         QMessageBox::critical(this, "Błąd", 
+             QString("Wystąpił błąd podczas zapisywania do pliku skompresowanego: %1").arg(e.what()));
+         return;
+     }
+     
+     if (files.isEmpty()) {
+         QMessageBox::warning(this, "Ostrzeżenie", "Brak danych do zapisania");
+         return;
+     }
+     statusLabel->setText(QString("Zapisano dane do plików: %1").arg(files.join(", ")));
+     QMessageBox::information(this, "Informacja", 
+         QString("Dane zostały zapisane pomyślnie do plików:\n%1").arg(files.join("\n")));
+ }
+ 
+ /**
+  * @brief Dopisuje nowe pomiary do plików eksportu przyrostowego
+  * @param stationIndex Indeks stacji
+  * @param sensorIndex Indeks w ComboBox czujników (0 = "Wszystkie")
+  * W trybie "Wszystkie" każdy czujnik ma własny plik, bo pomiary różnych czujników mają te same godziny.
+  */
+ void MainWindow::appendMeasurementsIncremental(int stationIndex, int sensorIndex) {
+     QDir().mkpath(exportPath);
+     const QString stationName = QString::fromStdString(stations[stationIndex].name).simplified().replace(" ", "_");
+     
+     std::size_t appended = 0;
+     std::size_t skipped = 0;
+     QStringList files;
+     try {
+         const int first = sensorIndex == 0 ? 0 : sensorIndex - 1;
+         const int last = sensorIndex == 0 ? static_cast<int>(sensors.size()) : sensorIndex;
+         for (int i = first; i < last; ++i) {
+             const QString filePath = exportPath + "/" + QString("pomiary_%1_%2.jsonl")
+                 .arg(stationName)
+                 .arg(QString::fromStdString(sensors[i].paramFormula));
+             
+             // Pojedynczy czujnik: wyświetlane pomiary; "Wszystkie": kolumna czujnika z ramki
+             MeasurementSeries series;
+             if (sensorIndex != 0) {
+                 series = MeasurementSeries::fromMeasurements(measurements);
+             } else if (static_cast<std::size_t>(i) < frame.columns.size()) {
+                 series = frameColumnSeries(static_cast<std::size_t>(i), {0, static_cast<std::int64_t>(frame.rows()) - 1});
+             }
+             AppendResult result = MeasurementFileWriter::appendJsonLines(
+                 filePath.toStdString(), exportMetadata(stationIndex, i + 1), series);
+             appended += result.appended;
+             skipped += result.skipped;
+             files << QFileInfo(filePath).fileName();
+             qDebug() << "Eksport przyrostowy:" << filePath << "dopisano" << result.appended
+                      << "do" << QString::fromStdString(formatMeasurementDate(result.lastTimestamp));
+         }
+     }
+     catch (const std::exception& e) {
+         statusLabel->setText("Błąd podczas zapisywania danych");
+         QMessageBox::critical(this, "Błąd", 
+             QString("Wystąpił błąd podczas eksportu przyrostowego: %1").arg(e.what()));
+         return;
+     }
+     
+     statusLabel->setText(QString("Dopisano %1 nowych pomiarów (pominięto %2 zapisanych) do: %3")
+         .arg(appended).arg(skipped).arg(files.join(", ")));
+ }
+ 
+ /**
+  * @brief Tworzy obiekt "metadata" eksportu
+  * @param stationIndex Indeks stacji
+  * @param sensorIndex Indeks w ComboBox czujników (0 = "Wszystkie")
+  * @return Metadane stacji, czujnika i kolorów
+  */
+ json MainWindow::exportMetadata(int stationIndex, int sensorIndex) const {
+     json metadata;
+     
+     // Funkcja konwersji QString na UTF-8
+     auto qstringToUtf8 = [](const QString& str) -> std::string {
+         return str.toUtf8().toStdString();
+     };
+     
+     // Metadane stacji
+     metadata["station"]["id"] = stations[stationIndex].id;
+     metadata["station"]["name"] = qstringToUtf8(QString::fromStdString(stations[stationIndex].name));
+     metadata["station"]["city"] = qstringToUtf8(QString::fromStdString(stations[stationIndex].city));
+     metadata["station"]["province"] = qstringToUtf8(QString::fromStdString(stations[stationIndex].province));
+     metadata["station"]["location"]["lat"] = stations[stationIndex].lat;
+     metadata["station"]["location"]["lon"] = stations[stationIndex].lon;
+     
+     // Metadane czujnika
+     if (sensorIndex == 0) {
+         metadata["sensor"]["id"] = -1;
+         metadata["sensor"]["paramName"] = "Wszystkie";
+         metadata["sensor"]["paramFormula"] = "Wszystkie";
+         metadata["sensor"]["paramCode"] = "Wszystkie";
+         // Zapis kolorów wszystkich czujników
+         json sensorColorsJson = json::array();
+         for (const auto& sensor : sensors) {
+             json sensorColor;
+             sensorColor["id"] = sensor.id;
+             sensorColor["paramName"] = qstringToUtf8(QString::fromStdString(sensor.paramName));
+             sensorColor["paramFormula"] = qstringToUtf8(QString::fromStdString(sensor.paramFormula));
+             sensorColor["idParam"] = sensor.paramId;
+             auto colorIt = sensorColors.find(sensor.id);
+             if (colorIt != sensorColors.end()) {
+                 sensorColor["color"] = qstringToUtf8(colorIt->second.name());
+             }
+             sensorColorsJson.push_back(sensorColor);
+         }
+         metadata["sensorColors"] = sensorColorsJson;
+     } else {
+         metadata["sensor"]["id"] = sensors[sensorIndex - 1].id;
+         metadata["sensor"]["paramName"] = qstringToUtf8(QString::fromStdString(sensors[sensorIndex - 1].paramName));
+         metadata["sensor"]["paramFormula"] = qstringToUtf8(QString::fromStdString(sensors[sensorIndex - 1].paramFormula));
+         metadata["sensor"]["paramCode"] = qstringToUtf8(QString::fromStdString(sensors[sensorIndex - 1].paramCode));
+         metadata["sensor"]["idParam"] = sensors[sensorIndex - 1].paramId;
+         if (const PollutantInfo* info = pollutantInfo(sensors[sensorIndex - 1].pollutant)) {
+             metadata["sensor"]["unit"] = std::string(info->unit);
+         }
+         // Zapis koloru pojedynczego czujnika
+         auto colorIt = sensorColors.find(sensors[sensorIndex - 1].id);
+         if (colorIt != sensorColors.end()) {
+             metadata["sensor"]["color"] = qstringToUtf8(colorIt->second.name());
+         }
+     }
+     
+     metadata["exportDate"] = qstringToUtf8(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"));
+     
+     return metadata;
+ }
+ 
  /**
   * @brief Zapisuje pomiary do pliku JSON
   * @param filename Nazwa pliku
@@ -711,53 +1337,7 @@
          int sensorIndex = sensorComboBox->currentIndex();
          
          json jsonData;
-         
-         // Funkcja konwersji QString na UTF-8
-         auto qstringToUtf8 = [](const QString& str) -> std::string {
-             return str.toUtf8().toStdString();
-         };
-         
-         // Metadane stacji
-         jsonData["metadata"]["station"]["id"] = stations[stationIndex].id;
-         jsonData["metadata"]["station"]["name"] = qstringToUtf8(QString::fromStdString(stations[stationIndex].name));
-         jsonData["metadata"]["station"]["city"] = qstringToUtf8(QString::fromStdString(stations[stationIndex].city));
-         jsonData["metadata"]["station"]["province"] = qstringToUtf8(QString::fromStdString(stations[stationIndex].province));
-         jsonData["metadata"]["station"]["location"]["lat"] = stations[stationIndex].lat;
-         jsonData["metadata"]["station"]["location"]["lon"] = stations[stationIndex].lon;
-         
-         // Metadane czujnika
-         if (sensorIndex == 0) {
-             jsonData["metadata"]["sensor"]["id"] = -1;
-             jsonData["metadata"]["sensor"]["paramName"] = "Wszystkie";
-             jsonData["metadata"]["sensor"]["paramFormula"] = "Wszystkie";
-             jsonData["metadata"]["sensor"]["paramCode"] = "Wszystkie";
-             // Zapis kolorów wszystkich czujników
-             json sensorColorsJson = json::array();
-             for (const auto& sensor : sensors) {
-                 json sensorColor;
-                 sensorColor["id"] = sensor.id;
-                 sensorColor["paramName"] = qstringToUtf8(QString::fromStdString(sensor.paramName));
-                 sensorColor["paramFormula"] = qstringToUtf8(QString::fromStdString(sensor.paramFormula));
-                 auto colorIt = sensorColors.find(sensor.id);
-                 if (colorIt != sensorColors.end()) {
-                     sensorColor["color"] = qstringToUtf8(colorIt->second.name());
-                 }
-                 sensorColorsJson.push_back(sensorColor);
-             }
-             jsonData["metadata"]["sensorColors"] = sensorColorsJson;
-         } else {
-             jsonData["metadata"]["sensor"]["id"] = sensors[sensorIndex - 1].id;
-             jsonData["metadata"]["sensor"]["paramName"] = qstringToUtf8(QString::fromStdString(sensors[sensorIndex - 1].paramName));
-             jsonData["metadata"]["sensor"]["paramFormula"] = qstringToUtf8(QString::fromStdString(sensors[sensorIndex - 1].paramFormula));
-             jsonData["metadata"]["sensor"]["paramCode"] = qstringToUtf8(QString::fromStdString(sensors[sensorIndex - 1].paramCode));
-             // Zapis koloru pojedynczego czujnika
-             auto colorIt = sensorColors.find(sensors[sensorIndex - 1].id);
-             if (colorIt != sensorColors.end()) {
-                 jsonData["metadata"]["sensor"]["color"] = qstringToUtf8(colorIt->second.name());
-             }
-         }
-         
-         jsonData["metadata"]["exportDate"] = qstringToUtf8(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"));
+         jsonData["metadata"] = exportMetadata(stationIndex, sensorIndex);
          
          // Zapis pomiarów
          json measurementsArray = json::array();
@@ -770,10 +1350,36 @@
          
          jsonData["measurements"] = measurementsArray;
          
+         // Tryb "Wszystkie": dodatkowo wyrównana ramka godzinowa (kolumna na parametr, null = brak pomiaru)
+         if (!frame.columns.empty()) {
+             json frameJson;
+             frameJson["start"] = formatMeasurementDate(frame.start);
+             frameJson["step"] = frame.step;
+             frameJson["rows"] = frame.rows();
+             json columnsJson = json::object();
+             for (std::size_t c = 0; c < frame.columns.size(); ++c) {
+                 json values = json::array();
+                 for (double value : frame.columns[c]) {
+                     values.push_back(std::isnan(value) ? json(nullptr) : json(value));
+                 }
+                 columnsJson[frame.names[c]] = std::move(values);
+             }
+             frameJson["columns"] = std::move(columnsJson);
+             jsonData["frame"] = std::move(frameJson);
+         }
+         
          // Tworzenie katalogu dla pliku
          QFileInfo fileInfo(filename);
          QDir().mkpath(fileInfo.path());
          
+         // Format skompresowany: metadane JSON i pomiary zakodowane przez SeriesCodec
+         if (fileInfo.suffix() == "aqz") {
+             MeasurementFileWriter::saveCompressed(filename.toStdString(), jsonData["metadata"],
+                                                   MeasurementSeries::fromMeasurements(measurements));
+             qDebug() << "Zapisano dane do pliku skompresowanego:" << filename;
+             return true;
+         }
+         
          // Zapis do pliku
          QFile file(filename);
          if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
@@ -805,9 +1411,13 @@
   * Wyświetla dialog z listą zapisanych plików JSON, umożliwiając ich wczytanie.
   */
  void MainWindow::openSavedMeasurements() {
-     QDialog* dialog = createSavedMeasurementsDialog();
-     dialog->exec();
-     delete dialog;
+     // Dialog powstaje przy pierwszym otwarciu, a przy kolejnych odświeżana jest tylko lista plików
+     if (!savedMeasurementsDialog) {
+         savedMeasurementsDialog = createSavedMeasurementsDialog();
+     } else {
+         refreshSavedFileList();
+     }
+     savedMeasurementsDialog->exec();
  }
  
  /**
@@ -871,7 +1481,7 @@ QDialog* MainWindow::createSavedMeasurementsDialog() {
         
         QDir dir(exportPath);
         QStringList filters;
-        filters << "*.json";
+        filters << "*.json" << "*.aqz" << "*.jsonl";
         dir.setNameFilters(filters);
         
         // Sortowanie plików po dacie modyfikacji
@@ -892,6 +1502,7 @@ QDialog* MainWindow::createSavedMeasurementsDialog() {
     
     // Wypełnienie listy
     fillFileList();
+    refreshSavedFileList = fillFileList;
     
     // Dodanie efektu cienia
     QGraphicsDropShadowEffect *shadowEffect = new QGraphicsDropShadowEffect();
@@ -908,10 +1519,125 @@ QDialog* MainWindow::createSavedMeasurementsDialog() {
 }
 
  
+ /**
+  * @brief Otwiera panel diagnostyczny
+  * Panel jest niemodalny, więc metryki można obserwować podczas korzystania z aplikacji.
+  */
+ void MainWindow::openDiagnostics() {
+     QDialog* dialog = createDiagnosticsDialog();
+     dialog->show();
+ }
+ 
+ /**
+  * @brief Tworzy panel diagnostyczny z metrykami klienta API
+  * @return Wskaźnik na dialog
+  * Wiersze odpowiadają klasom endpointów, kolumny licznikom i percentylom czasu (ms).
+  */
+ QDialog* MainWindow::createDiagnosticsDialog() {
+     QDialog* dialog = new QDialog(this);
+     dialog->setAttribute(Qt::WA_DeleteOnClose);
+     dialog->setWindowTitle("Diagnostyka klienta API");
+     dialog->resize(1100, 260);
+     
+     QVBoxLayout* layout = new QVBoxLayout(dialog);
+     
+     const QStringList headers = {"Zapytania", "Błędy", "Cache (traf.)", "Cache (chybienia)", "Scalone",
+                                  "Ponowienia", "Zapasowe", "Nieaktualne", "KB", "KB (sieć)",
+                                  "p50 [ms]", "p90 [ms]", "p99 [ms]",
+                                  "DNS p50", "Połączenie p50", "TLS p50", "Parsowanie p50"};
+     const int endpointCount = static_cast<int>(EndpointClass::Count);
+     
+     QTableWidget* table = new QTableWidget(endpointCount, headers.size(), dialog);
+     table->setHorizontalHeaderLabels(headers);
+     table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+     table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+     for (int e = 0; e < endpointCount; ++e) {
+         table->setVerticalHeaderItem(e, new QTableWidgetItem(endpointClassName(static_cast<EndpointClass>(e))));
+     }
+     layout->addWidget(table);
+     
+     // Przyciski
+     QHBoxLayout* buttonLayout = new QHBoxLayout();
+     QPushButton* exportButton = new QPushButton("Zapisz (Prometheus)", dialog);
+     QPushButton* resetButton = new QPushButton("Wyzeruj", dialog);
+     QPushButton* closeButton = new QPushButton("Zamknij", dialog);
+     buttonLayout->addWidget(exportButton);
+     buttonLayout->addWidget(resetButton);
+     buttonLayout->addStretch();
+     buttonLayout->addWidget(closeButton);
+     layout->addLayout(buttonLayout);
+     
+     // Funkcja odświeżająca tabelę
+     auto refreshTable = [this, table, endpointCount]() {
+         const ApiMetrics& metrics = apiClient->getMetrics();
+         auto milliseconds = [](std::uint64_t micros) {
+             return QString::number(static_cast<double>(micros) / 1000.0, 'f', 1);
+         };
+         
+         for (int e = 0; e < endpointCount; ++e) {
+             const EndpointMetrics& endpoint = metrics.endpoint(static_cast<EndpointClass>(e));
+             const LatencyHistogram& total = endpoint.phase(RequestPhase::Total);
+             const QStringList values = {
+                 QString::number(endpoint.requests.load()),
+                 QString::number(endpoint.failures.load()),
+                 QString::number(endpoint.cacheHits.load()),
+                 QString::number(endpoint.cacheMisses.load()),
+                 QString::number(endpoint.coalesced.load()),
+                 QString::number(endpoint.retries.load()),
+                 QString::number(endpoint.hedged.load()),
+                 QString::number(endpoint.staleServed.load()),
+                 QString::number(static_cast<double>(endpoint.bytes.load()) / 1024.0, 'f', 1),
+                 QString::number(static_cast<double>(endpoint.wireBytes.load()) / 1024.0, 'f', 1),
+                 milliseconds(total.percentile(50.0)),
+                 milliseconds(total.percentile(90.0)),
+                 milliseconds(total.percentile(99.0)),
+                 milliseconds(endpoint.phase(RequestPhase::Dns).percentile(50.0)),
+                 milliseconds(endpoint.phase(RequestPhase::Connect).percentile(50.0)),
+                 milliseconds(endpoint.phase(RequestPhase::Tls).percentile(50.0)),
+                 milliseconds(endpoint.phase(RequestPhase::Parse).percentile(50.0))
+             };
+             for (int c = 0; c < values.size(); ++c) {
+                 QTableWidgetItem* item = table->item(e, c);
+                 if (!item) {
+                     item = new QTableWidgetItem();
+                     item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+                     table->setItem(e, c, item);
+                 }
+                 item->setText(values[c]);
+             }
+         }
+     };
+     refreshTable();
+     
+     // Odświeżanie co sekundę, dopóki dialog jest otwarty
+     QTimer* timer = new QTimer(dialog);
+     connect(timer, &QTimer::timeout, dialog, refreshTable);
+     timer->start(1000);
+     
+     // Połączenie sygnałów
+     connect(exportButton, &QPushButton::clicked, dialog, [this, dialog]() {
+         QString fileName = QFileDialog::getSaveFileName(dialog, "Zapisz metryki",
+             QDir(exportPath).filePath("metrics.prom"), "Prometheus (*.prom *.txt)");
+         if (fileName.isEmpty()) {
+             return;
+         }
+         if (!apiClient->getMetrics().writePrometheus(fileName.toStdString())) {
+             QMessageBox::warning(dialog, "Błąd", "Nie udało się zapisać metryk do pliku.");
+         }
+     });
+     connect(resetButton, &QPushButton::clicked, dialog, [this, refreshTable]() {
+         apiClient->getMetrics().reset();
+         refreshTable();
+     });
+     connect(closeButton, &QPushButton::clicked, dialog, &QDialog::close);
+     
+     return dialog;
+ }
+ 
  /**
   * @brief Wczytuje zapisane pomiary z wybranego pliku
   * @param item Element z listy plików
-  * Wczytuje dane z pliku JSON, aktualizuje interfejs i wyświetla pomiary.
+  * Uruchamia wczytywanie pliku w wątku roboczym, aby duże pliki nie blokowały interfejsu.
   */
  void MainWindow::loadSavedMeasurement(QListWidgetItem* item) {
      if (!item || item->flags() == Qt::NoItemFlags) {
@@ -927,209 +1653,60 @@ QDialog* MainWindow::createSavedMeasurementsDialog() {
      // Zamknięcie dialogu
      item->listWidget()->window()->close();
      
+     // Ignorowanie kolejnych żądań, dopóki poprzedni plik jest wczytywany
+     if (savedFileWatcher.isRunning()) {
+         return;
+     }
+     
      // Czyszczenie tabeli
      dataTable->setRowCount(0);
+     statusLabel->setText(QString("Wczytywanie pliku: %1").arg(filePath));
+     
+     // Wczytanie pliku w wątku roboczym
+     auto loadFileAsync = [filePath]() -> SavedFileResult {
+         TRACE_SCOPE_DETAIL("MeasurementFileLoader::load", filePath.toStdString());
+         SavedFileResult result;
+         result.filePath = filePath;
+         try {
+             result.data = MeasurementFileLoader::load(QFile::encodeName(filePath).toStdString());
+         } catch (const std::exception& e) {
+             result.error = QString::fromUtf8(e.what());
+         }
+         return result;
+     };
+     
+     savedFileWatcher.setFuture(QtConcurrent::run(loadFileAsync));
+ }
+ 
+ /**
+  * @brief Obsługuje zakończenie asynchronicznego wczytywania pliku z pomiarami
+  * Aktualizuje dane aplikacji, tabelę i wykres na podstawie wczytanego pliku.
+  */
+ void MainWindow::onSavedMeasurementLoaded() {
+     TRACE_SCOPE("MainWindow::onSavedMeasurementLoaded");
+     SavedFileResult result = savedFileWatcher.result();
      
-     // Otwarcie pliku
-     QFile file(filePath);
-     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+     if (!result.error.isEmpty()) {
          QMessageBox::critical(this, "Błąd", 
-             QString("Nie można otworzyć pliku: %1").arg(filePath));
+             QString("Wystąpił błąd podczas wczytywania pliku JSON: %1").arg(result.error));
+         statusLabel->setText("Błąd wczytywania pliku");
          return;
      }
      
-     // Odczyt pliku
-     QTextStream in(&file);
-     in.setCodec("UTF-8");
-     QString jsonString = in.readAll();
-     file.close();
-     
-     try {
-         // Parsowanie JSON
-         json jsonData = json::parse(jsonString.toStdString());
-         
-         // Pobranie metadanych stacji
-         QString stationName;
-         QString stationCity;
-         QString stationProvince;
-         int stationId = -1;
-         double stationLat = 0.0;
-         double stationLon = 0.0;
-         
-         if (jsonData.contains("metadata") && jsonData["metadata"].contains("station")) {
-             auto& station = jsonData["metadata"]["station"];
-             if (station.contains("id")) stationId = station["id"].get<int>();
-             if (station.contains("name")) stationName = QString::fromUtf8(station["name"].get<std::string>().c_str());
-             if (station.contains("city")) stationCity = QString::fromUtf8(station["city"].get<std::string>().c_str());
-             if (station.contains("province")) stationProvince = QString::fromUtf8(station["province"].get<std::string>().c_str());
-             
-             if (station.contains("location")) {
-                 auto& location = station["location"];
-                 if (location.contains("lat")) stationLat = location["lat"].get<double>();
-                 if (location.contains("lon")) stationLon = location["lon"].get<double>();
-             }
-         }
-         
-         // Pobranie metadanych czujnika
-         QString paramName;
-         QString paramFormula;
-         QString paramCode;
-         int sensorId = -1;
-         
-         if (jsonData.contains("metadata") && jsonData["metadata"].contains("sensor")) {
-             auto& sensor = jsonData["metadata"]["sensor"];
-             if (sensor.contains("id")) sensorId = sensor["id"].get<int>();
-             if (sensor.contains("paramName")) paramName = QString::fromUtf8(sensor["paramName"].get<std::string>().c_str());
-             if (sensor.contains("paramFormula")) paramFormula = QString::fromUtf8(sensor["paramFormula"].get<std::string>().c_str());
-             if (sensor.contains("paramCode")) paramCode = QString::fromUtf8(sensor["paramCode"].get<std::string>().c_str());
-             
-             // Wczytanie koloru dla pojedynczego czujnika
-             if (sensor.contains("color") && sensorId != -1) {
-                 QString colorName = QString::fromUtf8(sensor["color"].get<std::string>().c_str());
-                 sensorColors[sensorId] = QColor(colorName);
-             }
-         }
-         
-         // Wczytanie kolorów dla wszystkich czujników
-         if (jsonData["metadata"].contains("sensorColors") && jsonData["metadata"]["sensorColors"].is_array()) {
-             for (const auto& sensorColor : jsonData["metadata"]["sensorColors"]) {
-                 int id = sensorColor["id"].get<int>();
-                 QString colorName = QString::fromUtf8(sensorColor["color"].get<std::string>().c_str());
-                 sensorColors[id] = QColor(colorName);
-             }
-         }
-         
-         // Wczytanie pomiarów
-         measurements.clear();
-         
-         if (jsonData.contains("measurements") && jsonData["measurements"].is_array()) {
-             for (const auto& item : jsonData["measurements"]) {
-                 Measurement measurement;
-                 measurement.date = item["date"].get<std::string>();
-                 measurement.value = item["value"].get<double>();
-                 measurements.push_back(measurement);
-             }
-         }
-         
-         if (measurements.empty()) {
-             QMessageBox::warning(this, "Ostrzeżenie", "Plik nie zawiera żadnych pomiarów");
-             return;
-         }
-         
-         // Tworzenie tymczasowej stacji
-         Station tempStation;
-         tempStation.id = stationId;
-         tempStation.name = stationName.toUtf8().toStdString();
-         tempStation.city = stationCity.toUtf8().toStdString();
-         tempStation.province = stationProvince.toUtf8().toStdString();
-         tempStation.lat = stationLat;
-         tempStation.lon = stationLon;
-         
-         // Tworzenie tymczasowego czujnika
-         Sensor tempSensor;
-         tempSensor.id = sensorId;
-         tempSensor.paramName = paramName.toUtf8().toStdString();
-         tempSensor.paramFormula = paramFormula.toUtf8().toStdString();
-         tempSensor.paramCode = paramCode.toUtf8().toStdString();
-         
-         // Dodanie stacji, jeśli nie istnieje
-         int stationIndex = -1;
-         for (size_t i = 0; i < stations.size(); i++) {
-             if (stations[i].id == stationId) {
-                 stationIndex = i;
-                 break;
-             }
-         }
-         
-         if (stationIndex == -1) {
-             stations.push_back(tempStation);
-             stationIndex = stations.size() - 1;
-         }
-         
-         // Dodanie czujnika, jeśli nie istnieje
-         int sensorIndex = -1;
-         for (size_t i = 0; i < sensors.size(); i++) {
-             if (sensors[i].id == sensorId) {
-                 sensorIndex = i;
-                 break;
-             }
-         }
-         
-         if (sensorIndex == -1 && sensorId != -1) {
-             sensors.push_back(tempSensor);
-             sensorIndex = sensors.size() - 1;
-         }
-         
-         // Blokowanie sygnałów ComboBox
-         stationComboBox->blockSignals(true);
-         sensorComboBox->blockSignals(true);
-         
-         // Aktualizacja ComboBox stacji
-         int stationComboIndex = -1;
-         for (int i = 0; i < stationComboBox->count(); i++) {
-             if (stationComboBox->itemText(i).contains(stationName)) {
-                 stationComboIndex = i;
-                 break;
-             }
-         }
-         
-         if (stationComboIndex == -1) {
-             QString displayText = QString("%1 (%2, %3) [WCZYTANE Z PLIKU]").arg(
-                 stationName, stationCity, stationProvince);
-             stationComboBox->addItem(displayText);
-             stationComboIndex = stationComboBox->count() - 1;
-         }
-         
-         stationComboBox->setCurrentIndex(stationComboIndex);
-         
-         // Aktualizacja ComboBox czujników
-         sensorComboBox->clear();
-         sensorComboBox->addItem("Wszystkie");
-         for (const auto& sensor : sensors) {
-             QString displayText = QString("%1 (%2)").arg(
-                 QString::fromUtf8(sensor.paramName.c_str()),
-                 QString::fromUtf8(sensor.paramFormula.c_str())
-             );
-             sensorComboBox->addItem(displayText);
-         }
-         
-         // Ustawienie wybranego czujnika
-         if (paramName == "Wszystkie") {
-             sensorComboBox->setCurrentIndex(0);
-         } else {
-             sensorComboBox->setCurrentIndex(sensorIndex + 1);
-         }
-         
-         // Odblokowanie sygnałów
-         stationComboBox->blockSignals(false);
-         sensorComboBox->blockSignals(false);
-         
-         // Wypełnienie tabeli danymi
-         dataTable->setRowCount(measurements.size());
-         
-         for (size_t i = 0; i < measurements.size(); ++i) {
-             const auto& measurement = measurements[i];
-             
-             QDateTime dateTime = QDateTime::fromString(QString::fromStdString(measurement.date), Qt::ISODate);
-             QTableWidgetItem *dateItem = new QTableWidgetItem(dateTime.toString("dd.MM.yyyy hh:mm"));
-             dataTable->setItem(i, 0, dateItem);
-             
-             QTableWidgetItem *valueItem = new QTableWidgetItem(QString::number(measurement.value, 'f', 2));
-             dataTable->setItem(i, 1, valueItem);
-         }
-         
-         // Sortowanie tabeli
-         dataTable->sortItems(0, Qt::DescendingOrder);
-         
-         // Wyświetlenie wykresu
-         if (displayChart(paramName, paramFormula, true)) {
-             saveButton->setEnabled(true);
-             statusLabel->setText(QString("Wczytano dane z pliku: %1").arg(filePath));
-         }
+     if (!applySavedMeasurementFile(result.data)) {
+         return;
      }
-     catch (const std::exception& e) {
-         QMessageBox::critical(this, "Błąd", 
-             QString("Wystąpił błąd podczas wczytywania pliku JSON: %1").arg(e.what()));
+     
+     // Wypełnienie tabeli danymi
+     setDisplayedSeries();
+     fillDataTable();
+     
+     // Wyświetlenie wykresu
+     QString paramName = QString::fromStdString(result.data.sensor.paramName);
+     QString paramFormula = QString::fromStdString(result.data.sensor.paramFormula);
+     if (displayChart(paramName, paramFormula, true)) {
+         saveButton->setEnabled(true);
+         statusLabel->setText(QString("Wczytano dane z pliku: %1").arg(result.filePath));
      }
  }
  
@@ -1141,205 +1718,309 @@ QDialog* MainWindow::createSavedMeasurementsDialog() {
   */
  bool MainWindow::loadMeasurementsFromJSON(const QString& filePath) {
      try {
-         // Otwarcie pliku
-         QFile file(filePath);
-         if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-             QMessageBox::critical(this, "Błąd", 
-                 QString("Nie można otworzyć pliku: %1").arg(filePath));
-             return false;
-         }
-         
-         // Odczyt pliku
-         QTextStream in(&file);
-         in.setCodec("UTF-8");
-         QString jsonString = in.readAll();
-         file.close();
-         
-         // Parsowanie JSON
-         json jsonData = json::parse(jsonString.toStdString());
-         
-         // Pobranie metadanych stacji
-         QString stationName;
-         QString stationCity;
-         QString stationProvince;
-         int stationId = -1;
-         double stationLat = 0.0;
-         double stationLon = 0.0;
-         
-         if (jsonData.contains("metadata") && jsonData["metadata"].contains("station")) {
-             auto& station = jsonData["metadata"]["station"];
-             if (station.contains("id")) stationId = station["id"].get<int>();
-             if (station.contains("name")) stationName = QString::fromUtf8(station["name"].get<std::string>().c_str());
-             if (station.contains("city")) stationCity = QString::fromUtf8(station["city"].get<std::string>().c_str());
-             if (station.contains("province")) stationProvince = QString::fromUtf8(station["province"].get<std::string>().c_str());
-             
-             if (station.contains("location")) {
-                 auto& location = station["location"];
-                 if (location.contains("lat")) stationLat = location["lat"].get<double>();
-                 if (location.contains("lon")) stationLon = location["lon"].get<double>();
-             }
-         }
-         
-         // Pobranie metadanych czujnika
-         QString paramName;
-         QString paramFormula;
-         QString paramCode;
-         int sensorId = -1;
-         
-         if (jsonData.contains("metadata") && jsonData["metadata"].contains("sensor")) {
-             auto& sensor = jsonData["metadata"]["sensor"];
-             if (sensor.contains("id")) sensorId = sensor["id"].get<int>();
-             if (sensor.contains("paramName")) paramName = QString::fromUtf8(sensor["paramName"].get<std::string>().c_str());
-             if (sensor.contains("paramFormula")) paramFormula = QString::fromUtf8(sensor["paramFormula"].get<std::string>().c_str());
-             if (sensor.contains("paramCode")) paramCode = QString::fromUtf8(sensor["paramCode"].get<std::string>().c_str());
-             
-             // Wczytanie koloru dla pojedynczego czujnika
-             if (sensor.contains("color") && sensorId != -1) {
-                 QString colorName = QString::fromUtf8(sensor["color"].get<std::string>().c_str());
-                 sensorColors[sensorId] = QColor(colorName);
-             }
-         }
-         
-         // Wczytanie kolorów dla wszystkich czujników
-         if (jsonData["metadata"].contains("sensorColors") && jsonData["metadata"]["sensorColors"].is_array()) {
-             for (const auto& sensorColor : jsonData["metadata"]["sensorColors"]) {
-                 int id = sensorColor["id"].get<int>();
-                 QString colorName = QString::fromUtf8(sensorColor["color"].get<std::string>().c_str());
-                 sensorColors[id] = QColor(colorName);
-             }
-         }
-         
-         // Wczytanie pomiarów
-         measurements.clear();
-         
-         if (jsonData.contains("measurements") && jsonData["measurements"].is_array()) {
-             for (const auto& item : jsonData["measurements"]) {
-                 Measurement measurement;
-                 measurement.date = item["date"].get<std::string>();
-                 measurement.value = item["value"].get<double>();
-                 measurements.push_back(measurement);
-             }
-         }
-         
-         if (measurements.empty()) {
-             QMessageBox::warning(this, "Ostrzeżenie", "Plik nie zawiera żadnych pomiarów");
-             return false;
-         }
-         
-         // Tworzenie tymczasowej stacji
-         Station tempStation;
-         tempStation.id = stationId;
-         tempStation.name = stationName.toUtf8().toStdString();
-         tempStation.city = stationCity.toUtf8().toStdString();
-         tempStation.province = stationProvince.toUtf8().toStdString();
-         tempStation.lat = stationLat;
-         tempStation.lon = stationLon;
-         
-         // Tworzenie tymczasowego czujnika
-         Sensor tempSensor;
-         tempSensor.id = sensorId;
-         tempSensor.paramName = paramName.toUtf8().toStdString();
-         tempSensor.paramFormula = paramFormula.toUtf8().toStdString();
-         tempSensor.paramCode = paramCode.toUtf8().toStdString();
-         
-         // Dodanie stacji, jeśli nie istnieje
-         bool stationExists = false;
-         int existingStationIndex = -1;
-         for (size_t i = 0; i < stations.size(); i++) {
-             if (stations[i].id == stationId) {
-                 stationExists = true;
-                 existingStationIndex = i;
-                 break;
-             }
-         }
-         
-         if (!stationExists) {
-             stations.push_back(tempStation);
-             existingStationIndex = stations.size() - 1;
-         }
-         
-         // Dodanie czujnika, jeśli nie istnieje
-         bool sensorExists = false;
-         int existingSensorIndex = -1;
-         for (size_t i = 0; i < sensors.size(); i++) {
-             if (sensors[i].id == sensorId) {
-                 sensorExists = true;
-                 existingSensorIndex = i;
-                 break;
-             }
+         SavedMeasurementFile file = MeasurementFileLoader::load(QFile::encodeName(filePath).toStdString());
+         return applySavedMeasurementFile(file);
+     }
+     catch (const std::exception& e) {
+         QMessageBox::critical(this, "Błąd", 
+             QString("Wystąpił błąd podczas wczytywania pliku JSON: %1").arg(e.what()));
+         return false;
+     }
+ }
+ 
+ /**
+  * @brief Aktualizuje dane aplikacji na podstawie wczytanego pliku
+  * @param file Zawartość wczytanego pliku
+  * @return true jeśli plik zawierał pomiary, false w przeciwnym razie
+  * Ustawia pomiary i kolory, dodaje brakującą stację i czujnik oraz aktualizuje ComboBoxy.
+  */
+ bool MainWindow::applySavedMeasurementFile(const SavedMeasurementFile& file) {
+     if (file.series.empty()) {
+         QMessageBox::warning(this, "Ostrzeżenie", "Plik nie zawiera żadnych pomiarów");
+         return false;
+     }
+     
+     const Station& fileStation = file.station;
+     const Sensor& fileSensor = file.sensor;
+     QString stationName = QString::fromStdString(fileStation.name);
+     QString paramName = QString::fromStdString(fileSensor.paramName);
+     
+     // Wczytanie kolorów czujników
+     if (!file.sensorColor.empty() && fileSensor.id != -1) {
+         sensorColors[fileSensor.id] = QColor(QString::fromStdString(file.sensorColor));
+     }
+     for (const auto& sensorColor : file.sensorColors) {
+         sensorColors[sensorColor.sensorId] = QColor(QString::fromStdString(sensorColor.color));
+     }
+     
+     // Wczytanie pomiarów (trwające pobieranie nie może ich już nadpisać)
+     startMeasurementRequest();
+     measurements = file.series.toMeasurements();
+     frame = ResampledFrame();
+     
+     // Dodanie stacji, jeśli nie istnieje
+     auto stationIt = std::find_if(stations.begin(), stations.end(),
+         [&](const Station& station) { return station.id == fileStation.id; });
+     if (stationIt == stations.end()) {
+         stations.push_back(fileStation);
+     }
+     
+     // Dodanie czujnika, jeśli nie istnieje
+     int existingSensorIndex = -1;
+     for (size_t i = 0; i < sensors.size(); i++) {
+         if (sensors[i].id == fileSensor.id) {
+             existingSensorIndex = i;
+             break;
          }
-         
-         if (!sensorExists && sensorId != -1) {
-             sensors.push_back(tempSensor);
-             existingSensorIndex = sensors.size() - 1;
+     }
+     
+     if (existingSensorIndex == -1 && fileSensor.id != -1) {
+         sensors.push_back(fileSensor);
+         existingSensorIndex = sensors.size() - 1;
+     }
+     
+     // Blokowanie sygnałów
+     bool stationBlocked = stationComboBox->blockSignals(true);
+     bool sensorBlocked = sensorComboBox->blockSignals(true);
+     
+     // Aktualizacja ComboBox stacji
+     int stationIndex = -1;
+     for (int i = 0; i < stationComboBox->count(); i++) {
+         if (stationComboBox->itemText(i).contains(stationName)) {
+             stationIndex = i;
+             break;
          }
-         
-         // Blokowanie sygnałów
-         bool stationBlocked = stationComboBox->blockSignals(true);
-         bool sensorBlocked = sensorComboBox->blockSignals(true);
-         
-         // Aktualizacja ComboBox stacji
-         int stationIndex = -1;
-         for (int i = 0; i < stationComboBox->count(); i++) {
-             if (stationComboBox->itemText(i).contains(stationName)) {
-                 stationIndex = i;
-                 break;
+     }
+     
+     if (stationIndex == -1) {
+         QString displayText = QString("%1 (%2, %3) [WCZYTANE Z PLIKU]").arg(
+             stationName,
+             QString::fromStdString(fileStation.city),
+             QString::fromStdString(fileStation.province));
+         stationComboBox->addItem(displayText);
+         stationIndex = stationComboBox->count() - 1;
+     }
+     
+     stationComboBox->setCurrentIndex(stationIndex);
+     
+     // Aktualizacja ComboBox czujników
+     sensorComboBox->clear();
+     sensorComboBox->addItem("Wszystkie");
+     for (const auto& sensor : sensors) {
+         QString displayText = QString("%1 (%2)").arg(
+             QString::fromStdString(sensor.paramName),
+             QString::fromStdString(sensor.paramFormula)
+         );
+         sensorComboBox->addItem(displayText);
+     }
+     
+     // Ustawienie wybranego czujnika
+     if (file.isAllSensors()) {
+         sensorComboBox->setCurrentIndex(0);
+     } else if (existingSensorIndex != -1) {
+         sensorComboBox->setCurrentIndex(existingSensorIndex + 1);
+     }
+     
+     // Odblokowanie sygnałów
+     stationComboBox->blockSignals(stationBlocked);
+     sensorComboBox->blockSignals(sensorBlocked);
+     
+     return true;
+ }
+ 
+ /**
+  * @brief Otwiera okno wyboru stacji do porównania
+  * Lista stacji z polami wyboru (zaznaczone stacje z miasta bieżącej stacji) i wybór parametru.
+  */
+ void MainWindow::openComparison() {
+     if (stations.empty()) {
+         QMessageBox::warning(this, "Informacja", "Lista stacji nie została jeszcze wczytana");
+         return;
+     }
+     if (comparisonWatcher.isRunning()) {
+         return;
+     }
+     
+     QDialog* dialog = new QDialog(this);
+     dialog->setAttribute(Qt::WA_DeleteOnClose);
+     dialog->setWindowTitle("Porównanie stacji");
+     dialog->resize(500, 600);
+     QVBoxLayout* layout = new QVBoxLayout(dialog);
+     
+     // Wybór parametru
+     QComboBox* pollutantComboBox = new QComboBox(dialog);
+     for (const auto& info : POLLUTANTS) {
+         pollutantComboBox->addItem(QString("%1 (%2)").arg(
+             QString::fromUtf8(info.name.data(), static_cast<int>(info.name.size())),
+             QString::fromUtf8(info.formula.data(), static_cast<int>(info.formula.size()))),
+             static_cast<int>(info.id));
+     }
+     pollutantComboBox->setCurrentIndex(pollutantComboBox->findData(static_cast<int>(Pollutant::PM10)));
+     layout->addWidget(new QLabel("Parametr:", dialog));
+     layout->addWidget(pollutantComboBox);
+     
+     // Lista stacji; domyślnie zaznaczone stacje z miasta bieżącej stacji
+     const int currentIndex = stationComboBox->currentIndex();
+     const InternedString currentCity = currentIndex >= 0 && currentIndex < static_cast<int>(stations.size()) ?
+         stations[currentIndex].city : InternedString();
+     QListWidget* stationList = new QListWidget(dialog);
+     for (size_t i = 0; i < stations.size(); ++i) {
+         QListWidgetItem* item = new QListWidgetItem(QString("%1 (%2)").arg(
+             QString::fromStdString(stations[i].name), QString::fromStdString(stations[i].city)), stationList);
+         item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+         item->setCheckState(!currentCity.empty() && stations[i].city == currentCity ? Qt::Checked : Qt::Unchecked);
+         item->setData(Qt::UserRole, static_cast<int>(i));
+     }
+     layout->addWidget(new QLabel("Stacje:", dialog));
+     layout->addWidget(stationList);
+     
+     QHBoxLayout* buttonLayout = new QHBoxLayout();
+     QPushButton* compareStationsButton = new QPushButton("Porównaj", dialog);
+     QPushButton* closeButton = new QPushButton("Zamknij", dialog);
+     buttonLayout->addStretch();
+     buttonLayout->addWidget(compareStationsButton);
+     buttonLayout->addWidget(closeButton);
+     layout->addLayout(buttonLayout);
+     
+     connect(closeButton, &QPushButton::clicked, dialog, &QDialog::close);
+     connect(compareStationsButton, &QPushButton::clicked, this, [this, dialog, stationList, pollutantComboBox]() {
+         std::vector<Station> selected;
+         for (int row = 0; row < stationList->count(); ++row) {
+             QListWidgetItem* item = stationList->item(row);
+             if (item->checkState() == Qt::Checked) {
+                 selected.push_back(stations[item->data(Qt::UserRole).toInt()]);
              }
          }
-         
-         if (stationIndex == -1) {
-             QString displayText = QString("%1 (%2, %3) [WCZYTANE Z PLIKU]").arg(
-                 stationName, stationCity, stationProvince);
-             stationComboBox->addItem(displayText);
-             stationIndex = stationComboBox->count() - 1;
-         }
-         
-         stationComboBox->setCurrentIndex(stationIndex);
-         
-         // Aktualizacja ComboBox czujników
-         sensorComboBox->clear();
-         sensorComboBox->addItem("Wszystkie");
-         QString selectedSensorText;
-         for (const auto& sensor : sensors) {
-             QString displayText = QString("%1 (%2)").arg(
-                 QString::fromUtf8(sensor.paramName.c_str()),
-                 QString::fromUtf8(sensor.paramFormula.c_str())
-             );
-             sensorComboBox->addItem(displayText);
-             
-             if (sensor.id == sensorId) {
-                 selectedSensorText = displayText;
-             }
+         if (selected.empty()) {
+             QMessageBox::warning(dialog, "Informacja", "Nie wybrano żadnej stacji");
+             return;
          }
-         
-         // Ustawienie wybranego czujnika
-         int sensorIndex = -1;
-         if (paramName == "Wszystkie") {
-             sensorIndex = 0;
-         } else {
-             for (int i = 0; i < sensorComboBox->count(); i++) {
-                 if (sensorComboBox->itemText(i).contains(paramName)) {
-                     sensorIndex = i;
-                     break;
-                 }
-             }
+         const Pollutant pollutant = static_cast<Pollutant>(pollutantComboBox->currentData().toInt());
+         
+         // Pobieranie stacji równolegle poza wątkiem interfejsu
+         ApiClient* client = apiClient.get();
+         statusLabel->setText(QString("Pobieranie danych %1 stacji...").arg(selected.size()));
+         comparisonWatcher.setFuture(QtConcurrent::run([client, selected, pollutant]() {
+             return StationComparisonLoader::load(*client, selected, pollutant);
+         }));
+         dialog->close();
+     });
+     
+     dialog->show();
+ }
+ 
+ /**
+  * @brief Obsługuje zakończenie asynchronicznego pobierania porównania stacji
+  * Wyświetla serie wszystkich stacji na wspólnym wykresie.
+  */
+ void MainWindow::onComparisonLoaded() {
+     TRACE_SCOPE("MainWindow::onComparisonLoaded");
+     StationComparison comparison = comparisonWatcher.result();
+     
+     if (comparison.stations.empty()) {
+         QMessageBox::warning(this, "Informacja", "Żadna z wybranych stacji nie ma pomiarów tego parametru");
+         statusLabel->setText("Brak danych do porównania");
+         return;
+     }
+     
+     if (displayComparisonChart(comparison)) {
+         QString status = QString("Porównanie %1 stacji").arg(comparison.stations.size());
+         if (!comparison.skipped.empty()) {
+             status += QString(" (pominięto %1 bez danych)").arg(comparison.skipped.size());
          }
-         
-         if (sensorIndex != -1) {
-             sensorComboBox->setCurrentIndex(sensorIndex);
-         } else if (existingSensorIndex != -1) {
-             sensorComboBox->setCurrentIndex(existingSensorIndex + 1);
+         statusLabel->setText(status);
+     }
+ }
+ 
+ /**
+  * @brief Rysuje porównanie stacji na wykresie
+  * @param comparison Serie stacji na wspólnej osi czasu
+  * @return true jeśli wykres został utworzony, false w przeciwnym razie
+  * Każda seria jest przerzedzana (minimum i maksimum w przedziale) do ok. dwóch punktów na piksel
+  * szerokości wykresu i przekazywana do QLineSeries jednym wywołaniem replace().
+  */
+ bool MainWindow::displayComparisonChart(const StationComparison& comparison) {
+     TRACE_SCOPE_DETAIL("MainWindow::displayComparisonChart", std::to_string(comparison.stations.size()) + " stacji");
+     const AlignedSeries& aligned = comparison.aligned;
+     if (aligned.timestamps.empty()) {
+         return false;
+     }
+     
+     QChart *chart = new QChart();
+     chart->legend()->show();
+     
+     QList<QColor> colors = {
+         Qt::blue, Qt::red, Qt::darkGreen, Qt::magenta, Qt::darkCyan,
+         Qt::darkYellow, Qt::darkMagenta, Qt::black, Qt::darkRed, Qt::darkBlue
+     };
+     const std::size_t maxPoints = static_cast<std::size_t>(std::max(200, ensureChartView()->width() * 2));
+     
+     // Znaczniki czasu GIOŚ są czasem lokalnym zapisanym jak UTC
+     auto toChartTime = [](std::int64_t timestamp) {
+         QDateTime dateTime = QDateTime::fromSecsSinceEpoch(timestamp, Qt::UTC);
+         dateTime.setTimeSpec(Qt::LocalTime);
+         return dateTime.toMSecsSinceEpoch();
+     };
+     
+     double minValue = std::numeric_limits<double>::max();
+     double maxValue = std::numeric_limits<double>::lowest();
+     for (std::size_t s = 0; s < comparison.stations.size(); ++s) {
+         MeasurementSeries points = decimateMinMax(aligned.timestamps.data(), aligned.columns[s].data(),
+                                                   aligned.timestamps.size(), maxPoints);
+         QVector<QPointF> chartPoints;
+         chartPoints.reserve(static_cast<int>(points.size()));
+         for (std::size_t i = 0; i < points.size(); ++i) {
+             chartPoints.append(QPointF(toChartTime(points.timestamps[i]), points.values[i]));
+             minValue = std::min(minValue, points.values[i]);
+             maxValue = std::max(maxValue, points.values[i]);
          }
          
-         // Odblokowanie sygnałów
-         stationComboBox->blockSignals(stationBlocked);
-         sensorComboBox->blockSignals(sensorBlocked);
-         
-         return true;
+         QLineSeries *series = new QLineSeries();
+         series->setName(QString::fromStdString(comparison.stations[s].name));
+         series->setPen(QPen(colors[static_cast<int>(s) % colors.size()], 2));
+         series->replace(chartPoints);
+         chart->addSeries(series);
      }
-     catch (const std::exception& e) {
-         QMessageBox::critical(this, "Błąd", 
-             QString("Wystąpił błąd podczas wczytywania pliku JSON: %1").arg(e.what()));
-         return false;
+     
+     double margin = (maxValue - minValue) * 0.1;
+     if (margin < 0.001) margin = 0.1;
+     
+     const PollutantInfo* info = pollutantInfo(comparison.pollutant);
+     const QString formula = info ? QString::fromUtf8(info->formula.data(), static_cast<int>(info->formula.size())) : QString();
+     const QString unit = info ? QString::fromUtf8(info->unit.data(), static_cast<int>(info->unit.size())) : QString();
+     chart->setTitle(QString("Porównanie stacji: %1\nOkres: %2 - %3").arg(formula,
+         QDateTime::fromMSecsSinceEpoch(toChartTime(aligned.timestamps.front())).toString("dd.MM.yyyy"),
+         QDateTime::fromMSecsSinceEpoch(toChartTime(aligned.timestamps.back())).toString("dd.MM.yyyy")));
+     
+     QDateTimeAxis *axisX = new QDateTimeAxis;
+     axisX->setTickCount(8);
+     axisX->setFormat("dd.MM.yy hh:mm");
+     axisX->setLabelsAngle(-45);
+     axisX->setTitleText("Czas pomiaru");
+     axisX->setRange(QDateTime::fromMSecsSinceEpoch(toChartTime(aligned.timestamps.front())),
+                     QDateTime::fromMSecsSinceEpoch(toChartTime(aligned.timestamps.back())));
+     
+     QValueAxis *axisY = new QValueAxis;
+     axisY->setLabelFormat("%.2f");
+     axisY->setTitleText(unit.isEmpty() ? formula : QString("%1 [%2]").arg(formula, unit));
+     axisY->setRange(minValue - margin, maxValue + margin);
+     
+     chart->addAxis(axisX, Qt::AlignBottom);
+     chart->addAxis(axisY, Qt::AlignLeft);
+     for (auto series : chart->series()) {
+         series->attachAxis(axisX);
+         series->attachAxis(axisY);
      }
- }
\ No newline at end of file
+     
+     // Animacje wielu serii spowalniają rysowanie - porównanie jest wyświetlane bez nich
+     chart->setAnimationOptions(QChart::NoAnimation);
+     chartView->setChart(chart);
+     chartKind = ChartKind::Comparison;
+     chartFrameColumns.clear();
+     
+     QList<QTabWidget*> tabWidgets = findChildren<QTabWidget*>();
+     if (!tabWidgets.isEmpty()) {
+         tabWidgets.first()->setCurrentIndex(1);
+     }
+     return true;
+ }
@@ -0,0 +1,516 @@
+/**
+ * @file measurement_file.cpp
+ * @brief Implementacja strumieniowego wczytywania zapisanych plików z pomiarami
+ */
+
+#include "measurement_file.hpp"
+#include "mapped_file.hpp"
+#include "series_codec.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr char COMPRESSED_MAGIC[4] = {'A', 'Q', 'Z', 'F'};
+
+// Początki wierszy pliku przyrostowego (bez kończącego zera)
+constexpr char JSONL_HEADER[] = "{\"format\":\"jsonl\"";
+constexpr char JSONL_DATE[] = "{\"date\":\"";
+constexpr char JSONL_VALUE[] = "\",\"value\":";
+constexpr char JSONL_CHECKPOINT[] = "{\"checkpoint\":\"";
+constexpr std::size_t DATE_LENGTH = 19;
+
+// Koniec pliku czytany przy szukaniu punktu kontrolnego
+constexpr std::size_t JSONL_TAIL_SIZE = 4096;
+
+bool startsWith(const char* begin, const char* end, const char* prefix, std::size_t length) {
+    return static_cast<std::size_t>(end - begin) >= length && std::memcmp(begin, prefix, length) == 0;
+}
+
+/**
+ * @brief Handler SAX budujący SavedMeasurementFile bez tworzenia drzewa JSON
+ *
+ * Zamiast ścieżki kluczy przechowywany jest stos kontekstów, więc dla każdej
+ * wartości wystarcza porównanie bieżącego kontekstu i ostatniego klucza.
+ */
+class MeasurementFileHandler : public nlohmann::json_sax<json> {
+public:
+    explicit MeasurementFileHandler(SavedMeasurementFile& result) : result(result) {
+        contexts.reserve(8);
+    }
+
+    bool null() override {
+        // Brak wartości pomiaru - pomiar zostanie pominięty
+        if (top() == Context::MeasurementItem && lastKey == "value") {
+            hasValue = false;
+        }
+        return true;
+    }
+
+    bool boolean(bool) override { return true; }
+
+    bool number_integer(number_integer_t value) override {
+        onNumber(static_cast<double>(value));
+        return true;
+    }
+
+    bool number_unsigned(number_unsigned_t value) override {
+        onNumber(static_cast<double>(value));
+        return true;
+    }
+
+    bool number_float(number_float_t value, const string_t&) override {
+        onNumber(value);
+        return true;
+    }
+
+    bool string(string_t& value) override {
+        switch (top()) {
+        case Context::MeasurementItem:
+            if (lastKey == "date") {
+                hasDate = parseMeasurementDate(value.data(), value.size(), pendingTimestamp);
+            } else if (lastKey == "value") {
+                // Starsze eksporty mogą zapisywać wartość jako tekst
+                try {
+                    pendingValue = std::stod(value);
+                    hasValue = true;
+                } catch (const std::exception&) {
+                    hasValue = false;
+                }
+            }
+            break;
+        case Context::Station:
+            if (lastKey == "name") result.station.name = std::move(value);
+            else if (lastKey == "city") result.station.city = std::move(value);
+            else if (lastKey == "province") result.station.province = std::move(value);
+            else if (lastKey == "address") result.station.address = std::move(value);
+            break;
+        case Context::Sensor:
+            if (lastKey == "paramName") result.sensor.paramName = std::move(value);
+            else if (lastKey == "paramFormula") result.sensor.paramFormula = std::move(value);
+            else if (lastKey == "paramCode") result.sensor.paramCode = std::move(value);
+            else if (lastKey == "color") result.sensorColor = std::move(value);
+            break;
+        case Context::SensorColorItem:
+            if (lastKey == "paramName") result.sensorColors.back().paramName = std::move(value);
+            else if (lastKey == "paramFormula") result.sensorColors.back().paramFormula = std::move(value);
+            else if (lastKey == "color") result.sensorColors.back().color = std::move(value);
+            break;
+        case Context::Metadata:
+            if (lastKey == "exportDate") result.exportDate = std::move(value);
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool binary(binary_t&) override { return true; }
+
+    bool start_object(std::size_t) override {
+        Context parent = top();
+        Context child = Context::Ignored;
+
+        if (contexts.empty()) {
+            child = Context::Root;
+        } else if (parent == Context::Measurements) {
+            child = Context::MeasurementItem;
+            hasDate = false;
+            hasValue = false;
+        } else if (parent == Context::Root && lastKey == "metadata") {
+            child = Context::Metadata;
+        } else if (parent == Context::Metadata && lastKey == "station") {
+            child = Context::Station;
+        } else if (parent == Context::Metadata && lastKey == "sensor") {
+            child = Context::Sensor;
+        } else if (parent == Context::Station && lastKey == "location") {
+            child = Context::Location;
+        } else if (parent == Context::SensorColors) {
+            child = Context::SensorColorItem;
+            result.sensorColors.push_back({-1, {}, {}, {}});
+        }
+
+        contexts.push_back(child);
+        return true;
+    }
+
+    bool key(string_t& value) override {
+        lastKey = value;
+        return true;
+    }
+
+    bool end_object() override {
+        if (top() == Context::MeasurementItem && hasDate && hasValue) {
+            result.series.append(pendingTimestamp, pendingValue);
+        }
+        contexts.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        Context parent = top();
+        Context child = Context::Ignored;
+
+        if (parent == Context::Root && lastKey == "measurements") {
+            child = Context::Measurements;
+        } else if (parent == Context::Metadata && lastKey == "sensorColors") {
+            child = Context::SensorColors;
+        }
+
+        contexts.push_back(child);
+        return true;
+    }
+
+    bool end_array() override {
+        contexts.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& ex) override {
+        throw std::runtime_error("Blad parsowania JSON na pozycji " + std::to_string(position) + ": " + ex.what());
+    }
+
+private:
+    enum class Context {
+        Root,
+        Ignored,
+        Measurements,
+        MeasurementItem,
+        Metadata,
+        Station,
+        Location,
+        Sensor,
+        SensorColors,
+        SensorColorItem
+    };
+
+    SavedMeasurementFile& result;
+    std::vector<Context> contexts;
+    std::string lastKey;
+
+    std::int64_t pendingTimestamp = 0;
+    double pendingValue = 0.0;
+    bool hasDate = false;
+    bool hasValue = false;
+
+    Context top() const {
+        return contexts.empty() ? Context::Ignored : contexts.back();
+    }
+
+    void onNumber(double value) {
+        switch (top()) {
+        case Context::MeasurementItem:
+            if (lastKey == "value") {
+                pendingValue = value;
+                hasValue = true;
+            }
+            break;
+        case Context::Station:
+            if (lastKey == "id") result.station.id = static_cast<int>(value);
+            break;
+        case Context::Location:
+            if (lastKey == "lat") result.station.lat = value;
+            else if (lastKey == "lon") result.station.lon = value;
+            break;
+        case Context::Sensor:
+            if (lastKey == "id") result.sensor.id = static_cast<int>(value);
+            else if (lastKey == "idParam") result.sensor.paramId = static_cast<int>(value);
+            break;
+        case Context::SensorColorItem:
+            if (lastKey == "id") result.sensorColors.back().sensorId = static_cast<int>(value);
+            break;
+        default:
+            break;
+        }
+    }
+};
+
+/**
+ * @brief Parsuje wiersz pomiaru pliku przyrostowego
+ *
+ * Wiersze zapisane przez MeasurementFileWriter mają stały układ i są czytane bez parsera JSON;
+ * pozostałe (np. edytowane ręcznie) przechodzą przez pełny parser. Niedokończony ostatni
+ * wiersz (przerwany zapis) jest pomijany.
+ */
+void parseJsonLine(const char* line, const char* end, bool lastLine, MeasurementSeries& series) {
+    if (line < end && end[-1] == '\r') --end;
+    if (line == end) return;
+
+    constexpr std::size_t dateOffset = sizeof(JSONL_DATE) - 1;
+    constexpr std::size_t valueOffset = dateOffset + DATE_LENGTH + sizeof(JSONL_VALUE) - 1;
+    std::int64_t timestamp;
+    if (startsWith(line, end, JSONL_DATE, dateOffset) &&
+        static_cast<std::size_t>(end - line) > valueOffset &&
+        std::memcmp(line + dateOffset + DATE_LENGTH, JSONL_VALUE, sizeof(JSONL_VALUE) - 1) == 0 &&
+        parseMeasurementDate(line + dateOffset, DATE_LENGTH, timestamp)) {
+        double value;
+        const std::from_chars_result parsed = std::from_chars(line + valueOffset, end, value);
+        if (parsed.ec == std::errc() && parsed.ptr + 1 == end && *parsed.ptr == '}') {
+            series.append(timestamp, value);
+            return;
+        }
+    }
+    if (startsWith(line, end, JSONL_CHECKPOINT, sizeof(JSONL_CHECKPOINT) - 1)) return;
+
+    const json item = json::parse(line, end, nullptr, false);
+    if (item.is_discarded()) {
+        if (lastLine) return;
+        throw std::runtime_error("Niepoprawny wiersz pliku przyrostowego: " + std::string(line, end));
+    }
+    // Brak wartości (null) lub wiersz innego typu - pomiar jest pomijany
+    if (item.is_object() && item.contains("date") && item["date"].is_string() &&
+        item.contains("value") && item["value"].is_number() &&
+        parseMeasurementDate(item["date"].get_ref<const std::string&>().data(),
+                             item["date"].get_ref<const std::string&>().size(), timestamp)) {
+        series.append(timestamp, item["value"].get<double>());
+    }
+}
+
+/**
+ * @brief Parsuje plik przyrostowy: wiersz metadanych i wiersze pomiarów
+ */
+void parseJsonLines(const char* data, std::size_t size, SavedMeasurementFile& result) {
+    const char* end = data + size;
+    const char* lineEnd = static_cast<const char*>(std::memchr(data, '\n', size));
+    if (lineEnd == nullptr) lineEnd = end;
+
+    MeasurementFileHandler handler(result);
+    json::sax_parse(data, lineEnd, &handler);
+
+    // Przybliżona liczba pomiarów: wiersz pomiaru zajmuje ok. 45 bajtów
+    result.series.reserve(size / 45);
+    for (const char* line = lineEnd + 1; line < end; line = lineEnd + 1) {
+        lineEnd = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(end - line)));
+        if (lineEnd == nullptr) lineEnd = end;
+        parseJsonLine(line, lineEnd, lineEnd == end, result.series);
+    }
+}
+
+/**
+ * @brief Stan końca pliku przyrostowego
+ */
+struct JsonLinesTail {
+    std::uintmax_t completeSize = 0; ///< Rozmiar pliku bez niedokończonego ostatniego wiersza
+    bool hasCheckpoint = false;      ///< Czy plik zawiera pomiary
+    std::int64_t checkpoint = 0;     ///< Czas ostatniego zapisanego pomiaru
+};
+
+/**
+ * @brief Odczytuje punkt kontrolny z końca pliku przyrostowego
+ *
+ * Zwykle wystarcza ostatni wiersz. Jeśli zapis przerwano przed wierszem punktu kontrolnego,
+ * punkt kontrolny jest odtwarzany z pomiarów (jednorazowe wczytanie całego pliku).
+ */
+JsonLinesTail readJsonLinesTail(const std::string& path, std::uintmax_t fileSize) {
+    std::ifstream file(path, std::ios::binary);
+    char header[sizeof(JSONL_HEADER) - 1];
+    if (!file.read(header, sizeof(header)) || std::memcmp(header, JSONL_HEADER, sizeof(header)) != 0) {
+        throw std::runtime_error("Plik nie jest eksportem przyrostowym: " + path);
+    }
+
+    const std::uintmax_t tailSize = std::min<std::uintmax_t>(fileSize, JSONL_TAIL_SIZE);
+    std::string tail(static_cast<std::size_t>(tailSize), '\0');
+    file.seekg(static_cast<std::streamoff>(fileSize - tailSize));
+    if (!file.read(&tail[0], static_cast<std::streamsize>(tailSize))) {
+        throw std::runtime_error("Nie mozna odczytac pliku: " + path);
+    }
+
+    JsonLinesTail result;
+    const std::size_t lastNewline = tail.rfind('\n');
+    if (lastNewline == std::string::npos) {
+        if (tailSize < fileSize) {
+            throw std::runtime_error("Uszkodzony plik przyrostowy: " + path);
+        }
+        // Przerwany zapis nowego pliku - nie ma nawet pełnego wiersza metadanych
+        return result;
+    }
+    result.completeSize = fileSize - tailSize + lastNewline + 1;
+
+    const std::size_t previousNewline = lastNewline == 0 ? std::string::npos : tail.rfind('\n', lastNewline - 1);
+    if (previousNewline != std::string::npos) {
+        const char* line = tail.data() + previousNewline + 1;
+        const char* lineEnd = tail.data() + lastNewline;
+        constexpr std::size_t dateOffset = sizeof(JSONL_CHECKPOINT) - 1;
+        if (startsWith(line, lineEnd, JSONL_CHECKPOINT, dateOffset) &&
+            static_cast<std::size_t>(lineEnd - line) > dateOffset + DATE_LENGTH &&
+            parseMeasurementDate(line + dateOffset, DATE_LENGTH, result.checkpoint)) {
+            result.hasCheckpoint = true;
+            return result;
+        }
+    }
+
+    MappedFile mapped(path);
+    const SavedMeasurementFile saved = MeasurementFileLoader::parse(mapped.data(), static_cast<std::size_t>(result.completeSize));
+    if (!saved.series.empty()) {
+        result.hasCheckpoint = true;
+        result.checkpoint = saved.series.timestamps.back();
+    }
+    return result;
+}
+
+void appendMeasurementLine(std::string& out, std::int64_t timestamp, double value) {
+    out += JSONL_DATE;
+    out += formatMeasurementDate(timestamp);
+    out += JSONL_VALUE;
+    if (std::isfinite(value)) {
+        char buffer[32];
+        const std::to_chars_result written = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, written.ptr);
+    } else {
+        out += "null";
+    }
+    out += "}\n";
+}
+
+} // namespace
+
+SavedMeasurementFile MeasurementFileLoader::parse(const char* data, std::size_t size) {
+    SavedMeasurementFile result;
+    result.station = {-1, {}, 0.0, 0.0, {}, {}, {}};
+    result.sensor = {-1, -1, {}, {}, {}, -1, Pollutant::Unknown};
+
+    if (size >= sizeof(COMPRESSED_MAGIC) + sizeof(std::uint32_t) &&
+        std::memcmp(data, COMPRESSED_MAGIC, sizeof(COMPRESSED_MAGIC)) == 0) {
+        // Plik skompresowany: metadane JSON i blok SeriesCodec
+        std::uint32_t metadataLength;
+        std::memcpy(&metadataLength, data + sizeof(COMPRESSED_MAGIC), sizeof(metadataLength));
+        const char* metadata = data + sizeof(COMPRESSED_MAGIC) + sizeof(metadataLength);
+        if (metadataLength > size - sizeof(COMPRESSED_MAGIC) - sizeof(metadataLength)) {
+            throw std::runtime_error("Uszkodzony plik skompresowany");
+        }
+        MeasurementFileHandler handler(result);
+        json::sax_parse(metadata, metadata + metadataLength, &handler);
+        const char* block = metadata + metadataLength;
+        result.series = SeriesCodec::decode(block, static_cast<std::size_t>(data + size - block));
+    } else if (startsWith(data, data + size, JSONL_HEADER, sizeof(JSONL_HEADER) - 1)) {
+        parseJsonLines(data, size, result);
+    } else {
+        // Przybliżona liczba pomiarów: jeden obiekt pomiaru zajmuje ok. 60 bajtów
+        result.series.reserve(size / 60);
+
+        MeasurementFileHandler handler(result);
+        json::sax_parse(data, data + size, &handler);
+    }
+
+    result.sensor.stationId = result.station.id;
+    result.sensor.pollutant = resolvePollutant(result.sensor.paramId, result.sensor.paramCode.str());
+    result.series.sortByTime();
+    return result;
+}
+
+SavedMeasurementFile MeasurementFileLoader::load(const std::string& path) {
+    MappedFile file(path);
+    if (file.size() == 0) {
+        throw std::runtime_error("Pusty plik: " + path);
+    }
+    return parse(file.data(), file.size());
+}
+
+std::string MeasurementFileWriter::compressed(const json& metadata, const MeasurementSeries& series) {
+    const std::string metadataJson = json{{"metadata", metadata}}.dump();
+    const std::uint32_t metadataLength = static_cast<std::uint32_t>(metadataJson.size());
+
+    std::string content(COMPRESSED_MAGIC, sizeof(COMPRESSED_MAGIC));
+    content.append(reinterpret_cast<const char*>(&metadataLength), sizeof(metadataLength));
+    content += metadataJson;
+    content += SeriesCodec::encode(series);
+    return content;
+}
+
+void MeasurementFileWriter::saveCompressed(const std::string& path, const json& metadata, const MeasurementSeries& series) {
+    const std::string content = compressed(metadata, series);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open() || !file.write(content.data(), static_cast<std::streamsize>(content.size()))) {
+        throw std::runtime_error("Nie mozna zapisac pliku: " + path);
+    }
+}
+
+bool MeasurementFileWriter::lastCheckpoint(const std::string& path, std::int64_t& timestamp) {
+    std::error_code error;
+    const std::uintmax_t fileSize = fs::file_size(path, error);
+    if (error || fileSize == 0) {
+        return false;
+    }
+    const JsonLinesTail tail = readJsonLinesTail(path, fileSize);
+    if (tail.hasCheckpoint) {
+        timestamp = tail.checkpoint;
+    }
+    return tail.hasCheckpoint;
+}
+
+AppendResult MeasurementFileWriter::appendJsonLines(const std::string& path, const json& metadata, const MeasurementSeries& series) {
+    std::error_code error;
+    std::uintmax_t fileSize = fs::file_size(path, error);
+    if (error) {
+        fileSize = 0;
+    }
+
+    JsonLinesTail tail;
+    if (fileSize > 0) {
+        tail = readJsonLinesTail(path, fileSize);
+        if (tail.completeSize < fileSize) {
+            fs::resize_file(path, tail.completeSize, error);
+            if (error) {
+                throw std::runtime_error("Nie mozna naprawic pliku: " + path);
+            }
+        }
+    }
+
+    AppendResult result;
+    result.created = tail.completeSize == 0;
+    result.lastTimestamp = tail.checkpoint;
+
+    // Tylko pomiary nowsze niż punkt kontrolny, rosnąco po czasie i bez powtórzeń
+    std::vector<std::size_t> fresh;
+    fresh.reserve(series.size());
+    for (std::size_t i = 0; i < series.size(); ++i) {
+        if (!tail.hasCheckpoint || series.timestamps[i] > tail.checkpoint) {
+            fresh.push_back(i);
+        }
+    }
+    std::stable_sort(fresh.begin(), fresh.end(), [&series](std::size_t a, std::size_t b) {
+        return series.timestamps[a] < series.timestamps[b];
+    });
+    fresh.erase(std::unique(fresh.begin(), fresh.end(), [&series](std::size_t a, std::size_t b) {
+        return series.timestamps[a] == series.timestamps[b];
+    }), fresh.end());
+    result.appended = fresh.size();
+    result.skipped = series.size() - fresh.size();
+
+    if (fresh.empty() && !result.created) {
+        return result;
+    }
+
+    std::string content;
+    content.reserve(fresh.size() * 48 + 64);
+    if (result.created) {
+        content += JSONL_HEADER;
+        content += ",\"metadata\":";
+        content += metadata.dump();
+        content += "}\n";
+    }
+    for (std::size_t i : fresh) {
+        appendMeasurementLine(content, series.timestamps[i], series.values[i]);
+    }
+    if (!fresh.empty()) {
+        result.lastTimestamp = series.timestamps[fresh.back()];
+        content += JSONL_CHECKPOINT;
+        content += formatMeasurementDate(result.lastTimestamp);
+        content += "\",\"appended\":";
+        content += std::to_string(fresh.size());
+        content += "}\n";
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    if (!file.is_open() || !file.write(content.data(), static_cast<std::streamsize>(content.size())) || !file.flush()) {
+        throw std::runtime_error("Nie mozna zapisac pliku: " + path);
+    }
+    return result;
+}
@@ -0,0 +1,305 @@
+/**
+ * @file measurement_series.cpp
+ * @brief Implementacja kolumnowej serii pomiarowej i konwersji dat GIOŚ
+ */
+
+#include "measurement_series.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+// Liczba dni od 1970-01-01 dla daty kalendarzowej (algorytm H. Hinnanta)
+std::int64_t daysFromCivil(std::int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+// Operacja odwrotna do daysFromCivil
+void civilFromDays(std::int64_t days, int& year, unsigned& month, unsigned& day) {
+    days += 719468;
+    const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(days - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int>(static_cast<std::int64_t>(yoe) + era * 400 + (month <= 2));
+}
+
+// Odczytuje stałą liczbę cyfr dziesiętnych
+bool readDigits(const char* text, int count, unsigned& out) {
+    out = 0;
+    for (int i = 0; i < count; ++i) {
+        const char c = text[i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        out = out * 10 + static_cast<unsigned>(c - '0');
+    }
+    return true;
+}
+
+} // namespace
+
+bool parseMeasurementDate(const char* date, std::size_t length, std::int64_t& timestamp) {
+    // Oczekiwany format: yyyy-MM-dd hh:mm[:ss]
+    if (length < 16 || date[4] != '-' || date[7] != '-' ||
+        (date[10] != ' ' && date[10] != 'T') || date[13] != ':') {
+        return false;
+    }
+
+    unsigned year, month, day, hour, minute, second = 0;
+    if (!readDigits(date, 4, year) || !readDigits(date + 5, 2, month) ||
+        !readDigits(date + 8, 2, day) || !readDigits(date + 11, 2, hour) ||
+        !readDigits(date + 14, 2, minute)) {
+        return false;
+    }
+    if (length >= 19 && date[16] == ':' && !readDigits(date + 17, 2, second)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 59) {
+        return false;
+    }
+
+    timestamp = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+std::int64_t parseMeasurementDate(const std::string& date) {
+    std::int64_t timestamp = 0;
+    if (!parseMeasurementDate(date.data(), date.size(), timestamp)) {
+        return -1;
+    }
+    return timestamp;
+}
+
+std::string formatMeasurementDate(std::int64_t timestamp) {
+    std::int64_t days = timestamp / 86400;
+    std::int64_t secondsOfDay = timestamp % 86400;
+    if (secondsOfDay < 0) {
+        secondsOfDay += 86400;
+        --days;
+    }
+
+    int year;
+    unsigned month, day;
+    civilFromDays(days, year, month, day);
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u %02d:%02d:%02d",
+                  year, month, day,
+                  static_cast<int>(secondsOfDay / 3600),
+                  static_cast<int>((secondsOfDay % 3600) / 60),
+                  static_cast<int>(secondsOfDay % 60));
+    return buffer;
+}
+
+bool MeasurementSeries::isSorted() const {
+    return std::is_sorted(timestamps.begin(), timestamps.end());
+}
+
+SeriesSlice MeasurementSeries::range(std::int64_t from, std::int64_t to) const {
+    SeriesSlice slice;
+    if (from > to) {
+        return slice;
+    }
+    const auto first = std::lower_bound(timestamps.begin(), timestamps.end(), from);
+    const auto last = std::upper_bound(first, timestamps.end(), to);
+    slice.offset = static_cast<std::size_t>(first - timestamps.begin());
+    slice.count = static_cast<std::size_t>(last - first);
+    slice.timestamps = timestamps.data() + slice.offset;
+    slice.values = values.data() + slice.offset;
+    return slice;
+}
+
+void MeasurementSeries::sortByTime() {
+    if (isSorted()) {
+        return;
+    }
+
+    // Pliki eksportu i odpowiedzi API są zwykle posortowane malejąco - wystarczy odwrócić
+    if (std::is_sorted(timestamps.rbegin(), timestamps.rend())) {
+        std::reverse(timestamps.begin(), timestamps.end());
+        std::reverse(values.begin(), values.end());
+        return;
+    }
+
+    std::vector<std::size_t> order(timestamps.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+        return timestamps[a] < timestamps[b];
+    });
+
+    MeasurementSeries sorted;
+    sorted.reserve(order.size());
+    for (std::size_t index : order) {
+        sorted.append(timestamps[index], values[index]);
+    }
+    *this = std::move(sorted);
+}
+
+std::vector<Measurement> MeasurementSeries::toMeasurements() const {
+    std::vector<Measurement> measurements;
+    measurements.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        measurements.push_back({formatMeasurementDate(timestamps[i]), values[i]});
+    }
+    return measurements;
+}
+
+MeasurementSeries MeasurementSeries::fromMeasurements(const std::vector<Measurement>& measurements) {
+    MeasurementSeries series;
+    series.reserve(measurements.size());
+    for (const auto& measurement : measurements) {
+        std::int64_t timestamp;
+        if (parseMeasurementDate(measurement.date.data(), measurement.date.size(), timestamp)) {
+            series.append(timestamp, measurement.value);
+        }
+    }
+    return series;
+}
+
+SeriesStatistics computeStatistics(const std::int64_t* timestamps, const double* values, std::size_t count) {
+    SeriesStatistics statistics;
+    if (count == 0) {
+        return statistics;
+    }
+
+    statistics.count = count;
+    statistics.min = values[0];
+    statistics.max = values[0];
+    statistics.firstTimestamp = timestamps[0];
+    statistics.lastTimestamp = timestamps[0];
+    statistics.lastValue = values[0];
+
+    double sum = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double value = values[i];
+        sum += value;
+        statistics.min = std::min(statistics.min, value);
+        statistics.max = std::max(statistics.max, value);
+        if (timestamps[i] < statistics.firstTimestamp) {
+            statistics.firstTimestamp = timestamps[i];
+        }
+        if (timestamps[i] >= statistics.lastTimestamp) {
+            statistics.lastTimestamp = timestamps[i];
+            statistics.lastValue = value;
+        }
+    }
+    statistics.mean = sum / static_cast<double>(count);
+    return statistics;
+}
+
+AlignedSeries alignSeries(const std::vector<MeasurementSeries>& series) {
+    AlignedSeries aligned;
+    std::size_t total = 0;
+    for (const auto& single : series) {
+        if (!single.isSorted()) {
+            throw std::runtime_error("Seria nie jest posortowana po czasie");
+        }
+        total += single.size();
+    }
+    aligned.timestamps.reserve(total);
+
+    // Kopiec kursorów: na szczycie seria z najwcześniejszym nieprzetworzonym pomiarem
+    struct Cursor {
+        std::int64_t timestamp;
+        std::size_t series;
+    };
+    auto later = [](const Cursor& a, const Cursor& b) {
+        return a.timestamp > b.timestamp || (a.timestamp == b.timestamp && a.series > b.series);
+    };
+    std::vector<Cursor> heap;
+    heap.reserve(series.size());
+    std::vector<std::size_t> positions(series.size(), 0);
+    for (std::size_t i = 0; i < series.size(); ++i) {
+        if (!series[i].empty()) {
+            heap.push_back({series[i].timestamps[0], i});
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), later);
+
+    // Scalanie k-drożne wyznacza wspólną oś czasu
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        const Cursor cursor = heap.back();
+        heap.pop_back();
+
+        if (aligned.timestamps.empty() || aligned.timestamps.back() != cursor.timestamp) {
+            aligned.timestamps.push_back(cursor.timestamp);
+        }
+        const MeasurementSeries& source = series[cursor.series];
+        if (++positions[cursor.series] < source.size()) {
+            heap.push_back({source.timestamps[positions[cursor.series]], cursor.series});
+            std::push_heap(heap.begin(), heap.end(), later);
+        }
+    }
+
+    // Wypełnienie kolumn jednym przejściem po osi i serii (obie posortowane)
+    const std::size_t rows = aligned.timestamps.size();
+    aligned.columns.assign(series.size(), std::vector<double>(rows, std::numeric_limits<double>::quiet_NaN()));
+    for (std::size_t s = 0; s < series.size(); ++s) {
+        const MeasurementSeries& source = series[s];
+        std::vector<double>& column = aligned.columns[s];
+        std::size_t row = 0;
+        for (std::size_t i = 0; i < source.size(); ++i) {
+            while (aligned.timestamps[row] != source.timestamps[i]) {
+                ++row;
+            }
+            column[row] = source.values[i];
+        }
+    }
+    return aligned;
+}
+
+MeasurementSeries decimateMinMax(const std::int64_t* timestamps, const double* values,
+                                 std::size_t count, std::size_t maxPoints) {
+    MeasurementSeries result;
+    maxPoints = std::max<std::size_t>(maxPoints, 2);
+    if (count <= maxPoints) {
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!std::isnan(values[i])) {
+                result.append(timestamps[i], values[i]);
+            }
+        }
+        return result;
+    }
+
+    // Równe przedziały indeksów: serie wyrównane do wspólnej osi mają wtedy wspólne granice
+    const std::size_t buckets = maxPoints / 2;
+    result.reserve(buckets * 2);
+    for (std::size_t b = 0; b < buckets; ++b) {
+        const std::size_t begin = count * b / buckets;
+        const std::size_t end = count * (b + 1) / buckets;
+        std::size_t minIndex = end;
+        std::size_t maxIndex = end;
+        for (std::size_t i = begin; i < end; ++i) {
+            if (std::isnan(values[i])) {
+                continue;
+            }
+            if (minIndex == end || values[i] < values[minIndex]) minIndex = i;
+            if (maxIndex == end || values[i] > values[maxIndex]) maxIndex = i;
+        }
+        if (minIndex == end) {
+            continue;
+        }
+        const std::size_t first = std::min(minIndex, maxIndex);
+        const std::size_t second = std::max(minIndex, maxIndex);
+        result.append(timestamps[first], values[first]);
+        if (second != first) {
+            result.append(timestamps[second], values[second]);
+        }
+    }
+    return result;
+}
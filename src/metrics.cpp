@@ -0,0 +1,312 @@
+/**
+ * @file metrics.cpp
+ * @brief Implementacja histogramów opóźnień i metryk klienta API
+ */
+
+#include "metrics.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+// Numer najstarszego ustawionego bitu (v > 0)
+int highestBit(std::uint64_t value) {
+    int bit = 0;
+    while (value >>= 1) {
+        ++bit;
+    }
+    return bit;
+}
+
+// Granice kubełków histogramu w formacie Prometheus (sekundy)
+const double kPrometheusBounds[] = {
+    0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+};
+
+std::string formatSeconds(std::uint64_t micros) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.6f", static_cast<double>(micros) / 1e6);
+    return buffer;
+}
+
+std::string formatBound(double seconds) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%g", seconds);
+    return buffer;
+}
+
+} // namespace
+
+// ======== LatencyHistogram ========
+
+int LatencyHistogram::bucketIndex(std::uint64_t micros) {
+    const std::uint64_t limit = (std::uint64_t(1) << MAX_MAGNITUDE) - 1;
+    if (micros > limit) {
+        micros = limit;
+    }
+    if (micros < 2 * SUB_BUCKET_COUNT) {
+        return static_cast<int>(micros);
+    }
+    const int magnitude = highestBit(micros);
+    const int shift = magnitude - SUB_BUCKET_BITS;
+    const int subBucket = static_cast<int>(micros >> shift) - SUB_BUCKET_COUNT;
+    return (shift + 1) * SUB_BUCKET_COUNT + subBucket;
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < 2 * SUB_BUCKET_COUNT) {
+        return static_cast<std::uint64_t>(index);
+    }
+    const int shift = index / SUB_BUCKET_COUNT - 1;
+    const std::uint64_t subBucket = static_cast<std::uint64_t>(index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT);
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(std::uint64_t micros) {
+    buckets[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sumMicros.fetch_add(micros, std::memory_order_relaxed);
+
+    std::uint64_t currentMax = maxMicros.load(std::memory_order_relaxed);
+    while (micros > currentMax &&
+           !maxMicros.compare_exchange_weak(currentMax, micros, std::memory_order_relaxed)) {
+    }
+}
+
+std::uint64_t LatencyHistogram::percentile(double percentile) const {
+    const std::uint64_t totalCount = count();
+    if (totalCount == 0) {
+        return 0;
+    }
+    if (percentile < 0.0) percentile = 0.0;
+    if (percentile > 100.0) percentile = 100.0;
+
+    // Pozycja pomiaru (od 1) odpowiadająca percentylowi
+    std::uint64_t rank = static_cast<std::uint64_t>(percentile / 100.0 * static_cast<double>(totalCount) + 0.5);
+    if (rank < 1) rank = 1;
+
+    std::uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            const std::uint64_t upper = bucketUpperBound(i);
+            const std::uint64_t observedMax = max();
+            return upper < observedMax ? upper : observedMax;
+        }
+    }
+    return max();
+}
+
+std::uint64_t LatencyHistogram::countAtOrBelow(std::uint64_t micros) const {
+    std::uint64_t result = 0;
+    for (int i = 0; i < BUCKET_COUNT && bucketUpperBound(i) <= micros; ++i) {
+        result += buckets[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    sumMicros.store(0, std::memory_order_relaxed);
+    maxMicros.store(0, std::memory_order_relaxed);
+}
+
+// ======== Nazwy i klasyfikacja ========
+
+const char* endpointClassName(EndpointClass endpointClass) {
+    switch (endpointClass) {
+        case EndpointClass::Stations: return "stations";
+        case EndpointClass::Sensors: return "sensors";
+        case EndpointClass::Measurements: return "measurements";
+        default: return "other";
+    }
+}
+
+const char* requestPhaseName(RequestPhase phase) {
+    switch (phase) {
+        case RequestPhase::Total: return "total";
+        case RequestPhase::Dns: return "dns";
+        case RequestPhase::Connect: return "connect";
+        case RequestPhase::Tls: return "tls";
+        case RequestPhase::Wait: return "wait";
+        case RequestPhase::Transfer: return "transfer";
+        case RequestPhase::Parse: return "parse";
+        case RequestPhase::Decode: return "decode";
+        default: return "unknown";
+    }
+}
+
+EndpointClass classifyEndpoint(const std::string& endpoint) {
+    if (endpoint.compare(0, 14, "/data/getData/") == 0) {
+        return EndpointClass::Measurements;
+    }
+    if (endpoint.compare(0, 17, "/station/sensors/") == 0) {
+        return EndpointClass::Sensors;
+    }
+    if (endpoint == "/station/findAll") {
+        return EndpointClass::Stations;
+    }
+    return EndpointClass::Other;
+}
+
+// ======== ApiMetrics ========
+
+void ApiMetrics::recordCacheHit(EndpointClass endpointClass) {
+    endpoint(endpointClass).cacheHits.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ApiMetrics::recordCacheMiss(EndpointClass endpointClass) {
+    endpoint(endpointClass).cacheMisses.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ApiMetrics::recordCoalesced(EndpointClass endpointClass) {
+    endpoint(endpointClass).coalesced.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ApiMetrics::recordRequest(EndpointClass endpointClass, const RequestTimings& timings,
+                               std::uint64_t bytes, bool success) {
+    EndpointMetrics& metrics = endpoint(endpointClass);
+    metrics.requests.fetch_add(1, std::memory_order_relaxed);
+    metrics.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    if (!success) {
+        metrics.failures.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    metrics.phase(RequestPhase::Total).record(timings.total);
+    metrics.phase(RequestPhase::Dns).record(timings.dns);
+    metrics.phase(RequestPhase::Connect).record(timings.connect);
+    metrics.phase(RequestPhase::Tls).record(timings.tls);
+    metrics.phase(RequestPhase::Wait).record(timings.wait);
+    metrics.phase(RequestPhase::Transfer).record(timings.transfer);
+}
+
+void ApiMetrics::recordTransfer(EndpointClass endpointClass, std::uint64_t wireBytes, bool newConnection, bool http2) {
+    EndpointMetrics& metrics = endpoint(endpointClass);
+    metrics.wireBytes.fetch_add(wireBytes, std::memory_order_relaxed);
+    if (newConnection) {
+        metrics.connections.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (http2) {
+        metrics.http2Requests.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ApiMetrics::recordPhase(EndpointClass endpointClass, RequestPhase phase, std::uint64_t micros) {
+    endpoint(endpointClass).phase(phase).record(micros);
+}
+
+void ApiMetrics::reset() {
+    for (auto& metrics : endpoints) {
+        metrics.requests.store(0, std::memory_order_relaxed);
+        metrics.failures.store(0, std::memory_order_relaxed);
+        metrics.bytes.store(0, std::memory_order_relaxed);
+        metrics.wireBytes.store(0, std::memory_order_relaxed);
+        metrics.connections.store(0, std::memory_order_relaxed);
+        metrics.http2Requests.store(0, std::memory_order_relaxed);
+        metrics.cacheHits.store(0, std::memory_order_relaxed);
+        metrics.cacheMisses.store(0, std::memory_order_relaxed);
+        metrics.coalesced.store(0, std::memory_order_relaxed);
+        metrics.retries.store(0, std::memory_order_relaxed);
+        metrics.hedged.store(0, std::memory_order_relaxed);
+        metrics.hedgeWins.store(0, std::memory_order_relaxed);
+        metrics.staleServed.store(0, std::memory_order_relaxed);
+        metrics.breakerRejections.store(0, std::memory_order_relaxed);
+        for (auto& histogram : metrics.phases) {
+            histogram.reset();
+        }
+    }
+}
+
+std::string ApiMetrics::toPrometheus() const {
+    std::ostringstream out;
+    const int endpointCount = static_cast<int>(EndpointClass::Count);
+    const int phaseCount = static_cast<int>(RequestPhase::Count);
+
+    // Liczniki
+    struct CounterInfo {
+        const char* name;
+        const char* help;
+        std::atomic<std::uint64_t> EndpointMetrics::*field;
+    };
+    const CounterInfo counters[] = {
+        {"airquality_api_requests_total", "Liczba zapytan HTTP do API", &EndpointMetrics::requests},
+        {"airquality_api_failures_total", "Liczba nieudanych zapytan HTTP", &EndpointMetrics::failures},
+        {"airquality_api_response_bytes_total", "Liczba odebranych bajtow tresci (po dekompresji)", &EndpointMetrics::bytes},
+        {"airquality_api_wire_bytes_total", "Liczba bajtow tresci przeslanych siecia (przed dekompresja)", &EndpointMetrics::wireBytes},
+        {"airquality_api_connections_total", "Nowo otwarte polaczenia", &EndpointMetrics::connections},
+        {"airquality_api_http2_requests_total", "Zapytania obsluzone przez HTTP/2", &EndpointMetrics::http2Requests},
+        {"airquality_api_cache_hits_total", "Odczyty obsluzone z cache", &EndpointMetrics::cacheHits},
+        {"airquality_api_cache_misses_total", "Odczyty wymagajace zapytania do API", &EndpointMetrics::cacheMisses},
+        {"airquality_api_coalesced_total", "Wywolania dolaczone do trwajacego pobrania", &EndpointMetrics::coalesced},
+        {"airquality_api_retries_total", "Ponowienia zapytan po bledzie przejsciowym", &EndpointMetrics::retries},
+        {"airquality_api_hedged_total", "Wyslane zapytania zapasowe", &EndpointMetrics::hedged},
+        {"airquality_api_hedge_wins_total", "Zapytania zapasowe, ktore odpowiedzialy pierwsze", &EndpointMetrics::hedgeWins},
+        {"airquality_api_stale_served_total", "Odczyty obsluzone nieaktualnymi danymi", &EndpointMetrics::staleServed},
+        {"airquality_api_breaker_rejections_total", "Zapytania odrzucone przez otwarty wylacznik obwodu", &EndpointMetrics::breakerRejections},
+    };
+    for (const auto& counter : counters) {
+        out << "# HELP " << counter.name << " " << counter.help << "\n";
+        out << "# TYPE " << counter.name << " counter\n";
+        for (int e = 0; e < endpointCount; ++e) {
+            out << counter.name << "{endpoint=\"" << endpointClassName(static_cast<EndpointClass>(e)) << "\"} "
+                << (endpoints[e].*counter.field).load(std::memory_order_relaxed) << "\n";
+        }
+    }
+
+    // Histogramy etapów
+    out << "# HELP airquality_api_phase_seconds Czas etapow obslugi zapytania\n";
+    out << "# TYPE airquality_api_phase_seconds histogram\n";
+    for (int e = 0; e < endpointCount; ++e) {
+        for (int p = 0; p < phaseCount; ++p) {
+            const LatencyHistogram& histogram = endpoints[e].phases[p];
+            const std::string labels = std::string("endpoint=\"") + endpointClassName(static_cast<EndpointClass>(e)) +
+                                       "\",phase=\"" + requestPhaseName(static_cast<RequestPhase>(p)) + "\"";
+            for (double bound : kPrometheusBounds) {
+                out << "airquality_api_phase_seconds_bucket{" << labels << ",le=\"" << formatBound(bound) << "\"} "
+                    << histogram.countAtOrBelow(static_cast<std::uint64_t>(bound * 1e6)) << "\n";
+            }
+            out << "airquality_api_phase_seconds_bucket{" << labels << ",le=\"+Inf\"} " << histogram.count() << "\n";
+            out << "airquality_api_phase_seconds_sum{" << labels << "} " << formatSeconds(histogram.sum()) << "\n";
+            out << "airquality_api_phase_seconds_count{" << labels << "} " << histogram.count() << "\n";
+        }
+    }
+
+    // Percentyle z histogramów o pełnej rozdzielczości
+    out << "# HELP airquality_api_phase_quantile_seconds Percentyle czasu etapow (histogram HDR)\n";
+    out << "# TYPE airquality_api_phase_quantile_seconds gauge\n";
+    const double quantiles[] = {50.0, 90.0, 99.0, 99.9};
+    for (int e = 0; e < endpointCount; ++e) {
+        for (int p = 0; p < phaseCount; ++p) {
+            const LatencyHistogram& histogram = endpoints[e].phases[p];
+            if (histogram.count() == 0) {
+                continue;
+            }
+            for (double quantile : quantiles) {
+                out << "airquality_api_phase_quantile_seconds{endpoint=\"" << endpointClassName(static_cast<EndpointClass>(e))
+                    << "\",phase=\"" << requestPhaseName(static_cast<RequestPhase>(p))
+                    << "\",quantile=\"" << formatBound(quantile / 100.0) << "\"} "
+                    << formatSeconds(histogram.percentile(quantile)) << "\n";
+            }
+        }
+    }
+    return out.str();
+}
+
+bool ApiMetrics::writePrometheus(const std::string& path) const {
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file << toPrometheus();
+        if (!file) {
+            return false;
+        }
+    }
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file resampler.cpp
+ * @brief Implementacja przeliczania serii na regularną siatkę czasu
+ */
+
+#include "resampler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+Resampler::Resampler(ResampleStep step) : step(static_cast<std::int64_t>(step)) {
+}
+
+std::size_t Resampler::addColumn(std::string name) {
+    names.push_back(std::move(name));
+    sums.emplace_back(rows(), 0.0);
+    counts.emplace_back(rows(), 0u);
+    watermarks.push_back(std::numeric_limits<std::int64_t>::min());
+    return names.size() - 1;
+}
+
+std::int64_t Resampler::snap(std::int64_t timestamp) const {
+    // Zaokrąglenie w dół także dla czasów sprzed epoki
+    std::int64_t remainder = timestamp % step;
+    if (remainder < 0) {
+        remainder += step;
+    }
+    return timestamp - remainder;
+}
+
+void Resampler::ensureRange(std::int64_t first, std::int64_t last) {
+    if (rows() == 0) {
+        start = first;
+        const std::size_t count = static_cast<std::size_t>((last - first) / step) + 1;
+        for (std::size_t c = 0; c < sums.size(); ++c) {
+            sums[c].assign(count, 0.0);
+            counts[c].assign(count, 0u);
+        }
+        return;
+    }
+
+    // Dane starsze niż początek siatki - rzadkie, wymagają przesunięcia kolumn
+    if (first < start) {
+        const std::size_t prepend = static_cast<std::size_t>((start - first) / step);
+        for (std::size_t c = 0; c < sums.size(); ++c) {
+            sums[c].insert(sums[c].begin(), prepend, 0.0);
+            counts[c].insert(counts[c].begin(), prepend, 0u);
+        }
+        start = first;
+    }
+    const std::size_t required = static_cast<std::size_t>((last - start) / step) + 1;
+    if (required > rows()) {
+        for (std::size_t c = 0; c < sums.size(); ++c) {
+            sums[c].resize(required, 0.0);
+            counts[c].resize(required, 0u);
+        }
+    }
+}
+
+std::size_t Resampler::append(std::size_t column, const MeasurementSeries& series) {
+    if (column >= names.size()) {
+        throw std::runtime_error("Nieznana kolumna resamplera: " + std::to_string(column));
+    }
+
+    // Tylko pomiary nowsze niż ostatni przyjęty
+    const std::int64_t watermark = watermarks[column];
+    std::int64_t first = std::numeric_limits<std::int64_t>::max();
+    std::int64_t last = std::numeric_limits<std::int64_t>::min();
+    for (std::size_t i = 0; i < series.size(); ++i) {
+        if (series.timestamps[i] > watermark && !std::isnan(series.values[i])) {
+            first = std::min(first, series.timestamps[i]);
+            last = std::max(last, series.timestamps[i]);
+        }
+    }
+    if (first > last) {
+        return 0;
+    }
+    ensureRange(snap(first), snap(last));
+
+    std::vector<double>& columnSums = sums[column];
+    std::vector<std::uint32_t>& columnCounts = counts[column];
+    std::size_t accepted = 0;
+    for (std::size_t i = 0; i < series.size(); ++i) {
+        if (series.timestamps[i] <= watermark || std::isnan(series.values[i])) {
+            continue;
+        }
+        const std::size_t row = static_cast<std::size_t>((snap(series.timestamps[i]) - start) / step);
+        columnSums[row] += series.values[i];
+        ++columnCounts[row];
+        ++accepted;
+    }
+    watermarks[column] = last;
+    return accepted;
+}
+
+ResampledFrame Resampler::frame(GapFill fill, std::size_t maxGapRows) const {
+    ResampledFrame result;
+    result.start = start;
+    result.step = step;
+    result.names = names;
+    result.columns.resize(names.size());
+
+    const std::size_t rowCount = rows();
+    for (std::size_t c = 0; c < names.size(); ++c) {
+        std::vector<double>& values = result.columns[c];
+        values.resize(rowCount);
+        const double* columnSums = sums[c].data();
+        const std::uint32_t* columnCounts = counts[c].data();
+        for (std::size_t row = 0; row < rowCount; ++row) {
+            values[row] = columnCounts[row] ? columnSums[row] / columnCounts[row] : std::nan("");
+        }
+
+        // Luki: puste węzły między dwoma pomiarami
+        std::size_t previous = rowCount;
+        for (std::size_t row = 0; row < rowCount; ++row) {
+            if (std::isnan(values[row])) {
+                continue;
+            }
+            if (previous != rowCount && row - previous > 1) {
+                const std::size_t gapRows = row - previous - 1;
+                result.gaps.push_back({c, previous + 1, gapRows});
+                if (fill != GapFill::None && gapRows <= maxGapRows) {
+                    for (std::size_t g = previous + 1; g < row; ++g) {
+                        const double t = static_cast<double>(g - previous) / static_cast<double>(row - previous);
+                        values[g] = fill == GapFill::Linear ?
+                            values[previous] + (values[row] - values[previous]) * t : values[previous];
+                    }
+                }
+            }
+            previous = row;
+        }
+    }
+    return result;
+}
+
+ResampledFrame Resampler::resample(const std::vector<MeasurementSeries>& series, const std::vector<std::string>& names,
+                                   ResampleStep step, GapFill fill) {
+    if (series.size() != names.size()) {
+        throw std::runtime_error("Liczba nazw kolumn nie odpowiada liczbie serii");
+    }
+    Resampler resampler(step);
+    for (std::size_t i = 0; i < series.size(); ++i) {
+        resampler.append(resampler.addColumn(names[i]), series[i]);
+    }
+    return resampler.frame(fill);
+}
+
+double pearsonCorrelation(const double* a, const double* b, std::size_t count) {
+    double sumA = 0.0, sumB = 0.0, sumAA = 0.0, sumBB = 0.0, sumAB = 0.0;
+    std::size_t pairs = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (std::isnan(a[i]) || std::isnan(b[i])) {
+            continue;
+        }
+        sumA += a[i];
+        sumB += b[i];
+        sumAA += a[i] * a[i];
+        sumBB += b[i] * b[i];
+        sumAB += a[i] * b[i];
+        ++pairs;
+    }
+    if (pairs < 2) {
+        return std::nan("");
+    }
+    const double n = static_cast<double>(pairs);
+    const double covariance = sumAB - sumA * sumB / n;
+    const double varianceA = sumAA - sumA * sumA / n;
+    const double varianceB = sumBB - sumB * sumB / n;
+    if (varianceA <= 0.0 || varianceB <= 0.0) {
+        return std::nan("");
+    }
+    return covariance / std::sqrt(varianceA * varianceB);
+}
@@ -0,0 +1,413 @@
+/**
+ * @file response_decoder.cpp
+ * @brief Implementacja dekoderów SAX odpowiedzi API GIOŚ z areną per odpowiedź
+ */
+
+#include "response_decoder.hpp"
+#include "logger.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory_resource>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+// Bufor początkowy areny na stosie; większe odpowiedzi dobierają bloki geometrycznie
+constexpr std::size_t INITIAL_ARENA_SIZE = 16 * 1024;
+
+std::uint64_t microsecondsSince(std::chrono::steady_clock::time_point start) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+// Kopiuje napis do areny; widok jest ważny do końca dekodowania odpowiedzi
+std::string_view copyToArena(std::pmr::memory_resource* arena, const std::string& value) {
+    if (value.empty()) {
+        return {};
+    }
+    char* copy = static_cast<char*>(arena->allocate(value.size(), 1));
+    std::memcpy(copy, value.data(), value.size());
+    return std::string_view(copy, value.size());
+}
+
+// Liczba zapisana jako tekst (np. "50.912475"); false jeśli tekst nie zaczyna się od liczby
+bool parseDouble(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return end != text.c_str();
+}
+
+/**
+ * @brief Wspólna część handlerów: stos kontekstów i ostatni klucz w arenie odpowiedzi
+ */
+template <typename Context>
+class ArenaHandler : public nlohmann::json_sax<json> {
+public:
+    explicit ArenaHandler(std::pmr::memory_resource* arena)
+        : arena(arena), contexts(arena), lastKey(arena) {
+        contexts.reserve(8);
+    }
+
+    bool boolean(bool) override { return true; }
+
+    bool binary(binary_t&) override { return true; }
+
+    bool key(string_t& value) override {
+        lastKey.assign(value.data(), value.size());
+        return true;
+    }
+
+    bool end_array() override {
+        contexts.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& ex) override {
+        throw std::runtime_error("Blad parsowania JSON na pozycji " + std::to_string(position) + ": " + ex.what());
+    }
+
+protected:
+    std::pmr::memory_resource* arena;
+    std::pmr::vector<Context> contexts;
+    std::pmr::string lastKey;
+
+    Context top() const {
+        return contexts.empty() ? Context::Ignored : contexts.back();
+    }
+};
+
+// ======== Stacje ========
+
+enum class StationContext { Root, Ignored, Station, City, Commune };
+
+struct PendingStation {
+    int id = 0;
+    std::string_view name;
+    double lat = 0.0;
+    double lon = 0.0;
+    InternedString city;
+    std::string_view address;
+    InternedString province;
+};
+
+class StationsHandler : public ArenaHandler<StationContext> {
+public:
+    explicit StationsHandler(std::pmr::memory_resource* arena) : ArenaHandler(arena), stations(arena) {}
+
+    std::pmr::vector<PendingStation> stations;
+
+    bool null() override { return true; }
+
+    bool number_integer(number_integer_t value) override {
+        onNumber(static_cast<double>(value));
+        return true;
+    }
+
+    bool number_unsigned(number_unsigned_t value) override {
+        onNumber(static_cast<double>(value));
+        return true;
+    }
+
+    bool number_float(number_float_t value, const string_t&) override {
+        onNumber(value);
+        return true;
+    }
+
+    bool string(string_t& value) override {
+        switch (top()) {
+        case StationContext::Station:
+            if (lastKey == "stationName") stations.back().name = copyToArena(arena, value);
+            else if (lastKey == "gegrLat") parseDouble(value, stations.back().lat);
+            else if (lastKey == "gegrLon") parseDouble(value, stations.back().lon);
+            else if (lastKey == "addressStreet") stations.back().address = copyToArena(arena, value);
+            break;
+        case StationContext::City:
+            if (lastKey == "name") stations.back().city = InternedString(value);
+            break;
+        case StationContext::Commune:
+            if (lastKey == "provinceName") stations.back().province = InternedString(value);
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        const StationContext parent = top();
+        StationContext child = StationContext::Ignored;
+        if (parent == StationContext::Root && contexts.size() == 1) {
+            child = StationContext::Station;
+            stations.emplace_back();
+        } else if (parent == StationContext::Station && lastKey == "city") {
+            child = StationContext::City;
+        } else if (parent == StationContext::City && lastKey == "commune") {
+            child = StationContext::Commune;
+        }
+        contexts.push_back(child);
+        return true;
+    }
+
+    bool end_object() override {
+        contexts.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t elements) override {
+        if (contexts.empty()) {
+            if (elements != static_cast<std::size_t>(-1)) {
+                stations.reserve(elements);
+            }
+            contexts.push_back(StationContext::Root);
+        } else {
+            contexts.push_back(StationContext::Ignored);
+        }
+        return true;
+    }
+
+private:
+    void onNumber(double value) {
+        if (top() != StationContext::Station) {
+            return;
+        }
+        if (lastKey == "id") stations.back().id = static_cast<int>(value);
+        else if (lastKey == "gegrLat") stations.back().lat = value;
+        else if (lastKey == "gegrLon") stations.back().lon = value;
+    }
+};
+
+// ======== Czujniki ========
+
+enum class SensorContext { Root, Ignored, Sensor, Param };
+
+class SensorsHandler : public ArenaHandler<SensorContext> {
+public:
+    explicit SensorsHandler(std::pmr::memory_resource* arena) : ArenaHandler(arena), sensors(arena) {}
+
+    std::pmr::vector<Sensor> sensors;
+
+    bool null() override { return true; }
+
+    bool number_integer(number_integer_t value) override {
+        onNumber(static_cast<int>(value));
+        return true;
+    }
+
+    bool number_unsigned(number_unsigned_t value) override {
+        onNumber(static_cast<int>(value));
+        return true;
+    }
+
+    bool number_float(number_float_t value, const string_t&) override {
+        onNumber(static_cast<int>(value));
+        return true;
+    }
+
+    bool string(string_t& value) override {
+        if (top() == SensorContext::Param) {
+            if (lastKey == "paramName") sensors.back().paramName = InternedString(value);
+            else if (lastKey == "paramFormula") sensors.back().paramFormula = InternedString(value);
+            else if (lastKey == "paramCode") sensors.back().paramCode = InternedString(value);
+        }
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        const SensorContext parent = top();
+        SensorContext child = SensorContext::Ignored;
+        if (parent == SensorContext::Root && contexts.size() == 1) {
+            child = SensorContext::Sensor;
+            sensors.push_back({0, 0, {}, {}, {}, 0, Pollutant::Unknown});
+        } else if (parent == SensorContext::Sensor && lastKey == "param") {
+            child = SensorContext::Param;
+        }
+        contexts.push_back(child);
+        return true;
+    }
+
+    bool end_object() override {
+        contexts.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        contexts.push_back(contexts.empty() ? SensorContext::Root : SensorContext::Ignored);
+        return true;
+    }
+
+private:
+    void onNumber(int value) {
+        if (top() == SensorContext::Sensor) {
+            if (lastKey == "id") sensors.back().id = value;
+            else if (lastKey == "stationId") sensors.back().stationId = value;
+        } else if (top() == SensorContext::Param && lastKey == "idParam") {
+            sensors.back().paramId = value;
+        }
+    }
+};
+
+// ======== Pomiary ========
+
+enum class MeasurementContext { Root, Ignored, Values, Item };
+
+struct PendingMeasurement {
+    std::string_view date;
+    double value;
+};
+
+class MeasurementsHandler : public ArenaHandler<MeasurementContext> {
+public:
+    MeasurementsHandler(std::pmr::memory_resource* arena, std::size_t expected)
+        : ArenaHandler(arena), measurements(arena) {
+        measurements.reserve(expected);
+    }
+
+    std::pmr::vector<PendingMeasurement> measurements;
+
+    bool null() override {
+        // Brak wartości pomiaru - pomiar zostanie pominięty
+        if (top() == MeasurementContext::Item && lastKey == "value") {
+            hasValue = false;
+        }
+        return true;
+    }
+
+    bool number_integer(number_integer_t value) override {
+        onNumber(static_cast<double>(value));
+        return true;
+    }
+
+    bool number_unsigned(number_unsigned_t value) override {
+        onNumber(static_cast<double>(value));
+        return true;
+    }
+
+    bool number_float(number_float_t value, const string_t&) override {
+        onNumber(value);
+        return true;
+    }
+
+    bool string(string_t& value) override {
+        if (top() != MeasurementContext::Item) {
+            return true;
+        }
+        if (lastKey == "date") {
+            pendingDate = copyToArena(arena, value);
+            hasDate = true;
+        } else if (lastKey == "value") {
+            // Wartość zapisana jako tekst
+            hasValue = parseDouble(value, pendingValue);
+            if (!hasValue) {
+                LOG_ERROR("api", "Blad konwersji wartosci: " << value);
+            }
+        }
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        MeasurementContext child = MeasurementContext::Ignored;
+        if (contexts.empty()) {
+            child = MeasurementContext::Root;
+        } else if (top() == MeasurementContext::Values) {
+            child = MeasurementContext::Item;
+            hasDate = false;
+            hasValue = false;
+        }
+        contexts.push_back(child);
+        return true;
+    }
+
+    bool end_object() override {
+        if (top() == MeasurementContext::Item && hasDate && hasValue) {
+            measurements.push_back({pendingDate, pendingValue});
+        }
+        contexts.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        const bool values = top() == MeasurementContext::Root && lastKey == "values";
+        contexts.push_back(values ? MeasurementContext::Values : MeasurementContext::Ignored);
+        return true;
+    }
+
+private:
+    std::string_view pendingDate;
+    double pendingValue = 0.0;
+    bool hasDate = false;
+    bool hasValue = false;
+
+    void onNumber(double value) {
+        if (top() == MeasurementContext::Item && lastKey == "value") {
+            pendingValue = value;
+            hasValue = true;
+        }
+    }
+};
+
+/**
+ * @brief Parsuje odpowiedź handlerem w arenie i przekazuje rekordy tymczasowe do kopiowania
+ */
+template <typename Handler, typename Result, typename Copy>
+Result decode(const char* data, std::size_t size, DecodeStats* stats, Handler& handler, Copy copy) {
+    auto parseStart = std::chrono::steady_clock::now();
+    json::sax_parse(data, data + size, &handler);
+    auto copyStart = std::chrono::steady_clock::now();
+    Result result = copy(handler);
+    if (stats) {
+        stats->parseMicros = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(copyStart - parseStart).count());
+        stats->copyMicros = microsecondsSince(copyStart);
+    }
+    return result;
+}
+
+} // namespace
+
+std::vector<Station> ResponseDecoder::decodeStations(const char* data, std::size_t size, DecodeStats* stats) {
+    alignas(std::max_align_t) char initialBuffer[INITIAL_ARENA_SIZE];
+    std::pmr::monotonic_buffer_resource arena(initialBuffer, sizeof(initialBuffer));
+    StationsHandler handler(&arena);
+
+    return decode<StationsHandler, std::vector<Station>>(data, size, stats, handler, [](StationsHandler& h) {
+        std::vector<Station> stations;
+        stations.reserve(h.stations.size());
+        for (const auto& pending : h.stations) {
+            stations.push_back({pending.id, std::string(pending.name), pending.lat, pending.lon,
+                                pending.city, std::string(pending.address), pending.province});
+        }
+        return stations;
+    });
+}
+
+std::vector<Sensor> ResponseDecoder::decodeSensors(const char* data, std::size_t size, DecodeStats* stats) {
+    alignas(std::max_align_t) char initialBuffer[INITIAL_ARENA_SIZE];
+    std::pmr::monotonic_buffer_resource arena(initialBuffer, sizeof(initialBuffer));
+    SensorsHandler handler(&arena);
+
+    return decode<SensorsHandler, std::vector<Sensor>>(data, size, stats, handler, [](SensorsHandler& h) {
+        std::vector<Sensor> sensors(h.sensors.begin(), h.sensors.end());
+        for (auto& sensor : sensors) {
+            sensor.pollutant = resolvePollutant(sensor.paramId, sensor.paramCode.str());
+        }
+        return sensors;
+    });
+}
+
+std::vector<Measurement> ResponseDecoder::decodeMeasurements(const char* data, std::size_t size, DecodeStats* stats) {
+    alignas(std::max_align_t) char initialBuffer[INITIAL_ARENA_SIZE];
+    std::pmr::monotonic_buffer_resource arena(initialBuffer, sizeof(initialBuffer));
+    // Jeden pomiar zajmuje w odpowiedzi ok. 45 bajtów
+    MeasurementsHandler handler(&arena, size / 45);
+
+    return decode<MeasurementsHandler, std::vector<Measurement>>(data, size, stats, handler, [](MeasurementsHandler& h) {
+        std::vector<Measurement> measurements;
+        measurements.reserve(h.measurements.size());
+        for (const auto& pending : h.measurements) {
+            measurements.push_back({std::string(pending.date), pending.value});
+        }
+        return measurements;
+    });
+}
@@ -0,0 +1,418 @@
+/**
+ * @file series_codec.cpp
+ * @brief Implementacja kompresji serii pomiarowych
+ */
+
+#include "series_codec.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr char BLOCK_MAGIC[4] = {'A', 'Q', 'Z', 'B'};
+constexpr std::uint8_t BLOCK_VERSION = 1;
+constexpr std::size_t FRAME_SIZE = 128;
+constexpr int MAX_DECIMALS = 6;
+constexpr std::size_t PADDING = 8; // Dekoder czyta ramki słowami 64-bitowymi
+
+/**
+ * @brief Nagłówek bloku (40 bajtów)
+ */
+struct BlockHeader {
+    char magic[4];
+    std::uint8_t version;
+    std::uint8_t encoding;
+    std::uint8_t decimals;
+    std::uint8_t reserved;
+    std::uint32_t count;
+    std::uint32_t timestampBytes;
+    std::int64_t firstTimestamp;
+    std::int64_t firstDelta;
+    std::uint32_t valueBytes;
+    std::uint32_t reserved2;
+};
+static_assert(sizeof(BlockHeader) == 40, "Naglowek bloku musi miec 40 bajtow");
+
+constexpr double POWERS_OF_TEN[MAX_DECIMALS + 1] = {1.0, 10.0, 100.0, 1e3, 1e4, 1e5, 1e6};
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+// Różnica i suma modulo 2^64: różnice dowolnych znaczników czasu nie przepełniają int64_t,
+// a dekodowanie odtwarza je dokładnie
+std::int64_t wrappingSub(std::int64_t a, std::int64_t b) {
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b));
+}
+
+std::int64_t wrappingAdd(std::int64_t a, std::int64_t b) {
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b));
+}
+
+unsigned bitWidth(std::uint64_t value) {
+    unsigned width = 0;
+    while (value) {
+        ++width;
+        value >>= 1;
+    }
+    return width;
+}
+
+/**
+ * @brief Pakuje liczby w ramki po FRAME_SIZE: bajt szerokości i bity wartości (little-endian)
+ *
+ * Szerokości 58-63 są zapisywane jako 64 (surowe słowa), aby dekoder mógł odczytać każdą
+ * wartość jednym słowem 64-bitowym.
+ */
+void packFrames(const std::uint64_t* input, std::size_t count, std::string& output) {
+    for (std::size_t start = 0; start < count; start += FRAME_SIZE) {
+        const std::size_t n = std::min(FRAME_SIZE, count - start);
+        std::uint64_t combined = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            combined |= input[start + i];
+        }
+        unsigned width = bitWidth(combined);
+        if (width > 57) {
+            width = 64;
+        }
+        output.push_back(static_cast<char>(width));
+        if (width == 0) {
+            continue;
+        }
+        if (width == 64) {
+            output.append(reinterpret_cast<const char*>(input + start), n * sizeof(std::uint64_t));
+            continue;
+        }
+
+        std::uint64_t buffer = 0;
+        unsigned buffered = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            buffer |= input[start + i] << buffered;
+            buffered += width;
+            if (buffered >= 64) {
+                output.append(reinterpret_cast<const char*>(&buffer), sizeof(buffer));
+                buffered -= 64;
+                buffer = buffered ? input[start + i] >> (width - buffered) : 0;
+            }
+        }
+        output.append(reinterpret_cast<const char*>(&buffer), (buffered + 7) / 8);
+    }
+}
+
+/**
+ * @brief Rozpakowuje jedną ramkę
+ * @return Wskaźnik za ramką
+ */
+const std::uint8_t* unpackFrame(const std::uint8_t* input, const std::uint8_t* end, std::size_t n, std::uint64_t* output) {
+    if (input >= end) {
+        throw std::runtime_error("Uszkodzony blok serii");
+    }
+    const unsigned width = *input++;
+    if (width == 0) {
+        std::fill(output, output + n, 0);
+        return input;
+    }
+    if (width == 64) {
+        if (static_cast<std::size_t>(end - input) < n * sizeof(std::uint64_t)) {
+            throw std::runtime_error("Uszkodzony blok serii");
+        }
+        std::memcpy(output, input, n * sizeof(std::uint64_t));
+        return input + n * sizeof(std::uint64_t);
+    }
+    if (width > 57 || static_cast<std::size_t>(end - input) < (n * width + 7) / 8) {
+        throw std::runtime_error("Uszkodzony blok serii");
+    }
+
+    // Odczyt słowem 64-bitowym może wyjść do 7 bajtów poza ramkę - blok kończy się dopełnieniem
+    const std::uint64_t mask = (std::uint64_t{1} << width) - 1;
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t bit = i * width;
+        std::uint64_t word;
+        std::memcpy(&word, input + bit / 8, sizeof(word));
+        output[i] = (word >> (bit % 8)) & mask;
+    }
+    return input + (n * width + 7) / 8;
+}
+
+/**
+ * @brief Najmniejsza liczba miejsc po przecinku, przy której wszystkie wartości są zapisywane bezstratnie
+ * @return Liczba miejsc lub -1, jeśli wartości nie mają krótkiego zapisu dziesiętnego
+ */
+int findDecimals(const double* values, std::size_t count) {
+    for (int decimals = 0; decimals <= MAX_DECIMALS; ++decimals) {
+        const double scale = POWERS_OF_TEN[decimals];
+        bool exact = true;
+        for (std::size_t i = 0; i < count && exact; ++i) {
+            const double scaled = values[i] * scale;
+            // NaN i nieskończoności nie spełniają warunku zakresu
+            if (!(std::fabs(scaled) < 9.0e15)) {
+                return -1;
+            }
+            exact = static_cast<double>(std::llround(scaled)) / scale == values[i] && !(values[i] == 0.0 && std::signbit(values[i]));
+        }
+        if (exact) {
+            return decimals;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Zapis bitów od najstarszego (kodowanie XOR)
+ */
+class BitWriter {
+public:
+    explicit BitWriter(std::string& output) : output(output) {}
+
+    void write(std::uint64_t value, unsigned bits) {
+        for (unsigned remaining = bits; remaining > 0;) {
+            const unsigned take = std::min(remaining, 8 - used);
+            const unsigned shift = remaining - take;
+            current = static_cast<std::uint8_t>(current | (((value >> shift) & ((1u << take) - 1)) << (8 - used - take)));
+            used += take;
+            remaining -= take;
+            if (used == 8) {
+                output.push_back(static_cast<char>(current));
+                current = 0;
+                used = 0;
+            }
+        }
+    }
+
+    void flush() {
+        if (used > 0) {
+            output.push_back(static_cast<char>(current));
+            current = 0;
+            used = 0;
+        }
+    }
+
+private:
+    std::string& output;
+    std::uint8_t current = 0;
+    unsigned used = 0;
+};
+
+/**
+ * @brief Odczyt bitów od najstarszego (kodowanie XOR)
+ */
+class BitReader {
+public:
+    BitReader(const std::uint8_t* data, std::size_t size) : data(data), bitCount(size * 8) {}
+
+    std::uint64_t read(unsigned bits) {
+        if (position + bits > bitCount) {
+            throw std::runtime_error("Uszkodzony blok serii");
+        }
+        std::uint64_t value = 0;
+        for (unsigned i = 0; i < bits; ++i, ++position) {
+            value = (value << 1) | ((data[position / 8] >> (7 - position % 8)) & 1u);
+        }
+        return value;
+    }
+
+private:
+    const std::uint8_t* data;
+    std::size_t bitCount;
+    std::size_t position = 0;
+};
+
+int leadingZeros(std::uint64_t value) {
+    int count = 0;
+    for (std::uint64_t bit = std::uint64_t{1} << 63; bit && !(value & bit); bit >>= 1) {
+        ++count;
+    }
+    return count;
+}
+
+int trailingZeros(std::uint64_t value) {
+    int count = 0;
+    for (; count < 64 && !(value & 1); value >>= 1) {
+        ++count;
+    }
+    return count;
+}
+
+void encodeXor(const double* values, std::size_t count, std::string& output) {
+    BitWriter writer(output);
+    std::uint64_t previous = 0;
+    int previousLeading = -1;
+    int previousTrailing = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        const std::uint64_t delta = bits ^ previous;
+        previous = bits;
+        if (delta == 0) {
+            writer.write(0, 1);
+            continue;
+        }
+        const int leading = std::min(leadingZeros(delta), 31);
+        const int trailing = trailingZeros(delta);
+        if (previousLeading >= 0 && leading >= previousLeading && trailing >= previousTrailing) {
+            // Znaczące bity mieszczą się w oknie poprzedniej wartości
+            writer.write(0b10, 2);
+            writer.write(delta >> previousTrailing, static_cast<unsigned>(64 - previousLeading - previousTrailing));
+        } else {
+            const int significant = 64 - leading - trailing;
+            writer.write(0b11, 2);
+            writer.write(static_cast<std::uint64_t>(leading), 5);
+            writer.write(static_cast<std::uint64_t>(significant - 1), 6);
+            writer.write(delta >> trailing, static_cast<unsigned>(significant));
+            previousLeading = leading;
+            previousTrailing = trailing;
+        }
+    }
+    writer.flush();
+}
+
+void decodeXor(const std::uint8_t* data, std::size_t size, double* values, std::size_t count) {
+    BitReader reader(data, size);
+    std::uint64_t previous = 0;
+    int previousLeading = 0;
+    int previousTrailing = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (reader.read(1)) {
+            if (reader.read(1)) {
+                previousLeading = static_cast<int>(reader.read(5));
+                const int significant = static_cast<int>(reader.read(6)) + 1;
+                previousTrailing = 64 - previousLeading - significant;
+                if (previousTrailing < 0) {
+                    throw std::runtime_error("Uszkodzony blok serii");
+                }
+            }
+            previous ^= reader.read(static_cast<unsigned>(64 - previousLeading - previousTrailing)) << previousTrailing;
+        }
+        std::memcpy(&values[i], &previous, sizeof(previous));
+    }
+}
+
+BlockHeader readHeader(const char* data, std::size_t size) {
+    BlockHeader header;
+    if (size < sizeof(header)) {
+        throw std::runtime_error("Uszkodzony blok serii");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) != 0 || header.version != BLOCK_VERSION ||
+        header.encoding > static_cast<std::uint8_t>(ValueEncoding::Xor) || header.decimals > MAX_DECIMALS) {
+        throw std::runtime_error("Niepoprawny blok serii");
+    }
+    if (size - sizeof(header) < static_cast<std::size_t>(header.timestampBytes) + header.valueBytes + PADDING) {
+        throw std::runtime_error("Uszkodzony blok serii");
+    }
+    return header;
+}
+
+} // namespace
+
+std::string SeriesCodec::encode(const std::int64_t* timestamps, const double* values, std::size_t count) {
+    if (count > UINT32_MAX) {
+        throw std::runtime_error("Seria jest zbyt dluga do zakodowania");
+    }
+
+    BlockHeader header{};
+    std::memcpy(header.magic, BLOCK_MAGIC, sizeof(BLOCK_MAGIC));
+    header.version = BLOCK_VERSION;
+    header.count = static_cast<std::uint32_t>(count);
+    header.firstTimestamp = count > 0 ? timestamps[0] : 0;
+    header.firstDelta = count > 1 ? wrappingSub(timestamps[1], timestamps[0]) : 0;
+
+    std::string output(sizeof(header), '\0');
+    std::vector<std::uint64_t> scratch(count);
+
+    // Znaczniki czasu: różnice drugiego rzędu od trzeciego pomiaru
+    for (std::size_t i = 2; i < count; ++i) {
+        scratch[i - 2] = zigzag(wrappingSub(wrappingSub(timestamps[i], timestamps[i - 1]),
+                                            wrappingSub(timestamps[i - 1], timestamps[i - 2])));
+    }
+    packFrames(scratch.data(), count > 2 ? count - 2 : 0, output);
+    header.timestampBytes = static_cast<std::uint32_t>(output.size() - sizeof(header));
+
+    const int decimals = findDecimals(values, count);
+    if (decimals >= 0) {
+        header.encoding = static_cast<std::uint8_t>(ValueEncoding::Decimal);
+        header.decimals = static_cast<std::uint8_t>(decimals);
+        std::int64_t previous = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::int64_t scaled = std::llround(values[i] * POWERS_OF_TEN[decimals]);
+            scratch[i] = zigzag(scaled - previous);
+            previous = scaled;
+        }
+        packFrames(scratch.data(), count, output);
+    } else {
+        header.encoding = static_cast<std::uint8_t>(ValueEncoding::Xor);
+        encodeXor(values, count, output);
+    }
+    header.valueBytes = static_cast<std::uint32_t>(output.size() - sizeof(header) - header.timestampBytes);
+    output.append(PADDING, '\0');
+
+    std::memcpy(&output[0], &header, sizeof(header));
+    return output;
+}
+
+MeasurementSeries SeriesCodec::decode(const char* data, std::size_t size, std::size_t* consumed) {
+    const BlockHeader header = readHeader(data, size);
+    const std::size_t count = header.count;
+    const auto* timestampSection = reinterpret_cast<const std::uint8_t*>(data) + sizeof(header);
+    const auto* valueSection = timestampSection + header.timestampBytes;
+    const auto* blockEnd = valueSection + header.valueBytes;
+
+    MeasurementSeries series;
+    series.timestamps.resize(count);
+    series.values.resize(count);
+    std::uint64_t frame[FRAME_SIZE];
+
+    // Znaczniki czasu: podwójna suma prefiksowa różnic drugiego rzędu
+    if (count > 0) {
+        series.timestamps[0] = header.firstTimestamp;
+    }
+    if (count > 1) {
+        series.timestamps[1] = wrappingAdd(header.firstTimestamp, header.firstDelta);
+    }
+    std::int64_t delta = header.firstDelta;
+    const std::uint8_t* input = timestampSection;
+    for (std::size_t start = 2; start < count; start += FRAME_SIZE) {
+        const std::size_t n = std::min(FRAME_SIZE, count - start);
+        input = unpackFrame(input, valueSection, n, frame);
+        std::int64_t* out = series.timestamps.data() + start;
+        std::int64_t timestamp = out[-1];
+        for (std::size_t i = 0; i < n; ++i) {
+            delta = wrappingAdd(delta, unzigzag(frame[i]));
+            timestamp = wrappingAdd(timestamp, delta);
+            out[i] = timestamp;
+        }
+    }
+
+    if (header.encoding == static_cast<std::uint8_t>(ValueEncoding::Decimal)) {
+        const double scale = POWERS_OF_TEN[header.decimals];
+        std::int64_t scaled = 0;
+        input = valueSection;
+        for (std::size_t start = 0; start < count; start += FRAME_SIZE) {
+            const std::size_t n = std::min(FRAME_SIZE, count - start);
+            input = unpackFrame(input, blockEnd, n, frame);
+            double* out = series.values.data() + start;
+            for (std::size_t i = 0; i < n; ++i) {
+                scaled += unzigzag(frame[i]);
+                out[i] = static_cast<double>(scaled) / scale;
+            }
+        }
+    } else {
+        decodeXor(valueSection, header.valueBytes, series.values.data(), count);
+    }
+
+    if (consumed) {
+        *consumed = sizeof(header) + header.timestampBytes + header.valueBytes + PADDING;
+    }
+    return series;
+}
+
+ValueEncoding SeriesCodec::valueEncoding(const char* data, std::size_t size) {
+    return static_cast<ValueEncoding>(readHeader(data, size).encoding);
+}
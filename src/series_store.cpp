@@ -0,0 +1,335 @@
+/**
+ * @file series_store.cpp
+ * @brief Implementacja archiwum pomiarów z segmentowanymi dziennikami
+ */
+
+#include "series_store.hpp"
+#include "mapped_file.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr char LOG_MAGIC[4] = {'A', 'Q', 'T', 'S'};
+constexpr std::uint32_t LOG_VERSION = 1;
+constexpr std::uint32_t SEGMENT_MAGIC = 0x47455351; // "QSEG"
+
+/**
+ * @brief Nagłówek pliku dziennika (16 bajtów); liczby zapisywane w kolejności bajtów maszyny
+ */
+struct LogHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t segmentCapacity;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(LogHeader) == 16, "Naglowek dziennika musi miec 16 bajtow");
+
+std::size_t segmentBytes(std::uint32_t capacity) {
+    return sizeof(SegmentHeader) + static_cast<std::size_t>(capacity) * (sizeof(std::int64_t) + sizeof(double));
+}
+
+std::size_t segmentOffset(std::uint32_t capacity, std::size_t segment) {
+    return sizeof(LogHeader) + segment * segmentBytes(capacity);
+}
+
+/**
+ * @brief Widok odwzorowanego dziennika
+ */
+struct LogView {
+    MappedFile file;
+    std::uint32_t capacity = 0;
+    std::size_t segmentCount = 0;
+
+    explicit LogView(const std::string& path) : file(path) {
+        if (file.size() < sizeof(LogHeader)) {
+            throw std::runtime_error("Niepoprawny plik dziennika pomiarow: " + path);
+        }
+        LogHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 || header.version != LOG_VERSION ||
+            header.segmentCapacity == 0) {
+            throw std::runtime_error("Niepoprawny plik dziennika pomiarow: " + path);
+        }
+        capacity = header.segmentCapacity;
+        // Niepełny ostatni segment (przerwany zapis) jest ignorowany
+        segmentCount = (file.size() - sizeof(LogHeader)) / segmentBytes(capacity);
+    }
+
+    const SegmentHeader& header(std::size_t segment) const {
+        return *reinterpret_cast<const SegmentHeader*>(file.data() + segmentOffset(capacity, segment));
+    }
+    const std::int64_t* timestamps(std::size_t segment) const {
+        return reinterpret_cast<const std::int64_t*>(file.data() + segmentOffset(capacity, segment) + sizeof(SegmentHeader));
+    }
+    const double* values(std::size_t segment) const {
+        return reinterpret_cast<const double*>(timestamps(segment) + capacity);
+    }
+};
+
+} // namespace
+
+SeriesStore::SeriesStore(std::string directory, std::uint32_t segmentCapacity)
+    : directory(std::move(directory)), segmentCapacity(segmentCapacity) {
+    if (segmentCapacity == 0) {
+        throw std::runtime_error("Pojemnosc segmentu musi byc dodatnia");
+    }
+}
+
+std::string SeriesStore::logPath(int sensorId) const {
+    return directory + "/sensor_" + std::to_string(sensorId) + ".aqts";
+}
+
+std::vector<SegmentHeader> SeriesStore::segments(int sensorId) const {
+    std::vector<SegmentHeader> headers;
+    const std::string path = logPath(sensorId);
+    if (!std::filesystem::exists(path)) {
+        return headers;
+    }
+    LogView log(path);
+    headers.reserve(log.segmentCount);
+    for (std::size_t s = 0; s < log.segmentCount; ++s) {
+        headers.push_back(log.header(s));
+    }
+    return headers;
+}
+
+template <typename Visitor>
+void SeriesStore::visitRange(int sensorId, std::int64_t from, std::int64_t to, Visitor&& visitor) const {
+    const std::string path = logPath(sensorId);
+    if (from > to || !std::filesystem::exists(path)) {
+        return;
+    }
+    LogView log(path);
+
+    // Segmenty są uporządkowane po czasie - wyszukiwanie binarne pierwszego segmentu kończącego się po from
+    std::size_t low = 0;
+    std::size_t high = log.segmentCount;
+    while (low < high) {
+        const std::size_t middle = (low + high) / 2;
+        const SegmentHeader& header = log.header(middle);
+        if (header.count == 0 || header.lastTime >= from) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+
+    for (std::size_t s = low; s < log.segmentCount; ++s) {
+        const SegmentHeader& header = log.header(s);
+        if (header.magic != SEGMENT_MAGIC || header.count == 0 || header.firstTime > to) {
+            break;
+        }
+        const std::int64_t* timestamps = log.timestamps(s);
+        const std::size_t count = std::min<std::size_t>(header.count, log.capacity);
+        const std::size_t begin = static_cast<std::size_t>(std::lower_bound(timestamps, timestamps + count, from) - timestamps);
+        const std::size_t end = static_cast<std::size_t>(std::upper_bound(timestamps + begin, timestamps + count, to) - timestamps);
+        if (begin < end) {
+            visitor(header, timestamps, log.values(s), begin, end);
+        }
+    }
+}
+
+MeasurementSeries SeriesStore::scan(int sensorId, std::int64_t from, std::int64_t to) const {
+    MeasurementSeries result;
+    visitRange(sensorId, from, to, [&](const SegmentHeader&, const std::int64_t* timestamps, const double* values,
+                                       std::size_t begin, std::size_t end) {
+        result.timestamps.insert(result.timestamps.end(), timestamps + begin, timestamps + end);
+        result.values.insert(result.values.end(), values + begin, values + end);
+    });
+    return result;
+}
+
+MeasurementSeries SeriesStore::scanAbove(int sensorId, double threshold, std::int64_t from, std::int64_t to) const {
+    MeasurementSeries result;
+    visitRange(sensorId, from, to, [&](const SegmentHeader& header, const std::int64_t* timestamps, const double* values,
+                                       std::size_t begin, std::size_t end) {
+        // Indeks min/max: segment bez przekroczeń nie jest czytany
+        if (header.maxValue <= threshold) {
+            return;
+        }
+        for (std::size_t i = begin; i < end; ++i) {
+            if (values[i] > threshold) {
+                result.append(timestamps[i], values[i]);
+            }
+        }
+    });
+    return result;
+}
+
+StoreMergeResult SeriesStore::merge(int sensorId, MeasurementSeries series) const {
+    StoreMergeResult result;
+
+    // Posortowane pomiary bez powtórzeń w samej odpowiedzi i bez braków
+    series.sortByTime();
+    MeasurementSeries incoming;
+    incoming.reserve(series.size());
+    for (std::size_t i = 0; i < series.size(); ++i) {
+        if (std::isnan(series.values[i])) {
+            continue;
+        }
+        if (!incoming.empty() && incoming.timestamps.back() == series.timestamps[i]) {
+            ++result.duplicates;
+            continue;
+        }
+        incoming.append(series.timestamps[i], series.values[i]);
+    }
+    if (incoming.empty()) {
+        return result;
+    }
+
+    const std::string path = logPath(sensorId);
+    std::uint32_t capacity = segmentCapacity;
+    std::size_t segmentCount = 0;
+    SegmentHeader last{};
+    if (std::filesystem::exists(path)) {
+        LogView log(path);
+        capacity = log.capacity;
+        segmentCount = log.segmentCount;
+        // Końcowe segmenty bez nagłówka (zapis przerwany po rezerwacji miejsca) są traktowane
+        // jak niezaalokowane: zostaną nadpisane nowym segmentem z poprawnym nagłówkiem
+        while (segmentCount > 0 && log.header(segmentCount - 1).magic != SEGMENT_MAGIC) {
+            --segmentCount;
+        }
+        if (segmentCount > 0) {
+            last = log.header(segmentCount - 1);
+        }
+    } else {
+        std::filesystem::create_directories(directory);
+        std::ofstream create(path, std::ios::binary);
+        LogHeader header{};
+        std::memcpy(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+        header.version = LOG_VERSION;
+        header.segmentCapacity = segmentCapacity;
+        if (!create.write(reinterpret_cast<const char*>(&header), sizeof(header))) {
+            throw std::runtime_error("Nie mozna utworzyc dziennika pomiarow: " + path);
+        }
+    }
+
+    // Pomiary nie nowsze niż koniec dziennika: powtórzone lub spóźnione (dziennik jest tylko do dopisywania)
+    std::size_t firstNew = 0;
+    if (segmentCount > 0 && last.count > 0) {
+        firstNew = static_cast<std::size_t>(
+            std::upper_bound(incoming.timestamps.begin(), incoming.timestamps.end(), last.lastTime) -
+            incoming.timestamps.begin());
+        if (firstNew > 0) {
+            MeasurementSeries stored = scan(sensorId, incoming.timestamps.front(), last.lastTime);
+            std::size_t j = 0;
+            for (std::size_t i = 0; i < firstNew; ++i) {
+                while (j < stored.size() && stored.timestamps[j] < incoming.timestamps[i]) {
+                    ++j;
+                }
+                if (j < stored.size() && stored.timestamps[j] == incoming.timestamps[i]) {
+                    ++result.duplicates;
+                } else {
+                    ++result.late;
+                }
+            }
+        }
+    }
+    if (firstNew == incoming.size()) {
+        return result;
+    }
+
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Nie mozna otworzyc dziennika pomiarow: " + path);
+    }
+
+    // Ostatni segment z wolnym miejscem jest uzupełniany, kolejne są dopisywane na końcu pliku
+    std::size_t segment = segmentCount;
+    SegmentHeader header{};
+    if (segmentCount > 0 && last.count < capacity) {
+        segment = segmentCount - 1;
+        header = last;
+    }
+    std::size_t next = firstNew;
+    while (next < incoming.size()) {
+        if (segment == segmentCount) {
+            // Nowy segment zajmuje od razu pełny rozmiar, aby kolejne segmenty miały stałe położenie
+            header = SegmentHeader{};
+            header.magic = SEGMENT_MAGIC;
+            std::vector<char> empty(segmentBytes(capacity), 0);
+            file.seekp(static_cast<std::streamoff>(segmentOffset(capacity, segment)));
+            file.write(empty.data(), static_cast<std::streamsize>(empty.size()));
+            ++segmentCount;
+        }
+
+        const std::size_t take = std::min<std::size_t>(capacity - header.count, incoming.size() - next);
+        const std::size_t base = segmentOffset(capacity, segment) + sizeof(SegmentHeader);
+        file.seekp(static_cast<std::streamoff>(base + header.count * sizeof(std::int64_t)));
+        file.write(reinterpret_cast<const char*>(incoming.timestamps.data() + next),
+                   static_cast<std::streamsize>(take * sizeof(std::int64_t)));
+        file.seekp(static_cast<std::streamoff>(base + (capacity + header.count) * sizeof(std::int64_t)));
+        file.write(reinterpret_cast<const char*>(incoming.values.data() + next),
+                   static_cast<std::streamsize>(take * sizeof(double)));
+
+        // Nagłówek jest zapisywany po danych - dopiero on udostępnia nowe pomiary
+        if (header.count == 0) {
+            header.firstTime = incoming.timestamps[next];
+            header.minValue = incoming.values[next];
+            header.maxValue = incoming.values[next];
+        }
+        for (std::size_t i = next; i < next + take; ++i) {
+            header.minValue = std::min(header.minValue, incoming.values[i]);
+            header.maxValue = std::max(header.maxValue, incoming.values[i]);
+        }
+        header.lastTime = incoming.timestamps[next + take - 1];
+        header.count += static_cast<std::uint32_t>(take);
+        file.seekp(static_cast<std::streamoff>(segmentOffset(capacity, segment)));
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        next += take;
+        result.appended += take;
+        ++segment;
+    }
+
+    if (!file.flush()) {
+        throw std::runtime_error("Blad zapisu dziennika pomiarow: " + path);
+    }
+    return result;
+}
+
+StoreMergeResult SeriesStore::backfill(int sensorId, MeasurementSeries series) const {
+    series.sortByTime();
+    StoreMergeResult result = merge(sensorId, series);
+    if (result.late == 0) {
+        return result;
+    }
+
+    // Scalenie zapisanych pomiarów ze spóźnionymi; przy tym samym czasie wygrywa pomiar zapisany
+    const std::string path = logPath(sensorId);
+    const std::uint32_t capacity = LogView(path).capacity;
+    const MeasurementSeries stored = scan(sensorId);
+    MeasurementSeries combined;
+    combined.reserve(stored.size() + result.late);
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < stored.size(); ++i) {
+        for (; j < series.size() && series.timestamps[j] <= stored.timestamps[i]; ++j) {
+            if (series.timestamps[j] < stored.timestamps[i] && !std::isnan(series.values[j]) &&
+                (combined.empty() || combined.timestamps.back() != series.timestamps[j])) {
+                combined.append(series.timestamps[j], series.values[j]);
+            }
+        }
+        combined.append(stored.timestamps[i], stored.values[i]);
+    }
+
+    // Nowy dziennik powstaje obok i zastępuje stary jedną operacją zmiany nazwy
+    const SeriesStore rebuilt(directory + "/.backfill", capacity);
+    const std::string rebuiltPath = rebuilt.logPath(sensorId);
+    std::filesystem::remove(rebuiltPath);
+    rebuilt.merge(sensorId, combined);
+    std::error_code error;
+    std::filesystem::rename(rebuiltPath, path, error);
+    if (error) {
+        throw std::runtime_error("Nie mozna podmienic dziennika pomiarow: " + path);
+    }
+
+    result.appended += result.late;
+    result.late = 0;
+    return result;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file station_comparison.cpp
+ * @brief Implementacja równoległego pobierania porównania stacji
+ */
+
+#include "station_comparison.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+StationComparison StationComparisonLoader::load(ApiClient& client, const std::vector<Station>& stations,
+                                                Pollutant pollutant, int jobs) {
+    TRACE_SCOPE_DETAIL("StationComparisonLoader::load", std::to_string(stations.size()) + " stacji");
+
+    struct StationResult {
+        int sensorId = -1;
+        MeasurementSeries series;
+    };
+    std::vector<StationResult> results(stations.size());
+
+    // Każdy wątek pobiera kolejne stacje; wywołania ApiClient są bezpieczne wątkowo
+    std::atomic<std::size_t> nextIndex{0};
+    auto worker = [&]() {
+        for (std::size_t i = nextIndex++; i < stations.size(); i = nextIndex++) {
+            for (const auto& sensor : client.getSensors(stations[i].id)) {
+                if (sensor.pollutant == pollutant) {
+                    results[i].sensorId = sensor.id;
+                    break;
+                }
+            }
+            if (results[i].sensorId < 0) {
+                continue;
+            }
+            results[i].series = MeasurementSeries::fromMeasurements(client.getMeasurements(results[i].sensorId));
+            results[i].series.sortByTime();
+        }
+    };
+
+    const int workerCount = std::max(1, std::min<int>(jobs, static_cast<int>(stations.size())));
+    std::vector<std::thread> workers;
+    for (int w = 1; w < workerCount; ++w) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    StationComparison comparison;
+    comparison.pollutant = pollutant;
+    std::vector<MeasurementSeries> series;
+    series.reserve(stations.size());
+    for (std::size_t i = 0; i < stations.size(); ++i) {
+        if (results[i].series.empty()) {
+            comparison.skipped.push_back(stations[i].name);
+            continue;
+        }
+        comparison.stations.push_back(stations[i]);
+        comparison.sensorIds.push_back(results[i].sensorId);
+        series.push_back(std::move(results[i].series));
+    }
+
+    TRACE_SCOPE("alignSeries");
+    comparison.aligned = alignSeries(series);
+    return comparison;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file string_pool.cpp
+ * @brief Implementacja puli internowanych napisów
+ */
+
+#include "string_pool.hpp"
+#include <mutex>
+
+StringPool::StringPool() {
+    entries.emplace_back();
+    emptyEntry = &entries.back();
+    index.emplace(std::string_view(*emptyEntry), emptyEntry);
+}
+
+StringPool& StringPool::instance() {
+    // Pula nie jest niszczona, aby napisy pozostały ważne także w destruktorach obiektów statycznych
+    static StringPool* pool = new StringPool();
+    return *pool;
+}
+
+const std::string* StringPool::intern(std::string_view value) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = index.find(value);
+        if (it != index.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    // Inny wątek mógł dodać ten sam napis między blokadami
+    auto it = index.find(value);
+    if (it != index.end()) {
+        return it->second;
+    }
+    entries.emplace_back(value);
+    const std::string* entry = &entries.back();
+    index.emplace(std::string_view(*entry), entry);
+    totalBytes += entry->size();
+    return entry;
+}
+
+std::size_t StringPool::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return entries.size();
+}
+
+std::size_t StringPool::bytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return totalBytes;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file trace.cpp
+ * @brief Implementacja buforów śledzenia i zapisu w formacie Chrome trace-event
+ */
+
+#include "trace.hpp"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+std::atomic<int> Tracer::enabledState{-1};
+
+namespace {
+
+// Zakończony zakres
+struct TraceEvent {
+    const char* name = nullptr;
+    std::string detail;
+    std::uint64_t start = 0;
+    std::uint64_t duration = 0;
+};
+
+// Bufor cykliczny jednego wątku; po zapełnieniu nadpisuje najstarsze zdarzenia
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+    std::size_t next = 0;
+    std::size_t size = 0;
+    int threadId = 0;
+    std::string threadName;
+
+    void push(TraceEvent event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        events[next] = std::move(event);
+        next = (next + 1) % events.size();
+        if (size < events.size()) {
+            ++size;
+        }
+    }
+};
+
+// Rejestr buforów wszystkich wątków (bufory żyją dłużej niż wątki)
+struct TraceRegistry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::size_t capacity = Tracer::DEFAULT_BUFFER_CAPACITY;
+    std::string outputPath;
+    bool exitHandlerRegistered = false;
+    int nextThreadId = 1;
+};
+
+TraceRegistry& registry() {
+    static TraceRegistry* instance = new TraceRegistry(); // celowo bez destruktora: używany w atexit
+    return *instance;
+}
+
+std::chrono::steady_clock::time_point traceEpoch() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return epoch;
+}
+
+ThreadBuffer& localBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+        TraceRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffer->events.resize(reg.capacity);
+        buffer->threadId = reg.nextThreadId++;
+        reg.buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void writeOnExit() {
+    std::string path;
+    {
+        TraceRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        path = reg.outputPath;
+    }
+    if (!path.empty() && Tracer::writeChromeTrace(path)) {
+        std::fprintf(stderr, "Zapisano slad wykonania do: %s\n", path.c_str());
+    }
+}
+
+} // namespace
+
+int Tracer::initializeFromEnvironment() {
+    const char* path = std::getenv("AIRQUALITY_TRACE");
+    if (path && *path) {
+        enable(path);
+        return 1;
+    }
+    int expected = -1;
+    enabledState.compare_exchange_strong(expected, 0);
+    return enabledState.load();
+}
+
+void Tracer::enable(const std::string& outputPath, std::size_t bufferCapacity) {
+    traceEpoch();
+    TraceRegistry& reg = registry();
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.capacity = bufferCapacity > 0 ? bufferCapacity : 1;
+        if (!outputPath.empty()) {
+            reg.outputPath = outputPath;
+            if (!reg.exitHandlerRegistered) {
+                std::atexit(writeOnExit);
+                reg.exitHandlerRegistered = true;
+            }
+        }
+    }
+    enabledState.store(1);
+}
+
+void Tracer::disable() {
+    enabledState.store(0);
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.threadName = name;
+}
+
+std::uint64_t Tracer::now() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - traceEpoch()).count());
+}
+
+void Tracer::record(const char* name, std::string detail, std::uint64_t start, std::uint64_t duration) {
+    TraceEvent event;
+    event.name = name;
+    event.detail = std::move(detail);
+    event.start = start;
+    event.duration = duration;
+    localBuffer().push(std::move(event));
+}
+
+std::size_t Tracer::eventCount() {
+    TraceRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::size_t total = 0;
+    for (const auto& buffer : reg.buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        total += buffer->size;
+    }
+    return total;
+}
+
+void Tracer::clear() {
+    TraceRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->next = 0;
+        buffer->size = 0;
+    }
+}
+
+std::string Tracer::toChromeTrace() {
+    TraceRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    std::ostringstream out;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&out, &first]() {
+        if (!first) {
+            out << ",\n";
+        }
+        first = false;
+    };
+
+    for (const auto& buffer : reg.buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        if (!buffer->threadName.empty()) {
+            separator();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"args\":{\"name\":" << nlohmann::json(buffer->threadName).dump() << "}}";
+        }
+
+        // Od najstarszego do najnowszego zdarzenia
+        const std::size_t capacity = buffer->events.size();
+        const std::size_t oldest = (buffer->next + capacity - buffer->size) % capacity;
+        for (std::size_t i = 0; i < buffer->size; ++i) {
+            const TraceEvent& event = buffer->events[(oldest + i) % capacity];
+            separator();
+            out << "{\"name\":" << nlohmann::json(event.name).dump()
+                << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"ts\":" << event.start << ",\"dur\":" << event.duration;
+            if (!event.detail.empty()) {
+                out << ",\"args\":{\"detail\":" << nlohmann::json(event.detail).dump() << "}";
+            }
+            out << "}";
+        }
+    }
+    out << "]}\n";
+    return out.str();
+}
+
+bool Tracer::writeChromeTrace(const std::string& path) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file << toChromeTrace();
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file archive_importer_test.cpp
+ * @brief Testy importu plików z pomiarami do archiwum
+ */
+
+ #include "archive_importer.hpp"
+ #include "measurement_file.hpp"
+ #include <gtest/gtest.h>
+ #include <cstdlib>
+ #include <fstream>
+ #include <stdexcept>
+
+ // Plik eksportu JSON czujnika z pomiarami godzin [first, first + count) od 2025-04-01 00:00:00
+ static std::string exportFile(int stationId, int sensorId, int first, int count, double offset = 0.0) {
+     const std::int64_t base = parseMeasurementDate("2025-04-01 00:00:00");
+     json measurements = json::array();
+     for (int i = first + count - 1; i >= first; --i) {
+         measurements.push_back({{"date", formatMeasurementDate(base + i * 3600)}, {"value", i + offset}});
+     }
+     json file;
+     file["metadata"]["station"]["id"] = stationId;
+     file["metadata"]["sensor"]["id"] = sensorId;
+     file["metadata"]["sensor"]["paramFormula"] = "NO2";
+     file["measurements"] = measurements;
+     return file.dump(4);
+ }
+
+ // Klasa testowa dla ArchiveImporter
+ class ArchiveImporterTest : public ::testing::Test {
+ protected:
+     // Konfiguracja przed każdym testem
+     void SetUp() override {
+         testDir = "test_data_archive_importer";
+         system(("rm -rf " + testDir).c_str());
+         system(("mkdir -p " + testDir + "/export/maszyna_a " + testDir + "/export/maszyna_b").c_str());
+     }
+
+     // Sprzątanie po każdym teście
+     void TearDown() override {
+         system(("rm -rf " + testDir).c_str());
+     }
+
+     // Zapisuje zawartość do pliku w katalogu testowym
+     void writeFile(const std::string& name, const std::string& content) {
+         std::ofstream file(testDir + "/" + name);
+         file << content;
+     }
+
+     std::string testDir;
+ };
+
+ // Test importu nakładających się plików z wielu maszyn i ponownego importu
+ TEST_F(ArchiveImporterTest, ImportsOverlappingFilesIdempotently) {
+     writeFile("export/maszyna_a/pomiary_Czerniawa_NO2_1.json", exportFile(11, 50, 24, 72));
+     writeFile("export/maszyna_a/pomiary_Czerniawa_NO2_2.json", exportFile(11, 50, 60, 72));
+     writeFile("export/maszyna_b/pomiary_Czerniawa_NO2_1.json", exportFile(11, 50, 24, 72));  // kopia
+     writeFile("export/maszyna_b/pomiary_Czerniawa_O3.json", exportFile(11, 51, 0, 48));
+     writeFile("export/maszyna_b/notatki.txt", "to nie jest plik z pomiarami");
+
+     SeriesStore store(testDir + "/archive");
+     ArchiveImporter importer(store, testDir + "/import_index.json");
+     ImportReport report = importer.importDirectory(testDir + "/export", 4);
+
+     EXPECT_EQ(report.files, 4u);
+     EXPECT_EQ(report.imported, 3u);
+     EXPECT_EQ(report.unchanged, 1u) << "Kopia pliku powinna byc wczytana raz";
+     EXPECT_EQ(report.failed, 0u);
+     EXPECT_EQ(report.sensors, 2u);
+     EXPECT_EQ(report.appended, 108u + 48u);
+     EXPECT_EQ(report.duplicates, 36u);
+
+     MeasurementSeries no2 = store.scan(50);
+     ASSERT_EQ(no2.size(), 108u);
+     EXPECT_DOUBLE_EQ(no2.values.front(), 24.0);
+     EXPECT_DOUBLE_EQ(no2.values.back(), 131.0);
+     EXPECT_EQ(store.scan(51).size(), 48u);
+
+     ImportReport again = importer.importDirectory(testDir + "/export", 4);
+     EXPECT_EQ(again.unchanged, 4u);
+     EXPECT_EQ(again.imported, 0u);
+     EXPECT_EQ(again.appended, 0u);
+     EXPECT_EQ(store.scan(50).size(), 108u);
+ }
+
+ // Test plików starszych niż archiwum, plików "Wszystkie" i plików uszkodzonych
+ TEST_F(ArchiveImporterTest, BackfillsOlderFilesAndReportsProblems) {
+     SeriesStore store(testDir + "/archive", 16);
+     ArchiveImporter importer(store, testDir + "/import_index.json");
+     writeFile("export/maszyna_a/nowy.json", exportFile(11, 50, 100, 24));
+     importer.importDirectory(testDir + "/export", 2);
+
+     // Starszy eksport z drugiej maszyny, częściowo pokrywający archiwum (inne wartości - wygrywa archiwum)
+     writeFile("export/maszyna_b/stary.json", exportFile(11, 50, 40, 70, 0.5));
+     writeFile("export/maszyna_b/wszystkie.json",
+               R"({"metadata":{"sensor":{"id":-1,"paramName":"Wszystkie"}},"measurements":[]})");
+     writeFile("export/maszyna_b/uszkodzony.json", "{ \"measurements\": [ { \"date\": ");
+     ImportReport report = importer.importDirectory(testDir + "/export", 2);
+
+     EXPECT_EQ(report.unchanged, 1u);
+     EXPECT_EQ(report.imported, 1u);
+     EXPECT_EQ(report.skipped, 1u);
+     EXPECT_EQ(report.failed, 1u);
+     ASSERT_EQ(report.errors.size(), 1u);
+     EXPECT_NE(report.errors[0].find("uszkodzony.json"), std::string::npos);
+     EXPECT_EQ(report.appended, 60u);
+     EXPECT_EQ(report.duplicates, 10u);
+
+     MeasurementSeries all = store.scan(50);
+     ASSERT_EQ(all.size(), 84u);
+     EXPECT_DOUBLE_EQ(all.values.front(), 40.5);
+     EXPECT_DOUBLE_EQ(all.values[60], 100.0);
+     EXPECT_TRUE(std::is_sorted(all.timestamps.begin(), all.timestamps.end()));
+
+     EXPECT_THROW(importer.importDirectory(testDir + "/nie_istnieje"), std::runtime_error);
+ }
+
+ // Test kopii pliku, którego import się nie powiódł: kopia jest liczona jako błąd, a nie bez zmian
+ TEST_F(ArchiveImporterTest, CopyOfFailedFileIsReportedAsFailed) {
+     const std::string corrupt = "{ \"measurements\": [ { \"date\": ";
+     writeFile("export/maszyna_a/uszkodzony.json", corrupt);
+     writeFile("export/maszyna_b/uszkodzony.json", corrupt);  // kopia
+     writeFile("export/maszyna_a/pomiary.json", exportFile(11, 50, 0, 24));
+     writeFile("export/maszyna_b/pomiary.json", exportFile(11, 50, 0, 24));  // kopia
+
+     SeriesStore store(testDir + "/archive");
+     ArchiveImporter importer(store, testDir + "/import_index.json");
+     ImportReport report = importer.importDirectory(testDir + "/export", 2);
+
+     EXPECT_EQ(report.files, 4u);
+     EXPECT_EQ(report.imported, 1u);
+     EXPECT_EQ(report.unchanged, 1u);
+     EXPECT_EQ(report.failed, 2u);
+     EXPECT_EQ(report.errors.size(), 2u);
+
+     // Nieudane pliki nie trafiają do indeksu, więc ponowny import znów je zgłasza
+     ImportReport again = importer.importDirectory(testDir + "/export", 2);
+     EXPECT_EQ(again.unchanged, 2u);
+     EXPECT_EQ(again.failed, 2u);
+ }
+
+ // Main dla Google Test
+ int main(int argc, char **argv) {
+     ::testing::InitGoogleTest(&argc, argv);
+     return RUN_ALL_TESTS();
+ }
@@ -0,0 +1,138 @@
+/**
+ * @file async_client_test.cpp
+ * @brief Testy asynchronicznego klienta API (korutyny, pętla curl_multi) z serwerem zastępczym GIOŚ
+ */
+
+ #include "async_client.hpp"
+ #include "mock_gios_server.hpp"
+ #include <gtest/gtest.h>
+ #include <chrono>
+ #include <iostream>
+ #include <thread>
+ #include <vector>
+
+ // Klasa testowa klienta asynchronicznego
+ class AsyncClientTest : public ::testing::Test {
+ protected:
+     // Tworzy i uruchamia serwer zastępczy
+     void startServer(MockGiosOptions options) {
+         options.fixtureDir = AIRQUALITY_MOCK_FIXTURES;
+         server = std::make_unique<MockGiosServer>(options);
+         server->start();
+     }
+
+     std::unique_ptr<MockGiosServer> server;
+ };
+
+ // Pobiera czujniki i pomiary pierwszego z nich, sprawdzając wątek wznowienia po każdym co_await
+ Task<std::size_t> fetchFirstSensor(AsyncApiClient& async, const WorkerExecutor& executor, int stationId,
+                                    bool& resumedOnExecutor) {
+     std::vector<Sensor> sensors = co_await async.sensors(stationId);
+     resumedOnExecutor = executor.runsInThisThread();
+     if (sensors.empty()) {
+         co_return 0;
+     }
+     std::vector<Measurement> measurements = co_await async.measurements(sensors.front().id);
+     resumedOnExecutor = resumedOnExecutor && executor.runsInThisThread();
+     co_return measurements.size();
+ }
+
+ // Test pobrania czujników i pomiarów z wznowieniem korutyny w wątku wykonawcy
+ TEST_F(AsyncClientTest, AwaitSensorsAndMeasurements) {
+     startServer(MockGiosOptions());
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+     WorkerExecutor executor;
+     AsyncApiClient async(client, executor);
+
+     bool resumedOnExecutor = false;
+     std::size_t count = syncWait(fetchFirstSensor(async, executor, 11, resumedOnExecutor));
+     EXPECT_GT(count, 0u);
+     EXPECT_TRUE(resumedOnExecutor) << "Korutyna powinna byc wznawiana przez wykonawce, a nie w watku I/O";
+
+     // Wyniki trafiły do cache klienta synchronicznego
+     const std::uint64_t requestsBefore = server->stats().requests;
+     std::vector<Sensor> sensors = client.getSensors(11);
+     ASSERT_FALSE(sensors.empty());
+     EXPECT_EQ(client.getMeasurements(sensors.front().id).size(), count);
+     EXPECT_EQ(server->stats().requests, requestsBefore);
+     EXPECT_EQ(client.getMetrics().endpoint(EndpointClass::Measurements).requests.load(), 1u);
+ }
+
+ // Test setek równoczesnych pobrań obsługiwanych przez jeden wątek I/O
+ TEST_F(AsyncClientTest, HundredsOfConcurrentFetches) {
+     MockGiosOptions options;
+     options.latencyMs = 50;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+     WorkerExecutor executor;
+     AsyncApiClient async(client, executor, 256);
+
+     const int sensorCount = 300;
+     std::vector<int> sensorIds;
+     for (int i = 0; i < sensorCount; ++i) {
+         sensorIds.push_back(5000 + i);
+     }
+
+     auto start = std::chrono::steady_clock::now();
+     std::vector<std::vector<Measurement>> results = syncWait(async.measurements(sensorIds));
+     double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+     std::cout << "Pobrano " << sensorCount << " czujnikow w " << elapsed << " ms" << std::endl;
+     RecordProperty("elapsed_ms", std::to_string(elapsed));
+
+     ASSERT_EQ(results.size(), static_cast<std::size_t>(sensorCount));
+     for (const auto& measurements : results) {
+         EXPECT_FALSE(measurements.empty());
+     }
+     EXPECT_EQ(server->stats().requests, static_cast<std::uint64_t>(sensorCount));
+     EXPECT_EQ(async.activeTransfers(), 0u);
+     // Kolejno zapytania trwałyby co najmniej 15 s
+     EXPECT_LT(elapsed, sensorCount * options.latencyMs / 5.0);
+ }
+
+ // Test ponowień bez blokowania wątku oraz zwracania nieaktualnych danych po błędzie API
+ TEST_F(AsyncClientTest, FailuresRetryAndServeStaleData) {
+     MockGiosOptions options;
+     options.errorRate = 1.0;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+     RequestPolicy policy;
+     policy.maxRetries = 2;
+     policy.retryBaseDelay = std::chrono::milliseconds(1);
+     policy.breakerFailureThreshold = 0;
+     client.setRequestPolicy(policy);
+     WorkerExecutor executor;
+     AsyncApiClient async(client, executor);
+
+     // Bez danych w cache błąd daje pusty wynik, jak w getMeasurements
+     EXPECT_TRUE(syncWait(async.measurements(1100)).empty());
+     EXPECT_EQ(server->stats().injectedErrors, 3u);
+     EXPECT_EQ(client.getMetrics().endpoint(EndpointClass::Measurements).retries.load(), 2u);
+
+     // Bezpośrednie zapytanie zgłasza błąd wyjątkiem
+     EXPECT_THROW(syncWait(async.request("/data/getData/1100",
+                                         std::chrono::steady_clock::now() + std::chrono::seconds(5))),
+                  std::runtime_error);
+
+     // Minięty termin kończy zapytanie bez wysyłania go do serwera
+     const std::uint64_t requestsBefore = server->stats().requests;
+     EXPECT_THROW(syncWait(async.request("/data/getData/1100", std::chrono::steady_clock::now())),
+                  std::runtime_error);
+     EXPECT_EQ(server->stats().requests, requestsBefore);
+
+     // Dane pobrane wcześniej z działającego API są zwracane jako nieaktualne
+     MockGiosOptions healthyOptions;
+     healthyOptions.fixtureDir = AIRQUALITY_MOCK_FIXTURES;
+     MockGiosServer healthy(healthyOptions);
+     healthy.start();
+     const std::string failingUrl = client.getBaseUrl();
+     client.setBaseUrl(healthy.baseUrl());
+     const std::size_t fresh = syncWait(async.measurements(1100)).size();
+     ASSERT_GT(fresh, 0u);
+     client.clearMeasurementCache(1100);
+     client.setBaseUrl(failingUrl);
+     EXPECT_EQ(syncWait(async.measurements(1100)).size(), fresh);
+     EXPECT_EQ(client.getMetrics().endpoint(EndpointClass::Measurements).staleServed.load(), 1u);
+ }
@@ -0,0 +1,203 @@
+/**
+ * @file http_server_test.cpp
+ * @brief Testy serwera HTTP z wykorzystaniem Google Test
+ */
+
+ #include "http_server.hpp"
+ #include <gtest/gtest.h>
+ #include <arpa/inet.h>
+ #include <netinet/in.h>
+ #include <sys/socket.h>
+ #include <unistd.h>
+ #include <memory>
+ #include <string>
+ #include <thread>
+
+ // Klasa testowa dla HttpServer
+ class HttpServerTest : public ::testing::Test {
+ protected:
+     // Konfiguracja przed każdym testem - serwer na losowym porcie w osobnym wątku
+     void SetUp() override {
+         server = std::make_unique<HttpServer>([](const HttpRequest& request, HttpServer::Responder respond) {
+             if (request.path == "/sync") {
+                 respond(HttpServer::makeResponse(200, "text/plain", "sync:" + request.query));
+             } else if (request.path == "/async") {
+                 // Odpowiedź udzielona z innego wątku
+                 std::thread([respond]() {
+                     respond(HttpServer::makeResponse(200, "text/plain", "async"));
+                 }).detach();
+             } else {
+                 respond(HttpServer::makeResponse(404, "text/plain", "brak"));
+             }
+         });
+         server->listen("127.0.0.1", 0);
+         loop = std::thread([this]() { server->run(); });
+     }
+
+     // Czyszczenie po każdym teście
+     void TearDown() override {
+         server->stop();
+         loop.join();
+         server.reset();
+     }
+
+     // Otwiera połączenie z serwerem
+     int connectToServer() {
+         int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+         sockaddr_in address{};
+         address.sin_family = AF_INET;
+         address.sin_port = htons(server->port());
+         address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+         if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+             ::close(fd);
+             return -1;
+         }
+         return fd;
+     }
+
+     // Wysyła dane i czyta odpowiedzi, aż odebrane zostanie tyle treści, ile oczekiwano
+     static std::string exchange(int fd, const std::string& request, std::size_t responses) {
+         ::send(fd, request.data(), request.size(), 0);
+         std::string received;
+         char buffer[4096];
+         while (true) {
+             std::size_t complete = 0;
+             std::size_t position = 0;
+             while ((position = received.find("\r\n\r\n", position)) != std::string::npos) {
+                 position += 4;
+                 ++complete;
+             }
+             if (complete >= responses) {
+                 // Poczekaj na treść ostatniej odpowiedzi (wszystkie treści w testach są krótkie)
+                 std::size_t lengthPos = received.rfind("Content-Length: ");
+                 std::size_t bodyStart = received.rfind("\r\n\r\n") + 4;
+                 std::size_t length = std::stoul(received.substr(lengthPos + 16));
+                 if (received.size() >= bodyStart + length) {
+                     return received;
+                 }
+             }
+             ssize_t count = ::recv(fd, buffer, sizeof(buffer), 0);
+             if (count <= 0) {
+                 return received;
+             }
+             received.append(buffer, static_cast<std::size_t>(count));
+         }
+     }
+
+     std::unique_ptr<HttpServer> server;
+     std::thread loop;
+ };
+
+ // Test odpowiedzi synchronicznej i asynchronicznej
+ TEST_F(HttpServerTest, SyncAndAsyncResponses) {
+     int fd = connectToServer();
+     ASSERT_GE(fd, 0) << "Nie udalo sie polaczyc z serwerem";
+
+     std::string sync = exchange(fd, "GET /sync?a=1 HTTP/1.1\r\nHost: test\r\n\r\n", 1);
+     EXPECT_NE(sync.find("HTTP/1.1 200 OK"), std::string::npos);
+     EXPECT_NE(sync.find("sync:a=1"), std::string::npos);
+
+     std::string async = exchange(fd, "GET /async HTTP/1.1\r\nHost: test\r\n\r\n", 1);
+     EXPECT_NE(async.find("HTTP/1.1 200 OK"), std::string::npos);
+     EXPECT_NE(async.find("async"), std::string::npos);
+
+     ::close(fd);
+ }
+
+ // Test potokowania - odpowiedzi muszą przyjść w kolejności żądań
+ TEST_F(HttpServerTest, PipelinedRequestsKeepOrder) {
+     int fd = connectToServer();
+     ASSERT_GE(fd, 0) << "Nie udalo sie polaczyc z serwerem";
+
+     std::string response = exchange(fd,
+         "GET /async HTTP/1.1\r\n\r\n"
+         "GET /sync?b=2 HTTP/1.1\r\n\r\n"
+         "GET /missing HTTP/1.1\r\n\r\n", 3);
+
+     std::size_t asyncPos = response.find("async");
+     std::size_t syncPos = response.find("sync:b=2");
+     std::size_t missingPos = response.find("404");
+     ASSERT_NE(asyncPos, std::string::npos);
+     ASSERT_NE(syncPos, std::string::npos);
+     ASSERT_NE(missingPos, std::string::npos);
+     EXPECT_LT(asyncPos, syncPos) << "Odpowiedzi powinny zachowac kolejnosc zadan";
+     EXPECT_LT(syncPos, missingPos) << "Odpowiedzi powinny zachowac kolejnosc zadan";
+
+     ::close(fd);
+ }
+
+ // Test niepoprawnego żądania i zamknięcia połączenia HTTP/1.0
+ TEST_F(HttpServerTest, BadRequestAndHttp10Close) {
+     int fd = connectToServer();
+     ASSERT_GE(fd, 0) << "Nie udalo sie polaczyc z serwerem";
+     std::string bad = exchange(fd, "NONSENSE\r\n\r\n", 1);
+     EXPECT_NE(bad.find("400"), std::string::npos);
+     ::close(fd);
+
+     fd = connectToServer();
+     ASSERT_GE(fd, 0) << "Nie udalo sie polaczyc z serwerem";
+     std::string response = exchange(fd, "GET /sync HTTP/1.0\r\n\r\n", 1);
+     EXPECT_NE(response.find("sync:"), std::string::npos);
+
+     // Serwer powinien zamknąć połączenie po odpowiedzi HTTP/1.0
+     char byte;
+     EXPECT_EQ(::recv(fd, &byte, 1, 0), 0);
+     ::close(fd);
+ }
+
+ // Test długiego ciągu żądań potokowych z odpowiedziami udzielanymi synchronicznie
+ TEST_F(HttpServerTest, LongPipelineOfInlineResponses) {
+     int fd = connectToServer();
+     ASSERT_GE(fd, 0) << "Nie udalo sie polaczyc z serwerem";
+
+     const std::size_t count = 200000;
+     std::string requests;
+     for (std::size_t i = 0; i < count; ++i) {
+         requests += "GET /sync HTTP/1.1\r\n\r\n";
+     }
+     // Klient wysyła i odbiera równocześnie, tak jak zwykły klient potokowy
+     std::thread sender([fd, &requests]() {
+         std::size_t sent = 0;
+         while (sent < requests.size()) {
+             ssize_t written = ::send(fd, requests.data() + sent, requests.size() - sent, MSG_NOSIGNAL);
+             if (written <= 0) {
+                 return;
+             }
+             sent += static_cast<std::size_t>(written);
+         }
+     });
+
+     const std::size_t expected = count * HttpServer::makeResponse(200, "text/plain", "sync:")->size();
+     std::size_t received = 0;
+     char buffer[64 * 1024];
+     while (received < expected) {
+         ssize_t length = ::recv(fd, buffer, sizeof(buffer), 0);
+         if (length <= 0) {
+             break;
+         }
+         received += static_cast<std::size_t>(length);
+     }
+     sender.join();
+
+     EXPECT_EQ(received, expected) << "Serwer powinien odpowiedziec na wszystkie zadania";
+     EXPECT_EQ(server->connectionCount(), 1u);
+     ::close(fd);
+ }
+
+ // Test odrzucenia zbyt dużej deklarowanej treści żądania
+ TEST_F(HttpServerTest, OversizedBodyIsRejected) {
+     int fd = connectToServer();
+     ASSERT_GE(fd, 0) << "Nie udalo sie polaczyc z serwerem";
+     std::string response = exchange(fd, "POST /sync HTTP/1.1\r\nContent-Length: 1000000000\r\n\r\n", 1);
+     EXPECT_NE(response.find("HTTP/1.1 413"), std::string::npos);
+
+     char byte;
+     EXPECT_EQ(::recv(fd, &byte, 1, 0), 0);
+     ::close(fd);
+ }
+
+ // Main dla Google Test
+ int main(int argc, char **argv) {
+     ::testing::InitGoogleTest(&argc, argv);
+     return RUN_ALL_TESTS();
+ }
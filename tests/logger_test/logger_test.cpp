@@ -0,0 +1,200 @@
+/**
+ * @file logger_test.cpp
+ * @brief Testy asynchronicznego loggera z wykorzystaniem Google Test
+ */
+
+ #include "logger.hpp"
+ #include <gtest/gtest.h>
+ #include <chrono>
+ #include <cstdio>
+ #include <fstream>
+ #include <future>
+ #include <map>
+ #include <thread>
+ #include <vector>
+
+ // Wyjście zapisujące komunikaty w pamięci
+ class MemorySink : public LogSink {
+ public:
+     explicit MemorySink(std::shared_future<void> gate = std::shared_future<void>()) : gate(gate) {}
+
+     void write(const LogRecord& record, const std::string& line) override {
+         if (gate.valid()) {
+             gate.wait();
+         }
+         std::lock_guard<std::mutex> lock(mutex);
+         records.push_back(record);
+         lines.push_back(line);
+     }
+
+     std::vector<LogRecord> snapshot() {
+         std::lock_guard<std::mutex> lock(mutex);
+         return records;
+     }
+
+     std::vector<std::string> snapshotLines() {
+         std::lock_guard<std::mutex> lock(mutex);
+         return lines;
+     }
+
+ private:
+     std::shared_future<void> gate;
+     std::mutex mutex;
+     std::vector<LogRecord> records;
+     std::vector<std::string> lines;
+ };
+
+ // Test kolejności i formatu komunikatów
+ TEST(LoggerTest, DeliversInOrderWithFormat) {
+     Logger logger;
+     auto sink = std::make_unique<MemorySink>();
+     MemorySink* memory = sink.get();
+     logger.addSink(std::move(sink));
+
+     for (int i = 0; i < 100; ++i) {
+         EXPECT_TRUE(logger.log(LogLevel::Info, "test", "komunikat " + std::to_string(i)));
+     }
+     logger.flush();
+
+     std::vector<LogRecord> records = memory->snapshot();
+     ASSERT_EQ(records.size(), 100u);
+     for (int i = 0; i < 100; ++i) {
+         EXPECT_EQ(records[i].message, "komunikat " + std::to_string(i));
+     }
+
+     std::string line = memory->snapshotLines()[0];
+     EXPECT_NE(line.find(" INFO  [test] #"), std::string::npos) << line;
+     EXPECT_EQ(line.substr(line.size() - 11), "komunikat 0");
+     EXPECT_EQ(logger.droppedCount(), 0u);
+ }
+
+ // Test wielu producentów
+ TEST(LoggerTest, ConcurrentProducersKeepPerThreadOrder) {
+     Logger logger;
+     auto sink = std::make_unique<MemorySink>();
+     MemorySink* memory = sink.get();
+     logger.addSink(std::move(sink));
+
+     const int threadCount = 4;
+     const int perThread = 1000;
+     std::vector<std::thread> threads;
+     for (int t = 0; t < threadCount; ++t) {
+         threads.emplace_back([&logger, t]() {
+             for (int i = 0; i < perThread; ++i) {
+                 while (!logger.log(LogLevel::Debug, "test", std::to_string(t) + ":" + std::to_string(i))) {
+                     std::this_thread::yield();
+                 }
+             }
+         });
+     }
+     for (auto& thread : threads) {
+         thread.join();
+     }
+     logger.flush();
+
+     std::vector<LogRecord> records = memory->snapshot();
+     ASSERT_EQ(records.size(), static_cast<std::size_t>(threadCount * perThread));
+
+     // Komunikaty z jednego wątku zachowują kolejność
+     std::map<std::uint32_t, int> lastIndex;
+     for (const auto& record : records) {
+         int index = std::stoi(record.message.substr(record.message.find(':') + 1));
+         auto it = lastIndex.find(record.threadId);
+         if (it != lastIndex.end()) {
+             EXPECT_GT(index, it->second);
+         }
+         lastIndex[record.threadId] = index;
+     }
+     EXPECT_EQ(lastIndex.size(), static_cast<std::size_t>(threadCount));
+ }
+
+ // Test odrzucania komunikatów przy przepełnionej kolejce (bez blokowania wywołującego)
+ TEST(LoggerTest, FullQueueDropsInsteadOfBlocking) {
+     std::promise<void> release;
+     std::shared_future<void> gate = release.get_future().share();
+
+     Logger logger(4);
+     auto sink = std::make_unique<MemorySink>(gate);
+     MemorySink* memory = sink.get();
+     logger.addSink(std::move(sink));
+
+     auto start = std::chrono::steady_clock::now();
+     int accepted = 0;
+     for (int i = 0; i < 100; ++i) {
+         if (logger.log(LogLevel::Info, "test", "x")) {
+             ++accepted;
+         }
+     }
+     auto elapsed = std::chrono::steady_clock::now() - start;
+
+     EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 100);
+     EXPECT_GT(logger.droppedCount(), 0u);
+     EXPECT_EQ(logger.droppedCount() + accepted, 100u);
+
+     release.set_value();
+     logger.flush();
+     EXPECT_EQ(memory->snapshot().size(), static_cast<std::size_t>(accepted));
+ }
+
+ // Test filtrowania poziomów i leniwego formatowania w makrach
+ TEST(LoggerTest, LevelFiltering) {
+     Logger logger;
+     logger.setLevel(LogLevel::Warning);
+     EXPECT_FALSE(logger.shouldLog(LogLevel::Info));
+     EXPECT_TRUE(logger.shouldLog(LogLevel::Warning));
+     EXPECT_TRUE(logger.shouldLog(LogLevel::Error));
+
+     Logger& global = Logger::instance();
+     LogLevel previous = global.level();
+     global.setLevel(LogLevel::Off);
+     int evaluations = 0;
+     auto expensive = [&evaluations]() { ++evaluations; return std::string("drogi opis"); };
+     LOG_ERROR("test", expensive());
+     LOG_DEBUG("test", expensive());
+     EXPECT_EQ(evaluations, 0) << "Wylaczony poziom nie powinien formatowac komunikatu";
+     global.setLevel(previous);
+
+     EXPECT_EQ(Logger::parseLevel("DEBUG", LogLevel::Info), LogLevel::Debug);
+     EXPECT_EQ(Logger::parseLevel("warn", LogLevel::Info), LogLevel::Warning);
+     EXPECT_EQ(Logger::parseLevel("nieznany", LogLevel::Error), LogLevel::Error);
+ }
+
+ // Test rotacji pliku logu
+ TEST(LoggerTest, RotatingFileSink) {
+     const std::string path = "test_logger.log";
+     for (const char* suffix : {"", ".1", ".2", ".3"}) {
+         std::remove((path + suffix).c_str());
+     }
+
+     {
+         Logger logger;
+         logger.addSink(std::make_unique<RotatingFileLogSink>(path, 200, 2));
+         for (int i = 0; i < 50; ++i) {
+             logger.log(LogLevel::Info, "test", "linia " + std::to_string(i));
+         }
+         logger.flush();
+     }
+
+     EXPECT_TRUE(std::ifstream(path).good());
+     EXPECT_TRUE(std::ifstream(path + ".1").good());
+     EXPECT_TRUE(std::ifstream(path + ".2").good());
+     EXPECT_FALSE(std::ifstream(path + ".3").good()) << "Zachowywane sa tylko 2 pliki archiwalne";
+
+     // Najnowszy komunikat trafia do bieżącego pliku
+     std::ifstream current(path);
+     std::string line, last;
+     while (std::getline(current, line)) {
+         last = line;
+     }
+     EXPECT_NE(last.find("linia 49"), std::string::npos);
+
+     for (const char* suffix : {"", ".1", ".2"}) {
+         std::remove((path + suffix).c_str());
+     }
+ }
+
+ // Main dla Google Test
+ int main(int argc, char **argv) {
+     ::testing::InitGoogleTest(&argc, argv);
+     return RUN_ALL_TESTS();
+ }
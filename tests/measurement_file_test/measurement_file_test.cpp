@@ -0,0 +1,333 @@
+/**
+ * @file measurement_file_test.cpp
+ * @brief Testy wczytywania zapisanych plików z pomiarami z wykorzystaniem Google Test
+ */
+
+ #include "measurement_file.hpp"
+ #include <gtest/gtest.h>
+ #include <algorithm>
+ #include <fstream>
+ #include <cmath>
+ #include <cstdlib>
+ #include <filesystem>
+
+ // Przykładowy plik z pomiarami pojedynczego czujnika (pomiary malejąco, jak w eksporcie)
+ const char* kSingleSensorFile = R"({
+     "measurements": [
+         { "date": "2025-04-26 16:00:00", "value": 1.8 },
+         { "date": "2025-04-26 15:00:00", "value": null },
+         { "date": "2025-04-26 14:00:00", "value": 2.5 },
+         { "date": "2025-04-26 13:00:00", "value": "2.0" }
+     ],
+     "metadata": {
+         "exportDate": "2025-04-26 16:46:20",
+         "sensor": {
+             "id": 50,
+             "paramCode": "NO2",
+             "paramFormula": "NO2",
+             "paramName": "dwutlenek azotu",
+             "color": "#0000ff"
+         },
+         "station": {
+             "city": "Czerniawa",
+             "id": 11,
+             "location": { "lat": 50.912475, "lon": 15.31219 },
+             "name": "Czerniawa",
+             "province": "DOLNOŚLĄSKIE"
+         }
+     }
+ })";
+
+ // Przykładowy plik z pomiarami wszystkich czujników stacji
+ const char* kAllSensorsFile = R"({
+     "metadata": {
+         "sensor": { "id": -1, "paramName": "Wszystkie", "paramFormula": "Wszystkie", "paramCode": "Wszystkie" },
+         "sensorColors": [
+             { "id": 50, "paramName": "dwutlenek azotu", "paramFormula": "NO2", "color": "#0000ff" },
+             { "id": 51, "paramName": "ozon", "paramFormula": "O3", "color": "#ff0000" }
+         ],
+         "station": { "id": 11, "name": "Czerniawa" }
+     },
+     "measurements": [
+         { "date": "2025-04-26 10:00:00", "value": 3.0 },
+         { "date": "2025-04-26 12:00:00", "value": 40.0 },
+         { "date": "2025-04-26 11:00:00", "value": 3.5 }
+     ]
+ })";
+
+ // Klasa testowa dla MeasurementFileLoader
+ class MeasurementFileTest : public ::testing::Test {
+ protected:
+     // Konfiguracja przed każdym testem
+     void SetUp() override {
+         testDir = "test_data_measurement_file";
+         system(("mkdir -p " + testDir).c_str());
+     }
+
+     // Sprzątanie po każdym teście
+     void TearDown() override {
+         system(("rm -rf " + testDir).c_str());
+     }
+
+     // Zapisuje zawartość do pliku w katalogu testowym
+     std::string writeFile(const std::string& name, const std::string& content) {
+         std::string path = testDir + "/" + name;
+         std::ofstream file(path);
+         file << content;
+         return path;
+     }
+
+     std::string testDir;
+ };
+
+ // Test konwersji dat w formacie GIOŚ
+ TEST_F(MeasurementFileTest, DateConversion) {
+     EXPECT_EQ(parseMeasurementDate("1970-01-01 00:00:00"), 0) << "Nieprawidłowa wartość dla początku epoki";
+     EXPECT_EQ(parseMeasurementDate("2025-04-26 16:00:00"), 1745683200) << "Nieprawidłowa konwersja daty";
+     EXPECT_EQ(parseMeasurementDate("2025-04-26T16:00:00"), 1745683200) << "Separator 'T' powinien być akceptowany";
+     EXPECT_EQ(parseMeasurementDate("niepoprawna data"), -1) << "Niepoprawna data powinna zwrócić -1";
+
+     EXPECT_EQ(formatMeasurementDate(1745683200), "2025-04-26 16:00:00") << "Nieprawidłowe formatowanie daty";
+     EXPECT_EQ(formatMeasurementDate(parseMeasurementDate("2024-02-29 23:59:59")), "2024-02-29 23:59:59")
+         << "Konwersja w obie strony powinna zachować datę";
+ }
+
+ // Test wyrównania serii do wspólnej osi czasu (scalanie k-drożne)
+ TEST_F(MeasurementFileTest, AlignSeriesOnSharedAxis) {
+     std::vector<MeasurementSeries> series(3);
+     series[0].append(100, 1.0); series[0].append(300, 3.0); series[0].append(500, 5.0);
+     series[1].append(200, 20.0); series[1].append(300, 30.0); series[1].append(300, 31.0);
+     // series[2] pozostaje pusta
+
+     AlignedSeries aligned = alignSeries(series);
+     ASSERT_EQ(aligned.timestamps, (std::vector<std::int64_t>{100, 200, 300, 500}));
+     ASSERT_EQ(aligned.columns.size(), 3u);
+     for (const auto& column : aligned.columns) {
+         ASSERT_EQ(column.size(), aligned.timestamps.size());
+     }
+     EXPECT_DOUBLE_EQ(aligned.columns[0][0], 1.0);
+     EXPECT_TRUE(std::isnan(aligned.columns[0][1]));
+     EXPECT_DOUBLE_EQ(aligned.columns[0][2], 3.0);
+     EXPECT_DOUBLE_EQ(aligned.columns[1][1], 20.0);
+     EXPECT_DOUBLE_EQ(aligned.columns[1][2], 31.0) << "Przy powtorzonym czasie wygrywa ostatnia wartosc";
+     EXPECT_TRUE(std::isnan(aligned.columns[1][3]));
+     EXPECT_TRUE(std::isnan(aligned.columns[2][0]));
+
+     MeasurementSeries unsorted;
+     unsorted.append(2, 0.0);
+     unsorted.append(1, 0.0);
+     EXPECT_THROW(alignSeries({unsorted}), std::runtime_error);
+ }
+
+ // Test przerzedzania serii z zachowaniem ekstremów
+ TEST_F(MeasurementFileTest, DecimateKeepsExtremes) {
+     std::vector<std::int64_t> timestamps;
+     std::vector<double> values;
+     for (int i = 0; i < 1000; ++i) {
+         timestamps.push_back(i * 3600);
+         values.push_back(i == 437 ? 500.0 : (i == 812 ? -50.0 : (i % 7 == 0 ? std::nan("") : i % 10)));
+     }
+
+     MeasurementSeries decimated = decimateMinMax(timestamps.data(), values.data(), values.size(), 100);
+     ASSERT_LE(decimated.size(), 100u);
+     EXPECT_TRUE(decimated.isSorted());
+     EXPECT_NE(std::find(decimated.values.begin(), decimated.values.end(), 500.0), decimated.values.end());
+     EXPECT_NE(std::find(decimated.values.begin(), decimated.values.end(), -50.0), decimated.values.end());
+     for (double value : decimated.values) {
+         EXPECT_FALSE(std::isnan(value));
+     }
+
+     // Krótka seria jest kopiowana bez wartości NaN
+     MeasurementSeries small = decimateMinMax(timestamps.data(), values.data(), 10, 100);
+     EXPECT_EQ(small.size(), 8u);
+ }
+
+ // Test wczytywania pliku pojedynczego czujnika
+ TEST_F(MeasurementFileTest, LoadSingleSensorFile) {
+     std::string path = writeFile("single.json", kSingleSensorFile);
+
+     SavedMeasurementFile file = MeasurementFileLoader::load(path);
+
+     EXPECT_EQ(file.station.id, 11) << "Nieprawidłowy ID stacji";
+     EXPECT_EQ(file.station.name, "Czerniawa") << "Nieprawidłowa nazwa stacji";
+     EXPECT_EQ(file.station.province, "DOLNOŚLĄSKIE") << "Nieprawidłowe województwo";
+     EXPECT_DOUBLE_EQ(file.station.lat, 50.912475) << "Nieprawidłowa szerokość geograficzna";
+     EXPECT_DOUBLE_EQ(file.station.lon, 15.31219) << "Nieprawidłowa długość geograficzna";
+
+     EXPECT_EQ(file.sensor.id, 50) << "Nieprawidłowy ID czujnika";
+     EXPECT_EQ(file.sensor.paramFormula, "NO2") << "Nieprawidłowy wzór parametru";
+     EXPECT_EQ(file.sensorColor, "#0000ff") << "Nieprawidłowy kolor czujnika";
+     EXPECT_EQ(file.exportDate, "2025-04-26 16:46:20") << "Nieprawidłowa data eksportu";
+     EXPECT_FALSE(file.isAllSensors());
+
+     // Pomiar z wartością null jest pomijany, seria jest posortowana rosnąco
+     ASSERT_EQ(file.series.size(), 3) << "Nieprawidłowa liczba pomiarów";
+     EXPECT_TRUE(file.series.isSorted()) << "Seria powinna być posortowana rosnąco";
+     EXPECT_DOUBLE_EQ(file.series.values[0], 2.0) << "Wartość tekstowa powinna zostać skonwertowana";
+     EXPECT_DOUBLE_EQ(file.series.values[2], 1.8);
+
+     std::vector<Measurement> measurements = file.series.toMeasurements();
+     EXPECT_EQ(measurements.back().date, "2025-04-26 16:00:00") << "Nieprawidłowa data najnowszego pomiaru";
+ }
+
+ // Test wyboru zakresu dat wyszukiwaniem binarnym i statystyk fragmentu
+ TEST_F(MeasurementFileTest, SeriesRangeSlice) {
+     MeasurementSeries series;
+     for (int i = 0; i < 10; ++i) {
+         series.append(1000 + i * 100, static_cast<double>(i));
+     }
+
+     SeriesSlice slice = series.range(1250, 1600);
+     ASSERT_EQ(slice.size(), 4u) << "Zakres powinien obejmowac pomiary 1300-1600";
+     EXPECT_EQ(slice.offset, 3u);
+     EXPECT_EQ(slice.timestamps, series.timestamps.data() + 3) << "Fragment nie powinien kopiowac danych";
+     EXPECT_EQ(slice.timestamps[3], 1600);
+
+     SeriesStatistics statistics = computeStatistics(slice);
+     EXPECT_EQ(statistics.count, 4u);
+     EXPECT_DOUBLE_EQ(statistics.min, 3.0);
+     EXPECT_DOUBLE_EQ(statistics.max, 6.0);
+     EXPECT_DOUBLE_EQ(statistics.mean, 4.5);
+
+     EXPECT_EQ(series.range(0, 5000).size(), 10u);
+     EXPECT_TRUE(series.range(0, 999).empty());
+     EXPECT_TRUE(series.range(1950, 1999).empty());
+     EXPECT_TRUE(series.range(1600, 1300).empty()) << "Odwrocony zakres powinien byc pusty";
+     EXPECT_EQ(computeStatistics(series.range(5000, 6000)).count, 0u);
+ }
+
+ // Test wczytywania pliku wszystkich czujników
+ TEST_F(MeasurementFileTest, ParseAllSensorsFile) {
+     std::string content = kAllSensorsFile;
+     SavedMeasurementFile file = MeasurementFileLoader::parse(content.data(), content.size());
+
+     EXPECT_TRUE(file.isAllSensors()) << "Plik powinien być rozpoznany jako 'Wszystkie'";
+     EXPECT_EQ(file.sensor.id, -1);
+     ASSERT_EQ(file.sensorColors.size(), 2) << "Nieprawidłowa liczba kolorów czujników";
+     EXPECT_EQ(file.sensorColors[1].sensorId, 51);
+     EXPECT_EQ(file.sensorColors[1].color, "#ff0000");
+
+     ASSERT_EQ(file.series.size(), 3);
+     EXPECT_TRUE(file.series.isSorted()) << "Nieposortowane pomiary powinny zostać posortowane";
+     EXPECT_DOUBLE_EQ(file.series.values[1], 3.5);
+ }
+
+ // Test zapisu i wczytania pliku skompresowanego (.aqz) z tymi samymi metadanymi co eksport JSON
+ TEST_F(MeasurementFileTest, CompressedFileRoundTrip) {
+     std::string content = kSingleSensorFile;
+     SavedMeasurementFile original = MeasurementFileLoader::parse(content.data(), content.size());
+     const json metadata = json::parse(content)["metadata"];
+
+     std::string path = testDir + "/single.aqz";
+     MeasurementFileWriter::saveCompressed(path, metadata, original.series);
+     SavedMeasurementFile file = MeasurementFileLoader::load(path);
+
+     EXPECT_EQ(file.station.name, "Czerniawa");
+     EXPECT_EQ(file.station.province, "DOLNOŚLĄSKIE");
+     EXPECT_EQ(file.sensor.id, 50);
+     EXPECT_EQ(file.sensorColor, "#0000ff");
+     EXPECT_EQ(file.series.timestamps, original.series.timestamps);
+     EXPECT_EQ(file.series.values, original.series.values);
+
+     std::string truncated = MeasurementFileWriter::compressed(metadata, original.series);
+     truncated.resize(truncated.size() - 12);
+     EXPECT_THROW(MeasurementFileLoader::parse(truncated.data(), truncated.size()), std::runtime_error)
+         << "Obciety plik skompresowany powinien zglosic wyjatek";
+ }
+
+ // Test eksportu przyrostowego: kolejne eksporty dopisują tylko nowsze pomiary
+ TEST_F(MeasurementFileTest, IncrementalExportAppendsOnlyNewer) {
+     std::string content = kSingleSensorFile;
+     SavedMeasurementFile original = MeasurementFileLoader::parse(content.data(), content.size());
+     const json metadata = json::parse(content)["metadata"];
+     std::string path = testDir + "/pomiary_11_50.jsonl";
+
+     std::int64_t checkpoint = 0;
+     EXPECT_FALSE(MeasurementFileWriter::lastCheckpoint(path, checkpoint));
+
+     AppendResult first = MeasurementFileWriter::appendJsonLines(path, metadata, original.series);
+     EXPECT_TRUE(first.created);
+     EXPECT_EQ(first.appended, 3u);
+     EXPECT_EQ(first.lastTimestamp, parseMeasurementDate("2025-04-26 16:00:00"));
+     const auto sizeAfterFirst = std::filesystem::file_size(path);
+
+     // Kolejna odpowiedź API (malejąco): dwa pomiary już zapisane i dwa nowe
+     MeasurementSeries response;
+     response.append(parseMeasurementDate("2025-04-26 18:00:00"), 0.1 + 0.2);
+     response.append(parseMeasurementDate("2025-04-26 17:00:00"), 2.25);
+     response.append(parseMeasurementDate("2025-04-26 16:00:00"), 1.8);
+     response.append(parseMeasurementDate("2025-04-26 14:00:00"), 2.5);
+     AppendResult second = MeasurementFileWriter::appendJsonLines(path, metadata, response);
+     EXPECT_FALSE(second.created);
+     EXPECT_EQ(second.appended, 2u);
+     EXPECT_EQ(second.skipped, 2u);
+     ASSERT_TRUE(MeasurementFileWriter::lastCheckpoint(path, checkpoint));
+     EXPECT_EQ(checkpoint, parseMeasurementDate("2025-04-26 18:00:00"));
+
+     // Brak nowych pomiarów - plik nie jest zmieniany
+     const auto sizeAfterSecond = std::filesystem::file_size(path);
+     EXPECT_LT(sizeAfterSecond - sizeAfterFirst, 200u);
+     EXPECT_EQ(MeasurementFileWriter::appendJsonLines(path, metadata, response).appended, 0u);
+     EXPECT_EQ(std::filesystem::file_size(path), sizeAfterSecond);
+
+     SavedMeasurementFile file = MeasurementFileLoader::load(path);
+     EXPECT_EQ(file.station.name, "Czerniawa");
+     EXPECT_EQ(file.sensor.id, 50);
+     EXPECT_EQ(file.sensorColor, "#0000ff");
+     ASSERT_EQ(file.series.size(), 5u);
+     EXPECT_EQ(file.series.values[4], 0.1 + 0.2) << "Wartosci musza byc zapisane bezstratnie";
+     EXPECT_DOUBLE_EQ(file.series.values[3], 2.25);
+ }
+
+ // Test odtwarzania punktu kontrolnego po przerwanym zapisie
+ TEST_F(MeasurementFileTest, IncrementalExportRecoversInterruptedWrite) {
+     const std::string path = writeFile("przerwany.jsonl",
+         "{\"format\":\"jsonl\",\"metadata\":{\"station\":{\"id\":11,\"name\":\"Czerniawa\"}}}\n"
+         "{\"date\":\"2025-04-26 10:00:00\",\"value\":3}\n"
+         "{\"date\":\"2025-04-26 11:00:00\",\"value\":null}\n"
+         "{ \"value\": 4.5, \"date\": \"2025-04-26 12:00:00\" }\n"
+         "{\"date\":\"2025-04-26 13:0");
+
+     // Niedokończony ostatni wiersz jest pomijany przy wczytywaniu
+     SavedMeasurementFile before = MeasurementFileLoader::load(path);
+     ASSERT_EQ(before.series.size(), 2u);
+     EXPECT_DOUBLE_EQ(before.series.values[1], 4.5);
+
+     std::int64_t checkpoint = 0;
+     ASSERT_TRUE(MeasurementFileWriter::lastCheckpoint(path, checkpoint));
+     EXPECT_EQ(checkpoint, parseMeasurementDate("2025-04-26 12:00:00"));
+
+     MeasurementSeries response;
+     response.append(parseMeasurementDate("2025-04-26 13:00:00"), 5.0);
+     response.append(parseMeasurementDate("2025-04-26 12:00:00"), 4.5);
+     EXPECT_EQ(MeasurementFileWriter::appendJsonLines(path, json::object(), response).appended, 1u);
+
+     SavedMeasurementFile after = MeasurementFileLoader::load(path);
+     ASSERT_EQ(after.series.size(), 3u);
+     EXPECT_EQ(after.station.id, 11);
+     EXPECT_DOUBLE_EQ(after.series.values[2], 5.0);
+
+     std::string notIncremental = writeFile("zwykly.jsonl", kSingleSensorFile);
+     EXPECT_THROW(MeasurementFileWriter::appendJsonLines(notIncremental, json::object(), response), std::runtime_error)
+         << "Dopisywanie do pliku w innym formacie powinno zglosic wyjatek";
+ }
+
+ // Test obsługi błędów
+ TEST_F(MeasurementFileTest, InvalidFiles) {
+     EXPECT_THROW(MeasurementFileLoader::load(testDir + "/nie_istnieje.json"), std::runtime_error)
+         << "Wczytanie nieistniejącego pliku powinno zgłosić wyjątek";
+
+     std::string emptyPath = writeFile("empty.json", "");
+     EXPECT_THROW(MeasurementFileLoader::load(emptyPath), std::runtime_error)
+         << "Wczytanie pustego pliku powinno zgłosić wyjątek";
+
+     std::string brokenPath = writeFile("broken.json", "{ \"measurements\": [ { \"date\": ");
+     EXPECT_THROW(MeasurementFileLoader::load(brokenPath), std::runtime_error)
+         << "Wczytanie uszkodzonego pliku powinno zgłosić wyjątek";
+ }
+
+ // Main dla Google Test
+ int main(int argc, char **argv) {
+     ::testing::InitGoogleTest(&argc, argv);
+     return RUN_ALL_TESTS();
+ }
@@ -0,0 +1,132 @@
+/**
+ * @file metrics_test.cpp
+ * @brief Testy metryk i histogramów opóźnień z wykorzystaniem Google Test
+ */
+
+ #include "metrics.hpp"
+ #include <gtest/gtest.h>
+ #include <cstdio>
+ #include <fstream>
+ #include <sstream>
+ #include <thread>
+ #include <vector>
+
+ // Test ciągłości i monotoniczności kubełków histogramu
+ TEST(LatencyHistogramTest, BucketsAreContiguous) {
+     for (int i = 0; i + 1 < LatencyHistogram::BUCKET_COUNT; ++i) {
+         std::uint64_t upper = LatencyHistogram::bucketUpperBound(i);
+         ASSERT_EQ(LatencyHistogram::bucketIndex(upper), i) << "Granica kubelka " << i;
+         ASSERT_EQ(LatencyHistogram::bucketIndex(upper + 1), i + 1) << "Nastepny kubelek po " << i;
+     }
+
+     // Wartości spoza zakresu trafiają do ostatniego kubełka
+     EXPECT_EQ(LatencyHistogram::bucketIndex(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+ }
+
+ // Test dokładności percentyli (błąd względny do ok. 3%)
+ TEST(LatencyHistogramTest, PercentilesWithinRelativeError) {
+     LatencyHistogram histogram;
+     for (std::uint64_t value = 1; value <= 100000; ++value) {
+         histogram.record(value);
+     }
+
+     EXPECT_EQ(histogram.count(), 100000u);
+     EXPECT_EQ(histogram.max(), 100000u);
+     EXPECT_EQ(histogram.sum(), 100000ull * 100001ull / 2);
+
+     const double percentiles[] = {50.0, 90.0, 99.0, 99.9};
+     for (double p : percentiles) {
+         double expected = p / 100.0 * 100000.0;
+         double actual = static_cast<double>(histogram.percentile(p));
+         EXPECT_NEAR(actual, expected, expected * 0.035) << "Percentyl " << p;
+     }
+     EXPECT_EQ(histogram.percentile(100.0), 100000u);
+
+     histogram.reset();
+     EXPECT_EQ(histogram.count(), 0u);
+     EXPECT_EQ(histogram.percentile(50.0), 0u);
+ }
+
+ // Test zapisu z wielu wątków
+ TEST(LatencyHistogramTest, ConcurrentRecording) {
+     LatencyHistogram histogram;
+     std::vector<std::thread> threads;
+     for (int t = 0; t < 4; ++t) {
+         threads.emplace_back([&histogram, t]() {
+             for (int i = 0; i < 10000; ++i) {
+                 histogram.record(static_cast<std::uint64_t>(t * 1000 + i % 1000));
+             }
+         });
+     }
+     for (auto& thread : threads) {
+         thread.join();
+     }
+     EXPECT_EQ(histogram.count(), 40000u);
+     EXPECT_EQ(histogram.max(), 3999u);
+     EXPECT_EQ(histogram.countAtOrBelow(UINT64_MAX >> 1), 40000u);
+ }
+
+ // Test klasyfikacji endpointów
+ TEST(ApiMetricsTest, ClassifyEndpoints) {
+     EXPECT_EQ(classifyEndpoint("/station/findAll"), EndpointClass::Stations);
+     EXPECT_EQ(classifyEndpoint("/station/sensors/14"), EndpointClass::Sensors);
+     EXPECT_EQ(classifyEndpoint("/data/getData/92"), EndpointClass::Measurements);
+     EXPECT_EQ(classifyEndpoint("/aqindex/getIndex/14"), EndpointClass::Other);
+ }
+
+ // Test eksportu w formacie Prometheus
+ TEST(ApiMetricsTest, PrometheusExport) {
+     ApiMetrics metrics;
+     RequestTimings timings;
+     timings.dns = 1000;
+     timings.connect = 2000;
+     timings.wait = 30000;
+     timings.transfer = 5000;
+     timings.total = 38000;
+     metrics.recordRequest(EndpointClass::Measurements, timings, 4096, true);
+     metrics.recordRequest(EndpointClass::Measurements, timings, 0, false);
+     metrics.recordCacheMiss(EndpointClass::Measurements);
+     metrics.recordCacheHit(EndpointClass::Measurements);
+     metrics.recordCacheHit(EndpointClass::Measurements);
+     metrics.recordPhase(EndpointClass::Measurements, RequestPhase::Parse, 700);
+     metrics.recordCoalesced(EndpointClass::Measurements);
+     metrics.recordTransfer(EndpointClass::Measurements, 1024, true, false);
+     metrics.recordTransfer(EndpointClass::Measurements, 0, false, false);
+
+     std::string text = metrics.toPrometheus();
+     EXPECT_NE(text.find("# TYPE airquality_api_requests_total counter"), std::string::npos);
+     EXPECT_NE(text.find("airquality_api_requests_total{endpoint=\"measurements\"} 2"), std::string::npos);
+     EXPECT_NE(text.find("airquality_api_failures_total{endpoint=\"measurements\"} 1"), std::string::npos);
+     EXPECT_NE(text.find("airquality_api_response_bytes_total{endpoint=\"measurements\"} 4096"), std::string::npos);
+     EXPECT_NE(text.find("airquality_api_cache_hits_total{endpoint=\"measurements\"} 2"), std::string::npos);
+     EXPECT_NE(text.find("airquality_api_cache_misses_total{endpoint=\"measurements\"} 1"), std::string::npos);
+     EXPECT_NE(text.find("airquality_api_coalesced_total{endpoint=\"measurements\"} 1"), std::string::npos);
+     EXPECT_NE(text.find("airquality_api_wire_bytes_total{endpoint=\"measurements\"} 1024"), std::string::npos);
+     EXPECT_NE(text.find("airquality_api_connections_total{endpoint=\"measurements\"} 1"), std::string::npos);
+     EXPECT_NE(text.find("airquality_api_http2_requests_total{endpoint=\"measurements\"} 0"), std::string::npos);
+
+     // Zapytania trwały 38 ms: kubełek 25 ms jest pusty, 50 ms zawiera oba
+     EXPECT_NE(text.find("airquality_api_phase_seconds_bucket{endpoint=\"measurements\",phase=\"total\",le=\"0.025\"} 0"),
+               std::string::npos);
+     EXPECT_NE(text.find("airquality_api_phase_seconds_bucket{endpoint=\"measurements\",phase=\"total\",le=\"0.05\"} 2"),
+               std::string::npos);
+     EXPECT_NE(text.find("airquality_api_phase_seconds_count{endpoint=\"measurements\",phase=\"parse\"} 1"),
+               std::string::npos);
+     EXPECT_NE(text.find("airquality_api_phase_quantile_seconds{endpoint=\"measurements\",phase=\"total\",quantile=\"0.99\"}"),
+               std::string::npos);
+
+     // Zapis do pliku
+     const std::string path = "test_metrics.prom";
+     ASSERT_TRUE(metrics.writePrometheus(path));
+     std::ifstream file(path);
+     std::stringstream content;
+     content << file.rdbuf();
+     EXPECT_EQ(content.str(), text);
+     std::remove(path.c_str());
+ }
+
+ // Main dla Google Test
+ int main(int argc, char **argv) {
+     ::testing::InitGoogleTest(&argc, argv);
+     return RUN_ALL_TESTS();
+ }
@@ -0,0 +1,410 @@
+/**
+ * @file offline_fetch_test.cpp
+ * @brief Testy end-to-end ścieżek pobierania ApiClient z serwerem zastępczym GIOŚ
+ */
+
+ #include "api_client.hpp"
+ #include "mock_gios_server.hpp"
+ #include "station_comparison.hpp"
+ #include <gtest/gtest.h>
+ #include <algorithm>
+ #include <atomic>
+ #include <chrono>
+ #include <cstdlib>
+ #include <fstream>
+ #include <future>
+ #include <thread>
+ #include <vector>
+
+ // Liczba stacji w nagranej odpowiedzi /station/findAll
+ std::size_t fixtureStationCount() {
+     std::ifstream file(std::string(AIRQUALITY_MOCK_FIXTURES) + "/station/findAll.json");
+     return json::parse(file).size();
+ }
+
+ // Klasa testowa dla ścieżek pobierania bez dostępu do sieci
+ class OfflineFetchTest : public ::testing::Test {
+ protected:
+     // Tworzy i uruchamia serwer zastępczy
+     void startServer(MockGiosOptions options) {
+         options.fixtureDir = AIRQUALITY_MOCK_FIXTURES;
+         server = std::make_unique<MockGiosServer>(options);
+         server->start();
+     }
+
+     // Zasady zapytań bez ponowień, aby liczba zapytań do serwera była przewidywalna
+     static RequestPolicy noRetryPolicy() {
+         RequestPolicy policy;
+         policy.maxRetries = 0;
+         policy.breakerFailureThreshold = 0;
+         return policy;
+     }
+ 
+     std::unique_ptr<MockGiosServer> server;
+ };
+
+ // Test pobrania stacji, czujników i pomiarów z nagranych odpowiedzi
+ TEST_F(OfflineFetchTest, FetchStationsSensorsMeasurements) {
+     startServer(MockGiosOptions());
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+
+     EXPECT_TRUE(client.isApiAvailable());
+
+     std::vector<Station> stations = client.getAllStations();
+     ASSERT_EQ(stations.size(), fixtureStationCount());
+     EXPECT_EQ(stations[0].id, 11);
+     EXPECT_EQ(stations[0].city, "Czerniawa");
+     EXPECT_NEAR(stations[0].lat, 50.912475, 1e-6);
+
+     std::vector<Sensor> sensors = client.getSensors(11);
+     ASSERT_FALSE(sensors.empty());
+     for (const auto& sensor : sensors) {
+         EXPECT_EQ(sensor.stationId, 11);
+     }
+
+     std::vector<Measurement> measurements = client.getMeasurements(sensors[0].id);
+     ASSERT_FALSE(measurements.empty());
+     EXPECT_EQ(measurements[0].date, "2025-04-26 16:00:00") << "Pomiar o wartosci null powinien zostac pominiety";
+
+     // Drugie pobranie pochodzi z cache klienta
+     std::uint64_t requestsBefore = server->stats().requests;
+     client.getMeasurements(sensors[0].id);
+     EXPECT_EQ(server->stats().requests, requestsBefore);
+
+     // Metryki klienta odzwierciedlają zapytania i trafienia w cache
+     const EndpointMetrics& measurementMetrics = client.getMetrics().endpoint(EndpointClass::Measurements);
+     EXPECT_EQ(measurementMetrics.requests.load(), 1u);
+     EXPECT_EQ(measurementMetrics.cacheMisses.load(), 1u);
+     EXPECT_EQ(measurementMetrics.cacheHits.load(), 1u);
+     EXPECT_GT(measurementMetrics.bytes.load(), 0u);
+     EXPECT_EQ(measurementMetrics.phase(RequestPhase::Total).count(), 1u);
+     EXPECT_EQ(measurementMetrics.phase(RequestPhase::Decode).count(), 1u);
+     EXPECT_EQ(client.getMetrics().endpoint(EndpointClass::Stations).requests.load(), 1u);
+ }
+
+ // Test porównania jednego parametru na wielu stacjach pobieranych równolegle
+ TEST_F(OfflineFetchTest, StationComparisonAlignsStations) {
+     startServer(MockGiosOptions());
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+
+     std::vector<Station> stations = client.getAllStations();
+     ASSERT_GE(stations.size(), 5u);
+     stations.resize(5);
+
+     StationComparison comparison = StationComparisonLoader::load(client, stations, Pollutant::PM10, 4);
+     ASSERT_EQ(comparison.stations.size(), 5u);
+     EXPECT_TRUE(comparison.skipped.empty());
+     EXPECT_EQ(comparison.stations[2].id, stations[2].id) << "Kolejnosc stacji powinna odpowiadac wejsciu";
+     ASSERT_EQ(comparison.aligned.columns.size(), 5u);
+     ASSERT_FALSE(comparison.aligned.timestamps.empty());
+     EXPECT_TRUE(std::is_sorted(comparison.aligned.timestamps.begin(), comparison.aligned.timestamps.end()));
+     for (const auto& column : comparison.aligned.columns) {
+         EXPECT_EQ(column.size(), comparison.aligned.timestamps.size());
+     }
+
+     // Parametr, którego nie mierzy żadna stacja
+     StationComparison none = StationComparisonLoader::load(client, stations, Pollutant::C6H6, 4);
+     EXPECT_TRUE(none.stations.empty());
+     EXPECT_EQ(none.skipped.size(), 5u);
+ }
+
+ // Test wstrzykniętych błędów HTTP 500
+ TEST_F(OfflineFetchTest, InjectedErrorsAreReported) {
+     MockGiosOptions options;
+     options.errorRate = 1.0;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+     client.setRequestPolicy(noRetryPolicy());
+
+     EXPECT_TRUE(client.getAllStations().empty());
+     EXPECT_TRUE(client.getMeasurements(1100).empty());
+     EXPECT_EQ(server->stats().injectedErrors, 2u);
+ }
+
+ // Test przepustowości i opóźnień ogonowych przy równoległym pobieraniu z limitem współbieżności
+ TEST_F(OfflineFetchTest, ConcurrentFetchThroughputAndTailLatency) {
+     MockGiosOptions options;
+     options.latencyMs = 5;
+     options.jitterMs = 5;
+     options.maxConcurrent = 4;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+     // Bez zapytań zapasowych liczba zapytań do serwera jest dokładnie znana
+     RequestPolicy policy = client.getRequestPolicy();
+     policy.hedging = false;
+     client.setRequestPolicy(policy);
+
+     const int threadCount = 8;
+     const int requestsPerThread = 20;
+     std::vector<std::vector<double>> latencies(threadCount);
+     std::atomic<int> failures{0};
+
+     auto start = std::chrono::steady_clock::now();
+     std::vector<std::thread> threads;
+     for (int t = 0; t < threadCount; ++t) {
+         threads.emplace_back([&, t]() {
+             for (int i = 0; i < requestsPerThread; ++i) {
+                 auto requestStart = std::chrono::steady_clock::now();
+                 if (client.getMeasurements(t * 1000 + i).empty()) {
+                     ++failures;
+                 }
+                 latencies[t].push_back(std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - requestStart).count());
+             }
+         });
+     }
+     for (auto& thread : threads) {
+         thread.join();
+     }
+     double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+     std::vector<double> all;
+     for (const auto& threadLatencies : latencies) {
+         all.insert(all.end(), threadLatencies.begin(), threadLatencies.end());
+     }
+     std::sort(all.begin(), all.end());
+     double p50 = all[all.size() / 2];
+     double p99 = all[all.size() * 99 / 100];
+
+     std::cout << "Zapytan: " << all.size() << ", przepustowosc: " << all.size() / elapsed
+               << " zapytan/s, p50: " << p50 << " ms, p99: " << p99 << " ms" << std::endl;
+     RecordProperty("p50_ms", std::to_string(p50));
+     RecordProperty("p99_ms", std::to_string(p99));
+
+     EXPECT_EQ(failures.load(), 0);
+     EXPECT_EQ(server->stats().requests, static_cast<std::uint64_t>(threadCount * requestsPerThread));
+     EXPECT_GT(server->stats().queued, 0u) << "Limit wspolbieznosci powinien kolejkowac zapytania";
+     EXPECT_GE(p50, options.latencyMs);
+ }
+
+ // Uruchamia równocześnie podaną liczbę wątków wykonujących tę samą funkcję
+ template <typename Function>
+ void runConcurrently(int threadCount, Function function) {
+     std::promise<void> start;
+     std::shared_future<void> startSignal = start.get_future().share();
+     std::vector<std::thread> threads;
+     for (int t = 0; t < threadCount; ++t) {
+         threads.emplace_back([&, t]() {
+             startSignal.wait();
+             function(t);
+         });
+     }
+     start.set_value();
+     for (auto& thread : threads) {
+         thread.join();
+     }
+ }
+
+ // Test scalania równoczesnych pobrań tych samych danych
+ TEST_F(OfflineFetchTest, ConcurrentDuplicateRequestsAreCoalesced) {
+     MockGiosOptions options;
+     options.latencyMs = 100;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+
+     const int threadCount = 8;
+     std::vector<std::size_t> sizes(threadCount);
+     runConcurrently(threadCount, [&](int t) {
+         sizes[t] = client.getMeasurements(1100).size();
+     });
+
+     EXPECT_EQ(server->stats().requests, 1u) << "Rownoczesne wywolania powinny wykonac jedno zapytanie";
+     for (std::size_t size : sizes) {
+         EXPECT_EQ(size, sizes[0]);
+         EXPECT_GT(size, 0u);
+     }
+     EXPECT_EQ(client.getCoalescedRequestCount(), static_cast<std::uint64_t>(threadCount - 1));
+     EXPECT_EQ(client.getMetrics().endpoint(EndpointClass::Measurements).coalesced.load(),
+               static_cast<std::uint64_t>(threadCount - 1));
+
+     // Różne klucze nie są scalane
+     runConcurrently(2, [&](int t) {
+         client.getSensors(11 + t);
+     });
+     EXPECT_EQ(server->stats().requests, 3u);
+ }
+
+ // Test przekazania błędu wszystkim oczekującym wywołaniom
+ TEST_F(OfflineFetchTest, CoalescedRequestsShareFailure) {
+     MockGiosOptions options;
+     options.latencyMs = 100;
+     options.errorRate = 1.0;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+     client.setRequestPolicy(noRetryPolicy());
+
+     std::atomic<int> emptyResults{0};
+     runConcurrently(4, [&](int) {
+         if (client.getMeasurements(1100).empty()) {
+             ++emptyResults;
+         }
+     });
+
+     EXPECT_EQ(emptyResults.load(), 4);
+     EXPECT_EQ(server->stats().injectedErrors, 1u);
+
+     // Po błędzie klucz jest zwalniany i kolejne wywołanie ponawia zapytanie
+     client.getMeasurements(1100);
+     EXPECT_EQ(server->stats().injectedErrors, 2u);
+ }
+
+ // Test zapytania zapasowego wysyłanego, gdy odpowiedź się opóźnia
+ TEST_F(OfflineFetchTest, SlowRequestIsHedged) {
+     MockGiosOptions options;
+     options.latencyMs = 200;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+     RequestPolicy policy = client.getRequestPolicy();
+     policy.initialHedgeDelay = std::chrono::milliseconds(20);
+     client.setRequestPolicy(policy);
+
+     EXPECT_FALSE(client.getMeasurements(1100).empty());
+     const EndpointMetrics& metrics = client.getMetrics().endpoint(EndpointClass::Measurements);
+     EXPECT_EQ(metrics.hedged.load(), 1u);
+     EXPECT_EQ(server->stats().requests, 2u);
+     EXPECT_EQ(metrics.phase(RequestPhase::Total).count(), 1u) << "Zapisywany jest tylko czas zwycieskiego zapytania";
+ }
+
+ // Test terminu pojedynczego wywołania
+ TEST_F(OfflineFetchTest, DeadlineBoundsSlowRequest) {
+     MockGiosOptions options;
+     options.latencyMs = 1000;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+
+     auto start = std::chrono::steady_clock::now();
+     EXPECT_TRUE(client.getMeasurements(1100, std::chrono::milliseconds(150)).empty());
+     auto elapsed = std::chrono::steady_clock::now() - start;
+     EXPECT_LT(elapsed, std::chrono::milliseconds(800)) << "Wywolanie powinno zakonczyc sie w terminie";
+ }
+
+ // Test ponowień po błędach przejściowych
+ TEST_F(OfflineFetchTest, TransientErrorsAreRetried) {
+     MockGiosOptions options;
+     options.errorRate = 0.5;
+     options.seed = 7;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+     RequestPolicy policy = client.getRequestPolicy();
+     policy.maxRetries = 20;
+     policy.retryBaseDelay = std::chrono::milliseconds(1);
+     policy.retryMaxDelay = std::chrono::milliseconds(5);
+     policy.breakerFailureThreshold = 0;
+     client.setRequestPolicy(policy);
+
+     for (int sensorId = 1100; sensorId < 1110; ++sensorId) {
+         EXPECT_FALSE(client.getMeasurements(sensorId).empty());
+     }
+     const EndpointMetrics& metrics = client.getMetrics().endpoint(EndpointClass::Measurements);
+     EXPECT_GT(server->stats().injectedErrors, 0u);
+     EXPECT_EQ(metrics.retries.load(), server->stats().injectedErrors);
+ }
+
+ // Test otwarcia wyłącznika obwodu po serii błędów
+ TEST_F(OfflineFetchTest, CircuitBreakerOpensAfterFailures) {
+     MockGiosOptions options;
+     options.errorRate = 1.0;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+     RequestPolicy policy = noRetryPolicy();
+     policy.breakerFailureThreshold = 3;
+     policy.breakerOpenDuration = std::chrono::milliseconds(100);
+     client.setRequestPolicy(policy);
+
+     for (int i = 0; i < 5; ++i) {
+         EXPECT_TRUE(client.getMeasurements(1100 + i).empty());
+     }
+     EXPECT_EQ(server->stats().injectedErrors, 3u) << "Po otwarciu obwodu zapytania nie sa wysylane";
+     EXPECT_EQ(client.getCircuitState(), CircuitBreaker::State::Open);
+     EXPECT_EQ(client.getMetrics().endpoint(EndpointClass::Measurements).breakerRejections.load(), 2u);
+
+     // Po czasie otwarcia wysyłane jest zapytanie próbne
+     std::this_thread::sleep_for(std::chrono::milliseconds(150));
+     client.getMeasurements(1100);
+     EXPECT_EQ(server->stats().injectedErrors, 4u);
+     EXPECT_EQ(client.getCircuitState(), CircuitBreaker::State::Open);
+ }
+
+ // Test zwracania nieaktualnych danych, gdy API jest niedostępne
+ TEST_F(OfflineFetchTest, StaleDataServedWhenApiUnavailable) {
+     startServer(MockGiosOptions());
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+     client.setRequestPolicy(noRetryPolicy());
+
+     std::vector<Measurement> fresh = client.getMeasurements(1100);
+     ASSERT_FALSE(fresh.empty());
+
+     // Zatrzymany serwer nie odpowiada; krótki termin ogranicza czas oczekiwania
+     client.clearMeasurementCache(1100);
+     server->stop();
+
+     std::vector<Measurement> stale = client.getMeasurements(1100, std::chrono::milliseconds(200));
+     ASSERT_EQ(stale.size(), fresh.size());
+     EXPECT_EQ(stale[0].date, fresh[0].date);
+     EXPECT_EQ(client.getMetrics().endpoint(EndpointClass::Measurements).staleServed.load(), 1u);
+     EXPECT_TRUE(client.getMeasurements(1101, std::chrono::milliseconds(200)).empty()) << "Bez wczesniejszych danych zwracany jest pusty wynik";
+ }
+
+ // Test kompresji odpowiedzi i ponownego użycia połączenia
+ TEST_F(OfflineFetchTest, CompressedTransferAndConnectionReuse) {
+     if (!MockGiosServer::compressionSupported()) {
+         GTEST_SKIP() << "Serwer zastepczy zbudowany bez zlib";
+     }
+     MockGiosOptions options;
+     options.gzip = true;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+
+     ASSERT_EQ(client.getAllStations().size(), fixtureStationCount());
+     const EndpointMetrics& stations = client.getMetrics().endpoint(EndpointClass::Stations);
+     EXPECT_GT(stations.wireBytes.load(), 0u);
+     EXPECT_LT(stations.wireBytes.load() * 2, stations.bytes.load()) << "JSON powinien skompresowac sie co najmniej dwukrotnie";
+
+     // Kolejne zapytania korzystają z otwartego połączenia
+     for (int sensorId = 1100; sensorId < 1105; ++sensorId) {
+         EXPECT_FALSE(client.getMeasurements(sensorId).empty());
+     }
+     EXPECT_EQ(stations.connections.load(), 1u);
+     EXPECT_EQ(client.getMetrics().endpoint(EndpointClass::Measurements).connections.load(), 0u);
+
+     // Bez kompresji bajty w sieci i po dekompresji są równe
+     RequestPolicy policy = client.getRequestPolicy();
+     policy.compression = false;
+     client.setRequestPolicy(policy);
+     client.clearCache();
+     client.getMetrics().reset();
+     client.getAllStations();
+     EXPECT_EQ(stations.wireBytes.load(), stations.bytes.load());
+ }
+
+ // Test konfiguracji adresu API zmienną środowiskową
+ TEST_F(OfflineFetchTest, BaseUrlFromEnvironment) {
+     setenv("AIRQUALITY_API_URL", "http://127.0.0.1:9/rest/", 1);
+     ApiClient fromEnvironment;
+     EXPECT_EQ(fromEnvironment.getBaseUrl(), "http://127.0.0.1:9/rest");
+
+     ApiClient explicitUrl("http://localhost:8090");
+     EXPECT_EQ(explicitUrl.getBaseUrl(), "http://localhost:8090") << "Jawny adres ma pierwszenstwo";
+     unsetenv("AIRQUALITY_API_URL");
+
+     ApiClient defaultUrl;
+     EXPECT_EQ(defaultUrl.getBaseUrl(), "http://api.gios.gov.pl/pjp-api/rest");
+ }
+
+ // Main dla Google Test
+ int main(int argc, char **argv) {
+     ::testing::InitGoogleTest(&argc, argv);
+     return RUN_ALL_TESTS();
+ }
@@ -0,0 +1,286 @@
+/**
+ * @file pipeline_test.cpp
+ * @brief Testy kolejki ograniczonej i potoku pobierania pomiarów z serwerem zastępczym GIOŚ
+ */
+
+ #include "bounded_queue.hpp"
+ #include "fetch_pipeline.hpp"
+ #include "mock_gios_server.hpp"
+ #include <gtest/gtest.h>
+ #include <atomic>
+ #include <chrono>
+ #include <iostream>
+ #include <map>
+ #include <thread>
+ #include <vector>
+
+ // Test kolejności FIFO, zaokrąglenia pojemności i zamknięcia kolejki
+ TEST(BoundedQueueTest, FifoOrderAndClose) {
+     BoundedQueue<int> queue(5);
+     EXPECT_EQ(queue.capacity(), 8u);
+
+     for (int i = 0; i < 8; ++i) {
+         int value = i;
+         ASSERT_TRUE(queue.tryPush(value));
+     }
+     int overflow = 8;
+     EXPECT_FALSE(queue.tryPush(overflow));
+     EXPECT_EQ(queue.size(), 8u);
+
+     int value = -1;
+     ASSERT_TRUE(queue.pop(value));
+     EXPECT_EQ(value, 0);
+
+     // Po zamknięciu nowe elementy są odrzucane, a pozostałe można pobrać
+     queue.close();
+     EXPECT_FALSE(queue.push(100));
+     for (int expected = 1; expected < 8; ++expected) {
+         ASSERT_TRUE(queue.pop(value));
+         EXPECT_EQ(value, expected);
+     }
+     EXPECT_FALSE(queue.pop(value));
+
+     QueueStats stats = queue.stats();
+     EXPECT_EQ(stats.pushed, 8u);
+     EXPECT_EQ(stats.maxDepth, 8u);
+ }
+
+ // Test przeciwciśnienia: producent czeka na wolniejszego konsumenta
+ TEST(BoundedQueueTest, FullQueueBlocksProducer) {
+     BoundedQueue<int> queue(2);
+     const int count = 20;
+     std::thread producer([&] {
+         for (int i = 0; i < count; ++i) {
+             ASSERT_TRUE(queue.push(i));
+         }
+         queue.close();
+     });
+
+     std::vector<int> received;
+     int value = 0;
+     while (queue.pop(value)) {
+         received.push_back(value);
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+         EXPECT_LE(queue.size(), queue.capacity());
+     }
+     producer.join();
+
+     ASSERT_EQ(received.size(), static_cast<std::size_t>(count));
+     for (int i = 0; i < count; ++i) {
+         EXPECT_EQ(received[i], i);
+     }
+     EXPECT_GT(queue.stats().fullWaits, 0u);
+     EXPECT_LE(queue.stats().maxDepth, 2u);
+ }
+
+ // Test wielu producentów i konsumentów: każdy element jest pobrany dokładnie raz
+ TEST(BoundedQueueTest, MultipleProducersAndConsumers) {
+     BoundedQueue<int> queue(16);
+     const int producers = 4;
+     const int perProducer = 20000;
+     std::atomic<long long> sum{0};
+     std::atomic<int> received{0};
+
+     std::vector<std::thread> consumers;
+     for (int c = 0; c < 4; ++c) {
+         consumers.emplace_back([&] {
+             int value = 0;
+             while (queue.pop(value)) {
+                 sum += value;
+                 ++received;
+             }
+         });
+     }
+     std::vector<std::thread> writers;
+     for (int p = 0; p < producers; ++p) {
+         writers.emplace_back([&, p] {
+             for (int i = 0; i < perProducer; ++i) {
+                 queue.push(p * perProducer + i + 1);
+             }
+         });
+     }
+     for (auto& writer : writers) {
+         writer.join();
+     }
+     queue.close();
+     for (auto& consumer : consumers) {
+         consumer.join();
+     }
+
+     const long long total = static_cast<long long>(producers) * perProducer;
+     EXPECT_EQ(received.load(), total);
+     EXPECT_EQ(sum.load(), total * (total + 1) / 2);
+ }
+
+ // Klasa testowa potoku
+ class PipelineTest : public ::testing::Test {
+ protected:
+     // Tworzy i uruchamia serwer zastępczy
+     void startServer(MockGiosOptions options) {
+         options.fixtureDir = AIRQUALITY_MOCK_FIXTURES;
+         server = std::make_unique<MockGiosServer>(options);
+         server->start();
+     }
+
+     // Zwraca kolejne ID czujników
+     static std::vector<int> sensorRange(int first, int count) {
+         std::vector<int> ids;
+         for (int i = 0; i < count; ++i) {
+             ids.push_back(first + i);
+         }
+         return ids;
+     }
+
+     std::unique_ptr<MockGiosServer> server;
+ };
+
+ // Test przejścia czujników przez wszystkie etapy i ponownego przebiegu z cache
+ TEST_F(PipelineTest, ItemsFlowThroughAllStages) {
+     MockGiosOptions options;
+     options.latencyMs = 20;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+
+     PipelineOptions pipelineOptions;
+     pipelineOptions.maxInFlight = 16;
+     pipelineOptions.queueCapacity = 8;
+     FetchPipeline pipeline(client, pipelineOptions);
+
+     std::map<int, std::size_t> storedPoints;
+     std::size_t published = 0;
+     pipeline.setStoreStage([&](PipelineItem& item) {
+         storedPoints[item.sensorId] = item.series.size();
+     });
+     pipeline.setPublishStage([&](PipelineItem& item) {
+         EXPECT_TRUE(item.error.empty()) << item.error;
+         EXPECT_EQ(item.series.size(), item.measurements.size());
+         ++published;
+     });
+
+     const std::vector<int> ids = sensorRange(7000, 40);
+     PipelineReport report = pipeline.run(ids);
+     std::cout << "Potok: " << report.summary() << std::endl;
+
+     EXPECT_EQ(report.items, ids.size());
+     EXPECT_EQ(report.failed, 0u);
+     EXPECT_EQ(published, ids.size());
+     ASSERT_EQ(storedPoints.size(), ids.size());
+     EXPECT_GT(storedPoints.begin()->second, 0u);
+     ASSERT_EQ(report.stages.size(), 4u);
+     ASSERT_EQ(report.queues.size(), 3u);
+     for (const auto& stage : report.stages) {
+         EXPECT_EQ(stage.items, ids.size()) << stage.name;
+     }
+     EXPECT_EQ(server->stats().requests, static_cast<std::uint64_t>(ids.size()));
+     // Kolejno zapytania trwałyby co najmniej 800 ms
+     EXPECT_LT(report.seconds, 0.4);
+
+     // Drugi przebieg korzysta z cache klienta zapisanego przez etap dekodowania
+     storedPoints.clear();
+     report = pipeline.run(ids);
+     EXPECT_EQ(report.items, ids.size());
+     EXPECT_EQ(storedPoints.size(), ids.size());
+     EXPECT_EQ(server->stats().requests, static_cast<std::uint64_t>(ids.size()));
+     EXPECT_EQ(client.getMeasurements(7000).size(), storedPoints[7000]);
+ }
+
+ // Test wskazania wolnego etapu jako wąskiego gardła i zapełnienia jego kolejki
+ TEST_F(PipelineTest, SlowStageIsReportedAsBottleneck) {
+     startServer(MockGiosOptions());
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+
+     PipelineOptions pipelineOptions;
+     pipelineOptions.maxInFlight = 8;
+     pipelineOptions.queueCapacity = 4;
+     pipelineOptions.useCache = false;
+     FetchPipeline pipeline(client, pipelineOptions);
+     pipeline.setStoreStage([](PipelineItem&) {
+         std::this_thread::sleep_for(std::chrono::milliseconds(5));
+     });
+
+     PipelineReport report = pipeline.run(sensorRange(8000, 60));
+     std::cout << "Potok: " << report.summary() << std::endl;
+
+     EXPECT_EQ(report.items, 60u);
+     EXPECT_EQ(report.bottleneck(), "zapis");
+     // Kolejka przed wolnym etapem zapełnia się i wstrzymuje dekodowanie
+     const QueueStats& storeInput = report.queues[1];
+     EXPECT_EQ(storeInput.maxDepth, storeInput.capacity);
+     EXPECT_GT(storeInput.fullWaits, 0u);
+     EXPECT_GT(report.stages[1].outputWaitMicros, 0u);
+ }
+
+ // Test błędów pobierania, publikacji przez wykonawcę i przerwania potoku
+ TEST_F(PipelineTest, FailuresArePublishedAndCancelStopsFetching) {
+     MockGiosOptions options;
+     options.errorRate = 1.0;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+     RequestPolicy policy;
+     policy.maxRetries = 0;
+     policy.breakerFailureThreshold = 0;
+     client.setRequestPolicy(policy);
+
+     PipelineOptions pipelineOptions;
+     pipelineOptions.maxInFlight = 2;
+     pipelineOptions.queueCapacity = 4;
+     FetchPipeline pipeline(client, pipelineOptions);
+     WorkerExecutor publishExecutor;
+     std::atomic<int> stored{0};
+     std::atomic<int> published{0};
+     std::atomic<bool> publishedOnExecutor{true};
+     pipeline.setStoreStage([&](PipelineItem&) { ++stored; });
+     pipeline.setPublishStage([&](PipelineItem& item) {
+         EXPECT_FALSE(item.error.empty());
+         publishedOnExecutor = publishedOnExecutor && publishExecutor.runsInThisThread();
+         if (++published == 5) {
+             pipeline.cancel();
+         }
+     }, &publishExecutor);
+
+     const std::vector<int> ids = sensorRange(9000, 200);
+     PipelineReport report = pipeline.run(ids);
+
+     EXPECT_EQ(stored.load(), 0);
+     EXPECT_EQ(published.load(), 5);
+     EXPECT_TRUE(publishedOnExecutor.load());
+     EXPECT_EQ(report.failed, report.items);
+     EXPECT_LT(server->stats().requests, static_cast<std::uint64_t>(ids.size()));
+ }
+
+ // Test przerwania potoku z zapytaniami w toku: run() nie czeka na odpowiedzi ani terminy
+ TEST_F(PipelineTest, CancelAbortsRequestsInFlight) {
+     MockGiosOptions options;
+     options.latencyMs = 5000;
+     startServer(options);
+     ApiClient client(server->baseUrl());
+     client.setVerbose(false);
+     RequestPolicy policy;
+     policy.maxRetries = 0;
+     client.setRequestPolicy(policy);
+
+     PipelineOptions pipelineOptions;
+     pipelineOptions.maxInFlight = 8;
+     pipelineOptions.useCache = false;
+     FetchPipeline pipeline(client, pipelineOptions);
+     std::atomic<int> published{0};
+     pipeline.setPublishStage([&](PipelineItem&) { ++published; });
+
+     std::thread canceller([&pipeline]() {
+         std::this_thread::sleep_for(std::chrono::milliseconds(200));
+         pipeline.cancel();
+     });
+     const auto start = std::chrono::steady_clock::now();
+     PipelineReport report = pipeline.run(sensorRange(9500, 40));
+     const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+     canceller.join();
+
+     EXPECT_TRUE(pipeline.isCancelled());
+     EXPECT_LT(seconds, 2.0) << "Przerwane zapytania nie powinny czekac na odpowiedz serwera";
+     EXPECT_EQ(report.failed, report.items);
+     EXPECT_LE(report.items, 8u);
+     EXPECT_EQ(published.load(), 0);
+ }
@@ -0,0 +1,96 @@
+/**
+ * @file pollutant_test.cpp
+ * @brief Testy tabeli parametrów GIOŚ i wyszukiwania parametru po kodzie i idParam
+ */
+
+ #include "api_client.hpp"
+ #include "pollutant.hpp"
+ #include <gtest/gtest.h>
+ #include <set>
+ #include <string>
+
+ // Wyszukiwanie działa w czasie kompilacji
+ static_assert(pollutantFromCode("NO2") == Pollutant::NO2, "NO2");
+ static_assert(pollutantFromParamId(69) == Pollutant::PM25, "PM2.5");
+ static_assert(airQualityIndex(Pollutant::PM10, 35.0) == 1, "PM10 35 -> dobry");
+
+ // Test wyszukiwania wszystkich parametrów tabeli po kodzie i idParam
+ TEST(PollutantTest, LookupRoundTrip) {
+     for (const auto& info : POLLUTANTS) {
+         EXPECT_EQ(pollutantFromCode(info.code), info.id) << info.code;
+         EXPECT_EQ(pollutantFromParamId(info.giosParamId), info.id) << info.code;
+         ASSERT_NE(pollutantInfo(info.id), nullptr);
+         EXPECT_EQ(pollutantInfo(info.id)->code, info.code);
+     }
+     EXPECT_EQ(pollutantInfo(Pollutant::Unknown), nullptr);
+ }
+
+ // Test odrzucania nieznanych kodów i identyfikatorów (także kolidujących w tablicy skrótów)
+ TEST(PollutantTest, UnknownKeysAreRejected) {
+     EXPECT_EQ(pollutantFromCode(""), Pollutant::Unknown);
+     EXPECT_EQ(pollutantFromCode("pm10"), Pollutant::Unknown);
+     EXPECT_EQ(pollutantFromCode("PM1"), Pollutant::Unknown);
+     EXPECT_EQ(pollutantFromCode("Wszystkie"), Pollutant::Unknown);
+     EXPECT_EQ(pollutantFromParamId(0), Pollutant::Unknown);
+     EXPECT_EQ(pollutantFromParamId(-3), Pollutant::Unknown);
+     for (int paramId = 1; paramId < 1000; ++paramId) {
+         Pollutant pollutant = pollutantFromParamId(paramId);
+         if (pollutant != Pollutant::Unknown) {
+             EXPECT_EQ(pollutantInfo(pollutant)->giosParamId, paramId);
+         }
+     }
+ }
+
+ // Test ustalania parametru: idParam ma pierwszeństwo, kod jest rezerwą
+ TEST(PollutantTest, ResolvePrefersParamId) {
+     EXPECT_EQ(resolvePollutant(3, "NO2"), Pollutant::PM10);
+     EXPECT_EQ(resolvePollutant(0, "O3"), Pollutant::O3);
+     EXPECT_EQ(resolvePollutant(999, "XYZ"), Pollutant::Unknown);
+ }
+
+ // Test klas indeksu jakości powietrza na granicach progów
+ TEST(PollutantTest, AirQualityIndexBreakpoints) {
+     EXPECT_EQ(airQualityIndex(Pollutant::PM10, 0.0), 0);
+     EXPECT_EQ(airQualityIndex(Pollutant::PM10, 20.0), 0);
+     EXPECT_EQ(airQualityIndex(Pollutant::PM10, 20.1), 1);
+     EXPECT_EQ(airQualityIndex(Pollutant::PM10, 150.0), 4);
+     EXPECT_EQ(airQualityIndex(Pollutant::PM10, 150.1), 5);
+     EXPECT_EQ(airQualityIndex(Pollutant::NO2, 401.0), 5);
+     EXPECT_EQ(airQualityIndex(Pollutant::Unknown, 10.0), -1);
+     EXPECT_EQ(AIR_QUALITY_LEVELS[static_cast<std::size_t>(airQualityIndex(Pollutant::O3, 130.0))], "Umiarkowany");
+ }
+
+ // Test spójności tabeli: unikalne klucze, rosnące progi, dodatnie normy
+ TEST(PollutantTest, TableIsConsistent) {
+     std::set<int> paramIds;
+     std::set<std::string> codes;
+     for (const auto& info : POLLUTANTS) {
+         EXPECT_TRUE(paramIds.insert(info.giosParamId).second);
+         EXPECT_TRUE(codes.insert(std::string(info.code)).second);
+         EXPECT_GT(info.limitValue, 0.0);
+         EXPECT_FALSE(info.unit.empty());
+         for (std::size_t i = 1; i < info.indexBreakpoints.size(); ++i) {
+             EXPECT_LT(info.indexBreakpoints[i - 1], info.indexBreakpoints[i]) << info.code;
+         }
+     }
+ }
+
+ // Test ustawiania typowanego parametru przy dekodowaniu czujników z API
+ TEST(PollutantTest, SensorsCarryTypedPollutant) {
+     json response = json::parse(R"([
+         {"id": 1, "stationId": 7, "param": {"paramName": "pył zawieszony PM2.5", "paramFormula": "PM2.5",
+                                             "paramCode": "PM2.5", "idParam": 69}},
+         {"id": 2, "stationId": 7, "param": {"paramName": "rtęć", "paramFormula": "Hg",
+                                             "paramCode": "Hg", "idParam": 500}}
+     ])");
+     std::vector<Sensor> sensors = ApiClient::parseSensors(response);
+     ASSERT_EQ(sensors.size(), 2u);
+     EXPECT_EQ(sensors[0].pollutant, Pollutant::PM25);
+     EXPECT_EQ(sensors[1].pollutant, Pollutant::Unknown);
+ }
+
+ // Main dla Google Test
+ int main(int argc, char **argv) {
+     ::testing::InitGoogleTest(&argc, argv);
+     return RUN_ALL_TESTS();
+ }
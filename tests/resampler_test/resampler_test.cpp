@@ -0,0 +1,122 @@
+/**
+ * @file resampler_test.cpp
+ * @brief Testy przeliczania serii na regularną siatkę czasu
+ */
+
+ #include "resampler.hpp"
+ #include <gtest/gtest.h>
+ #include <cmath>
+ #include <stdexcept>
+
+ // Seria z par (godzina od początku doby 2025-04-26, wartość)
+ static MeasurementSeries hourlySeries(std::initializer_list<std::pair<int, double>> points) {
+     const std::int64_t base = parseMeasurementDate("2025-04-26 00:00:00");
+     MeasurementSeries series;
+     for (const auto& point : points) {
+         series.append(base + point.first * 3600, point.second);
+     }
+     return series;
+ }
+
+ // Test wyrównania dwóch serii na wspólnej siatce (dowolna kolejność wejścia)
+ TEST(ResamplerTest, AlignsColumnsOnHourlyGrid) {
+     ResampledFrame frame = Resampler::resample(
+         {hourlySeries({{3, 30.0}, {1, 10.0}, {2, 20.0}}), hourlySeries({{2, 5.0}, {4, 7.0}})},
+         {"PM10", "NO2"});
+
+     ASSERT_EQ(frame.rows(), 4u);
+     EXPECT_EQ(frame.step, 3600);
+     EXPECT_EQ(formatMeasurementDate(frame.timestamp(0)), "2025-04-26 01:00:00");
+     EXPECT_EQ(frame.names[1], "NO2");
+     EXPECT_DOUBLE_EQ(frame.column(0)[0], 10.0);
+     EXPECT_DOUBLE_EQ(frame.column(0)[2], 30.0);
+     EXPECT_TRUE(std::isnan(frame.column(0)[3]));
+     EXPECT_TRUE(std::isnan(frame.column(1)[0]));
+     EXPECT_DOUBLE_EQ(frame.column(1)[1], 5.0);
+     EXPECT_TRUE(std::isnan(frame.column(1)[2]));
+     EXPECT_DOUBLE_EQ(frame.column(1)[3], 7.0);
+
+     // Brak pomiaru na brzegach kolumny nie jest luką
+     ASSERT_EQ(frame.gaps.size(), 1u);
+     EXPECT_EQ(frame.gaps[0].column, 1u);
+     EXPECT_EQ(frame.gaps[0].firstRow, 2u);
+     EXPECT_EQ(frame.gaps[0].rowCount, 1u);
+ }
+
+ // Test uzupełniania luk i limitu długości uzupełnianej luki
+ TEST(ResamplerTest, FillsGaps) {
+     Resampler resampler;
+     const std::size_t column = resampler.addColumn("O3");
+     resampler.append(column, hourlySeries({{0, 10.0}, {4, 50.0}, {5, 60.0}, {7, 80.0}}));
+
+     ResampledFrame linear = resampler.frame(GapFill::Linear);
+     ASSERT_EQ(linear.rows(), 8u);
+     EXPECT_DOUBLE_EQ(linear.column(0)[1], 20.0);
+     EXPECT_DOUBLE_EQ(linear.column(0)[3], 40.0);
+     EXPECT_DOUBLE_EQ(linear.column(0)[6], 70.0);
+     EXPECT_EQ(linear.gaps.size(), 2u);
+
+     ResampledFrame previous = resampler.frame(GapFill::Previous);
+     EXPECT_DOUBLE_EQ(previous.column(0)[3], 10.0);
+     EXPECT_DOUBLE_EQ(previous.column(0)[6], 60.0);
+
+     ResampledFrame limited = resampler.frame(GapFill::Linear, 1);
+     EXPECT_TRUE(std::isnan(limited.column(0)[2]));
+     EXPECT_DOUBLE_EQ(limited.column(0)[6], 70.0);
+ }
+
+ // Test dobowej siatki: wartością węzła jest średnia z doby
+ TEST(ResamplerTest, DailyStepAveragesDay) {
+     ResampledFrame frame = Resampler::resample(
+         {hourlySeries({{0, 10.0}, {12, 20.0}, {23, 30.0}, {24, 100.0}})}, {"SO2"}, ResampleStep::Day);
+     ASSERT_EQ(frame.rows(), 2u);
+     EXPECT_EQ(formatMeasurementDate(frame.timestamp(0)), "2025-04-26 00:00:00");
+     EXPECT_DOUBLE_EQ(frame.column(0)[0], 20.0);
+     EXPECT_DOUBLE_EQ(frame.column(0)[1], 100.0);
+ }
+
+ // Test przyrostowego dopisywania: powtórzone godziny są pomijane, nowe dopisywane
+ TEST(ResamplerTest, IncrementalAppendSkipsKnownHours) {
+     Resampler resampler;
+     const std::size_t pm10 = resampler.addColumn("PM10");
+     const std::size_t no2 = resampler.addColumn("NO2");
+     EXPECT_EQ(resampler.append(pm10, hourlySeries({{0, 1.0}, {1, 2.0}})), 2u);
+     EXPECT_EQ(resampler.append(no2, hourlySeries({{1, 5.0}})), 1u);
+
+     // Odpowiedź API po godzinie zawiera poprzednie pomiary i jeden nowy
+     EXPECT_EQ(resampler.append(pm10, hourlySeries({{2, 3.0}, {1, 2.0}, {0, 1.0}})), 1u);
+     EXPECT_EQ(resampler.append(pm10, hourlySeries({{2, 3.0}})), 0u);
+
+     ResampledFrame frame = resampler.frame();
+     ASSERT_EQ(frame.rows(), 3u);
+     EXPECT_DOUBLE_EQ(frame.column(pm10)[1], 2.0);
+     EXPECT_DOUBLE_EQ(frame.column(pm10)[2], 3.0);
+     EXPECT_TRUE(std::isnan(frame.column(no2)[2]));
+
+     // Nowa kolumna dostaje pełną długość siatki; starsze dane rozszerzają siatkę wstecz
+     const std::size_t o3 = resampler.addColumn("O3");
+     EXPECT_EQ(resampler.append(o3, hourlySeries({{-2, 9.0}})), 1u);
+     frame = resampler.frame();
+     ASSERT_EQ(frame.rows(), 5u);
+     EXPECT_DOUBLE_EQ(frame.column(o3)[0], 9.0);
+     EXPECT_DOUBLE_EQ(frame.column(pm10)[2], 1.0);
+
+     EXPECT_THROW(resampler.append(7, hourlySeries({{0, 1.0}})), std::runtime_error);
+ }
+
+ // Test korelacji kolumn z pominięciem braków
+ TEST(ResamplerTest, PearsonCorrelationSkipsMissing) {
+     const double nan = std::nan("");
+     const double a[] = {1.0, 2.0, nan, 4.0, 5.0};
+     const double b[] = {2.0, 4.0, 1.0, 8.0, nan};
+     const double c[] = {5.0, 4.0, 3.0, 2.0, 1.0};
+     EXPECT_NEAR(pearsonCorrelation(a, b, 5), 1.0, 1e-12);
+     EXPECT_NEAR(pearsonCorrelation(a, c, 5), -1.0, 1e-12);
+     EXPECT_TRUE(std::isnan(pearsonCorrelation(a, b, 1)));
+ }
+
+ // Main dla Google Test
+ int main(int argc, char **argv) {
+     ::testing::InitGoogleTest(&argc, argv);
+     return RUN_ALL_TESTS();
+ }
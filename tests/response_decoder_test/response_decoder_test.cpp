@@ -0,0 +1,153 @@
+/**
+ * @file response_decoder_test.cpp
+ * @brief Testy dekodera SAX odpowiedzi API (zgodność z dekodowaniem z drzewa JSON)
+ */
+
+ #include "response_decoder.hpp"
+ #include <gtest/gtest.h>
+ #include <fstream>
+ #include <sstream>
+ #include <stdexcept>
+ #include <string>
+
+ // Wczytuje nagraną odpowiedź API
+ static std::string readFixture(const std::string& relativePath) {
+     std::ifstream file(std::string(AIRQUALITY_FIXTURE_DIR) + "/" + relativePath);
+     std::stringstream buffer;
+     buffer << file.rdbuf();
+     return buffer.str();
+ }
+
+ // Test zgodności listy stacji z ApiClient::parseStations
+ TEST(ResponseDecoderTest, StationsMatchDomDecoder) {
+     std::string body = readFixture("station/findAll.json");
+     ASSERT_FALSE(body.empty()) << "Brak pliku z odpowiedzia";
+
+     std::vector<Station> expected = ApiClient::parseStations(json::parse(body));
+     DecodeStats stats;
+     std::vector<Station> actual = ResponseDecoder::decodeStations(body.data(), body.size(), &stats);
+
+     ASSERT_EQ(actual.size(), expected.size());
+     ASSERT_FALSE(actual.empty());
+     for (std::size_t i = 0; i < actual.size(); ++i) {
+         EXPECT_EQ(actual[i].id, expected[i].id);
+         EXPECT_EQ(actual[i].name, expected[i].name);
+         EXPECT_DOUBLE_EQ(actual[i].lat, expected[i].lat);
+         EXPECT_DOUBLE_EQ(actual[i].lon, expected[i].lon);
+         EXPECT_EQ(actual[i].city, expected[i].city);
+         EXPECT_EQ(actual[i].address, expected[i].address);
+         EXPECT_EQ(actual[i].province, expected[i].province);
+     }
+     EXPECT_EQ(actual.capacity(), actual.size()) << "Wynik powinien zajmowac dokladnie tyle pamieci, ile potrzeba";
+ }
+
+ // Test zgodności czujników z ApiClient::parseSensors
+ TEST(ResponseDecoderTest, SensorsMatchDomDecoder) {
+     std::string body = readFixture("station/sensors/default.json");
+     ASSERT_FALSE(body.empty()) << "Brak pliku z odpowiedzia";
+
+     std::vector<Sensor> expected = ApiClient::parseSensors(json::parse(body));
+     std::vector<Sensor> actual = ResponseDecoder::decodeSensors(body.data(), body.size());
+
+     ASSERT_EQ(actual.size(), expected.size());
+     ASSERT_FALSE(actual.empty());
+     for (std::size_t i = 0; i < actual.size(); ++i) {
+         EXPECT_EQ(actual[i].id, expected[i].id);
+         EXPECT_EQ(actual[i].stationId, expected[i].stationId);
+         EXPECT_EQ(actual[i].paramName, expected[i].paramName);
+         EXPECT_EQ(actual[i].paramFormula, expected[i].paramFormula);
+         EXPECT_EQ(actual[i].paramCode, expected[i].paramCode);
+         EXPECT_EQ(actual[i].paramId, expected[i].paramId);
+         EXPECT_EQ(actual[i].pollutant, expected[i].pollutant);
+         EXPECT_NE(actual[i].pollutant, Pollutant::Unknown);
+     }
+ }
+
+ // Test zgodności pomiarów z ApiClient::parseMeasurements (pomiary null są pomijane)
+ TEST(ResponseDecoderTest, MeasurementsMatchDomDecoder) {
+     std::string body = readFixture("data/getData/default.json");
+     ASSERT_FALSE(body.empty()) << "Brak pliku z odpowiedzia";
+
+     std::vector<Measurement> expected = ApiClient::parseMeasurements(json::parse(body));
+     std::vector<Measurement> actual = ResponseDecoder::decodeMeasurements(body.data(), body.size());
+
+     ASSERT_EQ(actual.size(), expected.size());
+     ASSERT_FALSE(actual.empty());
+     for (std::size_t i = 0; i < actual.size(); ++i) {
+         EXPECT_EQ(actual[i].date, expected[i].date);
+         EXPECT_DOUBLE_EQ(actual[i].value, expected[i].value);
+     }
+ }
+
+ // Test wartości zapisanych jako tekst, wartości niepoprawnych i zagnieżdżonych pól
+ TEST(ResponseDecoderTest, MeasurementEdgeCases) {
+     const std::string body = R"({
+         "key": "PM10",
+         "meta": {"values": [{"date": "ignorowane", "value": 1}]},
+         "values": [
+             {"date": "2025-04-26 12:00:00", "value": "12.5"},
+             {"date": "2025-04-26 11:00:00", "value": "brak"},
+             {"date": "2025-04-26 10:00:00", "value": null},
+             {"value": 3.0},
+             {"date": "2025-04-26 09:00:00", "value": 7}
+         ]
+     })";
+     std::vector<Measurement> measurements = ResponseDecoder::decodeMeasurements(body.data(), body.size());
+     ASSERT_EQ(measurements.size(), 2u);
+     EXPECT_EQ(measurements[0].date, "2025-04-26 12:00:00");
+     EXPECT_DOUBLE_EQ(measurements[0].value, 12.5);
+     EXPECT_EQ(measurements[1].date, "2025-04-26 09:00:00");
+     EXPECT_DOUBLE_EQ(measurements[1].value, 7.0);
+
+     const std::string noValues = R"({"key": "PM10"})";
+     EXPECT_TRUE(ResponseDecoder::decodeMeasurements(noValues.data(), noValues.size()).empty());
+ }
+
+ // Test stacji z brakującymi polami (null) i współrzędnymi zapisanymi jako liczby
+ TEST(ResponseDecoderTest, StationWithNullFields) {
+     const std::string body = R"([
+         {"id": 1, "stationName": "A", "gegrLat": "50.5", "gegrLon": 19.25,
+          "city": null, "addressStreet": null},
+         {"id": 2, "stationName": "B", "gegrLat": null, "gegrLon": null,
+          "city": {"id": 5, "name": "Kraków", "commune": null}, "addressStreet": "ul. Długa"}
+     ])";
+     std::vector<Station> stations = ResponseDecoder::decodeStations(body.data(), body.size());
+     ASSERT_EQ(stations.size(), 2u);
+     EXPECT_EQ(stations[0].id, 1);
+     EXPECT_DOUBLE_EQ(stations[0].lat, 50.5);
+     EXPECT_DOUBLE_EQ(stations[0].lon, 19.25);
+     EXPECT_TRUE(stations[0].city.empty());
+     EXPECT_TRUE(stations[0].address.empty());
+     EXPECT_EQ(stations[1].city, "Kraków");
+     EXPECT_TRUE(stations[1].province.empty());
+     EXPECT_EQ(stations[1].address, "ul. Długa");
+     EXPECT_DOUBLE_EQ(stations[1].lat, 0.0);
+ }
+
+ // Test odpowiedzi większej niż początkowy bufor areny
+ TEST(ResponseDecoderTest, LargeResponseOutgrowsInitialArena) {
+     std::string body = "{\"values\": [";
+     for (int i = 0; i < 5000; ++i) {
+         if (i > 0) body += ",";
+         body += "{\"date\": \"2025-01-01 " + std::to_string(i) + "\", \"value\": " + std::to_string(i) + "}";
+     }
+     body += "]}";
+     std::vector<Measurement> measurements = ResponseDecoder::decodeMeasurements(body.data(), body.size());
+     ASSERT_EQ(measurements.size(), 5000u);
+     EXPECT_EQ(measurements[4999].date, "2025-01-01 4999");
+     EXPECT_DOUBLE_EQ(measurements[4999].value, 4999.0);
+ }
+
+ // Test niepoprawnego JSON
+ TEST(ResponseDecoderTest, MalformedJsonThrows) {
+     const std::string body = R"([{"id": 1, "stationName": )";
+     EXPECT_THROW(ResponseDecoder::decodeStations(body.data(), body.size()), std::runtime_error);
+     EXPECT_THROW(ResponseDecoder::decodeSensors(body.data(), body.size()), std::runtime_error);
+     EXPECT_THROW(ResponseDecoder::decodeMeasurements(body.data(), body.size()), std::runtime_error);
+ }
+
+ // Main dla Google Test
+ int main(int argc, char **argv) {
+     ::testing::InitGoogleTest(&argc, argv);
+     return RUN_ALL_TESTS();
+ }
@@ -0,0 +1,109 @@
+/**
+ * @file series_codec_test.cpp
+ * @brief Testy kompresji serii pomiarowych
+ */
+
+ #include "series_codec.hpp"
+ #include <gtest/gtest.h>
+ #include <cmath>
+ #include <cstdint>
+ #include <cstring>
+ #include <iterator>
+ #include <limits>
+ #include <random>
+ #include <stdexcept>
+
+ // Porównanie bitowe (rozróżnia -0.0 i zachowuje NaN)
+ static void expectSameBits(const MeasurementSeries& actual, const MeasurementSeries& expected) {
+     ASSERT_EQ(actual.size(), expected.size());
+     EXPECT_EQ(actual.timestamps, expected.timestamps);
+     for (std::size_t i = 0; i < actual.size(); ++i) {
+         EXPECT_EQ(std::memcmp(&actual.values[i], &expected.values[i], sizeof(double)), 0) << "Indeks " << i;
+     }
+ }
+
+ // Rok pomiarów godzinowych z wartościami o dwóch miejscach po przecinku i kilkoma brakami godzin
+ static MeasurementSeries hourlyYear() {
+     std::mt19937 random(42);
+     std::normal_distribution<double> noise(0.0, 1.5);
+     MeasurementSeries series;
+     std::int64_t timestamp = parseMeasurementDate("2024-01-01 00:00:00");
+     double level = 20.0;
+     for (int i = 0; i < 8760; ++i) {
+         timestamp += (i % 500 == 499) ? 3 * 3600 : 3600;
+         level = std::max(0.0, level + noise(random));
+         series.append(timestamp, std::round(level * 100.0) / 100.0);
+     }
+     return series;
+ }
+
+ // Test bezstratności i stopnia kompresji dla typowej serii godzinowej
+ TEST(SeriesCodecTest, HourlySeriesRoundTrip) {
+     MeasurementSeries series = hourlyYear();
+     std::string block = SeriesCodec::encode(series);
+
+     EXPECT_EQ(SeriesCodec::valueEncoding(block.data(), block.size()), ValueEncoding::Decimal);
+     std::size_t consumed = 0;
+     MeasurementSeries decoded = SeriesCodec::decode(block.data(), block.size(), &consumed);
+     expectSameBits(decoded, series);
+     EXPECT_EQ(consumed, block.size());
+
+     // Eksport JSON zajmuje ok. 60 bajtów na pomiar
+     EXPECT_LT(block.size() * 20, series.size() * 60) << "Rozmiar bloku: " << block.size();
+ }
+
+ // Test wartości bez krótkiego zapisu dziesiętnego (kodowanie XOR) i wartości specjalnych
+ TEST(SeriesCodecTest, XorFallbackIsLossless) {
+     MeasurementSeries series;
+     const double special[] = {1.0 / 3.0, -0.0, 0.0, std::numeric_limits<double>::quiet_NaN(),
+                               std::numeric_limits<double>::infinity(), 1e300, -2.5, -2.5, 1.0 / 3.0};
+     std::int64_t timestamp = 1000;
+     for (double value : special) {
+         series.append(timestamp, value);
+         timestamp += 3600;
+     }
+     std::string block = SeriesCodec::encode(series);
+     EXPECT_EQ(SeriesCodec::valueEncoding(block.data(), block.size()), ValueEncoding::Xor);
+     expectSameBits(SeriesCodec::decode(block.data(), block.size()), series);
+ }
+
+ // Test nieregularnych, nieposortowanych i skrajnych znaczników czasu
+ TEST(SeriesCodecTest, IrregularTimestamps) {
+     MeasurementSeries series;
+     const std::int64_t timestamps[] = {5, -7, 1LL << 62, -(1LL << 62), 0, 0, 86400, 3,
+                                        INT64_MAX, INT64_MIN, INT64_MAX, -1, INT64_MIN};
+     for (std::size_t i = 0; i < std::size(timestamps); ++i) {
+         series.append(timestamps[i], static_cast<double>(i) * 0.5);
+     }
+     std::string block = SeriesCodec::encode(series);
+     expectSameBits(SeriesCodec::decode(block.data(), block.size()), series);
+ }
+
+ // Test krótkich serii i granic ramek
+ TEST(SeriesCodecTest, SmallAndFrameBoundarySizes) {
+     for (std::size_t count : {0u, 1u, 2u, 3u, 129u, 130u, 131u, 256u, 1000u}) {
+         MeasurementSeries series;
+         for (std::size_t i = 0; i < count; ++i) {
+             series.append(static_cast<std::int64_t>(i * 3600 + (i % 7)), static_cast<double>(i % 13) * 0.1);
+         }
+         std::string block = SeriesCodec::encode(series);
+         expectSameBits(SeriesCodec::decode(block.data(), block.size()), series);
+     }
+ }
+
+ // Test uszkodzonych bloków
+ TEST(SeriesCodecTest, CorruptedBlockThrows) {
+     std::string block = SeriesCodec::encode(hourlyYear());
+     EXPECT_THROW(SeriesCodec::decode(block.data(), 10), std::runtime_error);
+     EXPECT_THROW(SeriesCodec::decode(block.data(), block.size() - 9), std::runtime_error);
+
+     std::string badMagic = block;
+     badMagic[0] = 'X';
+     EXPECT_THROW(SeriesCodec::decode(badMagic.data(), badMagic.size()), std::runtime_error);
+ }
+
+ // Main dla Google Test
+ int main(int argc, char **argv) {
+     ::testing::InitGoogleTest(&argc, argv);
+     return RUN_ALL_TESTS();
+ }
@@ -0,0 +1,192 @@
+/**
+ * @file series_store_test.cpp
+ * @brief Testy archiwum pomiarów (dzienniki z segmentami i indeksem min/max)
+ */
+
+ #include "series_store.hpp"
+ #include <gtest/gtest.h>
+ #include <algorithm>
+ #include <cstdlib>
+ #include <fstream>
+ #include <stdexcept>
+
+ // Seria godzinowa od 2025-01-01 00:00:00: wartość i-tego pomiaru to i
+ static MeasurementSeries hourlySeries(std::size_t first, std::size_t count) {
+     const std::int64_t base = parseMeasurementDate("2025-01-01 00:00:00");
+     MeasurementSeries series;
+     for (std::size_t i = first; i < first + count; ++i) {
+         series.append(base + static_cast<std::int64_t>(i) * 3600, static_cast<double>(i));
+     }
+     return series;
+ }
+
+ // Klasa testowa dla SeriesStore
+ class SeriesStoreTest : public ::testing::Test {
+ protected:
+     // Konfiguracja przed każdym testem
+     void SetUp() override {
+         testDir = "test_data_series_store";
+         system(("rm -rf " + testDir).c_str());
+     }
+
+     // Sprzątanie po każdym teście
+     void TearDown() override {
+         system(("rm -rf " + testDir).c_str());
+     }
+
+     std::string testDir;
+ };
+
+ // Test zapisu w wielu segmentach i odczytu zakresu
+ TEST_F(SeriesStoreTest, AppendsAcrossSegments) {
+     SeriesStore store(testDir, 16);
+     StoreMergeResult result = store.merge(1, hourlySeries(0, 40));
+     EXPECT_EQ(result.appended, 40u);
+
+     std::vector<SegmentHeader> segments = store.segments(1);
+     ASSERT_EQ(segments.size(), 3u);
+     EXPECT_EQ(segments[0].count, 16u);
+     EXPECT_EQ(segments[2].count, 8u);
+     EXPECT_DOUBLE_EQ(segments[1].minValue, 16.0);
+     EXPECT_DOUBLE_EQ(segments[1].maxValue, 31.0);
+     EXPECT_EQ(segments[1].firstTime, hourlySeries(16, 1).timestamps[0]);
+
+     MeasurementSeries all = store.scan(1);
+     ASSERT_EQ(all.size(), 40u);
+     EXPECT_DOUBLE_EQ(all.values[39], 39.0);
+
+     // Zakres przechodzący przez granicę segmentów
+     const MeasurementSeries bounds = hourlySeries(10, 20);
+     MeasurementSeries range = store.scan(1, bounds.timestamps.front(), bounds.timestamps.back());
+     ASSERT_EQ(range.size(), 20u);
+     EXPECT_EQ(range.timestamps, bounds.timestamps);
+     EXPECT_EQ(range.values, bounds.values);
+
+     EXPECT_TRUE(store.scan(1, 0, 10).empty());
+     EXPECT_TRUE(store.scan(2).empty()) << "Brak dziennika to pusta seria";
+ }
+
+ // Test deduplikacji przy scalaniu kolejnych, nakładających się odpowiedzi getData
+ TEST_F(SeriesStoreTest, MergeDeduplicatesByTimestamp) {
+     SeriesStore store(testDir, 16);
+     store.merge(7, hourlySeries(0, 10));
+
+     // Kolejna odpowiedź w odwrotnej kolejności, pokrywa 6 zapisanych godzin i dodaje 5 nowych
+     MeasurementSeries response = hourlySeries(4, 11);
+     std::reverse(response.timestamps.begin(), response.timestamps.end());
+     std::reverse(response.values.begin(), response.values.end());
+     StoreMergeResult result = store.merge(7, response);
+     EXPECT_EQ(result.appended, 5u);
+     EXPECT_EQ(result.duplicates, 6u);
+     EXPECT_EQ(result.late, 0u);
+
+     StoreMergeResult again = store.merge(7, response);
+     EXPECT_EQ(again.appended, 0u);
+     EXPECT_EQ(again.duplicates, 11u);
+
+     MeasurementSeries all = store.scan(7);
+     ASSERT_EQ(all.size(), 15u);
+     for (std::size_t i = 0; i < all.size(); ++i) {
+         EXPECT_DOUBLE_EQ(all.values[i], static_cast<double>(i));
+     }
+
+     // Archiwum otwarte ponownie z inną pojemnością zachowuje układ istniejącego dziennika
+     SeriesStore reopened(testDir, 1000);
+     EXPECT_EQ(reopened.merge(7, hourlySeries(15, 2)).appended, 2u);
+     EXPECT_EQ(reopened.segments(7).size(), 2u);
+     EXPECT_EQ(reopened.scan(7).size(), 17u);
+ }
+
+ // Test pomiarów starszych niż koniec dziennika, których w nim brak
+ TEST_F(SeriesStoreTest, LateMeasurementsAreReported) {
+     SeriesStore store(testDir, 16);
+     MeasurementSeries withHole = hourlySeries(0, 3);
+     withHole.append(hourlySeries(5, 1).timestamps[0], 5.0);
+     store.merge(3, withHole);
+
+     StoreMergeResult result = store.merge(3, hourlySeries(3, 4));
+     EXPECT_EQ(result.late, 2u);
+     EXPECT_EQ(result.duplicates, 1u);
+     EXPECT_EQ(result.appended, 1u);
+     EXPECT_EQ(store.scan(3).size(), 5u);
+ }
+
+ // Test segmentu zarezerwowanego na końcu dziennika, którego nagłówek nie został zapisany
+ TEST_F(SeriesStoreTest, UnwrittenTrailingSegmentIsReused) {
+     SeriesStore store(testDir, 4);
+     store.merge(6, hourlySeries(0, 2));
+     {
+         // Zapis przerwany po zarezerwowaniu miejsca na kolejny segment
+         std::ofstream file(store.logPath(6), std::ios::binary | std::ios::app);
+         const std::string empty(sizeof(SegmentHeader) + 4 * (sizeof(std::int64_t) + sizeof(double)), '\0');
+         file.write(empty.data(), static_cast<std::streamsize>(empty.size()));
+     }
+     store.merge(6, hourlySeries(0, 4));
+
+     StoreMergeResult result = store.merge(6, hourlySeries(2, 4));
+     EXPECT_EQ(result.appended, 2u);
+     EXPECT_EQ(result.duplicates, 2u);
+     EXPECT_EQ(result.late, 0u);
+     MeasurementSeries all = store.scan(6);
+     ASSERT_EQ(all.size(), 6u);
+     EXPECT_EQ(all.timestamps, hourlySeries(0, 6).timestamps);
+     std::vector<SegmentHeader> segments = store.segments(6);
+     ASSERT_EQ(segments.size(), 2u);
+     EXPECT_EQ(segments[1].magic, segments[0].magic);
+     EXPECT_EQ(segments[1].count, 2u);
+ }
+
+ // Test wstawiania pomiarów spóźnionych (przebudowa dziennika)
+ TEST_F(SeriesStoreTest, BackfillInsertsLateMeasurements) {
+     SeriesStore store(testDir, 16);
+     store.merge(4, hourlySeries(30, 20));
+
+     MeasurementSeries older = hourlySeries(0, 35);
+     older.values[32] = -1.0;  // zapisany pomiar nie jest nadpisywany
+     StoreMergeResult result = store.backfill(4, older);
+     EXPECT_EQ(result.appended, 30u);
+     EXPECT_EQ(result.duplicates, 5u);
+     EXPECT_EQ(result.late, 0u);
+
+     MeasurementSeries all = store.scan(4);
+     ASSERT_EQ(all.size(), 50u);
+     for (std::size_t i = 0; i < all.size(); ++i) {
+         EXPECT_DOUBLE_EQ(all.values[i], static_cast<double>(i));
+     }
+     EXPECT_EQ(store.segments(4).size(), 4u);
+     EXPECT_EQ(store.backfill(4, hourlySeries(50, 1)).appended, 1u) << "Bez spoznionych pomiarow dziala jak merge";
+ }
+
+ // Test zapytania progowego z pomijaniem segmentów
+ TEST_F(SeriesStoreTest, ScanAboveThreshold) {
+     SeriesStore store(testDir, 16);
+     store.merge(5, hourlySeries(0, 64));
+
+     MeasurementSeries above = store.scanAbove(5, 45.5);
+     ASSERT_EQ(above.size(), 18u);
+     EXPECT_DOUBLE_EQ(above.values.front(), 46.0);
+
+     const MeasurementSeries bounds = hourlySeries(0, 50);
+     MeasurementSeries limited = store.scanAbove(5, 45.5, bounds.timestamps.front(), bounds.timestamps.back());
+     EXPECT_EQ(limited.size(), 4u);
+     EXPECT_TRUE(store.scanAbove(5, 100.0).empty());
+ }
+
+ // Test uszkodzonego pliku dziennika
+ TEST_F(SeriesStoreTest, CorruptedLogThrows) {
+     SeriesStore store(testDir);
+     store.merge(9, hourlySeries(0, 2));
+     {
+         std::ofstream file(store.logPath(9), std::ios::binary | std::ios::trunc);
+         file << "to nie jest dziennik";
+     }
+     EXPECT_THROW(store.scan(9), std::runtime_error);
+     EXPECT_THROW(store.merge(9, hourlySeries(2, 1)), std::runtime_error);
+     EXPECT_THROW(SeriesStore(testDir, 0), std::runtime_error);
+ }
+
+ // Main dla Google Test
+ int main(int argc, char **argv) {
+     ::testing::InitGoogleTest(&argc, argv);
+     return RUN_ALL_TESTS();
+ }
@@ -0,0 +1,126 @@
+/**
+ * @file string_pool_test.cpp
+ * @brief Testy puli internowanych napisów z wykorzystaniem Google Test
+ */
+
+ #include "api_client.hpp"
+ #include "string_pool.hpp"
+ #include <gtest/gtest.h>
+ #include <set>
+ #include <thread>
+ #include <unordered_map>
+ #include <vector>
+
+ // Test wspólnej kopii dla równych napisów
+ TEST(StringPoolTest, EqualStringsShareEntry) {
+     InternedString a("mazowieckie");
+     InternedString b(std::string("mazowieckie"));
+     InternedString c(std::string_view("małopolskie"));
+
+     EXPECT_EQ(a, b);
+     EXPECT_EQ(&a.str(), &b.str()) << "Rowne napisy powinny wskazywac ten sam wpis puli";
+     EXPECT_EQ(a.id(), b.id());
+     EXPECT_NE(a, c);
+     EXPECT_EQ(std::hash<InternedString>()(a), std::hash<InternedString>()(b));
+
+     EXPECT_EQ(a, "mazowieckie");
+     EXPECT_EQ(a, std::string("mazowieckie"));
+     EXPECT_EQ(a.size(), 11u);
+     EXPECT_STREQ(a.c_str(), "mazowieckie");
+ }
+
+ // Test pustego napisu i porządku leksykograficznego
+ TEST(StringPoolTest, EmptyAndOrdering) {
+     InternedString empty;
+     EXPECT_TRUE(empty.empty());
+     EXPECT_EQ(empty, InternedString(""));
+
+     std::set<InternedString> provinces = {"śląskie", "lubelskie", "dolnośląskie", "lubelskie"};
+     ASSERT_EQ(provinces.size(), 3u);
+     EXPECT_EQ(*provinces.begin(), "dolnośląskie");
+     EXPECT_EQ(*provinces.rbegin(), "śląskie");
+ }
+
+ // Test wzrostu puli tylko o nowe wartości
+ TEST(StringPoolTest, PoolGrowsOnlyForNewValues) {
+     StringPool& pool = StringPool::instance();
+     InternedString("Test-Pula-1");
+     const std::size_t size = pool.size();
+     const std::size_t bytes = pool.bytes();
+     for (int i = 0; i < 100; ++i) {
+         InternedString("Test-Pula-1");
+     }
+     EXPECT_EQ(pool.size(), size);
+     InternedString("Test-Pula-2");
+     EXPECT_EQ(pool.size(), size + 1);
+     EXPECT_EQ(pool.bytes(), bytes + 11);
+ }
+
+ // Test równoczesnego internowania z wielu wątków
+ TEST(StringPoolTest, ConcurrentInterning) {
+     const int threadCount = 8;
+     std::vector<std::vector<InternedString>> results(threadCount);
+     std::vector<std::thread> threads;
+     for (int t = 0; t < threadCount; ++t) {
+         threads.emplace_back([&results, t]() {
+             for (int i = 0; i < 1000; ++i) {
+                 results[t].emplace_back("Miasto-" + std::to_string(i % 50));
+             }
+         });
+     }
+     for (auto& thread : threads) {
+         thread.join();
+     }
+     for (int t = 1; t < threadCount; ++t) {
+         for (std::size_t i = 0; i < results[t].size(); ++i) {
+             ASSERT_EQ(&results[t][i].str(), &results[0][i].str());
+         }
+     }
+ }
+
+ // Test serializacji pól internowanych do JSON i z powrotem
+ TEST(StringPoolTest, JsonRoundTrip) {
+     Station station{};
+     station.city = "Kraków";
+     station.province = "małopolskie";
+
+     json stationJson;
+     stationJson["city"] = station.city;
+     stationJson["province"] = station.province;
+     EXPECT_EQ(stationJson.dump(), "{\"city\":\"Kraków\",\"province\":\"małopolskie\"}");
+
+     Station fromJson{};
+     fromJson.city = stationJson["city"];
+     fromJson.province = stationJson["province"].get<InternedString>();
+     EXPECT_EQ(fromJson.city, station.city);
+     EXPECT_EQ(fromJson.province, station.province);
+ }
+
+ // Test grupowania stacji po województwie z kluczem internowanym
+ TEST(StringPoolTest, GroupStationsByProvince) {
+     json response = json::parse(R"([
+         {"id": 1, "stationName": "A", "gegrLat": "50.0", "gegrLon": "19.9", "addressStreet": null,
+          "city": {"name": "Kraków", "commune": {"provinceName": "MAŁOPOLSKIE"}}},
+         {"id": 2, "stationName": "B", "gegrLat": "50.1", "gegrLon": "20.0", "addressStreet": null,
+          "city": {"name": "Kraków", "commune": {"provinceName": "MAŁOPOLSKIE"}}},
+         {"id": 3, "stationName": "C", "gegrLat": "52.2", "gegrLon": "21.0", "addressStreet": null,
+          "city": {"name": "Warszawa", "commune": {"provinceName": "MAZOWIECKIE"}}}
+     ])");
+     std::vector<Station> stations = ApiClient::parseStations(response);
+     ASSERT_EQ(stations.size(), 3u);
+     EXPECT_EQ(&stations[0].city.str(), &stations[1].city.str());
+
+     std::unordered_map<InternedString, int> perProvince;
+     for (const auto& station : stations) {
+         ++perProvince[station.province];
+     }
+     EXPECT_EQ(perProvince.size(), 2u);
+     EXPECT_EQ(perProvince[InternedString("MAŁOPOLSKIE")], 2);
+     EXPECT_EQ(perProvince[InternedString("MAZOWIECKIE")], 1);
+ }
+
+ // Main dla Google Test
+ int main(int argc, char **argv) {
+     ::testing::InitGoogleTest(&argc, argv);
+     return RUN_ALL_TESTS();
+ }
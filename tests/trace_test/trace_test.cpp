@@ -0,0 +1,156 @@
+/**
+ * @file trace_test.cpp
+ * @brief Testy śledzenia zakresów i zapisu w formacie Chrome trace-event z wykorzystaniem Google Test
+ */
+
+ #include "trace.hpp"
+ #include <nlohmann/json.hpp>
+ #include <gtest/gtest.h>
+ #include <chrono>
+ #include <cstdio>
+ #include <fstream>
+ #include <set>
+ #include <thread>
+ #include <vector>
+
+ using json = nlohmann::json;
+
+ // Zdarzenia typu "X" (zakończone zakresy) z pliku śladu
+ std::vector<json> completeEvents(const json& trace) {
+     std::vector<json> events;
+     for (const auto& event : trace["traceEvents"]) {
+         if (event["ph"] == "X") {
+             events.push_back(event);
+         }
+     }
+     return events;
+ }
+
+ // Klasa testowa czyszcząca bufory przed każdym testem
+ class TraceTest : public ::testing::Test {
+ protected:
+     void SetUp() override {
+         Tracer::enable();
+         Tracer::clear();
+     }
+
+     void TearDown() override {
+         Tracer::disable();
+         Tracer::clear();
+     }
+ };
+
+ // Test braku zdarzeń przy wyłączonym śledzeniu
+ TEST_F(TraceTest, DisabledRecordsNothing) {
+     Tracer::disable();
+     bool detailEvaluated = false;
+     {
+         TRACE_SCOPE("disabled");
+         TRACE_SCOPE_DETAIL("disabledDetail", (detailEvaluated = true, std::string("x")));
+     }
+     EXPECT_EQ(Tracer::eventCount(), 0u);
+     EXPECT_FALSE(detailEvaluated) << "Opis nie powinien byc obliczany przy wylaczonym sledzeniu";
+ }
+
+ // Test zagnieżdżonych zakresów i opisu
+ TEST_F(TraceTest, NestedScopesProduceCompleteEvents) {
+     {
+         TRACE_SCOPE_DETAIL("outer", "stationId=11");
+         {
+             TRACE_SCOPE("inner");
+             std::this_thread::sleep_for(std::chrono::milliseconds(2));
+         }
+     }
+     ASSERT_EQ(Tracer::eventCount(), 2u);
+
+     json trace = json::parse(Tracer::toChromeTrace());
+     std::vector<json> events = completeEvents(trace);
+     ASSERT_EQ(events.size(), 2u);
+
+     // Zakres wewnętrzny kończy się pierwszy
+     EXPECT_EQ(events[0]["name"], "inner");
+     EXPECT_EQ(events[1]["name"], "outer");
+     EXPECT_EQ(events[1]["args"]["detail"], "stationId=11");
+     EXPECT_GE(events[0]["dur"].get<std::uint64_t>(), 2000u);
+
+     // Zakres zewnętrzny obejmuje wewnętrzny
+     std::uint64_t outerStart = events[1]["ts"];
+     std::uint64_t outerEnd = outerStart + events[1]["dur"].get<std::uint64_t>();
+     std::uint64_t innerStart = events[0]["ts"];
+     std::uint64_t innerEnd = innerStart + events[0]["dur"].get<std::uint64_t>();
+     EXPECT_LE(outerStart, innerStart);
+     EXPECT_GE(outerEnd, innerEnd);
+ }
+
+ // Test buforów wielu wątków i nazw wątków
+ TEST_F(TraceTest, ThreadsHaveSeparateBuffers) {
+     std::vector<std::thread> threads;
+     for (int t = 0; t < 3; ++t) {
+         threads.emplace_back([t]() {
+             Tracer::setThreadName("worker-" + std::to_string(t));
+             for (int i = 0; i < 10; ++i) {
+                 TRACE_SCOPE("work");
+             }
+         });
+     }
+     for (auto& thread : threads) {
+         thread.join();
+     }
+
+     json trace = json::parse(Tracer::toChromeTrace());
+     std::set<int> threadIds;
+     for (const auto& event : completeEvents(trace)) {
+         threadIds.insert(event["tid"].get<int>());
+     }
+     EXPECT_EQ(threadIds.size(), 3u);
+     EXPECT_EQ(Tracer::eventCount(), 30u);
+
+     std::set<std::string> names;
+     for (const auto& event : trace["traceEvents"]) {
+         if (event["ph"] == "M") {
+             names.insert(event["args"]["name"].get<std::string>());
+         }
+     }
+     EXPECT_EQ(names.count("worker-1"), 1u);
+ }
+
+ // Test nadpisywania najstarszych zdarzeń po zapełnieniu bufora
+ TEST_F(TraceTest, RingBufferKeepsNewestEvents) {
+     Tracer::enable(std::string(), 8);
+     std::thread worker([]() {
+         for (int i = 0; i < 20; ++i) {
+             TRACE_SCOPE_DETAIL("event", std::to_string(i));
+         }
+     });
+     worker.join();
+     Tracer::enable();
+
+     json trace = json::parse(Tracer::toChromeTrace());
+     std::vector<json> events = completeEvents(trace);
+     ASSERT_EQ(events.size(), 8u);
+     EXPECT_EQ(events.front()["args"]["detail"], "12");
+     EXPECT_EQ(events.back()["args"]["detail"], "19");
+ }
+
+ // Test zapisu pliku śladu
+ TEST_F(TraceTest, WriteChromeTraceFile) {
+     {
+         TRACE_SCOPE_DETAIL("ApiClient::makeRequest", "/station/findAll \"quoted\"");
+     }
+     const std::string path = "test_trace.json";
+     ASSERT_TRUE(Tracer::writeChromeTrace(path));
+
+     std::ifstream file(path);
+     json trace = json::parse(file);
+     EXPECT_EQ(trace["displayTimeUnit"], "ms");
+     std::vector<json> events = completeEvents(trace);
+     ASSERT_EQ(events.size(), 1u);
+     EXPECT_EQ(events[0]["args"]["detail"], "/station/findAll \"quoted\"");
+     std::remove(path.c_str());
+ }
+
+ // Main dla Google Test
+ int main(int argc, char **argv) {
+     ::testing::InitGoogleTest(&argc, argv);
+     return RUN_ALL_TESTS();
+ }
@@ -0,0 +1,387 @@
+/**
+ * @file archiver.cpp
+ * @brief Narzędzie wsadowe archiwizujące wszystkie dane GIOŚ bez interfejsu graficznego
+ *
+ * Program pobiera listę stacji, czujniki wszystkich stacji i pomiary wszystkich
+ * czujników równolegle (z ograniczoną liczbą wątków i limitem zapytań na sekundę),
+ * a następnie scala je z lokalnym archiwum (SeriesStore - dziennik na czujnik). Pomiary
+ * przechodzą przez potok FetchPipeline, więc oczekiwanie na API nakłada się na dekodowanie
+ * i zapis, a na koniec wypisywana jest zajętość etapów. Postęp jest zapisywany
+ * w pliku progress.json, dzięki czemu przerwany przebieg można wznowić opcją --resume.
+ *
+ * Opcja --import zamiast pobierania z API importuje do archiwum drzewo zapisanych plików
+ * z pomiarami (ArchiveImporter), równolegle na wszystkich rdzeniach.
+ */
+
+#include "api_client.hpp"
+#include "archive_importer.hpp"
+#include "fetch_pipeline.hpp"
+#include "measurement_series.hpp"
+#include "series_store.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/stat.h>
+
+namespace {
+
+/**
+ * @brief Opcje uruchomienia archiwizatora
+ */
+struct ArchiverOptions {
+    std::string outputDir = "../archive"; ///< Katalog archiwum
+    int jobs = 0;                         ///< Liczba wątków (0 - 8 zapytań lub wszystkie rdzenie przy imporcie)
+    double rate = 10.0;                   ///< Maksymalna liczba zapytań na sekundę
+    bool resume = false;                  ///< Wznowienie przerwanego przebiegu
+    bool verbose = false;                 ///< Komunikaty ApiClient
+    std::string metricsFile;              ///< Plik na metryki w formacie Prometheus (pusty - brak)
+    std::string importDir;                ///< Katalog z plikami eksportu do zaimportowania (pusty - pobieranie z API)
+};
+
+/**
+ * @brief Ogranicznik liczby zapytań (równe odstępy między zapytaniami)
+ */
+class RateLimiter {
+public:
+    explicit RateLimiter(double requestsPerSecond)
+        : interval(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(requestsPerSecond > 0 ? 1.0 / requestsPerSecond : 0.0))),
+          nextSlot(std::chrono::steady_clock::now()) {}
+
+    /**
+     * @brief Czeka na kolejny wolny termin wykonania zapytania
+     */
+    void acquire() {
+        std::chrono::steady_clock::time_point slot;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            slot = std::max(nextSlot, std::chrono::steady_clock::now());
+            nextSlot = slot + interval;
+        }
+        std::this_thread::sleep_until(slot);
+    }
+
+private:
+    std::mutex mutex;
+    std::chrono::steady_clock::duration interval;
+    std::chrono::steady_clock::time_point nextSlot;
+};
+
+/**
+ * @brief Postęp przebiegu zapisywany w pliku progress.json
+ */
+class ProgressTracker {
+public:
+    explicit ProgressTracker(const std::string& path) : path(path) {}
+
+    /**
+     * @brief Wczytuje postęp poprzedniego przebiegu
+     * @return true jeśli plik postępu istniał
+     */
+    bool load() {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            return false;
+        }
+        try {
+            json progress;
+            file >> progress;
+            completedStations = progress.value("completedStations", std::set<int>());
+            completedSensors = progress.value("completedSensors", std::set<int>());
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Uszkodzony plik postepu (" << e.what() << "), rozpoczynam od nowa" << std::endl;
+            return false;
+        }
+    }
+
+    bool isStationCompleted(int stationId) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return completedStations.count(stationId) > 0;
+    }
+
+    bool isSensorCompleted(int sensorId) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return completedSensors.count(sensorId) > 0;
+    }
+
+    void markStation(int stationId) {
+        std::lock_guard<std::mutex> lock(mutex);
+        completedStations.insert(stationId);
+    }
+
+    /**
+     * @brief Oznacza czujnik jako zarchiwizowany i co pewien czas zapisuje postęp
+     */
+    void markSensor(int sensorId) {
+        std::lock_guard<std::mutex> lock(mutex);
+        completedSensors.insert(sensorId);
+        if (++unsavedChanges >= 25) {
+            saveLocked();
+        }
+    }
+
+    void save() {
+        std::lock_guard<std::mutex> lock(mutex);
+        saveLocked();
+    }
+
+private:
+    std::string path;
+    mutable std::mutex mutex;
+    std::set<int> completedStations;
+    std::set<int> completedSensors;
+    int unsavedChanges = 0;
+
+    // Zapis przez plik tymczasowy, aby przerwanie programu nie uszkodziło postępu
+    void saveLocked() {
+        json progress;
+        progress["completedStations"] = completedStations;
+        progress["completedSensors"] = completedSensors;
+
+        std::string tmpPath = path + ".tmp";
+        {
+            std::ofstream file(tmpPath);
+            if (!file.is_open()) {
+                std::cerr << "Nie mozna zapisac postepu: " << tmpPath << std::endl;
+                return;
+            }
+            file << progress.dump();
+        }
+        std::rename(tmpPath.c_str(), path.c_str());
+        unsavedChanges = 0;
+    }
+};
+
+/**
+ * @brief Wykonuje funkcję dla indeksów [0, count) na ograniczonej liczbie wątków
+ */
+template <typename Function>
+void parallelFor(std::size_t count, int jobs, Function function) {
+    std::atomic<std::size_t> nextIndex{0};
+    std::vector<std::thread> workers;
+    int workerCount = std::max(1, std::min<int>(jobs, static_cast<int>(count)));
+    for (int w = 0; w < workerCount; ++w) {
+        workers.emplace_back([&]() {
+            for (std::size_t i = nextIndex++; i < count; i = nextIndex++) {
+                function(i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void printUsage(const char* program) {
+    std::cout << "Uzycie: " << program << " [opcje]\n"
+              << "  --output KATALOG  katalog archiwum (domyslnie ../archive)\n"
+              << "  --jobs N          liczba rownoleglych zapytan (domyslnie 8; przy imporcie liczba rdzeni)\n"
+              << "  --rate R          maksymalna liczba zapytan na sekunde (domyslnie 10)\n"
+              << "  --resume          wznowienie przerwanego przebiegu\n"
+              << "  --metrics PLIK    zapis metryk zapytan w formacie Prometheus\n"
+              << "  --import KATALOG  import zapisanych plikow z pomiarami (.json, .aqz, .jsonl) zamiast pobierania\n"
+              << "  --verbose         komunikaty klienta API\n";
+}
+
+bool parseOptions(int argc, char* argv[], ArchiverOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--output" && hasValue) {
+            options.outputDir = argv[++i];
+        } else if (arg == "--jobs" && hasValue) {
+            options.jobs = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--rate" && hasValue) {
+            options.rate = std::atof(argv[++i]);
+        } else if (arg == "--resume") {
+            options.resume = true;
+        } else if (arg == "--metrics" && hasValue) {
+            options.metricsFile = argv[++i];
+        } else if (arg == "--import" && hasValue) {
+            options.importDir = argv[++i];
+        } else if (arg == "--verbose") {
+            options.verbose = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Importuje zapisane pliki z pomiarami do archiwum i wypisuje podsumowanie
+ * @return Kod wyjścia programu
+ */
+int runImport(const ArchiverOptions& options) {
+    SeriesStore store(options.outputDir);
+    ArchiveImporter importer(store, options.outputDir + "/import_index.json");
+    ImportReport report;
+    try {
+        report = importer.importDirectory(options.importDir, options.jobs);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    for (const auto& error : report.errors) {
+        std::cerr << error << std::endl;
+    }
+    const double seconds = std::max(report.seconds, 1e-9);
+    std::cout << "Zaimportowano " << report.imported << "/" << report.files << " plikow ("
+              << report.unchanged << " bez zmian, " << report.skipped << " bez czujnika, "
+              << report.failed << " bledow) w " << report.seconds << " s\n"
+              << "Czujniki: " << report.sensors << ", pomiary: " << report.measurements
+              << " (" << report.appended << " nowych, " << report.duplicates << " powtorzonych)\n"
+              << "Przepustowosc: " << static_cast<double>(report.imported + report.skipped) / seconds << " plikow/s, "
+              << static_cast<double>(report.bytes) / seconds / 1e6 << " MB/s, "
+              << static_cast<double>(report.measurements) / seconds << " pomiarow/s" << std::endl;
+    return report.failed == 0 ? 0 : 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ArchiverOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+#ifdef _WIN32
+    mkdir(options.outputDir.c_str());
+#else
+    mkdir(options.outputDir.c_str(), 0755);
+#endif
+
+    if (!options.importDir.empty()) {
+        return runImport(options);
+    }
+    if (options.jobs == 0) {
+        options.jobs = 8;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    ApiClient client;
+    client.setVerbose(options.verbose);
+    RateLimiter limiter(options.rate);
+
+    SeriesStore store(options.outputDir);
+    ProgressTracker progress(options.outputDir + "/progress.json");
+    if (options.resume && progress.load()) {
+        std::cout << "Wznawianie poprzedniego przebiegu" << std::endl;
+    }
+
+    // Etap 1: lista stacji
+    limiter.acquire();
+    std::vector<Station> stations = client.getAllStations();
+    if (stations.empty()) {
+        std::cerr << "Nie udalo sie pobrac listy stacji" << std::endl;
+        return 1;
+    }
+    std::cout << "Liczba stacji: " << stations.size() << std::endl;
+
+    // Etap 2: czujniki wszystkich nieukończonych stacji
+    std::vector<std::vector<Sensor>> stationSensors(stations.size());
+    parallelFor(stations.size(), options.jobs, [&](std::size_t i) {
+        if (progress.isStationCompleted(stations[i].id)) {
+            return;
+        }
+        limiter.acquire();
+        stationSensors[i] = client.getSensors(stations[i].id);
+    });
+
+    struct SensorTask {
+        std::size_t stationIndex;
+        int sensorId;
+    };
+    std::vector<SensorTask> tasks;
+    std::vector<std::atomic<int>> remainingPerStation(stations.size());
+    for (std::size_t i = 0; i < stations.size(); ++i) {
+        int remaining = 0;
+        for (const auto& sensor : stationSensors[i]) {
+            if (!progress.isSensorCompleted(sensor.id)) {
+                tasks.push_back({i, sensor.id});
+                ++remaining;
+            }
+        }
+        remainingPerStation[i] = remaining;
+        if (remaining == 0 && !stationSensors[i].empty()) {
+            progress.markStation(stations[i].id);
+        }
+    }
+    std::cout << "Czujniki do pobrania: " << tasks.size() << std::endl;
+
+    // Etap 3: pomiary wszystkich czujników w potoku pobieranie -> dekodowanie -> zapis -> postęp
+    std::size_t archivedSensors = 0;
+    std::size_t failedSensors = 0;
+    std::size_t appendedPoints = 0;
+
+    std::vector<int> sensorIds;
+    std::unordered_map<int, std::size_t> stationOfSensor;
+    for (const auto& task : tasks) {
+        sensorIds.push_back(task.sensorId);
+        stationOfSensor[task.sensorId] = task.stationIndex;
+    }
+
+    PipelineOptions pipelineOptions;
+    pipelineOptions.maxInFlight = options.jobs;
+    pipelineOptions.useCache = false;
+    pipelineOptions.throttle = [&limiter] { limiter.acquire(); };
+    FetchPipeline pipeline(client, pipelineOptions);
+
+    // Zapis w jednym wątku potoku, równolegle z pobieraniem i dekodowaniem kolejnych czujników
+    pipeline.setStoreStage([&](PipelineItem& item) {
+        // Pusta odpowiedź może oznaczać błąd - czujnik zostanie ponowiony przy wznowieniu
+        if (item.measurements.empty()) {
+            throw std::runtime_error("Brak pomiarow czujnika " + std::to_string(item.sensorId));
+        }
+        appendedPoints += store.merge(item.sensorId, std::move(item.series)).appended;
+
+        progress.markSensor(item.sensorId);
+        const std::size_t stationIndex = stationOfSensor.at(item.sensorId);
+        if (--remainingPerStation[stationIndex] == 0) {
+            progress.markStation(stations[stationIndex].id);
+        }
+    });
+
+    pipeline.setPublishStage([&](PipelineItem& item) {
+        if (!item.error.empty()) {
+            std::cerr << item.error << std::endl;
+            ++failedSensors;
+            return;
+        }
+        if (++archivedSensors % 50 == 0) {
+            std::cout << "Zarchiwizowano " << archivedSensors << "/" << tasks.size() << " czujnikow" << std::endl;
+        }
+    });
+
+    PipelineReport pipelineReport = pipeline.run(sensorIds);
+
+    progress.save();
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "Zakonczono w " << elapsed << " s: "
+              << archivedSensors << " czujnikow, "
+              << appendedPoints << " nowych pomiarow, "
+              << failedSensors << " bledow/brakow danych" << std::endl;
+    std::cout << "Potok: " << pipelineReport.summary() << std::endl;
+
+    if (!options.metricsFile.empty() && !client.getMetrics().writePrometheus(options.metricsFile)) {
+        std::cerr << "Nie udalo sie zapisac metryk do pliku: " << options.metricsFile << std::endl;
+    }
+
+    return failedSensors == 0 ? 0 : 2;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file mock_gios.cpp
+ * @brief Narzędzie uruchamiające lokalny serwer zastępczy API GIOŚ
+ *
+ * Pozwala uruchamiać aplikację, testy i benchmarki bez dostępu do api.gios.gov.pl:
+ *   airquality-mock-gios --port 8090 --latency-ms 40 --jitter-ms 20 --error-rate 0.01
+ *   AIRQUALITY_API_URL=http://127.0.0.1:8090 ./AirQualityApp
+ */
+
+#include "mock_gios_server.hpp"
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+MockGiosServer* activeServer = nullptr;
+
+void handleSignal(int) {
+    if (activeServer) {
+        activeServer->requestStop();
+    }
+}
+
+void printUsage(const char* program) {
+    std::cout << "Uzycie: " << program << " [opcje]\n"
+              << "  --host ADRES          adres nasluchiwania (domyslnie 127.0.0.1)\n"
+              << "  --port PORT           port nasluchiwania (domyslnie 8090)\n"
+              << "  --fixtures KATALOG    katalog z nagranymi odpowiedziami API\n"
+              << "  --latency-ms MS       stale opoznienie odpowiedzi\n"
+              << "  --jitter-ms MS        srednie losowe opoznienie dodatkowe (rozklad wykladniczy)\n"
+              << "  --bandwidth-kbps N    przepustowosc lacza w kbit/s\n"
+              << "  --error-rate P        prawdopodobienstwo odpowiedzi HTTP 500 (0..1)\n"
+              << "  --max-concurrent N    limit jednoczesnie obslugiwanych zapytan\n"
+              << "  --seed N              ziarno generatora losowego\n"
+              << "  --gzip                kompresja gzip odpowiedzi (gdy klient ja akceptuje)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    MockGiosOptions options;
+    options.fixtureDir = AIRQUALITY_MOCK_FIXTURES;
+    std::string host = "127.0.0.1";
+    std::uint16_t port = 8090;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--host" && hasValue) {
+            host = argv[++i];
+        } else if (arg == "--port" && hasValue) {
+            port = static_cast<std::uint16_t>(std::atoi(argv[++i]));
+        } else if (arg == "--fixtures" && hasValue) {
+            options.fixtureDir = argv[++i];
+        } else if (arg == "--latency-ms" && hasValue) {
+            options.latencyMs = std::atoi(argv[++i]);
+        } else if (arg == "--jitter-ms" && hasValue) {
+            options.jitterMs = std::atoi(argv[++i]);
+        } else if (arg == "--bandwidth-kbps" && hasValue) {
+            options.bandwidthKbps = std::atoi(argv[++i]);
+        } else if (arg == "--error-rate" && hasValue) {
+            options.errorRate = std::atof(argv[++i]);
+        } else if (arg == "--max-concurrent" && hasValue) {
+            options.maxConcurrent = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--gzip") {
+            options.gzip = true;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    try {
+        MockGiosServer server(options);
+        activeServer = &server;
+        std::signal(SIGINT, handleSignal);
+        std::signal(SIGTERM, handleSignal);
+
+        std::cout << "Serwer zastepczy GIOS: http://" << host << ":" << port
+                  << " (dane: " << options.fixtureDir << ")" << std::endl;
+        server.run(host, port);
+        activeServer = nullptr;
+
+        MockGiosServer::Stats stats = server.stats();
+        std::cout << "Zapytania: " << stats.requests << ", bledy wstrzykniete: " << stats.injectedErrors
+                  << ", nieznane zasoby: " << stats.notFound << ", w kolejce: " << stats.queued << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Blad serwera zastepczego: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
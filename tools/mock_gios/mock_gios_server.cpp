@@ -0,0 +1,291 @@
+/**
+ * @file mock_gios_server.cpp
+ * @brief Implementacja serwera zastępczego API GIOŚ
+ */
+
+#include "mock_gios_server.hpp"
+#include <nlohmann/json.hpp>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef AIRQUALITY_MOCK_GZIP
+#include <zlib.h>
+#endif
+
+namespace {
+
+bool readFile(const std::string& path, std::string& content) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    content = buffer.str();
+    return true;
+}
+
+// Sprawdza, czy ścieżka ma postać prefiks + liczba; zwraca liczbę w id
+bool matchIdPath(const std::string& path, const std::string& prefix, int& id) {
+    if (path.compare(0, prefix.size(), prefix) != 0 || path.size() == prefix.size() ||
+        path.size() - prefix.size() > 9) {
+        return false;
+    }
+    id = 0;
+    for (std::size_t i = prefix.size(); i < path.size(); ++i) {
+        if (!std::isdigit(static_cast<unsigned char>(path[i]))) {
+            return false;
+        }
+        id = id * 10 + (path[i] - '0');
+    }
+    return true;
+}
+
+// Sprawdza, czy klient akceptuje kodowanie gzip
+bool acceptsGzip(const HttpRequest& request) {
+    auto it = request.headers.find("accept-encoding");
+    return it != request.headers.end() && it->second.find("gzip") != std::string::npos;
+}
+
+#ifdef AIRQUALITY_MOCK_GZIP
+// Kompresuje treść do formatu gzip
+std::string gzipCompress(const std::string& input) {
+    z_stream stream{};
+    if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("Blad inicjalizacji kompresji gzip");
+    }
+    std::string output(deflateBound(&stream, static_cast<uLong>(input.size())), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&output[0]);
+    stream.avail_out = static_cast<uInt>(output.size());
+    const int result = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        throw std::runtime_error("Blad kompresji gzip");
+    }
+    return output;
+}
+#endif
+
+} // namespace
+
+MockGiosServer::MockGiosServer(MockGiosOptions options)
+    : options(std::move(options)),
+      http([this](const HttpRequest& request, HttpServer::Responder respond) {
+          handle(request, std::move(respond));
+      }),
+      random(this->options.seed) {
+    std::string stations;
+    if (!readFile(this->options.fixtureDir + "/station/findAll.json", stations)) {
+        throw std::runtime_error("Brak pliku z nagranymi stacjami: " +
+                                 this->options.fixtureDir + "/station/findAll.json");
+    }
+    schedulerThread = std::thread([this]() { schedulerLoop(); });
+}
+
+MockGiosServer::~MockGiosServer() {
+    stop();
+    {
+        std::lock_guard<std::mutex> lock(scheduleMutex);
+        schedulerStopping = true;
+    }
+    scheduleCondition.notify_all();
+    schedulerThread.join();
+}
+
+void MockGiosServer::start(const std::string& host, std::uint16_t port) {
+    http.listen(host, port);
+    boundHost = host;
+    loopThread = std::thread([this]() { http.run(); });
+}
+
+void MockGiosServer::run(const std::string& host, std::uint16_t port) {
+    http.listen(host, port);
+    boundHost = host;
+    http.run();
+}
+
+void MockGiosServer::requestStop() {
+    http.stop();
+}
+
+void MockGiosServer::stop() {
+    http.stop();
+    if (loopThread.joinable()) {
+        loopThread.join();
+    }
+}
+
+std::string MockGiosServer::baseUrl() const {
+    const std::string host = boundHost.empty() || boundHost == "0.0.0.0" ? "127.0.0.1" : boundHost;
+    return "http://" + host + ":" + std::to_string(port());
+}
+
+bool MockGiosServer::compressionSupported() {
+#ifdef AIRQUALITY_MOCK_GZIP
+    return true;
+#else
+    return false;
+#endif
+}
+
+MockGiosServer::Stats MockGiosServer::stats() const {
+    std::lock_guard<std::mutex> lock(scheduleMutex);
+    return counters;
+}
+
+void MockGiosServer::handle(const HttpRequest& request, HttpServer::Responder respond) {
+    if (request.method != "GET" && request.method != "HEAD") {
+        respond(HttpServer::makeResponse(405, "text/plain", "Method Not Allowed"));
+        return;
+    }
+
+    HttpResponsePtr response = lookup(request.path, options.gzip && acceptsGzip(request));
+    {
+        std::lock_guard<std::mutex> lock(scheduleMutex);
+        ++counters.requests;
+        if (!response) {
+            ++counters.notFound;
+        }
+    }
+    if (!response) {
+        response = HttpServer::makeResponse(404, "text/plain", "Not Found");
+    } else if (request.method == "HEAD") {
+        // Zapytanie o dostępność API (ApiClient::isApiAvailable) - bez treści
+        response = HttpServer::makeResponse(200, "application/json;charset=UTF-8", "");
+    }
+    serve(std::move(response), std::move(respond));
+}
+
+HttpResponsePtr MockGiosServer::lookup(const std::string& path, bool gzip) {
+    int id = 0;
+    const bool isStations = path == "/station/findAll";
+    const bool isSensors = matchIdPath(path, "/station/sensors/", id);
+    const bool isData = matchIdPath(path, "/data/getData/", id);
+    if (!isStations && !isSensors && !isData) {
+        return nullptr;
+    }
+
+#ifndef AIRQUALITY_MOCK_GZIP
+    gzip = false;
+#endif
+    const std::string key = gzip ? path + " gzip" : path;
+
+    std::lock_guard<std::mutex> lock(fixtureMutex);
+    auto cached = responses.find(key);
+    if (cached != responses.end()) {
+        return cached->second;
+    }
+
+    // Najpierw nagrana odpowiedź dla konkretnego ID, potem szablon default.json
+    std::string body;
+    if (!readFile(options.fixtureDir + path + ".json", body)) {
+        const std::string directory = path.substr(0, path.rfind('/'));
+        if (isStations || !readFile(options.fixtureDir + directory + "/default.json", body)) {
+            return nullptr;
+        }
+        if (isSensors) {
+            nlohmann::json sensors = nlohmann::json::parse(body);
+            int index = 0;
+            for (auto& sensor : sensors) {
+                sensor["stationId"] = id;
+                sensor["id"] = id * 100 + index++;
+            }
+            body = sensors.dump();
+        }
+    }
+
+    HttpResponsePtr response;
+#ifdef AIRQUALITY_MOCK_GZIP
+    if (gzip) {
+        response = HttpServer::makeResponse(200, "application/json;charset=UTF-8", gzipCompress(body),
+                                            {{"Content-Encoding", "gzip"}, {"Vary", "Accept-Encoding"}});
+    }
+#endif
+    if (!response) {
+        response = HttpServer::makeResponse(200, "application/json;charset=UTF-8", body);
+    }
+    responses[key] = response;
+    return response;
+}
+
+void MockGiosServer::serve(HttpResponsePtr response, HttpServer::Responder respond) {
+    static const HttpResponsePtr errorResponse =
+        HttpServer::makeResponse(500, "text/plain", "Internal Server Error");
+
+    const bool delayed = options.latencyMs > 0 || options.jitterMs > 0 ||
+                         options.bandwidthKbps > 0 || options.maxConcurrent > 0;
+
+    std::unique_lock<std::mutex> lock(scheduleMutex);
+    if (options.errorRate > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(random) < options.errorRate) {
+        ++counters.injectedErrors;
+        response = errorResponse;
+    }
+
+    // Bez opóźnień i limitów odpowiedź jest wysyłana od razu z wątku pętli
+    if (!delayed) {
+        lock.unlock();
+        respond(response);
+        return;
+    }
+
+    // Uruchamiane pod blokadą scheduleMutex, gdy zapytanie dostanie slot
+    auto begin = [this, response, respond]() {
+        double delayMs = options.latencyMs;
+        if (options.jitterMs > 0) {
+            delayMs += std::exponential_distribution<double>(1.0 / options.jitterMs)(random);
+        }
+        if (options.bandwidthKbps > 0) {
+            delayMs += static_cast<double>(response->size()) * 8.0 / options.bandwidthKbps;
+        }
+        const auto due = Clock::now() + std::chrono::microseconds(static_cast<std::int64_t>(delayMs * 1000.0));
+        schedule.push({due, nextSequence++, [this, response, respond]() {
+            respond(response);
+            release();
+        }});
+        scheduleCondition.notify_one();
+    };
+
+    if (options.maxConcurrent > 0 && activeRequests >= options.maxConcurrent) {
+        ++counters.queued;
+        waitingForSlot.push_back(std::move(begin));
+        return;
+    }
+    ++activeRequests;
+    begin();
+}
+
+void MockGiosServer::release() {
+    std::lock_guard<std::mutex> lock(scheduleMutex);
+    --activeRequests;
+    if (!waitingForSlot.empty()) {
+        auto next = std::move(waitingForSlot.front());
+        waitingForSlot.pop_front();
+        ++activeRequests;
+        next();
+    }
+}
+
+void MockGiosServer::schedulerLoop() {
+    std::unique_lock<std::mutex> lock(scheduleMutex);
+    while (!schedulerStopping) {
+        if (schedule.empty()) {
+            scheduleCondition.wait(lock);
+            continue;
+        }
+        const auto due = schedule.top().due;
+        if (Clock::now() < due) {
+            scheduleCondition.wait_until(lock, due);
+            continue;
+        }
+        auto task = std::move(const_cast<ScheduledTask&>(schedule.top()).task);
+        schedule.pop();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
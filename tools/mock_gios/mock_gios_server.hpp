@@ -0,0 +1,158 @@
+/**
+ * @file mock_gios_server.hpp
+ * @brief Lokalny serwer zastępczy API GIOŚ z wstrzykiwaniem opóźnień i błędów
+ */
+#ifndef MOCK_GIOS_SERVER_HPP
+#define MOCK_GIOS_SERVER_HPP
+
+#include "http_server.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Parametry serwera zastępczego
+ */
+struct MockGiosOptions {
+    std::string fixtureDir;     ///< Katalog z nagranymi odpowiedziami (struktura jak ścieżki API)
+    int latencyMs = 0;          ///< Stałe opóźnienie odpowiedzi (ms)
+    int jitterMs = 0;           ///< Średnie dodatkowe opóźnienie losowe, rozkład wykładniczy (ms)
+    int bandwidthKbps = 0;      ///< Przepustowość łącza w kbit/s (0 - bez limitu)
+    double errorRate = 0.0;     ///< Prawdopodobieństwo odpowiedzi HTTP 500 (0..1)
+    int maxConcurrent = 0;      ///< Maksymalna liczba jednocześnie obsługiwanych zapytań (0 - bez limitu)
+    unsigned seed = 12345;      ///< Ziarno generatora losowego (powtarzalne przebiegi)
+    bool gzip = false;          ///< Kompresja gzip, gdy klient ją akceptuje (Accept-Encoding)
+};
+
+/**
+ * @brief Serwer zastępczy API GIOŚ
+ *
+ * Obsługuje endpointy /station/findAll, /station/sensors/{id} i /data/getData/{id}
+ * na podstawie plików z katalogu fixtureDir. Plik odpowiedzi ma ścieżkę endpointu
+ * z rozszerzeniem .json (np. data/getData/92.json); jeśli go brak, używany jest
+ * default.json z tego samego katalogu (dla czujników z podstawionym ID stacji).
+ *
+ * Opóźnienia są realizowane przez osobny wątek harmonogramu, więc pętla zdarzeń
+ * HTTP nigdy nie jest blokowana. Zapytania ponad limit maxConcurrent czekają
+ * w kolejce FIFO, tak jak w przeciążonym serwerze.
+ */
+class MockGiosServer {
+public:
+    /**
+     * @brief Liczniki zapytań
+     */
+    struct Stats {
+        std::uint64_t requests = 0;       ///< Wszystkie zapytania
+        std::uint64_t injectedErrors = 0; ///< Odpowiedzi HTTP 500 wstrzyknięte celowo
+        std::uint64_t notFound = 0;       ///< Zapytania o nieznane zasoby
+        std::uint64_t queued = 0;         ///< Zapytania, które czekały na wolny slot
+    };
+
+    /**
+     * @brief Konstruktor
+     * @param options Parametry serwera
+     * @throws std::runtime_error jeśli brak pliku station/findAll.json
+     */
+    explicit MockGiosServer(MockGiosOptions options);
+
+    /**
+     * @brief Destruktor - zatrzymuje serwer i wątki pomocnicze
+     */
+    ~MockGiosServer();
+
+    MockGiosServer(const MockGiosServer&) = delete;
+    MockGiosServer& operator=(const MockGiosServer&) = delete;
+
+    /**
+     * @brief Uruchamia serwer w wątku w tle
+     * @param host Adres nasłuchiwania
+     * @param port Port (0 - dowolny wolny port)
+     */
+    void start(const std::string& host = "127.0.0.1", std::uint16_t port = 0);
+
+    /**
+     * @brief Uruchamia serwer w bieżącym wątku; kończy się po requestStop()
+     */
+    void run(const std::string& host, std::uint16_t port);
+
+    /**
+     * @brief Prosi o zatrzymanie pętli zdarzeń (bezpieczne w obsłudze sygnału)
+     */
+    void requestStop();
+
+    /**
+     * @brief Zatrzymuje serwer uruchomiony przez start()
+     */
+    void stop();
+
+    /**
+     * @brief Zwraca port nasłuchiwania
+     */
+    std::uint16_t port() const { return http.port(); }
+
+    /**
+     * @brief Zwraca adres bazowy do użycia w ApiClient
+     */
+    std::string baseUrl() const;
+
+    /**
+     * @brief Zwraca bieżące liczniki zapytań
+     */
+    Stats stats() const;
+
+    /**
+     * @brief Sprawdza, czy serwer został zbudowany z obsługą kompresji gzip
+     */
+    static bool compressionSupported();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct ScheduledTask {
+        Clock::time_point due;
+        std::uint64_t sequence;
+        std::function<void()> task;
+        bool operator>(const ScheduledTask& other) const {
+            return due != other.due ? due > other.due : sequence > other.sequence;
+        }
+    };
+
+    MockGiosOptions options;
+    HttpServer http;
+    std::string boundHost;
+    std::thread loopThread;
+
+    // Odpowiedzi z plików, serializowane raz (klucz: ścieżka endpointu i kodowanie)
+    std::mutex fixtureMutex;
+    std::unordered_map<std::string, HttpResponsePtr> responses;
+
+    // Harmonogram opóźnionych odpowiedzi i limit współbieżności
+    mutable std::mutex scheduleMutex;
+    std::condition_variable scheduleCondition;
+    std::priority_queue<ScheduledTask, std::vector<ScheduledTask>, std::greater<ScheduledTask>> schedule;
+    std::deque<std::function<void()>> waitingForSlot;
+    std::uint64_t nextSequence = 0;
+    int activeRequests = 0;
+    bool schedulerStopping = false;
+    std::mt19937 random;
+    Stats counters;
+    std::thread schedulerThread;
+
+    void handle(const HttpRequest& request, HttpServer::Responder respond);
+    HttpResponsePtr lookup(const std::string& path, bool gzip);
+    void serve(HttpResponsePtr response, HttpServer::Responder respond);
+    void release();
+    void schedulerLoop();
+};
+
+#endif // MOCK_GIOS_SERVER_HPP
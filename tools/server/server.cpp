@@ -0,0 +1,387 @@
+/**
+ * @file server.cpp
+ * @brief Lokalny serwer zapytań HTTP/JSON współdzielący jeden "ciepły" cache danych GIOŚ
+ *
+ * Serwer osadza ApiClient i udostępnia stacje, czujniki, pomiary i statystyki
+ * przez lokalny endpoint HTTP. Odpowiedzi są serializowane raz i przechowywane
+ * jako gotowe bajty, więc kolejne zapytania są obsługiwane bez ponownego
+ * kodowania JSON i bez zapytań do API GIOŚ. Wiele jednoczesnych zapytań o ten
+ * sam zasób oczekuje na jedno wspólne pobranie.
+ */
+
+#include "api_client.hpp"
+#include "http_server.hpp"
+#include "measurement_series.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Opcje uruchomienia serwera
+ */
+struct ServerOptions {
+    std::string host = "127.0.0.1"; ///< Adres nasłuchiwania
+    std::uint16_t port = 8080;      ///< Port nasłuchiwania
+    int workers = 4;                ///< Liczba wątków pobierających dane z API
+    int measurementTtl = 900;       ///< Czas ważności pomiarów w cache (sekundy)
+    int metadataTtl = 86400;        ///< Czas ważności stacji i czujników w cache (sekundy)
+    bool verbose = false;           ///< Komunikaty ApiClient
+};
+
+/**
+ * @brief Prosta pula wątków wykonująca zadania w kolejności zgłoszenia
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(int threadCount) {
+        for (int i = 0; i < threadCount; ++i) {
+            threads.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        condition.notify_one();
+    }
+
+private:
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+
+    void workerLoop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty()) {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+/**
+ * @brief Usługa zapytań: routing, cache serializowanych odpowiedzi i łączenie zapytań
+ */
+class QueryService {
+public:
+    QueryService(ApiClient& client, const ServerOptions& options)
+        : client(client), options(options), pool(options.workers) {}
+
+    /**
+     * @brief Obsługuje żądanie HTTP (wywoływane w wątku pętli zdarzeń)
+     */
+    void handle(const HttpRequest& request, HttpServer::Responder respond) {
+        if (request.method != "GET") {
+            respond(HttpServer::makeResponse(405, "text/plain", "Obslugiwana jest tylko metoda GET\n"));
+            return;
+        }
+        if (request.path == "/health") {
+            respond(HttpServer::makeResponse(200, "application/json", "{\"status\":\"ok\"}"));
+            return;
+        }
+        if (request.path == "/metrics") {
+            respond(HttpServer::makeResponse(200, "text/plain; version=0.0.4", client.getMetrics().toPrometheus()));
+            return;
+        }
+
+        const std::string key = request.path;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (key == "/stats") {
+                json stats;
+                stats["cacheEntries"] = cache.size();
+                stats["cacheHits"] = cacheHits;
+                stats["cacheMisses"] = cacheMisses;
+                stats["coalescedRequests"] = coalescedRequests;
+                respond(jsonResponse(200, stats, 0));
+                return;
+            }
+
+            auto cached = cache.find(key);
+            if (cached != cache.end() && Clock::now() < cached->second.expiresAt) {
+                ++cacheHits;
+                respond(cached->second.response);
+                return;
+            }
+
+            // Zasób jest już pobierany - dołącz do oczekujących
+            auto pendingIt = pending.find(key);
+            if (pendingIt != pending.end()) {
+                ++coalescedRequests;
+                pendingIt->second.push_back(std::move(respond));
+                return;
+            }
+            ++cacheMisses;
+            pending[key].push_back(std::move(respond));
+        }
+
+        pool.submit([this, key]() {
+            int ttl = 0;
+            HttpResponsePtr response = build(key, ttl);
+
+            std::vector<HttpServer::Responder> waiting;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (ttl > 0) {
+                    cache[key] = {response, Clock::now() + std::chrono::seconds(ttl)};
+                }
+                waiting.swap(pending[key]);
+                pending.erase(key);
+            }
+            for (auto& respond : waiting) {
+                respond(response);
+            }
+        });
+    }
+
+private:
+    struct CachedResponse {
+        HttpResponsePtr response;
+        Clock::time_point expiresAt;
+    };
+
+    ApiClient& client;
+    const ServerOptions& options;
+    ThreadPool pool;
+
+    std::mutex mutex;
+    std::unordered_map<std::string, CachedResponse> cache;
+    std::unordered_map<std::string, std::vector<HttpServer::Responder>> pending;
+    std::size_t cacheHits = 0;
+    std::size_t cacheMisses = 0;
+    std::size_t coalescedRequests = 0;
+
+    std::mutex fetchMutex;
+    std::unordered_map<int, Clock::time_point> measurementFetchTimes;
+
+    /**
+     * @brief Tworzy odpowiedź JSON z nagłówkami cache
+     */
+    static HttpResponsePtr jsonResponse(int status, const json& body, int ttl) {
+        return HttpServer::makeResponse(status, "application/json; charset=utf-8", body.dump(), {
+            {"Cache-Control", "max-age=" + std::to_string(ttl)},
+            {"Access-Control-Allow-Origin", "*"}
+        });
+    }
+
+    /**
+     * @brief Pobiera pomiary czujnika, odświeżając cache ApiClient po upływie TTL
+     */
+    std::vector<Measurement> fetchMeasurements(int sensorId) {
+        bool stale;
+        {
+            std::lock_guard<std::mutex> lock(fetchMutex);
+            auto it = measurementFetchTimes.find(sensorId);
+            stale = it == measurementFetchTimes.end() ||
+                    Clock::now() - it->second >= std::chrono::seconds(options.measurementTtl);
+            if (stale) {
+                measurementFetchTimes[sensorId] = Clock::now();
+            }
+        }
+        if (stale) {
+            client.clearMeasurementCache(sensorId);
+        }
+        return client.getMeasurements(sensorId);
+    }
+
+    /**
+     * @brief Buduje odpowiedź dla ścieżki (wywoływane w puli wątków)
+     * @param path Ścieżka zasobu
+     * @param ttl Czas ważności odpowiedzi w cache (0 - nie zapisywać)
+     */
+    HttpResponsePtr build(const std::string& path, int& ttl) {
+        // Błędy API są zapamiętywane krótko, aby nie przeciążać GIOŚ ponawianymi zapytaniami
+        const int errorTtl = 5;
+
+        if (path == "/stations") {
+            std::vector<Station> stations = client.getAllStations();
+            if (stations.empty()) {
+                ttl = errorTtl;
+                return jsonResponse(502, {{"error", "Nie udalo sie pobrac stacji"}}, ttl);
+            }
+            json body = json::array();
+            for (const auto& station : stations) {
+                body.push_back({{"id", station.id}, {"name", station.name}, {"lat", station.lat},
+                                {"lon", station.lon}, {"city", station.city},
+                                {"address", station.address}, {"province", station.province}});
+            }
+            ttl = options.metadataTtl;
+            return jsonResponse(200, body, ttl);
+        }
+
+        int id = 0;
+        char suffix[32] = {};
+        if (std::sscanf(path.c_str(), "/stations/%d/%31s", &id, suffix) == 2 && std::string(suffix) == "sensors") {
+            std::vector<Sensor> sensors = client.getSensors(id);
+            if (sensors.empty()) {
+                ttl = errorTtl;
+                return jsonResponse(502, {{"error", "Nie udalo sie pobrac czujnikow"}}, ttl);
+            }
+            json body = json::array();
+            for (const auto& sensor : sensors) {
+                json item = {{"id", sensor.id}, {"stationId", sensor.stationId},
+                             {"paramName", sensor.paramName}, {"paramFormula", sensor.paramFormula},
+                             {"paramCode", sensor.paramCode}, {"paramId", sensor.paramId}};
+                if (const PollutantInfo* info = pollutantInfo(sensor.pollutant)) {
+                    item["unit"] = std::string(info->unit);
+                    item["limit"] = {{"value", info->limitValue},
+                                     {"period", std::string(averagingPeriodName(info->limitPeriod))},
+                                     {"allowedExceedances", info->allowedExceedances}};
+                }
+                body.push_back(item);
+            }
+            ttl = options.metadataTtl;
+            return jsonResponse(200, body, ttl);
+        }
+
+        if (std::sscanf(path.c_str(), "/sensors/%d/%31s", &id, suffix) == 2) {
+            std::string resource = suffix;
+            if (resource != "measurements" && resource != "statistics") {
+                ttl = 0; // nieznane ścieżki nie trafiają do cache
+                return jsonResponse(404, {{"error", "Nieznany zasob"}}, ttl);
+            }
+
+            std::vector<Measurement> measurements = fetchMeasurements(id);
+            if (measurements.empty()) {
+                ttl = errorTtl;
+                return jsonResponse(502, {{"error", "Brak pomiarow dla czujnika"}}, ttl);
+            }
+
+            json body;
+            if (resource == "measurements") {
+                body = json::array();
+                for (const auto& measurement : measurements) {
+                    body.push_back({{"date", measurement.date}, {"value", measurement.value}});
+                }
+            } else {
+                SeriesStatistics statistics = computeStatistics(MeasurementSeries::fromMeasurements(measurements));
+                body = {{"sensorId", id}, {"count", statistics.count}, {"min", statistics.min},
+                        {"max", statistics.max}, {"mean", statistics.mean},
+                        {"from", formatMeasurementDate(statistics.firstTimestamp)},
+                        {"to", formatMeasurementDate(statistics.lastTimestamp)},
+                        {"latest", statistics.lastValue}};
+            }
+            ttl = options.measurementTtl;
+            return jsonResponse(200, body, ttl);
+        }
+
+        ttl = 0;
+        return jsonResponse(404, {{"error", "Nieznany zasob"}}, ttl);
+    }
+};
+
+HttpServer* activeServer = nullptr;
+
+void handleSignal(int) {
+    if (activeServer) {
+        activeServer->stop();
+    }
+}
+
+void printUsage(const char* program) {
+    std::cout << "Uzycie: " << program << " [opcje]\n"
+              << "  --host ADRES      adres nasluchiwania (domyslnie 127.0.0.1)\n"
+              << "  --port PORT       port nasluchiwania (domyslnie 8080)\n"
+              << "  --workers N       liczba watkow pobierajacych dane (domyslnie 4)\n"
+              << "  --ttl SEKUNDY     czas waznosci pomiarow w cache (domyslnie 900)\n"
+              << "  --verbose         komunikaty klienta API\n"
+              << "\nZasoby: /stations, /stations/{id}/sensors, /sensors/{id}/measurements,\n"
+              << "        /sensors/{id}/statistics, /stats, /metrics, /health\n";
+}
+
+bool parseOptions(int argc, char* argv[], ServerOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--host" && hasValue) {
+            options.host = argv[++i];
+        } else if (arg == "--port" && hasValue) {
+            options.port = static_cast<std::uint16_t>(std::atoi(argv[++i]));
+        } else if (arg == "--workers" && hasValue) {
+            options.workers = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--ttl" && hasValue) {
+            options.measurementTtl = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--verbose") {
+            options.verbose = true;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ServerOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    ApiClient client;
+    client.setVerbose(options.verbose);
+
+    try {
+        // Usługa (z pulą wątków) jest niszczona przed serwerem: zadania kończone po zatrzymaniu
+        // pętli wciąż odpowiadają przez serwer, więc musi on istnieć do zakończenia puli
+        QueryService* service = nullptr;
+        HttpServer server([&service](const HttpRequest& request, HttpServer::Responder respond) {
+            service->handle(request, std::move(respond));
+        });
+        QueryService queryService(client, options);
+        service = &queryService;
+        server.listen(options.host, options.port);
+
+        activeServer = &server;
+        std::signal(SIGINT, handleSignal);
+        std::signal(SIGTERM, handleSignal);
+
+        std::cout << "Serwer nasluchuje na http://" << options.host << ":" << server.port() << std::endl;
+        server.run();
+        activeServer = nullptr;
+    } catch (const std::exception& e) {
+        std::cerr << "Blad serwera: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Serwer zatrzymany" << std::endl;
+    return 0;
+}